@@ -20,7 +20,9 @@ set(
   "${draco_src_root}/compression/attributes/prediction_schemes/prediction_scheme_normal_octahedron_transform_test.cc"
   "${draco_src_root}/compression/attributes/sequential_integer_attribute_encoding_test.cc"
   "${draco_src_root}/compression/bit_coders/rans_coding_test.cc"
+  "${draco_src_root}/compression/chunked_encode_test.cc"
   "${draco_src_root}/compression/decode_test.cc"
+  "${draco_src_root}/compression/decoder_session_test.cc"
   "${draco_src_root}/compression/encode_test.cc"
   "${draco_src_root}/compression/entropy/shannon_entropy_test.cc"
   "${draco_src_root}/compression/entropy/symbol_coding_test.cc"
@@ -28,24 +30,37 @@ set(
   "${draco_src_root}/compression/mesh/mesh_encoder_test.cc"
   "${draco_src_root}/compression/point_cloud/point_cloud_kd_tree_encoding_test.cc"
   "${draco_src_root}/compression/point_cloud/point_cloud_sequential_encoding_test.cc"
+  "${draco_src_root}/compression/streaming_decode_test.cc"
+  "${draco_src_root}/core/arena_test.cc"
+  "${draco_src_root}/core/bit_vector_test.cc"
   "${draco_src_root}/core/buffer_bit_coding_test.cc"
   "${draco_src_root}/core/draco_test_base.h"
   "${draco_src_root}/core/draco_test_utils.cc"
   "${draco_src_root}/core/draco_test_utils.h"
+  "${draco_src_root}/core/flat_hash_index_test.cc"
   "${draco_src_root}/core/math_utils_test.cc"
   "${draco_src_root}/core/quantization_utils_test.cc"
   "${draco_src_root}/core/status_test.cc"
+  "${draco_src_root}/core/thread_pool_test.cc"
   "${draco_src_root}/core/vector_d_test.cc"
+  "${draco_src_root}/io/block_writer_test.cc"
+  "${draco_src_root}/io/data_source_test.cc"
+  "${draco_src_root}/io/encoded_chunk_list_test.cc"
   "${draco_src_root}/io/file_reader_test_common.h"
   "${draco_src_root}/io/file_utils_test.cc"
+  "${draco_src_root}/io/mmap_file_reader_test.cc"
+  "${draco_src_root}/io/number_formatting_test.cc"
   "${draco_src_root}/io/stdio_file_reader_test.cc"
   "${draco_src_root}/io/stdio_file_writer_test.cc"
   "${draco_src_root}/io/obj_decoder_test.cc"
   "${draco_src_root}/io/obj_encoder_test.cc"
+  "${draco_src_root}/io/parser_utils_test.cc"
   "${draco_src_root}/io/ply_decoder_test.cc"
   "${draco_src_root}/io/ply_reader_test.cc"
   "${draco_src_root}/io/point_cloud_io_test.cc"
+  "${draco_src_root}/mesh/corner_table_test.cc"
   "${draco_src_root}/mesh/mesh_are_equivalent_test.cc"
+  "${draco_src_root}/mesh/mesh_buffer_layout_test.cc"
   "${draco_src_root}/mesh/mesh_cleanup_test.cc"
   "${draco_src_root}/mesh/triangle_soup_mesh_builder_test.cc"
   "${draco_src_root}/metadata/metadata_encoder_test.cc"
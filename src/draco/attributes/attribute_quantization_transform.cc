@@ -15,11 +15,44 @@
 //
 #include "draco/attributes/attribute_quantization_transform.h"
 
+#include <algorithm>
+
 #include "draco/attributes/attribute_transform_type.h"
 #include "draco/core/quantization_utils.h"
 
 namespace draco {
 
+namespace {
+
+// Quantizes values of |attribute| for |num_entries| points given by
+// |point_id(i)| and stores them into |out_values|. The values are gathered
+// into blocks that are quantized at once with Quantizer::QuantizeFloats().
+template <typename PointIdFunctorT>
+void QuantizeAttributeValues(const PointAttribute &attribute,
+                             const Quantizer &quantizer,
+                             const float *min_values, int num_entries,
+                             const PointIdFunctorT &point_id,
+                             int32_t *out_values) {
+  constexpr int kMaxBlockEntries = 256;
+  const int num_components = attribute.num_components();
+  const std::unique_ptr<float[]> block(
+      new float[kMaxBlockEntries * num_components]);
+  for (int begin = 0; begin < num_entries; begin += kMaxBlockEntries) {
+    const int num_block_entries =
+        std::min(kMaxBlockEntries, num_entries - begin);
+    for (int i = 0; i < num_block_entries; ++i) {
+      attribute.GetValue(attribute.mapped_index(point_id(begin + i)),
+                         block.get() + i * num_components);
+    }
+    quantizer.QuantizeFloats(block.get(), num_block_entries, num_components,
+                             min_values,
+                             out_values + static_cast<int64_t>(begin) *
+                                              num_components);
+  }
+}
+
+}  // namespace
+
 bool AttributeQuantizationTransform::InitFromAttribute(
     const PointAttribute &attribute) {
   const AttributeTransformData *const transform_data =
@@ -138,17 +171,9 @@ AttributeQuantizationTransform::GeneratePortableAttribute(
   const uint32_t max_quantized_value = (1 << (quantization_bits_)) - 1;
   Quantizer quantizer;
   quantizer.Init(range(), max_quantized_value);
-  int32_t dst_index = 0;
-  const std::unique_ptr<float[]> att_val(new float[num_components]);
-  for (PointIndex i(0); i < num_points; ++i) {
-    const AttributeValueIndex att_val_id = attribute.mapped_index(i);
-    attribute.GetValue(att_val_id, att_val.get());
-    for (int c = 0; c < num_components; ++c) {
-      const float value = (att_val[c] - min_values()[c]);
-      const int32_t q_val = quantizer.QuantizeFloat(value);
-      portable_attribute_data[dst_index++] = q_val;
-    }
-  }
+  QuantizeAttributeValues(
+      attribute, quantizer, min_values().data(), num_entries,
+      [](int i) { return PointIndex(i); }, portable_attribute_data);
   return portable_attribute;
 }
 
@@ -170,17 +195,9 @@ AttributeQuantizationTransform::GeneratePortableAttribute(
   const uint32_t max_quantized_value = (1 << (quantization_bits_)) - 1;
   Quantizer quantizer;
   quantizer.Init(range(), max_quantized_value);
-  int32_t dst_index = 0;
-  const std::unique_ptr<float[]> att_val(new float[num_components]);
-  for (uint32_t i = 0; i < point_ids.size(); ++i) {
-    const AttributeValueIndex att_val_id = attribute.mapped_index(point_ids[i]);
-    attribute.GetValue(att_val_id, att_val.get());
-    for (int c = 0; c < num_components; ++c) {
-      const float value = (att_val[c] - min_values()[c]);
-      const int32_t q_val = quantizer.QuantizeFloat(value);
-      portable_attribute_data[dst_index++] = q_val;
-    }
-  }
+  QuantizeAttributeValues(
+      attribute, quantizer, min_values().data(), num_entries,
+      [&point_ids](int i) { return point_ids[i]; }, portable_attribute_data);
   return portable_attribute;
 }
 
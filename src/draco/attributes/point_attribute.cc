@@ -14,9 +14,7 @@
 //
 #include "draco/attributes/point_attribute.h"
 
-#include <unordered_map>
-
-using std::unordered_map;
+#include "draco/core/flat_hash_index.h"
 
 // Shortcut for typed conditionals.
 template <bool B, class T, class F>
@@ -64,11 +62,21 @@ void PointAttribute::CopyFrom(const PointAttribute &src_att) {
 }
 
 bool PointAttribute::Reset(size_t num_attribute_values) {
+  return Reset(num_attribute_values, nullptr);
+}
+
+bool PointAttribute::Reset(size_t num_attribute_values, Arena *arena) {
   if (attribute_buffer_ == nullptr) {
     attribute_buffer_ = std::unique_ptr<DataBuffer>(new DataBuffer());
   }
   const int64_t entry_size = DataTypeLength(data_type()) * num_components();
-  if (!attribute_buffer_->Update(nullptr, num_attribute_values * entry_size)) {
+  if (arena != nullptr) {
+    if (!attribute_buffer_->AllocateFromArena(
+            arena, num_attribute_values * entry_size)) {
+      return false;
+    }
+  } else if (!attribute_buffer_->Update(nullptr,
+                                        num_attribute_values * entry_size)) {
     return false;
   }
   // Assign the new buffer to the parent attribute.
@@ -90,30 +98,43 @@ AttributeValueIndex::ValueType PointAttribute::DeduplicateValues(
 
 AttributeValueIndex::ValueType PointAttribute::DeduplicateValues(
     const GeometryAttribute &in_att, AttributeValueIndex in_att_offset) {
+  return DeduplicateValues(in_att, in_att_offset, nullptr);
+}
+
+AttributeValueIndex::ValueType PointAttribute::DeduplicateValues(
+    const GeometryAttribute &in_att, AttributeValueIndex in_att_offset,
+    ThreadPool *thread_pool) {
   AttributeValueIndex::ValueType unique_vals = 0;
   switch (in_att.data_type()) {
     // Currently we support only float, uint8, and uint16 arguments.
     case DT_FLOAT32:
-      unique_vals = DeduplicateTypedValues<float>(in_att, in_att_offset);
+      unique_vals =
+          DeduplicateTypedValues<float>(in_att, in_att_offset, thread_pool);
       break;
     case DT_INT8:
-      unique_vals = DeduplicateTypedValues<int8_t>(in_att, in_att_offset);
+      unique_vals =
+          DeduplicateTypedValues<int8_t>(in_att, in_att_offset, thread_pool);
       break;
     case DT_UINT8:
     case DT_BOOL:
-      unique_vals = DeduplicateTypedValues<uint8_t>(in_att, in_att_offset);
+      unique_vals =
+          DeduplicateTypedValues<uint8_t>(in_att, in_att_offset, thread_pool);
       break;
     case DT_UINT16:
-      unique_vals = DeduplicateTypedValues<uint16_t>(in_att, in_att_offset);
+      unique_vals =
+          DeduplicateTypedValues<uint16_t>(in_att, in_att_offset, thread_pool);
       break;
     case DT_INT16:
-      unique_vals = DeduplicateTypedValues<int16_t>(in_att, in_att_offset);
+      unique_vals =
+          DeduplicateTypedValues<int16_t>(in_att, in_att_offset, thread_pool);
       break;
     case DT_UINT32:
-      unique_vals = DeduplicateTypedValues<uint32_t>(in_att, in_att_offset);
+      unique_vals =
+          DeduplicateTypedValues<uint32_t>(in_att, in_att_offset, thread_pool);
       break;
     case DT_INT32:
-      unique_vals = DeduplicateTypedValues<int32_t>(in_att, in_att_offset);
+      unique_vals =
+          DeduplicateTypedValues<int32_t>(in_att, in_att_offset, thread_pool);
       break;
     default:
       return -1;  // Unsupported data type.
@@ -129,18 +150,23 @@ AttributeValueIndex::ValueType PointAttribute::DeduplicateValues(
 // Returns the number of unique attribute values.
 template <typename T>
 AttributeValueIndex::ValueType PointAttribute::DeduplicateTypedValues(
-    const GeometryAttribute &in_att, AttributeValueIndex in_att_offset) {
+    const GeometryAttribute &in_att, AttributeValueIndex in_att_offset,
+    ThreadPool *thread_pool) {
   // Select the correct method to call based on the number of attribute
   // components.
   switch (in_att.num_components()) {
     case 1:
-      return DeduplicateFormattedValues<T, 1>(in_att, in_att_offset);
+      return DeduplicateFormattedValues<T, 1>(in_att, in_att_offset,
+                                              thread_pool);
     case 2:
-      return DeduplicateFormattedValues<T, 2>(in_att, in_att_offset);
+      return DeduplicateFormattedValues<T, 2>(in_att, in_att_offset,
+                                              thread_pool);
     case 3:
-      return DeduplicateFormattedValues<T, 3>(in_att, in_att_offset);
+      return DeduplicateFormattedValues<T, 3>(in_att, in_att_offset,
+                                              thread_pool);
     case 4:
-      return DeduplicateFormattedValues<T, 4>(in_att, in_att_offset);
+      return DeduplicateFormattedValues<T, 4>(in_att, in_att_offset,
+                                              thread_pool);
     default:
       return 0;
   }
@@ -148,10 +174,11 @@ AttributeValueIndex::ValueType PointAttribute::DeduplicateTypedValues(
 
 template <typename T, int num_components_t>
 AttributeValueIndex::ValueType PointAttribute::DeduplicateFormattedValues(
-    const GeometryAttribute &in_att, AttributeValueIndex in_att_offset) {
-  // We want to detect duplicates using a hash map but we cannot hash floating
-  // point numbers directly so bit-copy floats to the same sized integers and
-  // hash them.
+    const GeometryAttribute &in_att, AttributeValueIndex in_att_offset,
+    ThreadPool *thread_pool) {
+  // We want to detect duplicates using a hash table but we cannot hash
+  // floating point numbers directly so bit-copy floats to the same sized
+  // integers and hash them.
 
   // First we need to determine which int type to use (1, 2, 4 or 8 bytes).
   // Note, this is done at compile time using std::conditional struct.
@@ -163,42 +190,48 @@ AttributeValueIndex::ValueType PointAttribute::DeduplicateFormattedValues(
                                                     /*else*/ uint64_t>>>
       HashType;
 
-  AttributeValueIndex unique_vals(0);
   typedef std::array<T, num_components_t> AttributeValue;
   typedef std::array<HashType, num_components_t> AttributeHashableValue;
-  // Hash map storing index of the first attribute with a given value.
-  unordered_map<AttributeHashableValue, AttributeValueIndex,
-                HashArray<AttributeHashableValue>>
-      value_to_index_map;
+  const auto hash = [&](uint32_t i) {
+    AttributeHashableValue hashable_value;
+    memcpy(&(hashable_value[0]), in_att.GetAddress(in_att_offset + i),
+           sizeof(hashable_value));
+    uint64_t value_hash = 79;  // Magic number.
+    for (int c = 0; c < num_components_t; ++c) {
+      value_hash = HashCombine64(value_hash, hashable_value[c]);
+    }
+    return value_hash;
+  };
+  const auto equal = [&](uint32_t i0, uint32_t i1) {
+    return memcmp(in_att.GetAddress(in_att_offset + i0),
+                  in_att.GetAddress(in_att_offset + i1),
+                  sizeof(AttributeValue)) == 0;
+  };
+
+  // Find the first value equal to each value. All values are still
+  // unmodified at this point, even if |in_att| is equal to |this|.
+  std::vector<uint32_t> first_equal_values;
+  FindFirstEqualEntries(num_unique_entries_, hash, equal, thread_pool,
+                        &first_equal_values);
+
+  AttributeValueIndex unique_vals(0);
   AttributeValue att_value;
-  AttributeHashableValue hashable_value;
   IndexTypeVector<AttributeValueIndex, AttributeValueIndex> value_map(
       num_unique_entries_);
   for (AttributeValueIndex i(0); i < num_unique_entries_; ++i) {
-    const AttributeValueIndex att_pos = i + in_att_offset;
-    att_value = in_att.GetValue<T, num_components_t>(att_pos);
-    // Convert the value to hashable type. Bit-copy real attributes to integers.
-    memcpy(&(hashable_value[0]), &(att_value[0]), sizeof(att_value));
-
-    // Check if the given attribute value has been used before already.
-    auto it = value_to_index_map.find(hashable_value);
-    if (it != value_to_index_map.end()) {
+    const uint32_t first_equal_value = first_equal_values[i.value()];
+    if (first_equal_value != i.value()) {
       // Duplicated value found. Update index mapping.
-      value_map[i] = it->second;
-    } else {
-      // New unique value.
-      // Update the hash map with a new entry pointing to the latest unique
-      // vertex index.
-      value_to_index_map.insert(
-          std::pair<AttributeHashableValue, AttributeValueIndex>(hashable_value,
-                                                                 unique_vals));
-      // Add the unique value to the mesh builder.
-      SetAttributeValue(unique_vals, &att_value);
-      // Update index mapping.
-      value_map[i] = unique_vals;
-
-      ++unique_vals;
+      value_map[i] = value_map[AttributeValueIndex(first_equal_value)];
+      continue;
     }
+    // New unique value. Values are stored in their original order so the
+    // value that is overwritten here has already been processed.
+    att_value = in_att.GetValue<T, num_components_t>(i + in_att_offset);
+    SetAttributeValue(unique_vals, &att_value);
+    // Update index mapping.
+    value_map[i] = unique_vals;
+    ++unique_vals;
   }
   if (unique_vals == num_unique_entries_) {
     return unique_vals.value();  // Nothing has changed.
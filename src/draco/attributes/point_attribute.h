@@ -19,9 +19,11 @@
 
 #include "draco/attributes/attribute_transform_data.h"
 #include "draco/attributes/geometry_attribute.h"
+#include "draco/core/arena.h"
 #include "draco/core/draco_index_type_vector.h"
 #include "draco/core/hash_utils.h"
 #include "draco/core/macros.h"
+#include "draco/core/thread_pool.h"
 #include "draco/draco_features.h"
 
 namespace draco
@@ -54,6 +56,10 @@ class PointAttribute : public GeometryAttribute
   // Prepares the attribute storage for the specified number of entries.
   bool Reset(size_t num_attribute_values);
 
+  // Same as Reset(), but the storage is allocated from |arena| when it is not
+  // null. Such attribute must not be used after the arena is reset.
+  bool Reset(size_t num_attribute_values, Arena *arena);
+
   size_t size() const { return num_unique_entries_; }
   AttributeValueIndex mapped_index(PointIndex point_index) const
   {
@@ -129,6 +135,11 @@ class PointAttribute : public GeometryAttribute
   // Same as above but the values read from |in_att| are sampled with the
   // provided offset |in_att_offset|.
   AttributeValueIndex::ValueType DeduplicateValues(const GeometryAttribute &in_att, AttributeValueIndex in_att_offset);
+
+  // Same as above but large attributes are deduplicated in parallel on
+  // |thread_pool| (can be nullptr). The result is the same.
+  AttributeValueIndex::ValueType DeduplicateValues(const GeometryAttribute &in_att, AttributeValueIndex in_att_offset,
+                                                   ThreadPool *thread_pool);
 #endif
 
   // Set attribute transform data for the attribute. The data is used to store
@@ -147,10 +158,13 @@ class PointAttribute : public GeometryAttribute
  private:
 #ifdef DRACO_ATTRIBUTE_VALUES_DEDUPLICATION_SUPPORTED
   template <typename T>
-  AttributeValueIndex::ValueType DeduplicateTypedValues(const GeometryAttribute &in_att, AttributeValueIndex in_att_offset);
+  AttributeValueIndex::ValueType DeduplicateTypedValues(const GeometryAttribute &in_att, AttributeValueIndex in_att_offset,
+                                                        ThreadPool *thread_pool);
 
   template <typename T, int COMPONENTS_COUNT>
-  AttributeValueIndex::ValueType DeduplicateFormattedValues(const GeometryAttribute &in_att, AttributeValueIndex in_att_offset);
+  AttributeValueIndex::ValueType DeduplicateFormattedValues(const GeometryAttribute &in_att,
+                                                            AttributeValueIndex in_att_offset,
+                                                            ThreadPool *thread_pool);
 #endif
 
   // Data storage for attribute values. GeometryAttribute itself doesn't own its
@@ -14,6 +14,8 @@
 //
 #include "draco/attributes/point_attribute.h"
 
+#include <cstring>
+
 #include "draco/core/draco_test_base.h"
 
 namespace {
@@ -125,4 +127,39 @@ TEST_F(PointAttributeTest, TestResize) {
   ASSERT_EQ(pa.buffer()->data_size(), 4 * 3 * 10);
 }
 
+TEST_F(PointAttributeTest, TestDeduplicateValues) {
+  // Deduplicated values must keep the order of their first occurrence, both
+  // with and without a thread pool (the attribute is large enough to be
+  // processed in parallel).
+  const int num_values = 100000;
+  draco::PointAttribute pa[2];
+  for (int a = 0; a < 2; ++a) {
+    pa[a].Init(draco::GeometryAttribute::POSITION, 3, draco::DT_FLOAT32, false,
+               num_values);
+    for (int i = 0; i < num_values; ++i) {
+      const float value[3] = {static_cast<float>((i * 7) % 1000), 1.f,
+                              static_cast<float>(i % 3)};
+      pa[a].SetAttributeValue(draco::AttributeValueIndex(i), value);
+    }
+  }
+  draco::ThreadPool thread_pool(3);
+  ASSERT_EQ(pa[0].DeduplicateValues(pa[0]), 3000);
+  ASSERT_EQ(pa[1].DeduplicateValues(pa[1], draco::AttributeValueIndex(0),
+                                    &thread_pool),
+            3000);
+  for (int i = 0; i < 3000; ++i) {
+    float expected[3] = {static_cast<float>((i * 7) % 1000), 1.f,
+                         static_cast<float>(i % 3)};
+    for (int a = 0; a < 2; ++a) {
+      float value[3];
+      pa[a].GetValue(draco::AttributeValueIndex(i), value);
+      ASSERT_EQ(memcmp(value, expected, sizeof(value)), 0);
+    }
+  }
+  for (int i = 0; i < num_values; ++i) {
+    ASSERT_EQ(pa[0].mapped_index(draco::PointIndex(i)).value(), i % 3000);
+    ASSERT_EQ(pa[1].mapped_index(draco::PointIndex(i)).value(), i % 3000);
+  }
+}
+
 }  // namespace
@@ -44,6 +44,26 @@ class AttributesDecoderInterface {
   // the derived classes.
   virtual bool DecodeAttributes(DecoderBuffer *in_buffer) = 0;
 
+  // Same as DecodeAttributes() but the decoder may postpone any work that does
+  // not need to read data from the |in_buffer|. The postponed work must be
+  // then finished by calling FinishAttributeDecoding() for every attribute of
+  // the decoder. The default implementation decodes all data right away.
+  virtual bool DecodeAttributesDeferred(DecoderBuffer *in_buffer) {
+    return DecodeAttributes(in_buffer);
+  }
+
+  // Finishes decoding of the |i|-th attribute postponed by
+  // DecodeAttributesDeferred(). All attributes returned by
+  // GetParentAttributeIds(i) must be finished before this method is called.
+  // Different attributes can be finished concurrently.
+  virtual bool FinishAttributeDecoding(int /* i */) { return true; }
+
+  // Returns ids of point attributes that are needed to finish decoding of the
+  // |i|-th attribute (e.g., attributes used by its prediction scheme).
+  virtual std::vector<int32_t> GetParentAttributeIds(int /* i */) const {
+    return std::vector<int32_t>();
+  }
+
   virtual int32_t GetAttributeId(int i) const = 0;
   virtual int32_t GetNumAttributes() const = 0;
   virtual PointCloudDecoder *GetDecoder() const = 0;
@@ -63,6 +63,27 @@ class AttributesEncoder {
     return true;
   }
 
+  // The following methods split EncodeAttributes() into steps that can be used
+  // to encode attributes in parallel. First, PrepareAttributesEncoding() must
+  // be called for all attribute encoders in their encoding order. After that,
+  // EncodeAttributesTask() can be called concurrently for all tasks in range
+  // [0, NumEncodingTasks()). Each task stores its encoded portable data and
+  // the data needed by the portable transforms into separate buffers. The
+  // output of EncodeAttributes() is equal to all |data_buffer| followed by all
+  // |transform_buffer| in the order of the tasks.
+  virtual bool PrepareAttributesEncoding() {
+    return TransformAttributesToPortableFormat();
+  }
+  virtual int NumEncodingTasks() const { return 1; }
+  virtual bool EncodeAttributesTask(int /* task_id */,
+                                    EncoderBuffer *data_buffer,
+                                    EncoderBuffer *transform_buffer) {
+    if (!EncodePortableAttributes(data_buffer)) {
+      return false;
+    }
+    return EncodeDataNeededByPortableTransforms(transform_buffer);
+  }
+
   // Returns the number of attributes that need to be encoded before the
   // specified attribute is encoded.
   // Note that the attribute is specified by its point attribute id.
@@ -180,7 +180,11 @@ bool KdTreeAttributesDecoder::DecodePortableAttributes(
               num_components * DataTypeLength(DT_UINT32), 0);
       std::unique_ptr<PointAttribute> port_att(new PointAttribute(va));
       port_att->SetIdentityMapping();
-      port_att->Reset(num_points);
+      if (!port_att->Reset(num_points, GetDecoder()->options()
+                                          ? GetDecoder()->options()->GetArena()
+                                          : nullptr)) {
+        return false;
+      }
       quantized_portable_attributes_.push_back(std::move(port_att));
       target_att = quantized_portable_attributes_.back().get();
     } else {
@@ -521,28 +525,19 @@ bool KdTreeAttributesDecoder::TransformAttributesToOriginalFormat() {
       const int32_t max_quantized_value =
           (1u << static_cast<uint32_t>(transform.quantization_bits())) - 1;
       const int num_components = att->num_components();
-      const int entry_size = sizeof(float) * num_components;
-      const std::unique_ptr<float[]> att_val(new float[num_components]);
-      int quant_val_id = 0;
-      int out_byte_pos = 0;
       Dequantizer dequantizer;
       if (!dequantizer.Init(transform.range(), max_quantized_value)) {
         return false;
       }
-      const uint32_t *const portable_attribute_data =
-          reinterpret_cast<const uint32_t *>(
+      const int32_t *const portable_attribute_data =
+          reinterpret_cast<const int32_t *>(
               src_att->GetAddress(AttributeValueIndex(0)));
-      for (uint32_t i = 0; i < src_att->size(); ++i) {
-        for (int c = 0; c < num_components; ++c) {
-          float value = dequantizer.DequantizeFloat(
-              portable_attribute_data[quant_val_id++]);
-          value = value + transform.min_value(c);
-          att_val[c] = value;
-        }
-        // Store the floating point value into the attribute buffer.
-        att->buffer()->Write(out_byte_pos, att_val.get(), entry_size);
-        out_byte_pos += entry_size;
-      }
+      // Store the floating point values directly into the attribute buffer.
+      float *const out_values =
+          reinterpret_cast<float *>(att->buffer()->data());
+      dequantizer.DequantizeFloats(portable_attribute_data, src_att->size(),
+                                   num_components,
+                                   transform.min_values().data(), out_values);
     }
   }
   return true;
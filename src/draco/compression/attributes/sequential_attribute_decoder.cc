@@ -17,7 +17,10 @@
 namespace draco {
 
 SequentialAttributeDecoder::SequentialAttributeDecoder()
-    : decoder_(nullptr), attribute_(nullptr), attribute_id_(-1) {}
+    : decoder_(nullptr),
+      attribute_(nullptr),
+      attribute_id_(-1),
+      defer_value_computation_(false) {}
 
 bool SequentialAttributeDecoder::Init(PointCloudDecoder *decoder,
                                       int attribute_id) {
@@ -36,8 +39,10 @@ bool SequentialAttributeDecoder::InitializeStandalone(
 
 bool SequentialAttributeDecoder::DecodePortableAttribute(
     const std::vector<PointIndex> &point_ids, DecoderBuffer *in_buffer) {
-  if (attribute_->num_components() <= 0 ||
-      !attribute_->Reset(point_ids.size())) {
+  // No storage is needed for values that are written only to the outputs.
+  const size_t num_values =
+      WritesValuesOnlyToOutputs() ? 0 : point_ids.size();
+  if (attribute_->num_components() <= 0 || !attribute_->Reset(num_values)) {
     return false;
   }
   if (!DecodeValues(point_ids, in_buffer)) {
@@ -80,6 +85,7 @@ bool SequentialAttributeDecoder::InitPredictionScheme(
     if (att_id == -1) {
       return false;  // Requested attribute does not exist.
     }
+    parent_attribute_ids_.push_back(att_id);
 #ifdef DRACO_BACKWARDS_COMPATIBILITY_SUPPORTED
     if (decoder_->bitstream_version() < DRACO_BITSTREAM_VERSION(2, 0)) {
       if (!ps->SetParentAttribute(decoder_->point_cloud()->attribute(att_id))) {
@@ -48,8 +48,43 @@ class SequentialAttributeDecoder {
   virtual bool TransformAttributeToOriginalFormat(
       const std::vector<PointIndex> &point_ids);
 
+  // Returns true when the decoder can write the values of the attribute
+  // directly into all outputs requested for it from the PointCloudDecoder
+  // (see PointCloudDecoder::SetAttributeOutputCallback()). In that case, the
+  // decoded values are never stored in the attribute.
+  virtual bool WritesValuesOnlyToOutputs() const { return false; }
+
+  // Same as TransformAttributeToOriginalFormat() but the values are written to
+  // the outputs requested for the attribute instead of the attribute itself.
+  // Used only when WritesValuesOnlyToOutputs() returns true.
+  virtual bool TransformAttributeToOutputs(
+      const std::vector<PointIndex> & /* point_ids */) {
+    return false;
+  }
+
+  // When enabled, DecodePortableAttribute() only reads the encoded data from
+  // the buffer and the computation of the portable attribute values is
+  // postponed until ComputeDeferredValues() is called. Only supported for
+  // bitstream version 2.0 and newer.
+  void set_defer_value_computation(bool defer) {
+    defer_value_computation_ = defer;
+  }
+
+  // Computes the portable attribute values postponed by
+  // DecodePortableAttribute(). Portable attributes of all parent attributes
+  // (see parent_attribute_ids()) must be already computed.
+  virtual bool ComputeDeferredValues(
+      const std::vector<PointIndex> & /* point_ids */) {
+    return true;
+  }
+
   const PointAttribute *GetPortableAttribute();
 
+  // Returns ids of attributes used by the prediction scheme of the decoder.
+  const std::vector<int32_t> &parent_attribute_ids() const {
+    return parent_attribute_ids_;
+  }
+
   const PointAttribute *attribute() const { return attribute_; }
   PointAttribute *attribute() { return attribute_; }
   int attribute_id() const { return attribute_id_; }
@@ -72,6 +107,8 @@ class SequentialAttributeDecoder {
 
   PointAttribute *portable_attribute() { return portable_attribute_.get(); }
 
+  bool defer_value_computation() const { return defer_value_computation_; }
+
  private:
   PointCloudDecoder *decoder_;
   PointAttribute *attribute_;
@@ -79,6 +116,9 @@ class SequentialAttributeDecoder {
 
   // Storage for decoded portable attribute (after lossless decoding).
   std::unique_ptr<PointAttribute> portable_attribute_;
+
+  std::vector<int32_t> parent_attribute_ids_;
+  bool defer_value_computation_;
 };
 
 }  // namespace draco
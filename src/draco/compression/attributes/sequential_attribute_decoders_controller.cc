@@ -52,6 +52,36 @@ bool SequentialAttributeDecodersController::DecodeAttributesDecoderData(
 
 bool SequentialAttributeDecodersController::DecodeAttributes(
     DecoderBuffer *buffer) {
+  if (!GeneratePointSequence()) {
+    return false;
+  }
+  return AttributesDecoder::DecodeAttributes(buffer);
+}
+
+bool SequentialAttributeDecodersController::DecodeAttributesDeferred(
+    DecoderBuffer *buffer) {
+  if (!GeneratePointSequence()) {
+    return false;
+  }
+  // Read all encoded data but postpone the computation of the portable values
+  // and the inverse attribute transforms to FinishAttributeDecoding().
+  for (auto &sequential_decoder : sequential_decoders_) {
+    sequential_decoder->set_defer_value_computation(true);
+  }
+  if (!DecodePortableAttributes(buffer)) {
+    return false;
+  }
+  return DecodeDataNeededByPortableTransforms(buffer);
+}
+
+bool SequentialAttributeDecodersController::FinishAttributeDecoding(int i) {
+  if (!sequential_decoders_[i]->ComputeDeferredValues(point_ids_)) {
+    return false;
+  }
+  return TransformAttributeToOriginalFormat(i);
+}
+
+bool SequentialAttributeDecodersController::GeneratePointSequence() {
   if (!sequencer_ || !sequencer_->GenerateSequence(&point_ids_)) {
     return false;
   }
@@ -64,7 +94,7 @@ bool SequentialAttributeDecodersController::DecodeAttributes(
       return false;
     }
   }
-  return AttributesDecoder::DecodeAttributes(buffer);
+  return true;
 }
 
 bool SequentialAttributeDecodersController::DecodePortableAttributes(
@@ -95,32 +125,44 @@ bool SequentialAttributeDecodersController::
     TransformAttributesToOriginalFormat() {
   const int32_t num_attributes = GetNumAttributes();
   for (int i = 0; i < num_attributes; ++i) {
-    // Check whether the attribute transform should be skipped.
-    if (GetDecoder()->options()) {
-      const PointAttribute *const attribute =
-          sequential_decoders_[i]->attribute();
-      const PointAttribute *const portable_attribute =
-          sequential_decoders_[i]->GetPortableAttribute();
-      if (portable_attribute &&
-          GetDecoder()->options()->GetAttributeBool(
-              attribute->attribute_type(), "skip_attribute_transform", false)) {
-        // Attribute transform should not be performed. In this case, we replace
-        // the output geometry attribute with the portable attribute.
-        // TODO(ostava): We can potentially avoid this copy by introducing a new
-        // mechanism that would allow to use the final attributes as portable
-        // attributes for predictors that may need them.
-        sequential_decoders_[i]->attribute()->CopyFrom(*portable_attribute);
-        continue;
-      }
-    }
-    if (!sequential_decoders_[i]->TransformAttributeToOriginalFormat(
-            point_ids_)) {
+    if (!TransformAttributeToOriginalFormat(i)) {
       return false;
     }
   }
   return true;
 }
 
+bool SequentialAttributeDecodersController::TransformAttributeToOriginalFormat(
+    int i) {
+  // Check whether the attribute transform should be skipped.
+  if (GetDecoder()->options()) {
+    const PointAttribute *const attribute =
+        sequential_decoders_[i]->attribute();
+    const PointAttribute *const portable_attribute =
+        sequential_decoders_[i]->GetPortableAttribute();
+    if (portable_attribute &&
+        GetDecoder()->options()->GetAttributeBool(
+            attribute->attribute_type(), "skip_attribute_transform", false)) {
+      // Attribute transform should not be performed. In this case, we replace
+      // the output geometry attribute with the portable attribute.
+      // TODO(ostava): We can potentially avoid this copy by introducing a new
+      // mechanism that would allow to use the final attributes as portable
+      // attributes for predictors that may need them.
+      sequential_decoders_[i]->attribute()->CopyFrom(*portable_attribute);
+      return true;
+    }
+  }
+  if (sequential_decoders_[i]->WritesValuesOnlyToOutputs()) {
+    if (!sequential_decoders_[i]->TransformAttributeToOutputs(point_ids_)) {
+      return false;
+    }
+    GetDecoder()->MarkAttributeOutputsWritten(GetAttributeId(i));
+    return true;
+  }
+  return sequential_decoders_[i]->TransformAttributeToOriginalFormat(
+      point_ids_);
+}
+
 std::unique_ptr<SequentialAttributeDecoder>
 SequentialAttributeDecodersController::CreateSequentialDecoder(
     uint8_t decoder_type) {
@@ -67,6 +67,23 @@ bool SequentialAttributeEncodersController::EncodeAttributes(
   return AttributesEncoder::EncodeAttributes(buffer);
 }
 
+bool SequentialAttributeEncodersController::PrepareAttributesEncoding() {
+  if (!sequencer_ || !sequencer_->GenerateSequence(&point_ids_)) {
+    return false;
+  }
+  return TransformAttributesToPortableFormat();
+}
+
+bool SequentialAttributeEncodersController::EncodeAttributesTask(
+    int task_id, EncoderBuffer *data_buffer, EncoderBuffer *transform_buffer) {
+  if (!sequential_encoders_[task_id]->EncodePortableAttribute(point_ids_,
+                                                              data_buffer)) {
+    return false;
+  }
+  return sequential_encoders_[task_id]->EncodeDataNeededByPortableTransform(
+      transform_buffer);
+}
+
 bool SequentialAttributeEncodersController::
     TransformAttributesToPortableFormat() {
   for (uint32_t i = 0; i < sequential_encoders_.size(); ++i) {
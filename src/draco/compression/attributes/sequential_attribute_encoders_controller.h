@@ -38,6 +38,13 @@ class SequentialAttributeEncodersController : public AttributesEncoder {
   bool Init(PointCloudEncoder *encoder, const PointCloud *pc) override;
   bool EncodeAttributesEncoderData(EncoderBuffer *out_buffer) override;
   bool EncodeAttributes(EncoderBuffer *buffer) override;
+  bool PrepareAttributesEncoding() override;
+  // Each attribute is encoded by a separate task.
+  int NumEncodingTasks() const override {
+    return static_cast<int>(sequential_encoders_.size());
+  }
+  bool EncodeAttributesTask(int task_id, EncoderBuffer *data_buffer,
+                            EncoderBuffer *transform_buffer) override;
   uint8_t GetUniqueId() const override { return BASIC_ATTRIBUTE_ENCODER; }
 
   int NumParentAttributes(int32_t point_attribute_id) const override {
@@ -20,7 +20,8 @@
 
 namespace draco {
 
-SequentialIntegerAttributeDecoder::SequentialIntegerAttributeDecoder() {}
+SequentialIntegerAttributeDecoder::SequentialIntegerAttributeDecoder()
+    : has_deferred_values_(false) {}
 
 bool SequentialIntegerAttributeDecoder::Init(PointCloudDecoder *decoder,
                                              int attribute_id) {
@@ -41,6 +42,47 @@ bool SequentialIntegerAttributeDecoder::TransformAttributeToOriginalFormat(
   return StoreValues(static_cast<uint32_t>(point_ids.size()));
 }
 
+bool SequentialIntegerAttributeDecoder::WritesValuesOnlyToOutputs() const {
+  if (decoder() == nullptr ||
+      decoder()->bitstream_version() < DRACO_BITSTREAM_VERSION(2, 0)) {
+    return false;
+  }
+  const std::vector<AttributeBufferLayout> *const outputs =
+      decoder()->GetAttributeOutputs(attribute_id());
+  if (outputs == nullptr) {
+    return false;
+  }
+  // The values are written without the attribute conversions of
+  // WriteAttributeToBuffer() so the output format must match the attribute.
+  for (const AttributeBufferLayout &output : *outputs) {
+    if (output.data_type != attribute()->data_type() ||
+        output.GetNumComponents(attribute()->num_components()) !=
+            attribute()->num_components()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SequentialIntegerAttributeDecoder::TransformAttributeToOutputs(
+    const std::vector<PointIndex> & /* point_ids */) {
+  const std::vector<AttributeBufferLayout> *const outputs =
+      decoder()->GetAttributeOutputs(attribute_id());
+  if (outputs == nullptr) {
+    return false;
+  }
+  return StoreValuesToOutputs(*outputs);
+}
+
+bool SequentialIntegerAttributeDecoder::ComputeDeferredValues(
+    const std::vector<PointIndex> &point_ids) {
+  if (!has_deferred_values_) {
+    return true;
+  }
+  has_deferred_values_ = false;
+  return ComputeIntegerValues(point_ids);
+}
+
 bool SequentialIntegerAttributeDecoder::DecodeValues(
     const std::vector<PointIndex> &point_ids, DecoderBuffer *in_buffer) {
   // Decode prediction scheme.
@@ -101,7 +143,10 @@ bool SequentialIntegerAttributeDecoder::DecodeIntegerValues(
   }
   const size_t num_entries = point_ids.size();
   const size_t num_values = num_entries * num_components;
-  PreparePortableAttribute(static_cast<int>(num_entries), num_components);
+  if (!PreparePortableAttribute(static_cast<int>(num_entries),
+                                num_components)) {
+    return false;
+  }
   int32_t *const portable_attribute_data = GetPortableAttributeData();
   if (portable_attribute_data == nullptr) {
     return false;
@@ -111,9 +156,18 @@ bool SequentialIntegerAttributeDecoder::DecodeIntegerValues(
     return false;
   }
   if (compressed > 0) {
+    if (decoder() && !decoder()->interleaved_symbol_coding_allowed()) {
+      // Interleaved symbol coding can be used only when it is signaled in the
+      // header of the encoded data.
+      uint8_t symbol_coding_method;
+      if (!in_buffer->Peek(&symbol_coding_method) ||
+          symbol_coding_method == SYMBOL_CODING_INTERLEAVED) {
+        return false;
+      }
+    }
     // Decode compressed values.
     if (!DecodeSymbols(static_cast<uint32_t>(num_values), num_components,
-                       in_buffer,
+                       decoder() ? decoder()->options() : nullptr, in_buffer,
                        reinterpret_cast<uint32_t *>(portable_attribute_data))) {
       return false;
     }
@@ -138,8 +192,8 @@ bool SequentialIntegerAttributeDecoder::DecodeIntegerValues(
           num_bytes * num_values) {
         return false;
       }
-      if (in_buffer->remaining_size() <
-          static_cast<int64_t>(num_bytes) * static_cast<int64_t>(num_values)) {
+      if (!in_buffer->CheckRemainingSize(static_cast<uint64_t>(num_bytes) *
+                                         num_values)) {
         return false;
       }
       for (size_t i = 0; i < num_values; ++i) {
@@ -149,27 +203,44 @@ bool SequentialIntegerAttributeDecoder::DecodeIntegerValues(
     }
   }
 
-  if (num_values > 0 && (prediction_scheme_ == nullptr ||
-                         !prediction_scheme_->AreCorrectionsPositive())) {
+  // If the data was encoded with a prediction scheme, we must revert it.
+  if (prediction_scheme_) {
+    if (!prediction_scheme_->DecodePredictionData(in_buffer)) {
+      return false;
+    }
+  }
+
+  if (defer_value_computation()) {
+    // All data was read from the buffer. The values are computed later in
+    // ComputeDeferredValues().
+    has_deferred_values_ = true;
+    return true;
+  }
+  return ComputeIntegerValues(point_ids);
+}
+
+bool SequentialIntegerAttributeDecoder::ComputeIntegerValues(
+    const std::vector<PointIndex> &point_ids) {
+  const int num_components = GetNumValueComponents();
+  const size_t num_values = point_ids.size() * num_components;
+  int32_t *const portable_attribute_data = GetPortableAttributeData();
+  if (num_values == 0) {
+    return true;
+  }
+  if (prediction_scheme_ == nullptr ||
+      !prediction_scheme_->AreCorrectionsPositive()) {
     // Convert the values back to the original signed format.
     ConvertSymbolsToSignedInts(
         reinterpret_cast<const uint32_t *>(portable_attribute_data),
         static_cast<int>(num_values), portable_attribute_data);
   }
 
-  // If the data was encoded with a prediction scheme, we must revert it.
   if (prediction_scheme_) {
-    if (!prediction_scheme_->DecodePredictionData(in_buffer)) {
+    if (!prediction_scheme_->ComputeOriginalValues(
+            portable_attribute_data, portable_attribute_data,
+            static_cast<int>(num_values), num_components, point_ids.data())) {
       return false;
     }
-
-    if (num_values > 0) {
-      if (!prediction_scheme_->ComputeOriginalValues(
-              portable_attribute_data, portable_attribute_data,
-              static_cast<int>(num_values), num_components, point_ids.data())) {
-        return false;
-      }
-    }
   }
   return true;
 }
@@ -203,33 +274,67 @@ bool SequentialIntegerAttributeDecoder::StoreValues(uint32_t num_values) {
 template <typename AttributeTypeT>
 void SequentialIntegerAttributeDecoder::StoreTypedValues(uint32_t num_values) {
   const int num_components = attribute()->num_components();
-  const int entry_size = sizeof(AttributeTypeT) * num_components;
-  const std::unique_ptr<AttributeTypeT[]> att_val(
-      new AttributeTypeT[num_components]);
   const int32_t *const portable_attribute_data = GetPortableAttributeData();
-  int val_id = 0;
-  int out_byte_pos = 0;
-  for (uint32_t i = 0; i < num_values; ++i) {
-    for (int c = 0; c < num_components; ++c) {
-      const AttributeTypeT value =
-          static_cast<AttributeTypeT>(portable_attribute_data[val_id++]);
-      att_val[c] = value;
-    }
-    // Store the integer value into the attribute buffer.
-    attribute()->buffer()->Write(out_byte_pos, att_val.get(), entry_size);
-    out_byte_pos += entry_size;
+  // The values are stored tightly packed at the beginning of the attribute
+  // buffer so they can be converted in place without any temporary storage.
+  AttributeTypeT *const out_values =
+      reinterpret_cast<AttributeTypeT *>(attribute()->buffer()->data());
+  const size_t num_entries = static_cast<size_t>(num_values) * num_components;
+  for (size_t i = 0; i < num_entries; ++i) {
+    out_values[i] = static_cast<AttributeTypeT>(portable_attribute_data[i]);
+  }
+}
+
+bool SequentialIntegerAttributeDecoder::StoreValuesToOutputs(
+    const std::vector<AttributeBufferLayout> &outputs) {
+  switch (attribute()->data_type()) {
+    case DT_UINT8:
+      return StoreTypedValuesToOutputs<uint8_t>(outputs);
+    case DT_INT8:
+      return StoreTypedValuesToOutputs<int8_t>(outputs);
+    case DT_UINT16:
+      return StoreTypedValuesToOutputs<uint16_t>(outputs);
+    case DT_INT16:
+      return StoreTypedValuesToOutputs<int16_t>(outputs);
+    case DT_UINT32:
+      return StoreTypedValuesToOutputs<uint32_t>(outputs);
+    case DT_INT32:
+      return StoreTypedValuesToOutputs<int32_t>(outputs);
+    default:
+      return false;
   }
 }
 
-void SequentialIntegerAttributeDecoder::PreparePortableAttribute(
+template <typename AttributeTypeT>
+bool SequentialIntegerAttributeDecoder::StoreTypedValuesToOutputs(
+    const std::vector<AttributeBufferLayout> &outputs) {
+  const int num_components = attribute()->num_components();
+  return WriteValuesToOutputs<AttributeTypeT>(
+      outputs, [num_components](const int32_t *in_values,
+                                AttributeTypeT *out_values) {
+        for (int c = 0; c < num_components; ++c) {
+          out_values[c] = static_cast<AttributeTypeT>(in_values[c]);
+        }
+      });
+}
+
+bool SequentialIntegerAttributeDecoder::PreparePortableAttribute(
     int num_entries, int num_components) {
   GeometryAttribute va;
   va.Init(attribute()->attribute_type(), nullptr, num_components, DT_INT32,
           false, num_components * DataTypeLength(DT_INT32), 0);
   std::unique_ptr<PointAttribute> port_att(new PointAttribute(va));
   port_att->SetIdentityMapping();
-  port_att->Reset(num_entries);
+  // The portable attribute is a temporary that can be allocated from the
+  // arena of the decoder, if any.
+  Arena *const arena =
+      decoder() && decoder()->options() ? decoder()->options()->GetArena()
+                                        : nullptr;
+  if (!port_att->Reset(num_entries, arena)) {
+    return false;
+  }
   SetPortableAttribute(std::move(port_att));
+  return true;
 }
 
 }  // namespace draco
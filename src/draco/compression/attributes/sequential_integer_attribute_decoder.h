@@ -15,6 +15,8 @@
 #ifndef DRACO_COMPRESSION_ATTRIBUTES_SEQUENTIAL_INTEGER_ATTRIBUTE_DECODER_H_
 #define DRACO_COMPRESSION_ATTRIBUTES_SEQUENTIAL_INTEGER_ATTRIBUTE_DECODER_H_
 
+#include <cstring>
+
 #include "draco/compression/attributes/prediction_schemes/prediction_scheme_decoder.h"
 #include "draco/compression/attributes/sequential_attribute_decoder.h"
 #include "draco/draco_features.h"
@@ -29,6 +31,10 @@ class SequentialIntegerAttributeDecoder : public SequentialAttributeDecoder {
 
   bool TransformAttributeToOriginalFormat(
       const std::vector<PointIndex> &point_ids) override;
+  bool ComputeDeferredValues(const std::vector<PointIndex> &point_ids) override;
+  bool WritesValuesOnlyToOutputs() const override;
+  bool TransformAttributeToOutputs(
+      const std::vector<PointIndex> &point_ids) override;
 
  protected:
   bool DecodeValues(const std::vector<PointIndex> &point_ids,
@@ -52,7 +58,47 @@ class SequentialIntegerAttributeDecoder : public SequentialAttributeDecoder {
   // use this method to store the values into the attribute.
   virtual bool StoreValues(uint32_t num_values);
 
-  void PreparePortableAttribute(int num_entries, int num_components);
+  // Same as StoreValues() but the values of all points are written to
+  // |outputs|. All outputs use the data type and the number of components of
+  // the attribute.
+  virtual bool StoreValuesToOutputs(
+      const std::vector<AttributeBufferLayout> &outputs);
+
+  // Writes the value of each point into all |outputs|. The |convert_value|
+  // converts the GetNumValueComponents() portable values of one entry into
+  // attribute()->num_components() values of type OutT.
+  template <typename OutT, class ConvertFunctionT>
+  bool WriteValuesToOutputs(const std::vector<AttributeBufferLayout> &outputs,
+                            ConvertFunctionT convert_value) {
+    const int num_value_components = GetNumValueComponents();
+    const int num_components = attribute()->num_components();
+    const int32_t *const portable_attribute_data = GetPortableAttributeData();
+    const size_t num_entries = portable_attribute()->size();
+    const int num_points = decoder()->point_cloud()->num_points();
+    std::vector<OutT> value(num_components);
+    for (const AttributeBufferLayout &output : outputs) {
+      uint8_t *out_data =
+          static_cast<uint8_t *>(output.data) + output.byte_offset;
+      const int64_t byte_stride = output.GetByteStride(num_components);
+      for (PointIndex i(0); i < num_points; ++i) {
+        const AttributeValueIndex entry_id = attribute()->mapped_index(i);
+        if (entry_id.value() >= num_entries) {
+          return false;
+        }
+        convert_value(
+            portable_attribute_data + entry_id.value() * num_value_components,
+            value.data());
+        // The output may not be aligned for OutT.
+        memcpy(out_data, value.data(), sizeof(OutT) * num_components);
+        out_data += byte_stride;
+      }
+    }
+    return true;
+  }
+
+  // Creates the portable attribute for |num_entries| values. Returns false
+  // when the storage can't be allocated.
+  bool PreparePortableAttribute(int num_entries, int num_components);
 
   int32_t *GetPortableAttributeData() {
     if (portable_attribute()->size() == 0) {
@@ -63,12 +109,25 @@ class SequentialIntegerAttributeDecoder : public SequentialAttributeDecoder {
   }
 
  private:
+  // Converts the decoded symbols into the portable attribute values and
+  // reverts the prediction scheme.
+  bool ComputeIntegerValues(const std::vector<PointIndex> &point_ids);
+
   // Stores decoded values into the attribute with a data type AttributeTypeT.
   template <typename AttributeTypeT>
   void StoreTypedValues(uint32_t num_values);
 
+  // Stores the values into |outputs| with a data type AttributeTypeT.
+  template <typename AttributeTypeT>
+  bool StoreTypedValuesToOutputs(
+      const std::vector<AttributeBufferLayout> &outputs);
+
   std::unique_ptr<PredictionSchemeTypedDecoderInterface<int32_t>>
       prediction_scheme_;
+
+  // Set when the computation of the values was postponed by
+  // DecodeIntegerValues().
+  bool has_deferred_values_;
 };
 
 }  // namespace draco
@@ -155,6 +155,12 @@ bool SequentialIntegerAttributeEncoder::EncodeValues(
     if (encoder() != nullptr) {
       SetSymbolEncodingCompressionLevel(&symbol_encoding_options,
                                         10 - encoder()->options()->GetSpeed());
+      const int num_interleaved_states = encoder()->options()->GetGlobalInt(
+          "symbol_encoding_interleaved_states", 0);
+      if (num_interleaved_states > 0) {
+        SetSymbolEncodingInterleavedStates(&symbol_encoding_options,
+                                           num_interleaved_states);
+      }
     }
     if (!EncodeSymbols(reinterpret_cast<uint32_t *>(encoded_data.data()),
                        static_cast<int>(point_ids.size()) * num_components,
@@ -91,4 +91,17 @@ bool SequentialNormalAttributeDecoder::StoreValues(uint32_t num_points) {
   return true;
 }
 
+bool SequentialNormalAttributeDecoder::StoreValuesToOutputs(
+    const std::vector<AttributeBufferLayout> &outputs) {
+  OctahedronToolBox octahedron_tool_box;
+  if (!octahedron_tool_box.SetQuantizationBits(quantization_bits_)) {
+    return false;
+  }
+  return WriteValuesToOutputs<float>(
+      outputs, [&](const int32_t *in_values, float *out_values) {
+        octahedron_tool_box.QuantizedOctaherdalCoordsToUnitVector(
+            in_values[0], in_values[1], out_values);
+      });
+}
+
 }  // namespace draco
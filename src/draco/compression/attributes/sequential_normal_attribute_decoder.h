@@ -40,6 +40,8 @@ class SequentialNormalAttributeDecoder
       const std::vector<PointIndex> &point_ids,
       DecoderBuffer *in_buffer) override;
   bool StoreValues(uint32_t num_points) override;
+  bool StoreValuesToOutputs(
+      const std::vector<AttributeBufferLayout> &outputs) override;
 
  private:
   int32_t quantization_bits_;
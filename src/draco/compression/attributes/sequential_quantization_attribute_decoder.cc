@@ -69,6 +69,27 @@ bool SequentialQuantizationAttributeDecoder::StoreValues(uint32_t num_values) {
   return DequantizeValues(num_values);
 }
 
+bool SequentialQuantizationAttributeDecoder::StoreValuesToOutputs(
+    const std::vector<AttributeBufferLayout> &outputs) {
+  const int32_t max_quantized_value =
+      (1u << static_cast<uint32_t>(quantization_bits_)) - 1;
+  const int num_components = attribute()->num_components();
+  Dequantizer dequantizer;
+  if (!dequantizer.Init(max_value_dif_, max_quantized_value)) {
+    return false;
+  }
+  const float *const min_value = min_value_.get();
+  // Same arithmetic as Dequantizer::DequantizeFloats() so the output values
+  // match the values stored by DequantizeValues().
+  return WriteValuesToOutputs<float>(
+      outputs, [&](const int32_t *in_values, float *out_values) {
+        for (int c = 0; c < num_components; ++c) {
+          out_values[c] = dequantizer.DequantizeFloat(in_values[c]) +
+                          min_value[c];
+        }
+      });
+}
+
 bool SequentialQuantizationAttributeDecoder::DecodeQuantizedDataInfo() {
   const int num_components = attribute()->num_components();
   min_value_ = std::unique_ptr<float[]>(new float[num_components]);
@@ -94,26 +115,16 @@ bool SequentialQuantizationAttributeDecoder::DequantizeValues(
   const int32_t max_quantized_value =
       (1u << static_cast<uint32_t>(quantization_bits_)) - 1;
   const int num_components = attribute()->num_components();
-  const int entry_size = sizeof(float) * num_components;
-  const std::unique_ptr<float[]> att_val(new float[num_components]);
-  int quant_val_id = 0;
-  int out_byte_pos = 0;
   Dequantizer dequantizer;
   if (!dequantizer.Init(max_value_dif_, max_quantized_value)) {
     return false;
   }
   const int32_t *const portable_attribute_data = GetPortableAttributeData();
-  for (uint32_t i = 0; i < num_values; ++i) {
-    for (int c = 0; c < num_components; ++c) {
-      float value =
-          dequantizer.DequantizeFloat(portable_attribute_data[quant_val_id++]);
-      value = value + min_value_[c];
-      att_val[c] = value;
-    }
-    // Store the floating point value into the attribute buffer.
-    attribute()->buffer()->Write(out_byte_pos, att_val.get(), entry_size);
-    out_byte_pos += entry_size;
-  }
+  // Store the floating point values directly into the attribute buffer.
+  float *const out_values =
+      reinterpret_cast<float *>(attribute()->buffer()->data());
+  dequantizer.DequantizeFloats(portable_attribute_data, num_values,
+                               num_components, min_value_.get(), out_values);
   return true;
 }
 
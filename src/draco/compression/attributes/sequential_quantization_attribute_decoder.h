@@ -35,6 +35,8 @@ class SequentialQuantizationAttributeDecoder
       const std::vector<PointIndex> &point_ids,
       DecoderBuffer *in_buffer) override;
   bool StoreValues(uint32_t num_points) override;
+  bool StoreValuesToOutputs(
+      const std::vector<AttributeBufferLayout> &outputs) override;
 
   // Decodes data necessary for dequantizing the encoded values.
   virtual bool DecodeQuantizedDataInfo();
@@ -29,7 +29,7 @@ bool AdaptiveRAnsBitDecoder::StartDecoding(DecoderBuffer *source_buffer) {
   if (!source_buffer->Decode(&size_in_bytes)) {
     return false;
   }
-  if (size_in_bytes > source_buffer->remaining_size()) {
+  if (!source_buffer->CheckRemainingSize(size_in_bytes)) {
     return false;
   }
   if (ans_read_init(&ans_decoder_,
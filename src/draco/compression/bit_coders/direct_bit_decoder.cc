@@ -32,7 +32,7 @@ bool DirectBitDecoder::StartDecoding(DecoderBuffer *source_buffer) {
   if (size_in_bytes == 0 || size_in_bytes & 0x3) {
     return false;
   }
-  if (size_in_bytes > source_buffer->remaining_size()) {
+  if (!source_buffer->CheckRemainingSize(size_in_bytes)) {
     return false;
   }
   const uint32_t num_32bit_elements = size_in_bytes / 4;
@@ -0,0 +1,200 @@
+// Copyright 2016 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/chunked_decode.h"
+
+#include <cstring>
+
+#include "draco/compression/config/compression_shared.h"
+#include "draco/compression/decode.h"
+#include "draco/core/varint_decoding.h"
+
+namespace draco {
+
+namespace {
+
+// Merges all |chunks| into |mesh|. All chunks must have the same attributes.
+Status MergeChunks(const std::vector<std::unique_ptr<Mesh>> &chunks,
+                   Mesh *mesh) {
+  const Mesh &first_chunk = *chunks[0];
+  size_t num_faces = 0;
+  uint32_t num_points = 0;
+  for (const auto &chunk : chunks) {
+    if (chunk->num_attributes() != first_chunk.num_attributes()) {
+      return Status(Status::DRACO_ERROR, "Incompatible mesh chunks.");
+    }
+    num_faces += chunk->num_faces();
+    num_points += chunk->num_points();
+  }
+
+  mesh->SetNumFaces(num_faces);
+  mesh->set_num_points(num_points);
+  FaceIndex face_id(0);
+  uint32_t point_offset = 0;
+  for (const auto &chunk : chunks) {
+    for (FaceIndex f(0); f < chunk->num_faces(); ++f) {
+      Mesh::Face face = chunk->face(f);
+      for (int c = 0; c < 3; ++c) {
+        face[c] += point_offset;
+      }
+      mesh->SetFace(face_id++, face);
+    }
+    point_offset += chunk->num_points();
+  }
+
+  for (int a = 0; a < first_chunk.num_attributes(); ++a) {
+    const PointAttribute *const first_att = first_chunk.attribute(a);
+    const int entry_size =
+        first_att->num_components() * DataTypeLength(first_att->data_type());
+    uint32_t num_values = 0;
+    for (const auto &chunk : chunks) {
+      const PointAttribute *const att = chunk->attribute(a);
+      if (att->attribute_type() != first_att->attribute_type() ||
+          att->data_type() != first_att->data_type() ||
+          att->num_components() != first_att->num_components()) {
+        return Status(Status::DRACO_ERROR, "Incompatible mesh chunks.");
+      }
+      num_values += static_cast<uint32_t>(att->size());
+    }
+    GeometryAttribute ga;
+    ga.Init(first_att->attribute_type(), nullptr, first_att->num_components(),
+            first_att->data_type(), first_att->normalized(), entry_size, 0);
+    const int att_id = mesh->AddAttribute(ga, false, num_values);
+    PointAttribute *const mesh_att = mesh->attribute(att_id);
+
+    uint32_t value_offset = 0;
+    point_offset = 0;
+    for (const auto &chunk : chunks) {
+      const PointAttribute *const att = chunk->attribute(a);
+      for (AttributeValueIndex avi(0); avi < static_cast<uint32_t>(att->size());
+           ++avi) {
+        mesh_att->buffer()->Write(
+            static_cast<int64_t>(value_offset + avi.value()) * entry_size,
+            att->GetAddress(avi), entry_size);
+      }
+      for (PointIndex pi(0); pi < chunk->num_points(); ++pi) {
+        mesh_att->SetPointMapEntry(pi + point_offset,
+                                   att->mapped_index(pi) + value_offset);
+      }
+      value_offset += static_cast<uint32_t>(att->size());
+      point_offset += chunk->num_points();
+    }
+    mesh_att->set_unique_id(first_att->unique_id());
+    mesh->SetAttributeElementType(att_id,
+                                  first_chunk.GetAttributeElementType(a));
+  }
+
+  // Geometry metadata is stored only in the first chunk.
+  if (first_chunk.GetMetadata() != nullptr) {
+    mesh->AddMetadata(std::unique_ptr<GeometryMetadata>(
+        new GeometryMetadata(*first_chunk.GetMetadata())));
+  }
+  return OkStatus();
+}
+
+}  // namespace
+
+bool ChunkedMeshDecoder::IsChunkedMesh(DecoderBuffer *in_buffer) {
+  DecoderBuffer temp_buffer(*in_buffer);
+  char magic[kDracoChunkedMeshMagicLength];
+  if (!temp_buffer.Decode(magic, kDracoChunkedMeshMagicLength)) {
+    return false;
+  }
+  return memcmp(magic, kDracoChunkedMeshMagic, kDracoChunkedMeshMagicLength) ==
+         0;
+}
+
+Status ChunkedMeshDecoder::Init(DecoderBuffer *in_buffer) {
+  chunk_data_.clear();
+  chunk_sizes_.clear();
+  if (!IsChunkedMesh(in_buffer)) {
+    return Status(Status::DRACO_ERROR, "Not a chunked Draco mesh.");
+  }
+  in_buffer->Advance(kDracoChunkedMeshMagicLength);
+  uint8_t version_major, version_minor;
+  if (!in_buffer->Decode(&version_major) ||
+      !in_buffer->Decode(&version_minor)) {
+    return Status(Status::IO_ERROR, "Failed to parse chunked mesh header.");
+  }
+  if (version_major != kDracoChunkedMeshVersionMajor) {
+    return Status(Status::UNKNOWN_VERSION, "Unknown chunked mesh version.");
+  }
+  uint32_t num_chunks;
+  if (!DecodeVarint(&num_chunks, in_buffer) || num_chunks == 0 ||
+      num_chunks > in_buffer->remaining_size()) {
+    return Status(Status::IO_ERROR, "Failed to parse chunked mesh header.");
+  }
+  chunk_data_.resize(num_chunks);
+  chunk_sizes_.resize(num_chunks);
+  for (uint32_t i = 0; i < num_chunks; ++i) {
+    uint64_t chunk_size;
+    if (!DecodeVarint(&chunk_size, in_buffer)) {
+      return Status(Status::IO_ERROR, "Chunked mesh data is truncated.");
+    }
+    if (chunk_size > static_cast<uint64_t>(in_buffer->remaining_size())) {
+      return Status(Status::IO_ERROR, "Chunked mesh data is truncated.");
+    }
+    chunk_data_[i] = in_buffer->data_head();
+    chunk_sizes_[i] = static_cast<size_t>(chunk_size);
+    in_buffer->Advance(chunk_sizes_[i]);
+  }
+  return OkStatus();
+}
+
+StatusOr<std::unique_ptr<Mesh>> ChunkedMeshDecoder::DecodeChunk(
+    int chunk_id) {
+  if (chunk_id < 0 || chunk_id >= num_chunks()) {
+    return Status(Status::DRACO_ERROR, "Invalid chunk id.");
+  }
+  DecoderBuffer buffer;
+  buffer.Init(chunk_data_[chunk_id], chunk_sizes_[chunk_id]);
+  Decoder decoder;
+  *decoder.options() = options_;
+  return decoder.DecodeMeshFromBuffer(&buffer);
+}
+
+StatusOr<std::unique_ptr<Mesh>> ChunkedMeshDecoder::DecodeMesh() {
+  std::unique_ptr<Mesh> mesh(new Mesh());
+  DRACO_RETURN_IF_ERROR(DecodeMesh(mesh.get()))
+  return std::move(mesh);
+}
+
+Status ChunkedMeshDecoder::DecodeMesh(Mesh *out_mesh) {
+  if (num_chunks() == 0) {
+    return Status(Status::DRACO_ERROR, "Decoder is not initialized.");
+  }
+  std::vector<std::unique_ptr<Mesh>> chunks(num_chunks());
+  std::vector<Status> chunk_statuses(num_chunks());
+  const auto decode_chunk = [&](int i) {
+    StatusOr<std::unique_ptr<Mesh>> chunk_or = DecodeChunk(i);
+    chunk_statuses[i] = chunk_or.status();
+    if (chunk_or.ok()) {
+      chunks[i] = std::move(chunk_or).value();
+    }
+  };
+  ThreadPool *const thread_pool = options_.GetThreadPool();
+  if (thread_pool != nullptr) {
+    thread_pool->ParallelFor(num_chunks(), decode_chunk);
+  } else {
+    for (int i = 0; i < num_chunks(); ++i) {
+      decode_chunk(i);
+    }
+  }
+  for (const Status &status : chunk_statuses) {
+    DRACO_RETURN_IF_ERROR(status);
+  }
+  return MergeChunks(chunks, out_mesh);
+}
+
+}  // namespace draco
@@ -0,0 +1,66 @@
+// Copyright 2016 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_COMPRESSION_CHUNKED_DECODE_H_
+#define DRACO_COMPRESSION_CHUNKED_DECODE_H_
+
+#include <memory>
+#include <vector>
+
+#include "draco/compression/config/decoder_options.h"
+#include "draco/core/decoder_buffer.h"
+#include "draco/core/status_or.h"
+#include "draco/mesh/mesh.h"
+
+namespace draco {
+
+// Decoder for meshes encoded with the ChunkedMeshEncoder. Individual chunks can
+// be decoded independently using DecodeChunk() or all chunks can be decoded
+// and merged into a single mesh using DecodeMesh(). When a thread pool is set
+// in the decoder options (see DecoderOptions::SetThreadPool()), DecodeMesh()
+// decodes the chunks in parallel.
+class ChunkedMeshDecoder {
+ public:
+  // Returns true when |in_buffer| contains a chunked mesh container.
+  static bool IsChunkedMesh(DecoderBuffer *in_buffer);
+
+  // Decodes the container header and advances |in_buffer| past the container.
+  // The data of |in_buffer| must remain valid until all chunks are decoded.
+  Status Init(DecoderBuffer *in_buffer);
+
+  int num_chunks() const { return static_cast<int>(chunk_data_.size()); }
+
+  // Decodes chunk |chunk_id| into a standalone mesh.
+  StatusOr<std::unique_ptr<Mesh>> DecodeChunk(int chunk_id);
+
+  // Decodes all chunks and merges them into a single mesh. Points shared by
+  // multiple chunks are present in the merged mesh for each chunk.
+  StatusOr<std::unique_ptr<Mesh>> DecodeMesh();
+
+  // Same as above but the merged mesh is decoded into |out_mesh| that is
+  // expected to be empty.
+  Status DecodeMesh(Mesh *out_mesh);
+
+  // Returns the options used to decode all chunks.
+  DecoderOptions *options() { return &options_; }
+
+ private:
+  DecoderOptions options_;
+  std::vector<const char *> chunk_data_;
+  std::vector<size_t> chunk_sizes_;
+};
+
+}  // namespace draco
+
+#endif  // DRACO_COMPRESSION_CHUNKED_DECODE_H_
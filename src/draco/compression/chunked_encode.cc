@@ -0,0 +1,298 @@
+// Copyright 2016 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/chunked_encode.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+#include "draco/compression/config/compression_shared.h"
+#include "draco/core/varint_encoding.h"
+#include "draco/core/vector_d.h"
+
+namespace draco {
+
+namespace {
+
+// Recursively splits faces in range [|begin|, |end|) of |face_ids| at the
+// median centroid along the longest axis of the centroids' bounding box until
+// each part contains at most |max_num_faces| faces. The first face of each
+// resulting chunk is stored in |chunk_starts|.
+void PartitionFaces(const std::vector<Vector3f> &centroids, int max_num_faces,
+                    int begin, int end, std::vector<FaceIndex> *face_ids,
+                    std::vector<int> *chunk_starts) {
+  if (end - begin <= max_num_faces) {
+    chunk_starts->push_back(begin);
+    return;
+  }
+  Vector3f min_point = centroids[(*face_ids)[begin].value()];
+  Vector3f max_point = min_point;
+  for (int i = begin + 1; i < end; ++i) {
+    const Vector3f &centroid = centroids[(*face_ids)[i].value()];
+    for (int c = 0; c < 3; ++c) {
+      min_point[c] = std::min(min_point[c], centroid[c]);
+      max_point[c] = std::max(max_point[c], centroid[c]);
+    }
+  }
+  const Vector3f extent = max_point - min_point;
+  int axis = 0;
+  for (int c = 1; c < 3; ++c) {
+    if (extent[c] > extent[axis]) {
+      axis = c;
+    }
+  }
+  const int mid = begin + (end - begin) / 2;
+  std::nth_element(face_ids->begin() + begin, face_ids->begin() + mid,
+                   face_ids->begin() + end,
+                   [&centroids, axis](FaceIndex a, FaceIndex b) {
+                     return centroids[a.value()][axis] <
+                            centroids[b.value()][axis];
+                   });
+  PartitionFaces(centroids, max_num_faces, begin, mid, face_ids, chunk_starts);
+  PartitionFaces(centroids, max_num_faces, mid, end, face_ids, chunk_starts);
+}
+
+// Creates a mesh containing |num_faces| faces of |mesh| listed in |faces|.
+// The new mesh contains all attributes of |mesh| but only the attribute values
+// used by the selected faces.
+std::unique_ptr<Mesh> CreateChunkMesh(const Mesh &mesh, const FaceIndex *faces,
+                                      int num_faces, bool copy_metadata) {
+  std::unique_ptr<Mesh> chunk(new Mesh());
+  // Map between point ids of |mesh| and point ids of the |chunk|.
+  std::unordered_map<uint32_t, PointIndex> point_map;
+  std::vector<PointIndex> chunk_points;
+  chunk->SetNumFaces(num_faces);
+  for (FaceIndex f(0); f < static_cast<uint32_t>(num_faces); ++f) {
+    const Mesh::Face &face = mesh.face(faces[f.value()]);
+    Mesh::Face chunk_face;
+    for (int c = 0; c < 3; ++c) {
+      const auto it = point_map.insert(std::make_pair(
+          face[c].value(),
+          PointIndex(static_cast<uint32_t>(chunk_points.size()))));
+      if (it.second) {
+        chunk_points.push_back(face[c]);
+      }
+      chunk_face[c] = it.first->second;
+    }
+    chunk->SetFace(f, chunk_face);
+  }
+  chunk->set_num_points(static_cast<uint32_t>(chunk_points.size()));
+
+  for (int a = 0; a < mesh.num_attributes(); ++a) {
+    const PointAttribute *const att = mesh.attribute(a);
+    // Map between attribute values of |att| and values of the new attribute.
+    std::unordered_map<uint32_t, AttributeValueIndex> value_map;
+    std::vector<AttributeValueIndex> chunk_values;
+    std::vector<AttributeValueIndex> point_values(chunk_points.size());
+    for (size_t i = 0; i < chunk_points.size(); ++i) {
+      const AttributeValueIndex avi = att->mapped_index(chunk_points[i]);
+      const auto it = value_map.insert(std::make_pair(
+          avi.value(),
+          AttributeValueIndex(static_cast<uint32_t>(chunk_values.size()))));
+      if (it.second) {
+        chunk_values.push_back(avi);
+      }
+      point_values[i] = it.first->second;
+    }
+
+    const int entry_size =
+        att->num_components() * DataTypeLength(att->data_type());
+    GeometryAttribute ga;
+    ga.Init(att->attribute_type(), nullptr, att->num_components(),
+            att->data_type(), att->normalized(), entry_size, 0);
+    const int att_id = chunk->AddAttribute(
+        ga, false, static_cast<uint32_t>(chunk_values.size()));
+    PointAttribute *const chunk_att = chunk->attribute(att_id);
+    for (size_t i = 0; i < chunk_values.size(); ++i) {
+      chunk_att->buffer()->Write(i * entry_size,
+                                 att->GetAddress(chunk_values[i]), entry_size);
+    }
+    for (PointIndex pi(0); pi < static_cast<uint32_t>(chunk_points.size());
+         ++pi) {
+      chunk_att->SetPointMapEntry(pi, point_values[pi.value()]);
+    }
+    chunk_att->set_unique_id(att->unique_id());
+    chunk->SetAttributeElementType(att_id, mesh.GetAttributeElementType(a));
+  }
+
+  if (copy_metadata && mesh.GetMetadata() != nullptr) {
+    chunk->AddMetadata(std::unique_ptr<GeometryMetadata>(
+        new GeometryMetadata(*mesh.GetMetadata())));
+  }
+  return chunk;
+}
+
+// Sets explicit quantization parameters computed from all values of |mesh| to
+// all quantized attribute types so that all chunks use the same quantization
+// grid. Attribute types with explicit quantization set by the user are not
+// modified.
+void SetSharedQuantization(const Mesh &mesh, Encoder *encoder) {
+  for (int t = 0; t < GeometryAttribute::NAMED_ATTRIBUTES_COUNT; ++t) {
+    const GeometryAttribute::Type type = static_cast<GeometryAttribute::Type>(t);
+    if (type == GeometryAttribute::NORMAL) {
+      // Normals are quantized in octahedral coordinates that don't depend on
+      // the attribute values.
+      continue;
+    }
+    const int quantization_bits =
+        encoder->options().GetAttributeInt(type, "quantization_bits", -1);
+    const int num_atts = mesh.NumNamedAttributes(type);
+    if (quantization_bits <= 0 || num_atts == 0 ||
+        encoder->options().IsAttributeOptionSet(type, "quantization_origin")) {
+      continue;
+    }
+    const int num_components =
+        mesh.GetNamedAttribute(type, 0)->num_components();
+    bool can_share = true;
+    for (int i = 0; i < num_atts; ++i) {
+      const PointAttribute *const att = mesh.GetNamedAttribute(type, i);
+      if (att->data_type() != DT_FLOAT32 ||
+          att->num_components() != num_components || att->size() == 0) {
+        can_share = false;
+      }
+    }
+    if (!can_share) {
+      continue;
+    }
+
+    // Compute the quantization parameters in the same way as
+    // AttributeQuantizationTransform::ComputeParameters().
+    std::vector<float> min_values(num_components,
+                                  std::numeric_limits<float>::max());
+    std::vector<float> max_values(num_components,
+                                  -std::numeric_limits<float>::max());
+    std::vector<float> value(num_components);
+    for (int i = 0; i < num_atts; ++i) {
+      const PointAttribute *const att = mesh.GetNamedAttribute(type, i);
+      for (AttributeValueIndex avi(0); avi < static_cast<uint32_t>(att->size());
+           ++avi) {
+        att->GetValue(avi, value.data());
+        for (int c = 0; c < num_components; ++c) {
+          min_values[c] = std::min(min_values[c], value[c]);
+          max_values[c] = std::max(max_values[c], value[c]);
+        }
+      }
+    }
+    float range = 0.f;
+    for (int c = 0; c < num_components; ++c) {
+      if (std::isnan(min_values[c]) || std::isinf(min_values[c]) ||
+          std::isnan(max_values[c]) || std::isinf(max_values[c])) {
+        can_share = false;
+      }
+      range = std::max(range, max_values[c] - min_values[c]);
+    }
+    if (!can_share) {
+      continue;
+    }
+    if (range == 0.f) {
+      range = 1.f;
+    }
+    encoder->SetAttributeExplicitQuantization(
+        type, quantization_bits, num_components, min_values.data(), range);
+  }
+}
+
+}  // namespace
+
+ChunkedMeshEncoder::ChunkedMeshEncoder()
+    : max_num_faces_per_chunk_(kDefaultMaxNumFacesPerChunk) {}
+
+void ChunkedMeshEncoder::SetMaxNumFacesPerChunk(int max_num_faces) {
+  max_num_faces_per_chunk_ = std::max(max_num_faces, 1);
+}
+
+Status ChunkedMeshEncoder::EncodeMeshToBuffer(const Mesh &mesh,
+                                              EncoderBuffer *out_buffer) {
+  const PointAttribute *const pos_att =
+      mesh.GetNamedAttribute(GeometryAttribute::POSITION);
+  if (pos_att == nullptr) {
+    return Status(Status::DRACO_ERROR, "Mesh has no position attribute.");
+  }
+  const int num_faces = static_cast<int>(mesh.num_faces());
+
+  // Compute centroids of all faces that are used to split the mesh.
+  std::vector<Vector3f> centroids(num_faces);
+  for (FaceIndex f(0); f < mesh.num_faces(); ++f) {
+    Vector3f centroid(0.f, 0.f, 0.f);
+    for (int c = 0; c < 3; ++c) {
+      Vector3f pos(0.f, 0.f, 0.f);
+      pos_att->ConvertValue<float, 3>(pos_att->mapped_index(mesh.face(f)[c]),
+                                      &pos[0]);
+      centroid += pos;
+    }
+    centroids[f.value()] = centroid / 3.f;
+  }
+  std::vector<FaceIndex> face_ids(num_faces);
+  for (int i = 0; i < num_faces; ++i) {
+    face_ids[i] = FaceIndex(i);
+  }
+  std::vector<int> chunk_starts;
+  PartitionFaces(centroids, max_num_faces_per_chunk_, 0, num_faces, &face_ids,
+                 &chunk_starts);
+  chunk_starts.push_back(num_faces);
+  const int num_chunks = static_cast<int>(chunk_starts.size()) - 1;
+
+  Encoder chunk_encoder = encoder_;
+  SetSharedQuantization(mesh, &chunk_encoder);
+
+  out_buffer->Encode(kDracoChunkedMeshMagic, kDracoChunkedMeshMagicLength);
+  out_buffer->Encode(kDracoChunkedMeshVersionMajor);
+  out_buffer->Encode(kDracoChunkedMeshVersionMinor);
+  EncodeVarint(static_cast<uint32_t>(num_chunks), out_buffer);
+
+  // The chunks are encoded in windows of consecutive chunks (one chunk at a
+  // time without a thread pool). Each window is written to |out_buffer| in
+  // order as soon as it is encoded, so at most one window of encoded chunks
+  // is held in memory.
+  const int window_size =
+      thread_pool_ ? 2 * (thread_pool_->num_threads() + 1) : 1;
+  std::vector<EncoderBuffer> chunk_buffers(std::min(window_size, num_chunks));
+  std::vector<Status> chunk_statuses(chunk_buffers.size());
+  for (int window_start = 0; window_start < num_chunks;
+       window_start += window_size) {
+    const int window_end = std::min(window_start + window_size, num_chunks);
+    const auto encode_chunk = [&](int i) {
+      const int chunk_id = window_start + i;
+      // Only the first chunk stores the geometry metadata.
+      const std::unique_ptr<Mesh> chunk = CreateChunkMesh(
+          mesh, face_ids.data() + chunk_starts[chunk_id],
+          chunk_starts[chunk_id + 1] - chunk_starts[chunk_id], chunk_id == 0);
+      Encoder encoder = chunk_encoder;
+      chunk_buffers[i].Clear();
+      chunk_statuses[i] = encoder.EncodeMeshToBuffer(*chunk, &chunk_buffers[i]);
+    };
+    if (thread_pool_) {
+      thread_pool_->ParallelFor(window_end - window_start, encode_chunk);
+    } else {
+      encode_chunk(0);
+    }
+    for (int i = 0; i < window_end - window_start; ++i) {
+      DRACO_RETURN_IF_ERROR(chunk_statuses[i]);
+      const EncoderBuffer &chunk_buffer = chunk_buffers[i];
+      EncodeVarint(static_cast<uint64_t>(chunk_buffer.size()), out_buffer);
+      out_buffer->Encode(chunk_buffer.data(), chunk_buffer.size());
+      // When |out_buffer| has a sink, the chunk is released from memory as
+      // soon as it is written.
+      if (!out_buffer->Flush()) {
+        return Status(Status::IO_ERROR, "Failed to write encoded data.");
+      }
+    }
+  }
+  return OkStatus();
+}
+
+}  // namespace draco
@@ -0,0 +1,68 @@
+// Copyright 2016 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_COMPRESSION_CHUNKED_ENCODE_H_
+#define DRACO_COMPRESSION_CHUNKED_ENCODE_H_
+
+#include <memory>
+
+#include "draco/compression/encode.h"
+#include "draco/core/encoder_buffer.h"
+#include "draco/core/status.h"
+#include "draco/core/thread_pool.h"
+#include "draco/mesh/mesh.h"
+
+namespace draco {
+
+// Encoder for large meshes that splits the input mesh into spatially coherent
+// chunks that are encoded independently using the Encoder class. The chunks
+// are stored in a simple container (see kDracoChunkedMeshMagic) and they can
+// be decoded either independently or merged back into a single mesh using the
+// ChunkedMeshDecoder (or Decoder::DecodeMeshFromBuffer()).
+//
+// Quantized attributes use the same quantization grid in all chunks, so points
+// shared by multiple chunks are decoded to the same values. Shared points are
+// duplicated in each chunk that uses them.
+class ChunkedMeshEncoder {
+ public:
+  static constexpr int kDefaultMaxNumFacesPerChunk = 1 << 20;
+
+  ChunkedMeshEncoder();
+
+  // Returns the encoder used to encode the individual chunks. All options set
+  // on this encoder (speed, quantization, ...) are used for every chunk.
+  Encoder *encoder() { return &encoder_; }
+
+  // Sets the maximum number of faces stored in a single chunk.
+  void SetMaxNumFacesPerChunk(int max_num_faces);
+
+  // Sets a thread pool that is used to encode the chunks in parallel. The
+  // encoded data is the same as when the chunks are encoded on the calling
+  // thread. Set to nullptr to disable the parallel encoding (default).
+  void SetThreadPool(std::shared_ptr<ThreadPool> thread_pool) {
+    thread_pool_ = std::move(thread_pool);
+  }
+
+  // Encodes |mesh| into the chunked mesh container.
+  Status EncodeMeshToBuffer(const Mesh &mesh, EncoderBuffer *out_buffer);
+
+ private:
+  Encoder encoder_;
+  int max_num_faces_per_chunk_;
+  std::shared_ptr<ThreadPool> thread_pool_;
+};
+
+}  // namespace draco
+
+#endif  // DRACO_COMPRESSION_CHUNKED_ENCODE_H_
@@ -0,0 +1,178 @@
+// Copyright 2016 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/chunked_encode.h"
+
+#include <cstring>
+#include <set>
+
+#include "draco/compression/chunked_decode.h"
+#include "draco/compression/decode.h"
+#include "draco/core/draco_test_base.h"
+#include "draco/core/draco_test_utils.h"
+
+namespace {
+
+class ChunkedEncodeTest : public ::testing::Test {
+ protected:
+  // Encodes |mesh| into chunks with at most |max_num_faces| faces.
+  void EncodeMesh(const draco::Mesh &mesh, int max_num_faces,
+                  std::shared_ptr<draco::ThreadPool> thread_pool,
+                  draco::EncoderBuffer *buffer) {
+    draco::ChunkedMeshEncoder encoder;
+    encoder.SetMaxNumFacesPerChunk(max_num_faces);
+    encoder.SetThreadPool(std::move(thread_pool));
+    encoder.encoder()->SetAttributeQuantization(
+        draco::GeometryAttribute::POSITION, 11);
+    encoder.encoder()->SetAttributeQuantization(
+        draco::GeometryAttribute::TEX_COORD, 10);
+    encoder.encoder()->SetAttributeQuantization(
+        draco::GeometryAttribute::NORMAL, 8);
+    DRACO_ASSERT_OK(encoder.EncodeMeshToBuffer(mesh, buffer));
+  }
+
+  // Returns all distinct positions of the decoded |buffer|.
+  std::set<std::array<float, 3>> DecodePositions(
+      const draco::EncoderBuffer &buffer) {
+    draco::DecoderBuffer decoder_buffer;
+    decoder_buffer.Init(buffer.data(), buffer.size());
+    draco::Decoder decoder;
+    std::unique_ptr<draco::Mesh> mesh =
+        decoder.DecodeMeshFromBuffer(&decoder_buffer).value();
+    std::set<std::array<float, 3>> positions;
+    if (mesh == nullptr) {
+      return positions;
+    }
+    const draco::PointAttribute *const pos_att =
+        mesh->GetNamedAttribute(draco::GeometryAttribute::POSITION);
+    for (draco::PointIndex pi(0); pi < mesh->num_points(); ++pi) {
+      std::array<float, 3> pos;
+      pos_att->GetValue(pos_att->mapped_index(pi), &pos[0]);
+      positions.insert(pos);
+    }
+    return positions;
+  }
+};
+
+TEST_F(ChunkedEncodeTest, TestChunkedEncoding) {
+  // Tests that a mesh split into chunks decodes to the same positions as the
+  // same mesh encoded in a single chunk.
+  const std::unique_ptr<draco::Mesh> mesh =
+      draco::ReadMeshFromTestFile("test_sphere.obj");
+  ASSERT_NE(mesh, nullptr);
+
+  draco::EncoderBuffer single_chunk_buffer;
+  EncodeMesh(*mesh, mesh->num_faces(), nullptr, &single_chunk_buffer);
+  draco::EncoderBuffer buffer;
+  EncodeMesh(*mesh, 30, nullptr, &buffer);
+  draco::EncoderBuffer parallel_buffer;
+  EncodeMesh(*mesh, 30, std::make_shared<draco::ThreadPool>(3),
+             &parallel_buffer);
+
+  // Parallel encoding must not change the encoded data.
+  ASSERT_EQ(buffer.size(), parallel_buffer.size());
+  ASSERT_EQ(memcmp(buffer.data(), parallel_buffer.data(), buffer.size()), 0);
+
+  // All chunks use the same quantization so the decoded positions must be
+  // the same as for the single chunk.
+  const std::set<std::array<float, 3>> positions =
+      DecodePositions(single_chunk_buffer);
+  ASSERT_FALSE(positions.empty());
+  ASSERT_EQ(DecodePositions(buffer), positions);
+}
+
+TEST_F(ChunkedEncodeTest, TestDecodeIndividualChunks) {
+  // Tests that chunks can be decoded independently and merged into a mesh with
+  // all faces of the input mesh.
+  const std::unique_ptr<draco::Mesh> mesh =
+      draco::ReadMeshFromTestFile("test_sphere.obj");
+  ASSERT_NE(mesh, nullptr);
+  draco::EncoderBuffer buffer;
+  EncodeMesh(*mesh, 50, nullptr, &buffer);
+
+  draco::DecoderBuffer decoder_buffer;
+  decoder_buffer.Init(buffer.data(), buffer.size());
+  ASSERT_TRUE(draco::ChunkedMeshDecoder::IsChunkedMesh(&decoder_buffer));
+  draco::ChunkedMeshDecoder decoder;
+  DRACO_ASSERT_OK(decoder.Init(&decoder_buffer));
+  ASSERT_EQ(decoder_buffer.remaining_size(), 0);
+  ASSERT_GT(decoder.num_chunks(), 1);
+
+  size_t num_faces = 0;
+  for (int i = 0; i < decoder.num_chunks(); ++i) {
+    std::unique_ptr<draco::Mesh> chunk = decoder.DecodeChunk(i).value();
+    ASSERT_NE(chunk, nullptr);
+    ASSERT_LE(chunk->num_faces(), 50);
+    ASSERT_EQ(chunk->num_attributes(), mesh->num_attributes());
+    num_faces += chunk->num_faces();
+  }
+  ASSERT_EQ(num_faces, mesh->num_faces());
+
+  decoder.options()->SetThreadPool(std::make_shared<draco::ThreadPool>(2));
+  std::unique_ptr<draco::Mesh> merged_mesh = decoder.DecodeMesh().value();
+  ASSERT_NE(merged_mesh, nullptr);
+  ASSERT_EQ(merged_mesh->num_faces(), mesh->num_faces());
+  ASSERT_EQ(merged_mesh->num_attributes(), mesh->num_attributes());
+}
+
+TEST_F(ChunkedEncodeTest, TestDecodeBufferToGeometry) {
+  // Tests that Decoder::DecodeBufferToGeometry() merges the chunks of the
+  // container into the provided mesh.
+  const std::unique_ptr<draco::Mesh> mesh =
+      draco::ReadMeshFromTestFile("test_sphere.obj");
+  ASSERT_NE(mesh, nullptr);
+  draco::EncoderBuffer buffer;
+  EncodeMesh(*mesh, 50, nullptr, &buffer);
+
+  draco::DecoderBuffer decoder_buffer;
+  decoder_buffer.Init(buffer.data(), buffer.size());
+  draco::Decoder decoder;
+  draco::Mesh decoded_mesh;
+  DRACO_ASSERT_OK(
+      decoder.DecodeBufferToGeometry(&decoder_buffer, &decoded_mesh));
+  ASSERT_EQ(decoded_mesh.num_faces(), mesh->num_faces());
+  ASSERT_EQ(decoded_mesh.num_attributes(), mesh->num_attributes());
+}
+
+TEST_F(ChunkedEncodeTest, TestChunksWrittenIncrementally) {
+  // Tests that the encoded chunks are passed to the sink of the output buffer
+  // one after another instead of all at once at the end of the encoding.
+  const std::unique_ptr<draco::Mesh> mesh =
+      draco::ReadMeshFromTestFile("test_sphere.obj");
+  ASSERT_NE(mesh, nullptr);
+  draco::EncoderBuffer buffer;
+  EncodeMesh(*mesh, 30, nullptr, &buffer);
+
+  for (const int num_threads : {0, 2}) {
+    std::vector<char> sink_data;
+    int num_sink_calls = 0;
+    draco::EncoderBuffer sink_buffer;
+    sink_buffer.SetSink([&](std::vector<char> *data) {
+      sink_data.insert(sink_data.end(), data->begin(), data->end());
+      ++num_sink_calls;
+      return true;
+    });
+    EncodeMesh(*mesh, 30,
+               num_threads > 0
+                   ? std::make_shared<draco::ThreadPool>(num_threads)
+                   : nullptr,
+               &sink_buffer);
+    ASSERT_EQ(sink_buffer.size(), 0);
+    ASSERT_GT(num_sink_calls, 1);
+    ASSERT_EQ(sink_data.size(), buffer.size());
+    ASSERT_EQ(memcmp(sink_data.data(), buffer.data(), buffer.size()), 0);
+  }
+}
+
+}  // namespace
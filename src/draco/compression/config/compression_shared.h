@@ -36,6 +36,16 @@ static constexpr uint16_t kDracoPointCloudBitstreamVersion =
 static constexpr uint16_t kDracoMeshBitstreamVersion = DRACO_BITSTREAM_VERSION(
     kDracoMeshBitstreamVersionMajor, kDracoMeshBitstreamVersionMinor);
 
+// Container for meshes encoded as a set of independent chunks (see
+// ChunkedMeshEncoder). The container starts with the magic string followed by
+// the container version and the number of chunks. Each encoded chunk follows
+// in order, preceded by its byte size, so that the chunks can be written as
+// soon as they are encoded.
+static constexpr char kDracoChunkedMeshMagic[] = "DRCHK";
+static constexpr int kDracoChunkedMeshMagicLength = 5;
+static constexpr uint8_t kDracoChunkedMeshVersionMajor = 1;
+static constexpr uint8_t kDracoChunkedMeshVersionMinor = 0;
+
 // Currently, we support point cloud and triangular mesh encoding.
 // TODO(draco-eng) Convert enum to enum class (safety, not performance).
 enum EncodedGeometryType {
@@ -141,12 +151,20 @@ enum NormalPredictionMode {
 enum SymbolCodingMethod {
   SYMBOL_CODING_TAGGED = 0,
   SYMBOL_CODING_RAW = 1,
+  // Same as SYMBOL_CODING_RAW but the symbols are coded with several
+  // interleaved rANS states that can be decoded in parallel.
+  SYMBOL_CODING_INTERLEAVED = 2,
   NUM_SYMBOL_CODING_METHODS,
 };
 
 // Mask for setting and getting the bit for metadata in |flags| of header.
 #define METADATA_FLAG_MASK 0x8000
 
+// Mask for setting and getting the bit in |flags| of header that signals that
+// the encoder was allowed to use SYMBOL_CODING_INTERLEAVED. Decoders reject
+// attribute values coded with SYMBOL_CODING_INTERLEAVED when it isn't set.
+#define INTERLEAVED_SYMBOL_CODING_FLAG_MASK 0x4000
+
 }  // namespace draco
 
 #endif  // DRACO_COMPRESSION_CONFIG_COMPRESSION_SHARED_H_
@@ -20,6 +20,9 @@
 
 #include "draco/attributes/geometry_attribute.h"
 #include "draco/compression/config/draco_options.h"
+#include "draco/compression/entropy/rans_table_cache.h"
+#include "draco/core/arena.h"
+#include "draco/core/thread_pool.h"
 
 namespace draco {
 
@@ -27,7 +30,39 @@ namespace draco {
 // decoding of the input geometry. The options can be specified either for the
 // whole geometry or for a specific attribute type. Each option is identified
 // by a unique name stored as an std::string.
-typedef DracoOptions<GeometryAttribute::Type> DecoderOptions;
+class DecoderOptions : public DracoOptions<GeometryAttribute::Type> {
+ public:
+  // Sets a cache of rANS look up tables that is used by all entropy decoders
+  // (see RAnsTableCache). The same cache can be shared by multiple decoders
+  // to avoid building the same tables for each decoded geometry. Set to
+  // nullptr to disable the caching (default).
+  void SetRAnsTableCache(std::shared_ptr<RAnsTableCache> cache) {
+    rans_table_cache_ = std::move(cache);
+  }
+  RAnsTableCache *GetRAnsTableCache() const { return rans_table_cache_.get(); }
+
+  // Sets a thread pool that is used to decode independent attributes in
+  // parallel. Set to nullptr to decode all attributes on the calling thread
+  // (default).
+  void SetThreadPool(std::shared_ptr<ThreadPool> thread_pool) {
+    thread_pool_ = std::move(thread_pool);
+  }
+  ThreadPool *GetThreadPool() const { return thread_pool_.get(); }
+
+  // Sets an arena that is used for temporary data of the decoder, such as the
+  // portable (quantized) attribute values. The temporary data is never
+  // referenced by the decoded geometry, so the arena can be reset as soon as
+  // the decoding finished, releasing all temporary memory at once. The same
+  // arena must not be reset while any decoder using it is running. Set to
+  // nullptr to allocate the temporary data from the heap (default).
+  void SetArena(std::shared_ptr<Arena> arena) { arena_ = std::move(arena); }
+  Arena *GetArena() const { return arena_.get(); }
+
+ private:
+  std::shared_ptr<RAnsTableCache> rans_table_cache_;
+  std::shared_ptr<ThreadPool> thread_pool_;
+  std::shared_ptr<Arena> arena_;
+};
 
 }  // namespace draco
 
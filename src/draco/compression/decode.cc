@@ -14,6 +14,7 @@
 //
 #include "draco/compression/decode.h"
 
+#include "draco/compression/chunked_decode.h"
 #include "draco/compression/config/compression_shared.h"
 
 #ifdef DRACO_MESH_COMPRESSION_SUPPORTED
@@ -54,6 +55,9 @@ StatusOr<std::unique_ptr<MeshDecoder>> CreateMeshDecoder(uint8_t method) {
 
 StatusOr<EncodedGeometryType> Decoder::GetEncodedGeometryType(
     DecoderBuffer *in_buffer) {
+  if (ChunkedMeshDecoder::IsChunkedMesh(in_buffer)) {
+    return TRIANGULAR_MESH;
+  }
   DecoderBuffer temp_buffer(*in_buffer);
   DracoHeader header;
   DRACO_RETURN_IF_ERROR(PointCloudDecoder::DecodeHeader(&temp_buffer, &header))
@@ -72,8 +76,8 @@ StatusOr<std::unique_ptr<PointCloud>> Decoder::DecodePointCloudFromBuffer(
 #endif
   } else if (type == TRIANGULAR_MESH) {
 #ifdef DRACO_MESH_COMPRESSION_SUPPORTED
-    std::unique_ptr<Mesh> mesh(new Mesh());
-    DRACO_RETURN_IF_ERROR(DecodeBufferToGeometry(in_buffer, mesh.get()))
+    DRACO_ASSIGN_OR_RETURN(std::unique_ptr<Mesh> mesh,
+                           DecodeMeshFromBuffer(in_buffer))
     return static_cast<std::unique_ptr<PointCloud>>(std::move(mesh));
 #endif
   }
@@ -87,6 +91,41 @@ StatusOr<std::unique_ptr<Mesh>> Decoder::DecodeMeshFromBuffer(
   return std::move(mesh);
 }
 
+Status Decoder::DecodeMeshToBuffers(
+    DecoderBuffer *in_buffer, const MeshBufferLayoutCallback &layout_callback) {
+#ifdef DRACO_MESH_COMPRESSION_SUPPORTED
+  MeshBufferLayout layout;
+  if (ChunkedMeshDecoder::IsChunkedMesh(in_buffer)) {
+    // Chunks are merged into a single mesh before their values are known.
+    DRACO_ASSIGN_OR_RETURN(std::unique_ptr<Mesh> mesh,
+                           DecodeMeshFromBuffer(in_buffer))
+    DRACO_RETURN_IF_ERROR(layout_callback(*mesh, &layout))
+    return WriteMeshToBuffers(*mesh, layout);
+  }
+  DecoderBuffer temp_buffer(*in_buffer);
+  DracoHeader header;
+  DRACO_RETURN_IF_ERROR(PointCloudDecoder::DecodeHeader(&temp_buffer, &header))
+  if (header.encoder_type != TRIANGULAR_MESH) {
+    return Status(Status::DRACO_ERROR, "Input is not a mesh.");
+  }
+  DRACO_ASSIGN_OR_RETURN(std::unique_ptr<MeshDecoder> decoder,
+                         CreateMeshDecoder(header.encoder_method))
+  // The layout is requested once the connectivity is decoded so that the
+  // attribute decoders can write the values directly into the caller's memory.
+  Mesh mesh;
+  decoder->SetAttributeOutputCallback(
+      [&](std::vector<AttributeBufferLayout> *out_outputs) {
+        DRACO_RETURN_IF_ERROR(layout_callback(mesh, &layout))
+        *out_outputs = layout.attributes;
+        return OkStatus();
+      });
+  DRACO_RETURN_IF_ERROR(decoder->Decode(options_, in_buffer, &mesh))
+  return WriteMeshIndicesToBuffer(mesh, layout);
+#else
+  return Status(Status::DRACO_ERROR, "Unsupported geometry type.");
+#endif
+}
+
 Status Decoder::DecodeBufferToGeometry(DecoderBuffer *in_buffer,
                                        PointCloud *out_geometry) {
 #ifdef DRACO_POINT_CLOUD_COMPRESSION_SUPPORTED
@@ -109,6 +148,12 @@ Status Decoder::DecodeBufferToGeometry(DecoderBuffer *in_buffer,
 Status Decoder::DecodeBufferToGeometry(DecoderBuffer *in_buffer,
                                        Mesh *out_geometry) {
 #ifdef DRACO_MESH_COMPRESSION_SUPPORTED
+  if (ChunkedMeshDecoder::IsChunkedMesh(in_buffer)) {
+    ChunkedMeshDecoder chunked_decoder;
+    *chunked_decoder.options() = options_;
+    DRACO_RETURN_IF_ERROR(chunked_decoder.Init(in_buffer))
+    return chunked_decoder.DecodeMesh(out_geometry);
+  }
   DecoderBuffer temp_buffer(*in_buffer);
   DracoHeader header;
   DRACO_RETURN_IF_ERROR(PointCloudDecoder::DecodeHeader(&temp_buffer, &header))
@@ -15,12 +15,15 @@
 #ifndef DRACO_COMPRESSION_DECODE_H_
 #define DRACO_COMPRESSION_DECODE_H_
 
+#include <functional>
+
 #include "draco/compression/config/compression_shared.h"
 #include "draco/compression/config/decoder_options.h"
 #include "draco/core/decoder_buffer.h"
 #include "draco/core/status_or.h"
 #include "draco/draco_features.h"
 #include "draco/mesh/mesh.h"
+#include "draco/mesh/mesh_buffer_layout.h"
 
 namespace draco {
 
@@ -28,6 +31,13 @@ namespace draco {
 // compressed by a Draco encoder.
 class Decoder {
  public:
+  // Callback used by DecodeMeshToBuffers() to describe the output memory of
+  // the decoded |mesh| in |out_layout|. The number of faces and points and the
+  // attribute descriptors of the mesh can be used to size the caller-owned
+  // buffers. The attribute values of the |mesh| may not be decoded yet.
+  typedef std::function<Status(const Mesh &mesh, MeshBufferLayout *out_layout)>
+      MeshBufferLayoutCallback;
+
   // Returns the geometry type encoded in the input |in_buffer|.
   // The return value is one of POINT_CLOUD, MESH or INVALID_GEOMETRY in case
   // the input data is invalid.
@@ -46,14 +56,27 @@ class Decoder {
   // Decodes a triangular mesh from the provided buffer. The mesh must be filled
   // with data that was encoded using the EncodeMeshToBuffer method in encode.h.
   // The function will return nullptr in case the input is invalid or if it was
-  // encoded with the EncodePointCloudToBuffer method.
+  // encoded with the EncodePointCloudToBuffer method. Meshes encoded with the
+  // ChunkedMeshEncoder are decoded into a single merged mesh (see
+  // ChunkedMeshDecoder for decoding of individual chunks).
   StatusOr<std::unique_ptr<Mesh>> DecodeMeshFromBuffer(
       DecoderBuffer *in_buffer);
 
+  // Decodes a triangular mesh from the provided buffer and writes its faces
+  // and attribute values into caller-owned memory described by the layout
+  // returned from |layout_callback| (see WriteMeshToBuffers()). Attributes
+  // requested in their decoded data type and number of components (e.g.
+  // dequantized positions as floats) are converted by the attribute decoders
+  // straight into the caller's memory without being stored in an
+  // intermediate mesh. Other attributes are decoded first and then converted.
+  Status DecodeMeshToBuffers(DecoderBuffer *in_buffer,
+                             const MeshBufferLayoutCallback &layout_callback);
+
   // Decodes the buffer into a provided geometry. If the geometry is
   // incompatible with the encoded data. For example, when |out_geometry| is
   // draco::Mesh while the data contains a point cloud, the function will return
-  // an error status.
+  // an error status. Meshes encoded with the ChunkedMeshEncoder are decoded
+  // into a single merged mesh.
   Status DecodeBufferToGeometry(DecoderBuffer *in_buffer,
                                 PointCloud *out_geometry);
   Status DecodeBufferToGeometry(DecoderBuffer *in_buffer, Mesh *out_geometry);
@@ -17,8 +17,11 @@
 #include <cinttypes>
 #include <sstream>
 
+#include "draco/compression/encode.h"
+#include "draco/compression/mesh/mesh_sequential_decoder.h"
 #include "draco/core/draco_test_base.h"
 #include "draco/core/draco_test_utils.h"
+#include "draco/core/thread_pool.h"
 #include "draco/io/file_utils.h"
 
 namespace {
@@ -166,4 +169,320 @@ TEST_F(DecodeTest, TestSkipAttributeTransformWithNoQuantization) {
   ASSERT_EQ(pos_att->GetAttributeTransformData(), nullptr);
 }
 
+
+// Decodes |data| with and without a thread pool and verifies that both
+// decoded geometries are the same.
+void TestParallelAttributeDecoding(const std::vector<char> &data) {
+  draco::DecoderBuffer buffer;
+  buffer.Init(data.data(), data.size());
+  draco::Decoder decoder;
+  std::unique_ptr<draco::PointCloud> pc =
+      decoder.DecodePointCloudFromBuffer(&buffer).value();
+  ASSERT_NE(pc, nullptr);
+
+  draco::DecoderBuffer buffer_2;
+  buffer_2.Init(data.data(), data.size());
+  draco::Decoder decoder_2;
+  decoder_2.options()->SetThreadPool(
+      std::make_shared<draco::ThreadPool>(3));
+  std::unique_ptr<draco::PointCloud> pc_2 =
+      decoder_2.DecodePointCloudFromBuffer(&buffer_2).value();
+  ASSERT_NE(pc_2, nullptr);
+
+  ASSERT_EQ(pc->num_points(), pc_2->num_points());
+  ASSERT_EQ(pc->num_attributes(), pc_2->num_attributes());
+  for (int a = 0; a < pc->num_attributes(); ++a) {
+    const draco::PointAttribute *const att = pc->attribute(a);
+    const draco::PointAttribute *const att_2 = pc_2->attribute(a);
+    ASSERT_EQ(att->byte_stride(), att_2->byte_stride());
+    for (draco::PointIndex pi(0); pi < pc->num_points(); ++pi) {
+      ASSERT_EQ(std::memcmp(att->GetAddress(att->mapped_index(pi)),
+                            att_2->GetAddress(att_2->mapped_index(pi)),
+                            att->byte_stride()),
+                0);
+    }
+  }
+}
+
+TEST_F(DecodeTest, TestParallelAttributeDecoding) {
+  // Tests that attributes decoded in parallel are the same as attributes
+  // decoded on a single thread.
+  for (const std::string file_name :
+       {"car.drc", "pc_color.drc", "pc_kd_color.drc",
+        "cube_att_sub_o_2.drc"}) {
+    std::vector<char> data;
+    ASSERT_TRUE(
+        draco::ReadFileToBuffer(draco::GetTestFileFullPath(file_name), &data));
+    TestParallelAttributeDecoding(data);
+  }
+
+  // Test also meshes with attributes that are predicted from other attributes
+  // (e.g., normals and texture coordinates predicted from positions).
+  const std::unique_ptr<draco::Mesh> mesh =
+      draco::ReadMeshFromTestFile("cube_att.obj");
+  ASSERT_NE(mesh, nullptr);
+  for (int speed : {0, 5, 10}) {
+    draco::Encoder encoder;
+    encoder.SetSpeedOptions(speed, speed);
+    encoder.SetAttributeQuantization(draco::GeometryAttribute::POSITION, 12);
+    encoder.SetAttributeQuantization(draco::GeometryAttribute::TEX_COORD, 10);
+    encoder.SetAttributeQuantization(draco::GeometryAttribute::NORMAL, 8);
+    draco::EncoderBuffer encoder_buffer;
+    DRACO_ASSERT_OK(encoder.EncodeMeshToBuffer(*mesh, &encoder_buffer));
+    TestParallelAttributeDecoding(*encoder_buffer.buffer());
+  }
+}
+
+TEST_F(DecodeTest, TestDecodeWithArena) {
+  // Tests that geometry decoded with temporaries allocated from an arena is
+  // the same as geometry decoded without the arena, and that the decoded
+  // geometry doesn't reference the arena memory.
+  const std::shared_ptr<draco::Arena> arena =
+      std::make_shared<draco::Arena>(1024);
+  bool arena_used = false;
+  for (const std::string file_name :
+       {"car.drc", "pc_color.drc", "pc_kd_color.drc", "cube_att_sub_o_2.drc",
+        "test_nm.obj.edgebreaker.1.2.0.drc"}) {
+    for (bool skip_transform : {false, true}) {
+      std::vector<char> data;
+      ASSERT_TRUE(draco::ReadFileToBuffer(
+          draco::GetTestFileFullPath(file_name), &data));
+      draco::DecoderBuffer buffer;
+      buffer.Init(data.data(), data.size());
+      draco::Decoder decoder;
+      if (skip_transform) {
+        decoder.SetSkipAttributeTransform(draco::GeometryAttribute::POSITION);
+      }
+      std::unique_ptr<draco::PointCloud> pc =
+          decoder.DecodePointCloudFromBuffer(&buffer).value();
+      ASSERT_NE(pc, nullptr);
+
+      buffer.Init(data.data(), data.size());
+      decoder.options()->SetArena(arena);
+      std::unique_ptr<draco::PointCloud> pc_2 =
+          decoder.DecodePointCloudFromBuffer(&buffer).value();
+      ASSERT_NE(pc_2, nullptr);
+      arena_used |= arena->allocated_size() > 0;
+      // Overwrite all temporary memory before the geometries are compared.
+      arena->Reset();
+      memset(arena->Allocate(arena->capacity()), 0xff, arena->capacity());
+      arena->Reset();
+
+      ASSERT_EQ(pc->num_points(), pc_2->num_points());
+      ASSERT_EQ(pc->num_attributes(), pc_2->num_attributes());
+      for (int a = 0; a < pc->num_attributes(); ++a) {
+        const draco::PointAttribute *const att = pc->attribute(a);
+        const draco::PointAttribute *const att_2 = pc_2->attribute(a);
+        ASSERT_FALSE(att_2->buffer()->is_external());
+        ASSERT_EQ(att->byte_stride(), att_2->byte_stride());
+        for (draco::PointIndex pi(0); pi < pc->num_points(); ++pi) {
+          ASSERT_EQ(std::memcmp(att->GetAddress(att->mapped_index(pi)),
+                                att_2->GetAddress(att_2->mapped_index(pi)),
+                                att->byte_stride()),
+                    0);
+        }
+      }
+    }
+  }
+  ASSERT_TRUE(arena_used);
+}
+
+TEST_F(DecodeTest, TestDecodeMeshToBuffers) {
+  // Tests that a mesh decoded into caller-provided buffers matches the
+  // decoded mesh.
+  std::vector<char> data;
+  ASSERT_TRUE(
+      draco::ReadFileToBuffer(draco::GetTestFileFullPath("car.drc"), &data));
+  draco::DecoderBuffer buffer;
+  buffer.Init(data.data(), data.size());
+  draco::Decoder decoder;
+  const std::unique_ptr<draco::Mesh> mesh =
+      decoder.DecodeMeshFromBuffer(&buffer).value();
+  ASSERT_NE(mesh, nullptr);
+  const draco::PointAttribute *const pos_att =
+      mesh->GetNamedAttribute(draco::GeometryAttribute::POSITION);
+  ASSERT_NE(pos_att, nullptr);
+
+  std::vector<uint32_t> indices;
+  std::vector<float> positions;
+  buffer.Init(data.data(), data.size());
+  DRACO_ASSERT_OK(decoder.DecodeMeshToBuffers(
+      &buffer, [&](const draco::Mesh &decoded_mesh,
+                   draco::MeshBufferLayout *layout) {
+        indices.resize(decoded_mesh.num_faces() * 3);
+        positions.resize(decoded_mesh.num_points() * 3);
+        layout->indices = indices.data();
+        layout->indices_size = indices.size() * sizeof(uint32_t);
+        layout->attributes.resize(1);
+        layout->attributes[0].attribute_id = decoded_mesh.GetNamedAttributeId(
+            draco::GeometryAttribute::POSITION);
+        layout->attributes[0].data = positions.data();
+        layout->attributes[0].data_size = positions.size() * sizeof(float);
+        return draco::OkStatus();
+      }));
+
+  ASSERT_EQ(indices.size(), mesh->num_faces() * 3);
+  for (draco::FaceIndex f(0); f < mesh->num_faces(); ++f) {
+    for (int c = 0; c < 3; ++c) {
+      const draco::PointIndex pi = mesh->face(f)[c];
+      ASSERT_EQ(indices[3 * f.value() + c], pi.value());
+      float pos[3];
+      pos_att->GetMappedValue(pi, pos);
+      ASSERT_EQ(std::memcmp(pos, &positions[3 * pi.value()], sizeof(pos)), 0);
+    }
+  }
+}
+
+TEST_F(DecodeTest, TestDecodeMeshToInterleavedBuffers) {
+  // Tests that attribute values written directly into an interleaved vertex
+  // buffer by the attribute decoders match the values of the decoded mesh.
+  const std::unique_ptr<draco::Mesh> mesh =
+      draco::ReadMeshFromTestFile("cube_att.obj");
+  ASSERT_NE(mesh, nullptr);
+  for (int speed : {0, 5, 10}) {
+    draco::Encoder encoder;
+    encoder.SetSpeedOptions(speed, speed);
+    encoder.SetAttributeQuantization(draco::GeometryAttribute::POSITION, 12);
+    encoder.SetAttributeQuantization(draco::GeometryAttribute::TEX_COORD, 10);
+    encoder.SetAttributeQuantization(draco::GeometryAttribute::NORMAL, 8);
+    draco::EncoderBuffer encoder_buffer;
+    DRACO_ASSERT_OK(encoder.EncodeMeshToBuffer(*mesh, &encoder_buffer));
+    const std::vector<char> &data = *encoder_buffer.buffer();
+
+    for (int num_threads : {0, 3}) {
+      draco::Decoder decoder;
+      if (num_threads > 0) {
+        decoder.options()->SetThreadPool(
+            std::make_shared<draco::ThreadPool>(num_threads));
+      }
+      draco::DecoderBuffer buffer;
+      buffer.Init(data.data(), data.size());
+      const std::unique_ptr<draco::Mesh> decoded_mesh =
+          decoder.DecodeMeshFromBuffer(&buffer).value();
+      ASSERT_NE(decoded_mesh, nullptr);
+
+      // Values of all attributes are stored in their native format at the
+      // beginning of each vertex, followed by a 4-component position that
+      // has to be converted from the decoded values.
+      std::vector<int> offsets;
+      int vertex_size = 0;
+      for (int a = 0; a < decoded_mesh->num_attributes(); ++a) {
+        offsets.push_back(vertex_size);
+        vertex_size += decoded_mesh->attribute(a)->byte_stride();
+      }
+      const int pos_4_offset = vertex_size;
+      vertex_size += 4 * sizeof(float);
+      const int pos_att_id =
+          decoded_mesh->GetNamedAttributeId(draco::GeometryAttribute::POSITION);
+
+      std::vector<uint16_t> indices;
+      std::vector<uint8_t> vertices;
+      buffer.Init(data.data(), data.size());
+      DRACO_ASSERT_OK(decoder.DecodeMeshToBuffers(
+          &buffer,
+          [&](const draco::Mesh &m, draco::MeshBufferLayout *layout) {
+            indices.resize(m.num_faces() * 3);
+            vertices.resize(m.num_points() * vertex_size);
+            layout->index_type = draco::DT_UINT16;
+            layout->indices = indices.data();
+            layout->indices_size = indices.size() * sizeof(uint16_t);
+            draco::AttributeBufferLayout att_layout;
+            att_layout.data = vertices.data();
+            att_layout.data_size = vertices.size();
+            att_layout.byte_stride = vertex_size;
+            for (int a = 0; a < m.num_attributes(); ++a) {
+              att_layout.attribute_id = a;
+              att_layout.data_type = m.attribute(a)->data_type();
+              att_layout.byte_offset = offsets[a];
+              layout->attributes.push_back(att_layout);
+            }
+            att_layout.attribute_id = pos_att_id;
+            att_layout.data_type = draco::DT_FLOAT32;
+            att_layout.num_components = 4;
+            att_layout.byte_offset = pos_4_offset;
+            layout->attributes.push_back(att_layout);
+            return draco::OkStatus();
+          }));
+
+      ASSERT_EQ(indices.size(), decoded_mesh->num_faces() * 3);
+      for (draco::FaceIndex f(0); f < decoded_mesh->num_faces(); ++f) {
+        for (int c = 0; c < 3; ++c) {
+          ASSERT_EQ(indices[3 * f.value() + c],
+                    decoded_mesh->face(f)[c].value());
+        }
+      }
+      for (draco::PointIndex pi(0); pi < decoded_mesh->num_points(); ++pi) {
+        const uint8_t *const vertex = &vertices[pi.value() * vertex_size];
+        for (int a = 0; a < decoded_mesh->num_attributes(); ++a) {
+          const draco::PointAttribute *const att = decoded_mesh->attribute(a);
+          ASSERT_EQ(std::memcmp(att->GetAddress(att->mapped_index(pi)),
+                                vertex + offsets[a], att->byte_stride()),
+                    0);
+        }
+        float pos_4[4];
+        std::memcpy(pos_4, vertex + pos_4_offset, sizeof(pos_4));
+        ASSERT_EQ(std::memcmp(pos_4, vertex + offsets[pos_att_id],
+                              3 * sizeof(float)),
+                  0);
+        ASSERT_EQ(pos_4[3], 0.f);
+      }
+    }
+  }
+}
+
+TEST_F(DecodeTest, TestAttributeOutputsWithoutAttributeValues) {
+  // Tests that quantized attribute values written directly into the requested
+  // outputs are not stored in the decoded geometry.
+  const std::unique_ptr<draco::Mesh> in_mesh =
+      draco::ReadMeshFromTestFile("cube_att.obj");
+  ASSERT_NE(in_mesh, nullptr);
+  draco::Encoder encoder;
+  encoder.SetEncodingMethod(draco::MESH_SEQUENTIAL_ENCODING);
+  encoder.SetAttributeQuantization(draco::GeometryAttribute::POSITION, 12);
+  draco::EncoderBuffer encoder_buffer;
+  DRACO_ASSERT_OK(encoder.EncodeMeshToBuffer(*in_mesh, &encoder_buffer));
+  const std::vector<char> &data = *encoder_buffer.buffer();
+  draco::DecoderBuffer buffer;
+  buffer.Init(data.data(), data.size());
+  draco::Mesh mesh;
+  draco::MeshSequentialDecoder decoder;
+  std::vector<float> positions;
+  int pos_att_id = -1;
+  decoder.SetAttributeOutputCallback(
+      [&](std::vector<draco::AttributeBufferLayout> *outputs) {
+        pos_att_id =
+            mesh.GetNamedAttributeId(draco::GeometryAttribute::POSITION);
+        positions.resize(mesh.num_points() * 3);
+        outputs->resize(1);
+        (*outputs)[0].attribute_id = pos_att_id;
+        (*outputs)[0].data = positions.data();
+        (*outputs)[0].data_size = positions.size() * sizeof(float);
+        return draco::OkStatus();
+      });
+  const draco::DecoderOptions options;
+  DRACO_ASSERT_OK(decoder.Decode(options, &buffer, &mesh));
+  ASSERT_GE(pos_att_id, 0);
+  ASSERT_EQ(mesh.attribute(pos_att_id)->size(), 0);
+  buffer.Init(data.data(), data.size());
+  const std::unique_ptr<draco::Mesh> decoded_mesh =
+      draco::Decoder().DecodeMeshFromBuffer(&buffer).value();
+  ASSERT_NE(decoded_mesh, nullptr);
+  const draco::PointAttribute *const pos_att =
+      decoded_mesh->attribute(pos_att_id);
+  for (draco::PointIndex pi(0); pi < mesh.num_points(); ++pi) {
+    ASSERT_EQ(std::memcmp(pos_att->GetAddress(pos_att->mapped_index(pi)),
+                          &positions[3 * pi.value()], 3 * sizeof(float)),
+              0);
+  }
+
+  // Errors of the callback are reported by the decoder.
+  buffer.Init(data.data(), data.size());
+  decoder.SetAttributeOutputCallback(
+      [&](std::vector<draco::AttributeBufferLayout> *outputs) {
+        return draco::Status(draco::Status::INVALID_PARAMETER, "Test error.");
+      });
+  ASSERT_EQ(decoder.Decode(options, &buffer, &mesh).code(),
+            draco::Status::INVALID_PARAMETER);
+}
+
 }  // namespace
@@ -0,0 +1,132 @@
+// Copyright 2016 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/decoder_session.h"
+
+#include "draco/compression/chunked_decode.h"
+#include "draco/compression/config/compression_shared.h"
+#include "draco/compression/decode.h"
+
+#ifdef DRACO_MESH_COMPRESSION_SUPPORTED
+#include "draco/compression/mesh/mesh_edgebreaker_decoder.h"
+#include "draco/compression/mesh/mesh_sequential_decoder.h"
+#endif
+
+#ifdef DRACO_POINT_CLOUD_COMPRESSION_SUPPORTED
+#include "draco/compression/point_cloud/point_cloud_kd_tree_decoder.h"
+#include "draco/compression/point_cloud/point_cloud_sequential_decoder.h"
+#endif
+
+namespace draco {
+
+DecoderSession::DecoderSession() {}
+
+DecoderSession::~DecoderSession() {}
+
+StatusOr<std::unique_ptr<Mesh>> DecoderSession::DecodeMeshFromBuffer(
+    DecoderBuffer *in_buffer) {
+  std::unique_ptr<Mesh> mesh(new Mesh());
+  DRACO_RETURN_IF_ERROR(DecodeBufferToGeometry(in_buffer, mesh.get()))
+  return std::move(mesh);
+}
+
+StatusOr<std::unique_ptr<PointCloud>>
+DecoderSession::DecodePointCloudFromBuffer(DecoderBuffer *in_buffer) {
+  DRACO_ASSIGN_OR_RETURN(EncodedGeometryType type,
+                         Decoder::GetEncodedGeometryType(in_buffer))
+  if (type == POINT_CLOUD) {
+#ifdef DRACO_POINT_CLOUD_COMPRESSION_SUPPORTED
+    std::unique_ptr<PointCloud> point_cloud(new PointCloud());
+    DRACO_RETURN_IF_ERROR(DecodeBufferToGeometry(in_buffer, point_cloud.get()))
+    return std::move(point_cloud);
+#endif
+  } else if (type == TRIANGULAR_MESH) {
+#ifdef DRACO_MESH_COMPRESSION_SUPPORTED
+    DRACO_ASSIGN_OR_RETURN(std::unique_ptr<Mesh> mesh,
+                           DecodeMeshFromBuffer(in_buffer))
+    return static_cast<std::unique_ptr<PointCloud>>(std::move(mesh));
+#endif
+  }
+  return Status(Status::DRACO_ERROR, "Unsupported geometry type.");
+}
+
+Status DecoderSession::DecodeBufferToGeometry(DecoderBuffer *in_buffer,
+                                              PointCloud *out_geometry) {
+#ifdef DRACO_POINT_CLOUD_COMPRESSION_SUPPORTED
+  DecoderBuffer temp_buffer(*in_buffer);
+  DracoHeader header;
+  DRACO_RETURN_IF_ERROR(PointCloudDecoder::DecodeHeader(&temp_buffer, &header))
+  if (header.encoder_type != POINT_CLOUD) {
+    return Status(Status::DRACO_ERROR, "Input is not a point cloud.");
+  }
+  if (header.encoder_method >= kNumPointCloudMethods) {
+    return Status(Status::DRACO_ERROR, "Unsupported encoding method.");
+  }
+  std::unique_ptr<PointCloudDecoder> &decoder =
+      point_cloud_decoders_[header.encoder_method];
+  if (decoder == nullptr) {
+    if (header.encoder_method == POINT_CLOUD_SEQUENTIAL_ENCODING) {
+      decoder.reset(new PointCloudSequentialDecoder());
+    } else {
+      decoder.reset(new PointCloudKdTreeDecoder());
+    }
+  }
+  return decoder->Decode(options_, in_buffer, out_geometry);
+#else
+  return Status(Status::DRACO_ERROR, "Unsupported geometry type.");
+#endif
+}
+
+Status DecoderSession::DecodeBufferToGeometry(DecoderBuffer *in_buffer,
+                                              Mesh *out_geometry) {
+#ifdef DRACO_MESH_COMPRESSION_SUPPORTED
+  if (ChunkedMeshDecoder::IsChunkedMesh(in_buffer)) {
+    ChunkedMeshDecoder chunked_decoder;
+    *chunked_decoder.options() = options_;
+    DRACO_RETURN_IF_ERROR(chunked_decoder.Init(in_buffer))
+    return chunked_decoder.DecodeMesh(out_geometry);
+  }
+  DecoderBuffer temp_buffer(*in_buffer);
+  DracoHeader header;
+  DRACO_RETURN_IF_ERROR(PointCloudDecoder::DecodeHeader(&temp_buffer, &header))
+  if (header.encoder_type != TRIANGULAR_MESH) {
+    return Status(Status::DRACO_ERROR, "Input is not a mesh.");
+  }
+  if (header.encoder_method >= kNumMeshMethods) {
+    return Status(Status::DRACO_ERROR, "Unsupported encoding method.");
+  }
+  std::unique_ptr<MeshDecoder> &decoder = mesh_decoders_[header.encoder_method];
+  if (decoder == nullptr) {
+    if (header.encoder_method == MESH_SEQUENTIAL_ENCODING) {
+      decoder.reset(new MeshSequentialDecoder());
+    } else {
+      decoder.reset(new MeshEdgebreakerDecoder());
+    }
+  }
+  return decoder->Decode(options_, in_buffer, out_geometry);
+#else
+  return Status(Status::DRACO_ERROR, "Unsupported geometry type.");
+#endif
+}
+
+void DecoderSession::Clear() {
+  for (int i = 0; i < kNumMeshMethods; ++i) {
+    mesh_decoders_[i] = nullptr;
+  }
+  for (int i = 0; i < kNumPointCloudMethods; ++i) {
+    point_cloud_decoders_[i] = nullptr;
+  }
+}
+
+}  // namespace draco
@@ -0,0 +1,81 @@
+// Copyright 2016 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_COMPRESSION_DECODER_SESSION_H_
+#define DRACO_COMPRESSION_DECODER_SESSION_H_
+
+#include <memory>
+
+#include "draco/compression/config/decoder_options.h"
+#include "draco/core/decoder_buffer.h"
+#include "draco/core/status_or.h"
+#include "draco/draco_features.h"
+#include "draco/mesh/mesh.h"
+
+namespace draco {
+
+class MeshDecoder;
+class PointCloudDecoder;
+
+// Decoder for many geometries in a row, e.g. on a server decoding a stream of
+// small meshes. Unlike Decoder, which creates new decoder instances for each
+// decoded geometry, the session keeps the decoders between decodes together
+// with their internal data structures (corner tables, traversal stacks, vertex
+// and face flags and similar). These structures are only reset and grown when
+// needed, so decoding of a geometry that is not larger than any of the
+// previously decoded ones allocates mostly just the output geometry and the
+// attribute decoders.
+//
+// The decoded output is identical to the output of Decoder. The session is not
+// thread-safe; use one session per thread.
+class DecoderSession {
+ public:
+  DecoderSession();
+  ~DecoderSession();
+
+  // Same as Decoder::DecodeMeshFromBuffer(). Chunked meshes are decoded
+  // without reusing any data structures.
+  StatusOr<std::unique_ptr<Mesh>> DecodeMeshFromBuffer(
+      DecoderBuffer *in_buffer);
+
+  // Same as Decoder::DecodePointCloudFromBuffer().
+  StatusOr<std::unique_ptr<PointCloud>> DecodePointCloudFromBuffer(
+      DecoderBuffer *in_buffer);
+
+  // Same as Decoder::DecodeBufferToGeometry().
+  Status DecodeBufferToGeometry(DecoderBuffer *in_buffer,
+                                PointCloud *out_geometry);
+  Status DecodeBufferToGeometry(DecoderBuffer *in_buffer, Mesh *out_geometry);
+
+  // Releases all memory retained from the previous decodes.
+  void Clear();
+
+  // Returns the options used for all decodes in the session.
+  DecoderOptions *options() { return &options_; }
+
+ private:
+  // Number of supported encoding methods for each geometry type.
+  static constexpr int kNumMeshMethods = 2;
+  static constexpr int kNumPointCloudMethods = 2;
+
+  DecoderOptions options_;
+  // Decoders indexed by their encoding method. Created on first use.
+  std::unique_ptr<MeshDecoder> mesh_decoders_[kNumMeshMethods];
+  std::unique_ptr<PointCloudDecoder>
+      point_cloud_decoders_[kNumPointCloudMethods];
+};
+
+}  // namespace draco
+
+#endif  // DRACO_COMPRESSION_DECODER_SESSION_H_
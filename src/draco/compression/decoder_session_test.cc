@@ -0,0 +1,155 @@
+// Copyright 2016 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/decoder_session.h"
+
+#include <cstring>
+
+#include "draco/compression/decode.h"
+#include "draco/compression/encode.h"
+#include "draco/core/draco_test_base.h"
+#include "draco/core/draco_test_utils.h"
+#include "draco/io/file_utils.h"
+
+namespace {
+
+class DecoderSessionTest : public ::testing::Test {
+ protected:
+  // Encodes |file_name| with the given |encoding_method| and |speed|.
+  void EncodeTestFile(const std::string &file_name, int encoding_method,
+                      int speed, std::vector<char> *out_data) {
+    const std::unique_ptr<draco::Mesh> mesh =
+        draco::ReadMeshFromTestFile(file_name);
+    ASSERT_NE(mesh, nullptr);
+    draco::Encoder encoder;
+    encoder.SetEncodingMethod(encoding_method);
+    encoder.SetSpeedOptions(speed, speed);
+    encoder.SetAttributeQuantization(draco::GeometryAttribute::POSITION, 14);
+    encoder.SetAttributeQuantization(draco::GeometryAttribute::TEX_COORD, 12);
+    encoder.SetAttributeQuantization(draco::GeometryAttribute::NORMAL, 10);
+    draco::EncoderBuffer buffer;
+    DRACO_ASSERT_OK(encoder.EncodeMeshToBuffer(*mesh, &buffer));
+    out_data->assign(buffer.data(), buffer.data() + buffer.size());
+  }
+
+  // Verifies that |pc| is identical to |expected_pc|.
+  void ComparePointClouds(const draco::PointCloud &expected_pc,
+                          const draco::PointCloud &pc) {
+    ASSERT_EQ(pc.num_points(), expected_pc.num_points());
+    ASSERT_EQ(pc.num_attributes(), expected_pc.num_attributes());
+    for (int a = 0; a < pc.num_attributes(); ++a) {
+      const draco::PointAttribute *const att = pc.attribute(a);
+      const draco::PointAttribute *const expected_att =
+          expected_pc.attribute(a);
+      ASSERT_EQ(att->size(), expected_att->size());
+      ASSERT_EQ(att->byte_stride(), expected_att->byte_stride());
+      for (draco::PointIndex pi(0); pi < pc.num_points(); ++pi) {
+        ASSERT_EQ(att->mapped_index(pi), expected_att->mapped_index(pi));
+      }
+      ASSERT_EQ(memcmp(att->GetAddress(draco::AttributeValueIndex(0)),
+                       expected_att->GetAddress(draco::AttributeValueIndex(0)),
+                       att->size() * att->byte_stride()),
+                0);
+    }
+  }
+
+  // Decodes |data| with |session| and verifies the result is the same as the
+  // result of the regular decoder.
+  void TestSessionDecoding(const std::vector<char> &data,
+                           draco::DecoderSession *session) {
+    draco::DecoderBuffer buffer;
+    buffer.Init(data.data(), data.size());
+    draco::Decoder decoder;
+    auto expected_statusor = decoder.DecodePointCloudFromBuffer(&buffer);
+    DRACO_ASSERT_OK(expected_statusor.status());
+    const std::unique_ptr<draco::PointCloud> expected_pc =
+        std::move(expected_statusor).value();
+
+    buffer.Init(data.data(), data.size());
+    auto statusor = session->DecodePointCloudFromBuffer(&buffer);
+    DRACO_ASSERT_OK(statusor.status());
+    const std::unique_ptr<draco::PointCloud> pc = std::move(statusor).value();
+    ComparePointClouds(*expected_pc, *pc);
+
+    const draco::Mesh *const expected_mesh =
+        dynamic_cast<const draco::Mesh *>(expected_pc.get());
+    const draco::Mesh *const mesh = dynamic_cast<const draco::Mesh *>(pc.get());
+    ASSERT_EQ(mesh == nullptr, expected_mesh == nullptr);
+    if (mesh == nullptr) {
+      return;
+    }
+    ASSERT_EQ(mesh->num_faces(), expected_mesh->num_faces());
+    for (draco::FaceIndex f(0); f < mesh->num_faces(); ++f) {
+      ASSERT_EQ(mesh->face(f), expected_mesh->face(f));
+    }
+  }
+};
+
+TEST_F(DecoderSessionTest, DecodeMultipleMeshes) {
+  // Meshes of various sizes and topologies encoded with all encoding methods
+  // and traversal types are decoded with a single session in an order where
+  // larger meshes are followed by smaller ones.
+  const std::string file_names[] = {"test_nm.obj", "cube_att.obj",
+                                    "multiple_tetrahedrons.obj", "sphere.obj",
+                                    "triangle.obj"};
+  std::vector<std::vector<char>> encoded_data;
+  for (const std::string &file_name : file_names) {
+    for (int speed : {0, 5, 10}) {
+      encoded_data.push_back(std::vector<char>());
+      EncodeTestFile(file_name, draco::MESH_EDGEBREAKER_ENCODING, speed,
+                     &encoded_data.back());
+    }
+    encoded_data.push_back(std::vector<char>());
+    EncodeTestFile(file_name, draco::MESH_SEQUENTIAL_ENCODING, 5,
+                   &encoded_data.back());
+  }
+  draco::DecoderSession session;
+  for (int pass = 0; pass < 2; ++pass) {
+    for (const std::vector<char> &data : encoded_data) {
+      TestSessionDecoding(data, &session);
+    }
+  }
+}
+
+TEST_F(DecoderSessionTest, DecodeLegacyAndPointCloudFiles) {
+  const std::string file_names[] = {
+      "test_nm.obj.edgebreaker.0.9.1.drc", "cube_pc.drc",
+      "test_nm.obj.edgebreaker.1.2.0.drc", "pc_kd_color.drc",
+      "test_nm.obj.edgebreaker.0.10.0.drc", "car.drc",
+      "test_nm.obj.sequential.1.2.0.drc",   "point_cloud_no_qp.drc"};
+  draco::DecoderSession session;
+  for (int pass = 0; pass < 2; ++pass) {
+    for (const std::string &file_name : file_names) {
+      std::vector<char> data;
+      ASSERT_TRUE(
+          draco::ReadFileToBuffer(draco::GetTestFileFullPath(file_name), &data));
+      TestSessionDecoding(data, &session);
+    }
+  }
+}
+
+TEST_F(DecoderSessionTest, DecodeAfterError) {
+  std::vector<char> data;
+  EncodeTestFile("test_nm.obj", draco::MESH_EDGEBREAKER_ENCODING, 5, &data);
+  draco::DecoderSession session;
+  // Decoding of truncated data fails but doesn't affect subsequent decodes.
+  draco::DecoderBuffer buffer;
+  buffer.Init(data.data(), data.size() / 2);
+  ASSERT_FALSE(session.DecodeMeshFromBuffer(&buffer).ok());
+  TestSessionDecoding(data, &session);
+  session.Clear();
+  TestSessionDecoding(data, &session);
+}
+
+}  // namespace
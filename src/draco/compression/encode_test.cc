@@ -24,8 +24,10 @@
 #include "draco/compression/expert_encode.h"
 #include "draco/core/draco_test_base.h"
 #include "draco/core/draco_test_utils.h"
+#include "draco/core/thread_pool.h"
 #include "draco/core/vector_d.h"
 #include "draco/io/obj_decoder.h"
+#include "draco/mesh/mesh_are_equivalent.h"
 #include "draco/mesh/triangle_soup_mesh_builder.h"
 #include "draco/point_cloud/point_cloud_builder.h"
 
@@ -235,6 +237,136 @@ TEST_F(EncodeTest, TestExpertEncoderQuantization)
   VerifyNumQuantizationBits(buffer, 16, 15, 14);
 }
 
+TEST_F(EncodeTest, TestExpertEncoderInterleavedSymbolCoding)
+{
+  // This test verifies that attributes encoded with interleaved rANS states
+  // are decoded to the same mesh as attributes encoded with the default
+  // symbol coding and that the header flag is set.
+  std::unique_ptr<draco::Mesh> mesh(draco::ReadMeshFromTestFile("test_nm.obj"));
+  ASSERT_NE(mesh, nullptr);
+
+  std::unique_ptr<draco::Mesh> decoded_meshes[2];
+
+  for (int i = 0; i < 2; ++i)
+  {
+    draco::ExpertEncoder encoder(*mesh);
+    encoder.SetAttributeQuantization(0, 14);
+
+    if (i == 1)
+    {
+      ASSERT_FALSE(encoder.SetInterleavedSymbolCoding(5).ok());
+      ASSERT_TRUE(encoder.SetInterleavedSymbolCoding(8).ok());
+    }
+
+    draco::EncoderBuffer buffer;
+    ASSERT_TRUE(encoder.EncodeToBuffer(&buffer).ok());
+
+    // Flags are stored right after the first 9 bytes of the header.
+    uint16_t flags;
+    memcpy(&flags, buffer.data() + 9, sizeof(flags));
+    ASSERT_EQ((flags & INTERLEAVED_SYMBOL_CODING_FLAG_MASK) != 0, i == 1);
+
+    draco::DecoderBuffer decoder_buffer;
+    decoder_buffer.Init(buffer.data(), buffer.size());
+    draco::Decoder decoder;
+    auto maybe_mesh = decoder.DecodeMeshFromBuffer(&decoder_buffer);
+    ASSERT_TRUE(maybe_mesh.ok());
+    decoded_meshes[i] = std::move(maybe_mesh).value();
+  }
+
+  draco::MeshAreEquivalent equiv;
+  ASSERT_TRUE(equiv(*decoded_meshes[0], *decoded_meshes[1]));
+}
+
+TEST_F(EncodeTest, TestInterleavedSymbolCodingRequiresHeaderFlag)
+{
+  // This test verifies that values encoded with interleaved rANS states are
+  // rejected by the decoder when the header flag is cleared. The attribute
+  // uses a small alphabet so that the raw (interleaved) symbol coding is
+  // selected over the tagged one.
+  constexpr int kNumPoints = 4096;
+  draco::PointCloudBuilder pc_builder;
+  pc_builder.Start(kNumPoints);
+  const int att_id = pc_builder.AddAttribute(draco::GeometryAttribute::GENERIC,
+                                             1, draco::DT_UINT8);
+  uint32_t state = 1;
+  for (draco::PointIndex i(0); i < kNumPoints; ++i)
+  {
+    state = state * 1664525u + 1013904223u;
+    const uint8_t value = static_cast<uint8_t>((state >> 24) % 3);
+    pc_builder.SetAttributeValueForPoint(att_id, i, &value);
+  }
+  std::unique_ptr<draco::PointCloud> pc = pc_builder.Finalize(false);
+  ASSERT_NE(pc, nullptr);
+
+  draco::ExpertEncoder encoder(*pc);
+  encoder.SetEncodingMethod(draco::POINT_CLOUD_SEQUENTIAL_ENCODING);
+  ASSERT_TRUE(encoder.SetInterleavedSymbolCoding(4).ok());
+  draco::EncoderBuffer buffer;
+  ASSERT_TRUE(encoder.EncodeToBuffer(&buffer).ok());
+
+  draco::DecoderBuffer decoder_buffer;
+  decoder_buffer.Init(buffer.data(), buffer.size());
+  draco::Decoder decoder;
+  auto maybe_pc = decoder.DecodePointCloudFromBuffer(&decoder_buffer);
+  ASSERT_TRUE(maybe_pc.ok());
+  ASSERT_EQ(maybe_pc.value()->num_points(), kNumPoints);
+
+  // Flags are stored right after the first 9 bytes of the header.
+  std::vector<char> data(buffer.data(), buffer.data() + buffer.size());
+  uint16_t flags;
+  memcpy(&flags, data.data() + 9, sizeof(flags));
+  ASSERT_NE(flags & INTERLEAVED_SYMBOL_CODING_FLAG_MASK, 0);
+  flags &= ~INTERLEAVED_SYMBOL_CODING_FLAG_MASK;
+  memcpy(data.data() + 9, &flags, sizeof(flags));
+  decoder_buffer.Init(data.data(), data.size());
+  ASSERT_FALSE(decoder.DecodePointCloudFromBuffer(&decoder_buffer).ok());
+}
+
+TEST_F(EncodeTest, TestExpertEncoderThreadPool)
+{
+  // This test verifies that attributes encoded in parallel produce the same
+  // encoded data as attributes encoded on a single thread.
+  const std::shared_ptr<draco::ThreadPool> thread_pool(new draco::ThreadPool(3));
+
+  for (const std::string file_name : {"cube_att.obj", "test_nm.obj"})
+  {
+    std::unique_ptr<draco::Mesh> mesh(draco::ReadMeshFromTestFile(file_name));
+    ASSERT_NE(mesh, nullptr);
+
+    for (const bool is_point_cloud : {false, true})
+    {
+      for (const int speed : {0, 5, 10})
+      {
+        draco::EncoderBuffer buffers[2];
+
+        for (int i = 0; i < 2; ++i)
+        {
+          std::unique_ptr<draco::ExpertEncoder> encoder;
+
+          if (is_point_cloud)
+            encoder.reset(new draco::ExpertEncoder(*static_cast<draco::PointCloud *>(mesh.get())));
+          else
+            encoder.reset(new draco::ExpertEncoder(*mesh));
+
+          encoder->SetSpeedOptions(speed, speed);
+
+          for (int a = 0; a < mesh->num_attributes(); ++a)
+            encoder->SetAttributeQuantization(a, 10 + a);
+
+          if (i == 1)
+            encoder->SetThreadPool(thread_pool);
+
+          ASSERT_TRUE(encoder->EncodeToBuffer(&buffers[i]).ok());
+        }
+
+        ASSERT_EQ(buffers[0].size(), buffers[1].size());
+        ASSERT_EQ(memcmp(buffers[0].data(), buffers[1].data(), buffers[0].size()), 0);
+      }
+    }
+  }
+}
+
 TEST_F(EncodeTest, TestEncoderQuantization)
 {
   // This test verifies that Encoder applies the same quantization to all
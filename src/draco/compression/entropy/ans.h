@@ -18,8 +18,13 @@
 // See http://arxiv.org/abs/1311.2540v2 for more information on rANS.
 // This file is based off libvpx's ans.h.
 
+#include <algorithm>
+#include <memory>
 #include <vector>
 
+#include "draco/compression/entropy/rans_simd_decoding.h"
+#include "draco/core/cpu_features.h"
+
 #define DRACO_ANS_DIVIDE_BY_MULTIPLY 1
 #if DRACO_ANS_DIVIDE_BY_MULTIPLY
 #include "draco/core/divide.h"
@@ -346,60 +351,97 @@ struct rans_sym {
 // The max number of precision bits is currently 19. The actual number of
 // symbols in the input alphabet should be (much) smaller than that, otherwise
 // the compression rate may suffer.
+// The encoder can optionally use up to |kMaxNumStates| interleaved rANS states
+// that share the same output buffer. Each symbol is then encoded with one of
+// the states selected by the caller and the decoder needs to use the same
+// state for the symbol. Consecutive symbols coded with different states don't
+// depend on each other, which allows the decoder to process them in parallel.
 template <int rans_precision_bits_t>
 class RAnsEncoder {
  public:
-  RAnsEncoder() {}
+  // Maximum number of interleaved rANS states.
+  static constexpr int kMaxNumStates = 8;
+
+  RAnsEncoder() : buf_(nullptr), buf_offset_(0), num_states_(1) {}
 
   // Provides the input buffer where the data is going to be stored.
-  inline void write_init(uint8_t *const buf) {
-    ans_.buf = buf;
-    ans_.buf_offset = 0;
-    ans_.state = l_rans_base;
+  inline void write_init(uint8_t *const buf) { write_init(buf, 1); }
+
+  // Same as above but the data is going to be encoded with |num_states|
+  // interleaved rANS states.
+  inline void write_init(uint8_t *const buf, int num_states) {
+    DRACO_DCHECK_GE(num_states, 1);
+    DRACO_DCHECK_LE(num_states, kMaxNumStates);
+    buf_ = buf;
+    buf_offset_ = 0;
+    num_states_ = num_states;
+    for (int i = 0; i < num_states_; ++i) {
+      states_[i] = l_rans_base;
+    }
   }
 
-  // Needs to be called after all symbols are encoded.
+  // Needs to be called after all symbols are encoded. The final states are
+  // stored in the order of their ids. Returns the total number of bytes
+  // written into the buffer.
   inline int write_end() {
-    uint32_t state;
-    DRACO_DCHECK_GE(ans_.state, l_rans_base);
-    DRACO_DCHECK_LT(ans_.state, l_rans_base * DRACO_ANS_IO_BASE);
-    state = ans_.state - l_rans_base;
-    if (state < (1 << 6)) {
-      ans_.buf[ans_.buf_offset] = (0x00 << 6) + state;
-      return ans_.buf_offset + 1;
-    } else if (state < (1 << 14)) {
-      mem_put_le16(ans_.buf + ans_.buf_offset, (0x01 << 14) + state);
-      return ans_.buf_offset + 2;
-    } else if (state < (1 << 22)) {
-      mem_put_le24(ans_.buf + ans_.buf_offset, (0x02 << 22) + state);
-      return ans_.buf_offset + 3;
-    } else if (state < (1 << 30)) {
-      mem_put_le32(ans_.buf + ans_.buf_offset, (0x03u << 30u) + state);
-      return ans_.buf_offset + 4;
-    } else {
-      DRACO_DCHECK(0 && "State is too large to be serialized");
-      return ans_.buf_offset;
+    for (int i = 0; i < num_states_; ++i) {
+      if (!write_state(states_[i])) {
+        DRACO_DCHECK(0 && "State is too large to be serialized");
+        return buf_offset_;
+      }
     }
+    return buf_offset_;
   }
 
   // rANS with normalization.
   // sym->prob takes the place of l_s from the paper.
   // rans_precision is m.
   inline void rans_write(const struct rans_sym *const sym) {
+    rans_write(0, sym);
+  }
+
+  // Encodes |sym| using the rANS state |state_id|.
+  inline void rans_write(int state_id, const struct rans_sym *const sym) {
     const uint32_t p = sym->prob;
-    while (ans_.state >= l_rans_base / rans_precision * DRACO_ANS_IO_BASE * p) {
-      ans_.buf[ans_.buf_offset++] = ans_.state % DRACO_ANS_IO_BASE;
-      ans_.state /= DRACO_ANS_IO_BASE;
+    uint32_t state = states_[state_id];
+    while (state >= l_rans_base / rans_precision * DRACO_ANS_IO_BASE * p) {
+      buf_[buf_offset_++] = state % DRACO_ANS_IO_BASE;
+      state /= DRACO_ANS_IO_BASE;
     }
     // TODO(ostava): The division and multiplication should be optimized.
-    ans_.state =
-        (ans_.state / p) * rans_precision + ans_.state % p + sym->cum_prob;
+    states_[state_id] = (state / p) * rans_precision + state % p + sym->cum_prob;
   }
 
  private:
+  // Serializes one final rANS state into the output buffer.
+  inline bool write_state(uint32_t ans_state) {
+    DRACO_DCHECK_GE(ans_state, l_rans_base);
+    DRACO_DCHECK_LT(ans_state, l_rans_base * DRACO_ANS_IO_BASE);
+    const uint32_t state = ans_state - l_rans_base;
+    if (state < (1 << 6)) {
+      buf_[buf_offset_] = (0x00 << 6) + state;
+      buf_offset_ += 1;
+    } else if (state < (1 << 14)) {
+      mem_put_le16(buf_ + buf_offset_, (0x01 << 14) + state);
+      buf_offset_ += 2;
+    } else if (state < (1 << 22)) {
+      mem_put_le24(buf_ + buf_offset_, (0x02 << 22) + state);
+      buf_offset_ += 3;
+    } else if (state < (1 << 30)) {
+      mem_put_le32(buf_ + buf_offset_, (0x03u << 30u) + state);
+      buf_offset_ += 4;
+    } else {
+      return false;
+    }
+    return true;
+  }
+
   static constexpr int rans_precision = 1 << rans_precision_bits_t;
   static constexpr int l_rans_base = rans_precision * 4;
-  AnsCoder ans_;
+  uint8_t *buf_;
+  int buf_offset_;
+  int num_states_;
+  uint32_t states_[kMaxNumStates];
 };
 
 struct rans_dec_sym {
@@ -408,113 +450,367 @@ struct rans_dec_sym {
   uint32_t cum_prob;  // not-inclusive.
 };
 
+// Look up tables used by RAnsDecoder. The tables are immutable once they are
+// built so they can be shared by multiple decoders that use the same
+// precision and the same probabilities (see RAnsTableCache).
+struct RAnsLookUpTable {
+  RAnsLookUpTable() : bucket_shift(0) {}
+
+  // Full look up table with |rans_precision| 32-bit entries. When
+  // |symbol_table| is empty, the entries are fused (see RAnsDecoder).
+  // Otherwise each entry is the index of the decoded symbol in |symbol_table|.
+  std::vector<uint32_t> lut_table;
+  // Bucketed look up table used when the size of the table is limited. Each
+  // bucket stores the index of the first candidate symbol in |symbol_table|.
+  std::vector<uint32_t> bucket_table;
+  // Packed entries of all symbols with a non-zero probability, storing their
+  // cumulative probabilities as offsets.
+  std::vector<uint64_t> symbol_table;
+  // Number of bits of the remainder that are not used to select a bucket.
+  int bucket_shift;
+};
+
 // Class for performing rANS decoding using a desired number of precision bits.
 // The number of precision bits needs to be the same as with the RAnsEncoder
-// that was used to encode the input data.
+// that was used to encode the input data. Data encoded with interleaved rANS
+// states must be decoded with the same number of states and each symbol must
+// be decoded with the state that was used to encode it.
+//
+// Symbols are decoded using a look up table with |rans_precision| 32-bit
+// entries. When the decoded symbol, its probability and the offset of the
+// entry within the range of the symbol fit into 32 bits (see PackEntry()),
+// e.g. for 12-bit precision with up to 256 symbols, they are fused into the
+// entry so that a symbol is decoded with a single table lookup. Otherwise the
+// entry stores the index of the symbol in a table of packed symbols. The size
+// of the table can be optionally limited with
+// set_max_look_up_table_bits(). In that case the table is split into buckets
+// and the symbol is found with a binary search over the symbols that overlap
+// the bucket. This is slower but it keeps the table small enough to stay in
+// the cache for high precisions.
 template <int rans_precision_bits_t>
 class RAnsDecoder {
  public:
-  RAnsDecoder() {}
+  // Maximum number of interleaved rANS states.
+  static constexpr int kMaxNumStates = 8;
+
+  // Minimum number of bits that can be set in set_max_look_up_table_bits().
+  static constexpr int kMinLookUpTableBits = 8;
+
+  RAnsDecoder()
+      : lut_table_(nullptr),
+        bucket_table_(nullptr),
+        symbol_table_(nullptr),
+        bucket_shift_(0),
+        buf_(nullptr),
+        buf_offset_(0),
+        num_states_(1),
+        max_look_up_table_bits_(rans_precision_bits_t) {}
+
+  // Limits the number of entries of the look up table to
+  // 2^|max_look_up_table_bits|. The limit must be set before the table is
+  // built with rans_build_look_up_table(). Values larger than the precision
+  // of the decoder disable the limit and values smaller than
+  // |kMinLookUpTableBits| are clamped.
+  void set_max_look_up_table_bits(int max_look_up_table_bits) {
+    max_look_up_table_bits_ =
+        std::max(kMinLookUpTableBits,
+                 std::min(max_look_up_table_bits, rans_precision_bits_t));
+  }
+  int max_look_up_table_bits() const { return max_look_up_table_bits_; }
 
   // Initializes the decoder from the input buffer. The |offset| specifies the
   // number of bytes encoded by the encoder. A non zero return value is an
   // error.
   inline int read_init(const uint8_t *const buf, int offset) {
-    unsigned x;
-    if (offset < 1) {
+    return read_init(buf, offset, 1);
+  }
+
+  // Same as above but for data encoded with |num_states| interleaved rANS
+  // states.
+  inline int read_init(const uint8_t *const buf, int offset, int num_states) {
+    if (num_states < 1 || num_states > kMaxNumStates) {
       return 1;
     }
-    ans_.buf = buf;
-    x = buf[offset - 1] >> 6;
-    if (x == 0) {
-      ans_.buf_offset = offset - 1;
-      ans_.state = buf[offset - 1] & 0x3F;
-    } else if (x == 1) {
-      if (offset < 2) {
-        return 1;
-      }
-      ans_.buf_offset = offset - 2;
-      ans_.state = mem_get_le16(buf + offset - 2) & 0x3FFF;
-    } else if (x == 2) {
-      if (offset < 3) {
+    buf_ = buf;
+    num_states_ = num_states;
+    // The final states were stored in the order of their ids, so we need to
+    // read them in the reverse order.
+    for (int i = num_states_ - 1; i >= 0; --i) {
+      if (read_state(&offset, &states_[i]) != 0) {
         return 1;
       }
-      ans_.buf_offset = offset - 3;
-      ans_.state = mem_get_le24(buf + offset - 3) & 0x3FFFFF;
-    } else if (x == 3) {
-      ans_.buf_offset = offset - 4;
-      ans_.state = mem_get_le32(buf + offset - 4) & 0x3FFFFFFF;
-    } else {
-      return 1;
-    }
-    ans_.state += l_rans_base;
-    if (ans_.state >= l_rans_base * DRACO_ANS_IO_BASE) {
-      return 1;
     }
+    buf_offset_ = offset;
     return 0;
   }
 
-  inline int read_end() { return ans_.state == l_rans_base; }
+  inline int read_end() {
+    for (int i = 0; i < num_states_; ++i) {
+      if (states_[i] != l_rans_base) {
+        return 0;
+      }
+    }
+    return 1;
+  }
 
   inline int reader_has_error() {
-    return ans_.state < l_rans_base && ans_.buf_offset == 0;
+    return states_[0] < l_rans_base && buf_offset_ == 0;
   }
 
-  inline int rans_read() {
+  inline int rans_read() { return rans_read(0); }
+
+  // Decodes one symbol using the rANS state |state_id|.
+  inline int rans_read(int state_id) {
     unsigned rem;
     unsigned quo;
     struct rans_dec_sym sym;
-    while (ans_.state < l_rans_base && ans_.buf_offset > 0) {
-      ans_.state = ans_.state * DRACO_ANS_IO_BASE + ans_.buf[--ans_.buf_offset];
+    uint32_t state = states_[state_id];
+    while (state < l_rans_base && buf_offset_ > 0) {
+      state = state * DRACO_ANS_IO_BASE + buf_[--buf_offset_];
     }
     // |rans_precision| is a power of two compile time constant, and the below
     // division and modulo are going to be optimized by the compiler.
-    quo = ans_.state / rans_precision;
-    rem = ans_.state % rans_precision;
+    quo = state / rans_precision;
+    rem = state % rans_precision;
     fetch_sym(&sym, rem);
-    ans_.state = quo * sym.prob + rem - sym.cum_prob;
+    states_[state_id] = quo * sym.prob + rem - sym.cum_prob;
     return sym.val;
   }
 
-  // Construct a lookup table with |rans_precision| number of entries.
+  // Decodes |num_values| symbols into |out_values|. Symbol i is decoded with
+  // the state i % num_states. Interleaved data is decoded with SIMD
+  // instructions when they are supported by the CPU.
+  inline void rans_read_symbols(uint32_t *out_values, size_t num_values) {
+    size_t i = 0;
+#ifdef DRACO_X86_SIMD_SUPPORTED
+    // The SIMD kernels support only the full look up table.
+    if (num_states_ > 1 && bucket_table_ == nullptr) {
+      RAnsSimdDecodingState simd_state = {lut_table_, symbol_table_,
+                                          rans_precision_bits_t, buf_,
+                                          buf_offset_, states_};
+      if (num_states_ == 8 && CpuAvx2Supported()) {
+        i = DecodeRAnsSymbolsAvx2(&simd_state, out_values, num_values);
+      } else if (num_states_ == 4 && CpuSse41Supported()) {
+        i = DecodeRAnsSymbolsSse41(&simd_state, out_values, num_values);
+      }
+      buf_offset_ = simd_state.buf_offset;
+    }
+#endif
+    // Decode the remaining values. |i| is always a multiple of |num_states_|
+    // here so the next symbol is decoded with the state 0.
+    int state_id = 0;
+    for (; i < num_values; ++i) {
+      out_values[i] = rans_read(state_id);
+      if (++state_id == num_states_) {
+        state_id = 0;
+      }
+    }
+  }
+
+  // Construct a lookup table with |rans_precision| number of entries (or
+  // fewer when the size of the table is limited).
   // Returns false if the table couldn't be built (because of wrong input data).
   inline bool rans_build_look_up_table(const uint32_t token_probs[],
                                        uint32_t num_symbols) {
-    lut_table_.resize(rans_precision);
-    probability_table_.resize(num_symbols);
+    if (static_cast<uint64_t>(num_symbols) > kMaxNumSymbols) {
+      return false;
+    }
+    const bool use_buckets = max_look_up_table_bits_ < rans_precision_bits_t;
+    const bool use_fused_entries =
+        !use_buckets && num_symbols <= kMaxNumFusedSymbols;
+    std::shared_ptr<RAnsLookUpTable> table(new RAnsLookUpTable());
+    if (!use_buckets) {
+      table->lut_table.resize(rans_precision);
+    }
     uint32_t cum_prob = 0;
-    uint32_t act_prob = 0;
     for (uint32_t i = 0; i < num_symbols; ++i) {
-      probability_table_[i].prob = token_probs[i];
-      probability_table_[i].cum_prob = cum_prob;
-      cum_prob += token_probs[i];
-      if (cum_prob > rans_precision) {
+      const uint32_t prob = token_probs[i];
+      if (prob == 0) {
+        continue;
+      }
+      if (prob > rans_precision - cum_prob) {
         return false;
       }
-      for (uint32_t j = act_prob; j < cum_prob; ++j) {
-        lut_table_[j] = i;
+      if (use_fused_entries) {
+        for (uint32_t j = 0; j < prob; ++j) {
+          table->lut_table[cum_prob + j] =
+              static_cast<uint32_t>(PackEntry(i, prob, j));
+        }
+      } else {
+        if (!use_buckets) {
+          std::fill(table->lut_table.begin() + cum_prob,
+                    table->lut_table.begin() + cum_prob + prob,
+                    static_cast<uint32_t>(table->symbol_table.size()));
+        }
+        table->symbol_table.push_back(PackEntry(i, prob, cum_prob));
       }
-      act_prob = cum_prob;
+      cum_prob += prob;
     }
     if (cum_prob != rans_precision) {
       return false;
     }
+    if (use_buckets) {
+      // For each bucket, store the index of the symbol that contains the
+      // first entry of the bucket. The extra last bucket points to the last
+      // symbol.
+      const std::vector<uint64_t> &symbols = table->symbol_table;
+      const uint32_t num_buckets = 1 << max_look_up_table_bits_;
+      table->bucket_shift = rans_precision_bits_t - max_look_up_table_bits_;
+      table->bucket_table.resize(num_buckets + 1);
+      uint32_t symbol_id = 0;
+      for (uint32_t b = 0; b < num_buckets; ++b) {
+        const uint32_t first_entry = b << table->bucket_shift;
+        while (EntryOffset(symbols[symbol_id]) +
+                   EntryProb(symbols[symbol_id]) <=
+               first_entry) {
+          ++symbol_id;
+        }
+        table->bucket_table[b] = symbol_id;
+      }
+      table->bucket_table[num_buckets] =
+          static_cast<uint32_t>(symbols.size()) - 1;
+    }
+    set_look_up_table(table);
     return true;
   }
 
+  // Returns the look up table built with rans_build_look_up_table().
+  const std::shared_ptr<const RAnsLookUpTable> &look_up_table() const {
+    return table_;
+  }
+
+  // Uses a look up table built by another decoder instead of building a new
+  // one. The table must have been built by a decoder with the same precision
+  // and the same limit on the table size.
+  void set_look_up_table(std::shared_ptr<const RAnsLookUpTable> table) {
+    table_ = std::move(table);
+    const bool use_buckets = !table_->bucket_table.empty();
+    lut_table_ = use_buckets ? nullptr : table_->lut_table.data();
+    bucket_table_ = use_buckets ? table_->bucket_table.data() : nullptr;
+    symbol_table_ =
+        table_->symbol_table.empty() ? nullptr : table_->symbol_table.data();
+    bucket_shift_ = table_->bucket_shift;
+  }
+
  private:
+  // Packs a symbol, its probability and an offset into a single table entry.
+  // The offset is the position of the entry within the range of the symbol in
+  // fused entries of the full table, or the cumulative probability of the
+  // symbol in |symbol_table_|.
+  static inline uint64_t PackEntry(uint32_t symbol, uint32_t prob,
+                                   uint32_t offset) {
+    return (static_cast<uint64_t>(symbol) << (2 * rans_precision_bits_t)) |
+           (static_cast<uint64_t>(prob - 1) << rans_precision_bits_t) | offset;
+  }
+  static inline uint32_t EntrySymbol(uint64_t entry) {
+    return static_cast<uint32_t>(entry >> (2 * rans_precision_bits_t));
+  }
+  static inline uint32_t EntryProb(uint64_t entry) {
+    return static_cast<uint32_t>((entry >> rans_precision_bits_t) &
+                                 (rans_precision - 1)) +
+           1;
+  }
+  static inline uint32_t EntryOffset(uint64_t entry) {
+    return static_cast<uint32_t>(entry & (rans_precision - 1));
+  }
+
   inline void fetch_sym(struct rans_dec_sym *out, uint32_t rem) {
-    uint32_t symbol = lut_table_[rem];
-    out->val = symbol;
-    out->prob = probability_table_[symbol].prob;
-    out->cum_prob = probability_table_[symbol].cum_prob;
+    if (bucket_table_ == nullptr) {
+      const uint32_t entry = lut_table_[rem];
+      if (symbol_table_ == nullptr) {
+        out->val = EntrySymbol(entry);
+        out->prob = EntryProb(entry);
+        out->cum_prob = rem - EntryOffset(entry);
+      } else {
+        const uint64_t symbol = symbol_table_[entry];
+        out->val = EntrySymbol(symbol);
+        out->prob = EntryProb(symbol);
+        out->cum_prob = EntryOffset(symbol);
+      }
+      return;
+    }
+    // Find the last symbol whose cumulative probability is not larger than
+    // |rem| among the symbols overlapping the bucket of |rem|.
+    const uint32_t bucket = rem >> bucket_shift_;
+    uint32_t low = bucket_table_[bucket];
+    uint32_t high = bucket_table_[bucket + 1];
+    while (low < high) {
+      const uint32_t mid = (low + high + 1) / 2;
+      if (EntryOffset(symbol_table_[mid]) <= rem) {
+        low = mid;
+      } else {
+        high = mid - 1;
+      }
+    }
+    const uint64_t entry = symbol_table_[low];
+    out->val = EntrySymbol(entry);
+    out->prob = EntryProb(entry);
+    out->cum_prob = EntryOffset(entry);
+  }
+
+  // Reads one final rANS state stored in front of |*offset| and moves the
+  // |*offset| to the beginning of the state. A non zero return value is an
+  // error.
+  inline int read_state(int *offset, uint32_t *out_state) const {
+    const int end = *offset;
+    if (end < 1) {
+      return 1;
+    }
+    uint32_t state;
+    const unsigned x = buf_[end - 1] >> 6;
+    if (x == 0) {
+      *offset = end - 1;
+      state = buf_[end - 1] & 0x3F;
+    } else if (x == 1) {
+      if (end < 2) {
+        return 1;
+      }
+      *offset = end - 2;
+      state = mem_get_le16(buf_ + end - 2) & 0x3FFF;
+    } else if (x == 2) {
+      if (end < 3) {
+        return 1;
+      }
+      *offset = end - 3;
+      state = mem_get_le24(buf_ + end - 3) & 0x3FFFFF;
+    } else {
+      if (end < 4) {
+        return 1;
+      }
+      *offset = end - 4;
+      state = mem_get_le32(buf_ + end - 4) & 0x3FFFFFFF;
+    }
+    state += l_rans_base;
+    if (state >= l_rans_base * DRACO_ANS_IO_BASE) {
+      return 1;
+    }
+    *out_state = state;
+    return 0;
   }
 
   static constexpr int rans_precision = 1 << rans_precision_bits_t;
   static constexpr int l_rans_base = rans_precision * 4;
-  std::vector<uint32_t> lut_table_;
-  std::vector<rans_sym> probability_table_;
-  AnsDecoder ans_;
+  // Maximum number of symbols that can be stored in the packed table entries.
+  static constexpr uint64_t kMaxNumSymbols =
+      1ull << (64 - 2 * rans_precision_bits_t);
+  // Maximum number of symbols that can be stored in the fused 32-bit entries
+  // of the full table.
+  static constexpr uint64_t kMaxNumFusedSymbols =
+      2 * rans_precision_bits_t < 32 ? 1ull << (32 - 2 * rans_precision_bits_t)
+                                     : 0;
+  std::shared_ptr<const RAnsLookUpTable> table_;
+  // Pointers to the data of |table_|. Only one of |lut_table_| and
+  // |bucket_table_| is set depending on the type of the table.
+  // |symbol_table_| is not set for fused entries.
+  const uint32_t *lut_table_;
+  const uint32_t *bucket_table_;
+  const uint64_t *symbol_table_;
+  int bucket_shift_;
+  const uint8_t *buf_;
+  int buf_offset_;
+  int num_states_;
+  int max_look_up_table_bits_;
+  uint32_t states_[kMaxNumStates];
 };
 
 #undef DRACO_ANS_DIVREM
@@ -0,0 +1,300 @@
+// Copyright 2016 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/entropy/rans_simd_decoding.h"
+
+#ifdef DRACO_X86_SIMD_SUPPORTED
+
+#include <immintrin.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include "draco/compression/entropy/ans.h"
+
+namespace draco {
+
+// All kernels follow the scalar RAnsDecoder::rans_read() exactly. Before a
+// symbol is decoded, its state is renormalized by reading input bytes from
+// the end of the buffer while the state is smaller than |l_rans_base|. The
+// states are renormalized in the order of their ids, so state i reads its
+// bytes right after all bytes consumed by states 0..i-1. For a state |x|:
+//   x < l_rans_base        needs at least one byte.
+//   x < l_rans_base >> 8   needs exactly two bytes (|l_rans_base| is a
+//                          multiple of 256).
+// Any smaller state would need more than two bytes and such input is left to
+// the scalar decoder (it can't happen for valid data).
+
+namespace {
+
+// Minimum number of bytes that must be available in front of the current
+// position for one step of a kernel with |num_states| states. Each state
+// reads at most two bytes and the bytes are fetched with 32-bit loads that
+// end at the last byte read by each state.
+constexpr int MinBytesForStep(int num_states) { return 2 * num_states + 3; }
+
+// Smallest state that can be renormalized with at most two input bytes.
+inline int MinRenormalizableState(int l_rans_base) {
+  return std::max(1, l_rans_base >> 16);
+}
+
+// Returns the low 32 bits of the four 64-bit values in |a| followed by the low
+// 32 bits of the four 64-bit values in |b|.
+DRACO_TARGET_AVX2 inline __m256i PackLow32Avx2(__m256i a, __m256i b) {
+  const __m256 packed = _mm256_shuffle_ps(
+      _mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _MM_SHUFFLE(2, 0, 2, 0));
+  return _mm256_permute4x64_epi64(_mm256_castps_si256(packed),
+                                  _MM_SHUFFLE(3, 1, 2, 0));
+}
+
+}  // namespace
+
+DRACO_TARGET_AVX2 size_t DecodeRAnsSymbolsAvx2(RAnsSimdDecodingState *state,
+                                               uint32_t *out_values,
+                                               size_t num_values) {
+  constexpr int kNumStates = 8;
+  const int l_rans_base = 4 << state->precision_bits;
+  const __m256i l_base = _mm256_set1_epi32(l_rans_base);
+  const __m256i l_base_two_bytes = _mm256_set1_epi32(l_rans_base >> 8);
+  const __m256i min_state =
+      _mm256_set1_epi32(MinRenormalizableState(l_rans_base));
+  const __m256i precision_mask =
+      _mm256_set1_epi32((1 << state->precision_bits) - 1);
+  const __m128i precision_shift = _mm_cvtsi32_si128(state->precision_bits);
+  const __m128i symbol_shift = _mm_cvtsi32_si128(2 * state->precision_bits);
+  const __m256i byte_mask = _mm256_set1_epi32(0xff);
+  const __m256i one = _mm256_set1_epi32(1);
+  const __m256i zero = _mm256_setzero_si256();
+  // Permutations used to shift the lanes by 1, 2 and 4 positions when
+  // computing the prefix sum of the number of bytes read by each state.
+  const __m256i shift_1 = _mm256_setr_epi32(0, 0, 1, 2, 3, 4, 5, 6);
+  const __m256i shift_2 = _mm256_setr_epi32(0, 0, 0, 1, 2, 3, 4, 5);
+  const __m256i shift_4 = _mm256_setr_epi32(0, 0, 0, 0, 0, 1, 2, 3);
+
+  const int *const lut = reinterpret_cast<const int *>(state->lut_table);
+  const long long *const symbols =
+      reinterpret_cast<const long long *>(state->symbol_table);
+  const int *const buf = reinterpret_cast<const int *>(state->buf);
+  int buf_offset = state->buf_offset;
+  __m256i x =
+      _mm256_loadu_si256(reinterpret_cast<const __m256i *>(state->states));
+
+  size_t i = 0;
+  for (; i + kNumStates <= num_values; i += kNumStates) {
+    if (buf_offset < MinBytesForStep(kNumStates)) {
+      break;
+    }
+    // States are always smaller than 2^31 so the signed comparisons are safe.
+    if (_mm256_movemask_epi8(_mm256_cmpgt_epi32(min_state, x)) != 0) {
+      break;
+    }
+    // Renormalization. |need_one| and |need_two| are -1 for states that need
+    // at least one and exactly two bytes respectively.
+    const __m256i need_one = _mm256_cmpgt_epi32(l_base, x);
+    const __m256i need_two = _mm256_cmpgt_epi32(l_base_two_bytes, x);
+    const __m256i count =
+        _mm256_sub_epi32(zero, _mm256_add_epi32(need_one, need_two));
+    __m256i prefix = count;
+    prefix = _mm256_add_epi32(
+        prefix, _mm256_blend_epi32(
+                    _mm256_permutevar8x32_epi32(prefix, shift_1), zero, 0x01));
+    prefix = _mm256_add_epi32(
+        prefix, _mm256_blend_epi32(
+                    _mm256_permutevar8x32_epi32(prefix, shift_2), zero, 0x03));
+    prefix = _mm256_add_epi32(
+        prefix, _mm256_blend_epi32(
+                    _mm256_permutevar8x32_epi32(prefix, shift_4), zero, 0x0f));
+    const int num_bytes_read = _mm256_extract_epi32(prefix, 7);
+    // Offset of the 32-bit word whose most significant byte is the first byte
+    // read by each state.
+    const __m256i word_offset = _mm256_sub_epi32(
+        _mm256_set1_epi32(buf_offset - 4), _mm256_sub_epi32(prefix, count));
+    const __m256i word = _mm256_i32gather_epi32(buf, word_offset, 1);
+    const __m256i first_byte = _mm256_srli_epi32(word, 24);
+    const __m256i second_byte =
+        _mm256_and_si256(_mm256_srli_epi32(word, 16), byte_mask);
+    const __m256i x_one =
+        _mm256_or_si256(_mm256_slli_epi32(x, 8), first_byte);
+    const __m256i x_two =
+        _mm256_or_si256(_mm256_slli_epi32(x_one, 8), second_byte);
+    x = _mm256_blendv_epi8(x, x_one, need_one);
+    x = _mm256_blendv_epi8(x, x_two, need_two);
+    buf_offset -= num_bytes_read;
+
+    // Decoding of the symbols.
+    const __m256i quo = _mm256_srl_epi32(x, precision_shift);
+    const __m256i rem = _mm256_and_si256(x, precision_mask);
+    // See RAnsDecoder::PackEntry() for the layout of the entries.
+    const __m256i entry = _mm256_i32gather_epi32(lut, rem, 4);
+    __m256i offset, prob, symbol;
+    if (symbols == nullptr) {
+      // Fused entries.
+      offset = _mm256_and_si256(entry, precision_mask);
+      prob = _mm256_add_epi32(
+          _mm256_and_si256(_mm256_srl_epi32(entry, precision_shift),
+                           precision_mask),
+          one);
+      symbol = _mm256_srl_epi32(entry, symbol_shift);
+    } else {
+      // The entries are indices of the packed symbols which are 64 bits wide
+      // so each gather loads four of them.
+      const __m256i symbol_lo =
+          _mm256_i32gather_epi64(symbols, _mm256_castsi256_si128(entry), 8);
+      const __m256i symbol_hi = _mm256_i32gather_epi64(
+          symbols, _mm256_extracti128_si256(entry, 1), 8);
+      const __m256i cum_prob = _mm256_and_si256(
+          PackLow32Avx2(symbol_lo, symbol_hi), precision_mask);
+      offset = _mm256_sub_epi32(rem, cum_prob);
+      prob = _mm256_add_epi32(
+          _mm256_and_si256(
+              PackLow32Avx2(_mm256_srl_epi64(symbol_lo, precision_shift),
+                            _mm256_srl_epi64(symbol_hi, precision_shift)),
+              precision_mask),
+          one);
+      symbol = PackLow32Avx2(_mm256_srl_epi64(symbol_lo, symbol_shift),
+                             _mm256_srl_epi64(symbol_hi, symbol_shift));
+    }
+    x = _mm256_add_epi32(_mm256_mullo_epi32(quo, prob), offset);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out_values + i), symbol);
+  }
+  _mm256_storeu_si256(reinterpret_cast<__m256i *>(state->states), x);
+  state->buf_offset = buf_offset;
+  return i;
+}
+
+namespace {
+
+// Loads the 64-bit values from |base| at the first two and at the last two
+// indices stored in |index| into |out_lo| and |out_hi|. SSE4.1 doesn't
+// support gather instructions so the loads are scalar.
+DRACO_TARGET_SSE41 inline void GatherEntriesSse41(const uint64_t *base,
+                                                  __m128i index,
+                                                  __m128i *out_lo,
+                                                  __m128i *out_hi) {
+  *out_lo = _mm_set_epi64x(base[_mm_extract_epi32(index, 1)],
+                           base[_mm_extract_epi32(index, 0)]);
+  *out_hi = _mm_set_epi64x(base[_mm_extract_epi32(index, 3)],
+                           base[_mm_extract_epi32(index, 2)]);
+}
+
+// Returns the low 32 bits of the two 64-bit values in |a| followed by the low
+// 32 bits of the two 64-bit values in |b|.
+DRACO_TARGET_SSE41 inline __m128i PackLow32Sse41(__m128i a, __m128i b) {
+  return _mm_castps_si128(_mm_shuffle_ps(
+      _mm_castsi128_ps(a), _mm_castsi128_ps(b), _MM_SHUFFLE(2, 0, 2, 0)));
+}
+
+// Loads unaligned 32-bit words at byte offsets |index|.
+DRACO_TARGET_SSE41 inline __m128i GatherBytesSse41(const uint8_t *base,
+                                                   __m128i index) {
+  int words[4];
+  memcpy(&words[0], base + _mm_extract_epi32(index, 0), 4);
+  memcpy(&words[1], base + _mm_extract_epi32(index, 1), 4);
+  memcpy(&words[2], base + _mm_extract_epi32(index, 2), 4);
+  memcpy(&words[3], base + _mm_extract_epi32(index, 3), 4);
+  return _mm_loadu_si128(reinterpret_cast<const __m128i *>(words));
+}
+
+}  // namespace
+
+DRACO_TARGET_SSE41 size_t DecodeRAnsSymbolsSse41(RAnsSimdDecodingState *state,
+                                                 uint32_t *out_values,
+                                                 size_t num_values) {
+  constexpr int kNumStates = 4;
+  const int l_rans_base = 4 << state->precision_bits;
+  const __m128i l_base = _mm_set1_epi32(l_rans_base);
+  const __m128i l_base_two_bytes = _mm_set1_epi32(l_rans_base >> 8);
+  const __m128i min_state = _mm_set1_epi32(MinRenormalizableState(l_rans_base));
+  const __m128i precision_mask =
+      _mm_set1_epi32((1 << state->precision_bits) - 1);
+  const __m128i precision_shift = _mm_cvtsi32_si128(state->precision_bits);
+  const __m128i symbol_shift = _mm_cvtsi32_si128(2 * state->precision_bits);
+  const __m128i byte_mask = _mm_set1_epi32(0xff);
+  const __m128i one = _mm_set1_epi32(1);
+  const __m128i zero = _mm_setzero_si128();
+
+  const uint32_t *const lut = state->lut_table;
+  const uint64_t *const symbols = state->symbol_table;
+  const uint8_t *const buf = state->buf;
+  int buf_offset = state->buf_offset;
+  __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(state->states));
+
+  size_t i = 0;
+  for (; i + kNumStates <= num_values; i += kNumStates) {
+    if (buf_offset < MinBytesForStep(kNumStates)) {
+      break;
+    }
+    if (_mm_movemask_epi8(_mm_cmpgt_epi32(min_state, x)) != 0) {
+      break;
+    }
+    // Renormalization (see DecodeRAnsSymbolsAvx2()).
+    const __m128i need_one = _mm_cmpgt_epi32(l_base, x);
+    const __m128i need_two = _mm_cmpgt_epi32(l_base_two_bytes, x);
+    const __m128i count =
+        _mm_sub_epi32(zero, _mm_add_epi32(need_one, need_two));
+    __m128i prefix = _mm_add_epi32(count, _mm_slli_si128(count, 4));
+    prefix = _mm_add_epi32(prefix, _mm_slli_si128(prefix, 8));
+    const int num_bytes_read = _mm_extract_epi32(prefix, 3);
+    const __m128i word_offset = _mm_sub_epi32(_mm_set1_epi32(buf_offset - 4),
+                                              _mm_sub_epi32(prefix, count));
+    const __m128i word = GatherBytesSse41(buf, word_offset);
+    const __m128i first_byte = _mm_srli_epi32(word, 24);
+    const __m128i second_byte =
+        _mm_and_si128(_mm_srli_epi32(word, 16), byte_mask);
+    const __m128i x_one = _mm_or_si128(_mm_slli_epi32(x, 8), first_byte);
+    const __m128i x_two = _mm_or_si128(_mm_slli_epi32(x_one, 8), second_byte);
+    x = _mm_blendv_epi8(x, x_one, need_one);
+    x = _mm_blendv_epi8(x, x_two, need_two);
+    buf_offset -= num_bytes_read;
+
+    // Decoding of the symbols.
+    const __m128i quo = _mm_srl_epi32(x, precision_shift);
+    const __m128i rem = _mm_and_si128(x, precision_mask);
+    const __m128i entry = _mm_setr_epi32(
+        lut[_mm_extract_epi32(rem, 0)], lut[_mm_extract_epi32(rem, 1)],
+        lut[_mm_extract_epi32(rem, 2)], lut[_mm_extract_epi32(rem, 3)]);
+    __m128i offset, prob, symbol;
+    if (symbols == nullptr) {
+      // Fused entries.
+      offset = _mm_and_si128(entry, precision_mask);
+      prob = _mm_add_epi32(
+          _mm_and_si128(_mm_srl_epi32(entry, precision_shift), precision_mask),
+          one);
+      symbol = _mm_srl_epi32(entry, symbol_shift);
+    } else {
+      __m128i symbol_lo, symbol_hi;
+      GatherEntriesSse41(symbols, entry, &symbol_lo, &symbol_hi);
+      const __m128i cum_prob =
+          _mm_and_si128(PackLow32Sse41(symbol_lo, symbol_hi), precision_mask);
+      offset = _mm_sub_epi32(rem, cum_prob);
+      prob = _mm_add_epi32(
+          _mm_and_si128(
+              PackLow32Sse41(_mm_srl_epi64(symbol_lo, precision_shift),
+                             _mm_srl_epi64(symbol_hi, precision_shift)),
+              precision_mask),
+          one);
+      symbol = PackLow32Sse41(_mm_srl_epi64(symbol_lo, symbol_shift),
+                              _mm_srl_epi64(symbol_hi, symbol_shift));
+    }
+    x = _mm_add_epi32(_mm_mullo_epi32(quo, prob), offset);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out_values + i), symbol);
+  }
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(state->states), x);
+  state->buf_offset = buf_offset;
+  return i;
+}
+
+}  // namespace draco
+
+#endif  // DRACO_X86_SIMD_SUPPORTED
@@ -0,0 +1,62 @@
+// Copyright 2016 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_COMPRESSION_ENTROPY_RANS_SIMD_DECODING_H_
+#define DRACO_COMPRESSION_ENTROPY_RANS_SIMD_DECODING_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "draco/core/cpu_features.h"
+
+namespace draco {
+
+// State of an interleaved rANS decoder (see RAnsDecoder in ans.h) that is
+// shared with the SIMD decoding kernels below. |lut_table| is the full look up
+// table of the decoder with 2^|precision_bits| entries. The entries are fused
+// when |symbol_table| is nullptr, otherwise they are indices into
+// |symbol_table|. The kernels update |buf_offset| and |states| so that the
+// decoding can continue with the scalar decoder.
+struct RAnsSimdDecodingState {
+  const uint32_t *lut_table;
+  const uint64_t *symbol_table;
+  int precision_bits;
+  const uint8_t *buf;
+  int buf_offset;
+  uint32_t *states;
+};
+
+#ifdef DRACO_X86_SIMD_SUPPORTED
+
+// Decodes up to |num_values| symbols encoded with 8 interleaved rANS states
+// using AVX2 instructions. All states are advanced at once and the table
+// lookups are done with gathers. Returns the number of decoded symbols which
+// is always a multiple of 8. The kernel stops early close to the end of the
+// encoded data or when a state would need more input than the kernel handles.
+// The remaining symbols must be decoded with the scalar decoder.
+// Must be called only when CpuAvx2Supported() returns true.
+size_t DecodeRAnsSymbolsAvx2(RAnsSimdDecodingState *state,
+                             uint32_t *out_values, size_t num_values);
+
+// Same as above but for data encoded with 4 interleaved rANS states using
+// SSE4.1 instructions. Returns a multiple of 4.
+// Must be called only when CpuSse41Supported() returns true.
+size_t DecodeRAnsSymbolsSse41(RAnsSimdDecodingState *state,
+                              uint32_t *out_values, size_t num_values);
+
+#endif  // DRACO_X86_SIMD_SUPPORTED
+
+}  // namespace draco
+
+#endif  // DRACO_COMPRESSION_ENTROPY_RANS_SIMD_DECODING_H_
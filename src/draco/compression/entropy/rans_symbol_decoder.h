@@ -17,6 +17,7 @@
 
 #include "draco/compression/config/compression_shared.h"
 #include "draco/compression/entropy/rans_symbol_coding.h"
+#include "draco/compression/entropy/rans_table_cache.h"
 #include "draco/core/decoder_buffer.h"
 #include "draco/core/varint_decoding.h"
 #include "draco/draco_features.h"
@@ -30,19 +31,46 @@ namespace draco {
 template <int unique_symbols_bit_length_t>
 class RAnsSymbolDecoder {
  public:
-  RAnsSymbolDecoder() : num_symbols_(0) {}
+  RAnsSymbolDecoder() : num_symbols_(0), table_cache_(nullptr) {}
 
   // Initialize the decoder and decode the probability table.
   bool Create(DecoderBuffer *buffer);
 
   uint32_t num_symbols() const { return num_symbols_; }
 
+  // Limits the size of the rANS look up table to 2^|max_look_up_table_bits|
+  // entries (see RAnsDecoder::set_max_look_up_table_bits()). Must be called
+  // before Create().
+  void set_max_look_up_table_bits(int max_look_up_table_bits) {
+    ans_.set_max_look_up_table_bits(max_look_up_table_bits);
+  }
+
+  // Sets a cache that is used to share the rANS look up tables with other
+  // decoders (can be nullptr). Must be called before Create().
+  void set_table_cache(RAnsTableCache *table_cache) {
+    table_cache_ = table_cache;
+  }
+
   // Starts decoding from the buffer. The buffer will be advanced past the
   // encoded data after this call.
   bool StartDecoding(DecoderBuffer *buffer);
   uint32_t DecodeSymbol() { return ans_.rans_read(); }
   void EndDecoding();
 
+  // Starts decoding of data encoded with |num_states| interleaved rANS states
+  // (see RAnsSymbolEncoder::StartInterleavedEncoding()). Each symbol must be
+  // then decoded with DecodeSymbol(state_id) using the same state that was
+  // used to encode it.
+  bool StartInterleavedDecoding(DecoderBuffer *buffer, int num_states);
+  uint32_t DecodeSymbol(int state_id) { return ans_.rans_read(state_id); }
+
+  // Decodes |num_values| symbols into |out_values|. For interleaved data,
+  // symbol i is decoded with the state i % num_states. This is faster than
+  // decoding the symbols one by one.
+  void DecodeSymbols(uint32_t *out_values, size_t num_values) {
+    ans_.rans_read_symbols(out_values, num_values);
+  }
+
  private:
   static constexpr int rans_precision_bits_ =
       ComputeRAnsPrecisionFromUniqueSymbolsBitLength(
@@ -52,6 +80,7 @@ class RAnsSymbolDecoder {
   std::vector<uint32_t> probability_table_;
   uint32_t num_symbols_;
   RAnsDecoder<rans_precision_bits_> ans_;
+  RAnsTableCache *table_cache_;
 };
 
 template <int unique_symbols_bit_length_t>
@@ -61,6 +90,10 @@ bool RAnsSymbolDecoder<unique_symbols_bit_length_t>::Create(
   if (buffer->bitstream_version() == 0) {
     return false;
   }
+  // Start of the serialized probability table that is used to identify the
+  // table in the |table_cache_|.
+  const uint8_t *const table_data =
+      reinterpret_cast<const uint8_t *>(buffer->data_head());
   // Decode the number of alphabet symbols.
 #ifdef DRACO_BACKWARDS_COMPATIBILITY_SUPPORTED
   if (buffer->bitstream_version() < DRACO_BITSTREAM_VERSION(2, 0)) {
@@ -117,6 +150,23 @@ bool RAnsSymbolDecoder<unique_symbols_bit_length_t>::Create(
       probability_table_[i] = prob;
     }
   }
+  if (table_cache_ != nullptr) {
+    const size_t table_size =
+        reinterpret_cast<const uint8_t *>(buffer->data_head()) - table_data;
+    std::shared_ptr<const RAnsLookUpTable> table =
+        table_cache_->Find(rans_precision_bits_, ans_.max_look_up_table_bits(),
+                           table_data, table_size);
+    if (table != nullptr) {
+      ans_.set_look_up_table(std::move(table));
+      return true;
+    }
+    if (!ans_.rans_build_look_up_table(&probability_table_[0], num_symbols_)) {
+      return false;
+    }
+    table_cache_->Insert(rans_precision_bits_, ans_.max_look_up_table_bits(),
+                         table_data, table_size, ans_.look_up_table());
+    return true;
+  }
   if (!ans_.rans_build_look_up_table(&probability_table_[0], num_symbols_)) {
     return false;
   }
@@ -126,6 +176,12 @@ bool RAnsSymbolDecoder<unique_symbols_bit_length_t>::Create(
 template <int unique_symbols_bit_length_t>
 bool RAnsSymbolDecoder<unique_symbols_bit_length_t>::StartDecoding(
     DecoderBuffer *buffer) {
+  return StartInterleavedDecoding(buffer, 1);
+}
+
+template <int unique_symbols_bit_length_t>
+bool RAnsSymbolDecoder<unique_symbols_bit_length_t>::StartInterleavedDecoding(
+    DecoderBuffer *buffer, int num_states) {
   uint64_t bytes_encoded;
   // Decode the number of bytes encoded by the encoder.
 #ifdef DRACO_BACKWARDS_COMPATIBILITY_SUPPORTED
@@ -141,14 +197,15 @@ bool RAnsSymbolDecoder<unique_symbols_bit_length_t>::StartDecoding(
       return false;
     }
   }
-  if (bytes_encoded > static_cast<uint64_t>(buffer->remaining_size())) {
+  if (!buffer->CheckRemainingSize(bytes_encoded)) {
     return false;
   }
   const uint8_t *const data_head =
       reinterpret_cast<const uint8_t *>(buffer->data_head());
   // Advance the buffer past the rANS data.
   buffer->Advance(bytes_encoded);
-  if (ans_.read_init(data_head, static_cast<int>(bytes_encoded)) != 0) {
+  if (ans_.read_init(data_head, static_cast<int>(bytes_encoded), num_states) !=
+      0) {
     return false;
   }
   return true;
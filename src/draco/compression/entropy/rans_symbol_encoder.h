@@ -46,6 +46,13 @@ class RAnsSymbolEncoder {
   }
   void EndEncoding(EncoderBuffer *buffer);
 
+  // Starts encoding of symbols using |num_states| interleaved rANS states.
+  // Each symbol must be then encoded with EncodeSymbol(symbol, state_id).
+  void StartInterleavedEncoding(EncoderBuffer *buffer, int num_states);
+  void EncodeSymbol(uint32_t symbol, int state_id) {
+    ans_.rans_write(state_id, &probability_table_[symbol]);
+  }
+
   // rANS requires to encode the input symbols in the reverse order.
   static constexpr bool needs_reverse_encoding() { return true; }
 
@@ -253,15 +260,22 @@ bool RAnsSymbolEncoder<unique_symbols_bit_length_t>::EncodeTable(
 template <int unique_symbols_bit_length_t>
 void RAnsSymbolEncoder<unique_symbols_bit_length_t>::StartEncoding(
     EncoderBuffer *buffer) {
-  // Allocate extra storage just in case.
-  const uint64_t required_bits = 2 * num_expected_bits_ + 32;
+  StartInterleavedEncoding(buffer, 1);
+}
+
+template <int unique_symbols_bit_length_t>
+void RAnsSymbolEncoder<unique_symbols_bit_length_t>::StartInterleavedEncoding(
+    EncoderBuffer *buffer, int num_states) {
+  // Allocate extra storage just in case (including space for the final state
+  // of each rANS state).
+  const uint64_t required_bits = 2 * num_expected_bits_ + 32 * num_states;
 
   buffer_offset_ = buffer->size();
   const int64_t required_bytes = (required_bits + 7) / 8;
   buffer->Resize(buffer_offset_ + required_bytes + sizeof(buffer_offset_));
   uint8_t *const data =
       reinterpret_cast<uint8_t *>(const_cast<char *>(buffer->data()));
-  ans_.write_init(data + buffer_offset_);
+  ans_.write_init(data + buffer_offset_, num_states);
 }
 
 template <int unique_symbols_bit_length_t>
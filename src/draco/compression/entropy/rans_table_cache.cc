@@ -0,0 +1,130 @@
+// Copyright 2016 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/entropy/rans_table_cache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+#include "draco/core/hash_utils.h"
+
+namespace draco {
+
+std::shared_ptr<const RAnsLookUpTable> RAnsTableCache::Find(
+    int precision_bits, int max_look_up_table_bits,
+    const uint8_t *serialized_table, size_t size) {
+  const uint64_t hash = ComputeHash(precision_bits, max_look_up_table_bits,
+                                    serialized_table, size);
+  std::lock_guard<std::mutex> lock(mutex_);
+  const EntryIterator it = FindEntry(hash, precision_bits,
+                                     max_look_up_table_bits, serialized_table,
+                                     size);
+  if (it == entries_.end()) {
+    return nullptr;
+  }
+  // Mark the entry as the most recently used one.
+  entries_.splice(entries_.begin(), entries_, it);
+  return it->table;
+}
+
+void RAnsTableCache::Insert(int precision_bits, int max_look_up_table_bits,
+                            const uint8_t *serialized_table, size_t size,
+                            std::shared_ptr<const RAnsLookUpTable> table) {
+  if (max_num_tables_ <= 0) {
+    return;
+  }
+  const uint64_t hash = ComputeHash(precision_bits, max_look_up_table_bits,
+                                    serialized_table, size);
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (FindEntry(hash, precision_bits, max_look_up_table_bits, serialized_table,
+                size) != entries_.end()) {
+    // The table was already added, e.g. by another thread.
+    return;
+  }
+  if (entries_.size() >= static_cast<size_t>(max_num_tables_)) {
+    EvictLeastRecentlyUsedEntry();
+  }
+  Entry entry;
+  entry.hash = hash;
+  entry.precision_bits = precision_bits;
+  entry.max_look_up_table_bits = max_look_up_table_bits;
+  entry.serialized_table.assign(
+      reinterpret_cast<const char *>(serialized_table), size);
+  entry.table = std::move(table);
+  entries_.push_front(std::move(entry));
+  entries_by_hash_[hash].push_back(entries_.begin());
+}
+
+int RAnsTableCache::num_tables() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return static_cast<int>(entries_.size());
+}
+
+void RAnsTableCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_by_hash_.clear();
+  entries_.clear();
+}
+
+RAnsTableCache::EntryIterator RAnsTableCache::FindEntry(
+    uint64_t hash, int precision_bits, int max_look_up_table_bits,
+    const uint8_t *serialized_table, size_t size) {
+  const auto it = entries_by_hash_.find(hash);
+  if (it == entries_by_hash_.end()) {
+    return entries_.end();
+  }
+  // Compare the whole key to rule out hash collisions.
+  for (const EntryIterator &entry : it->second) {
+    if (EntryMatches(*entry, precision_bits, max_look_up_table_bits,
+                     serialized_table, size)) {
+      return entry;
+    }
+  }
+  return entries_.end();
+}
+
+void RAnsTableCache::EvictLeastRecentlyUsedEntry() {
+  const EntryIterator last = std::prev(entries_.end());
+  const auto it = entries_by_hash_.find(last->hash);
+  std::vector<EntryIterator> &entries = it->second;
+  entries.erase(std::find(entries.begin(), entries.end(), last));
+  if (entries.empty()) {
+    entries_by_hash_.erase(it);
+  }
+  entries_.erase(last);
+}
+
+bool RAnsTableCache::EntryMatches(const Entry &entry, int precision_bits,
+                                  int max_look_up_table_bits,
+                                  const uint8_t *serialized_table,
+                                  size_t size) {
+  return entry.precision_bits == precision_bits &&
+         entry.max_look_up_table_bits == max_look_up_table_bits &&
+         entry.serialized_table.size() == size &&
+         memcmp(entry.serialized_table.data(), serialized_table, size) == 0;
+}
+
+uint64_t RAnsTableCache::ComputeHash(int precision_bits,
+                                     int max_look_up_table_bits,
+                                     const uint8_t *serialized_table,
+                                     size_t size) {
+  const uint64_t table_hash = FingerprintString(
+      reinterpret_cast<const char *>(serialized_table), size);
+  return HashCombine(
+      table_hash, static_cast<uint64_t>(precision_bits << 8 |
+                                        max_look_up_table_bits));
+}
+
+}  // namespace draco
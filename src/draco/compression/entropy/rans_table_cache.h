@@ -0,0 +1,110 @@
+// Copyright 2016 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_COMPRESSION_ENTROPY_RANS_TABLE_CACHE_H_
+#define DRACO_COMPRESSION_ENTROPY_RANS_TABLE_CACHE_H_
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "draco/compression/entropy/ans.h"
+
+namespace draco {
+
+// Cache of rANS look up tables that can be shared by multiple symbol decoders
+// (see RAnsSymbolDecoder). Building of a look up table can be expensive
+// compared to the decoding of a small number of symbols, for example when
+// many small meshes encoded with the same settings are decoded. With the
+// cache, decoders that read the same serialized probability table reuse the
+// look up table built by the first decoder instead of building a new one.
+//
+// The tables are identified by the serialized probability table data and by
+// the parameters of the decoder that built them. When the cache is full, the
+// least recently used table is evicted to make room for a new one. The cache
+// can be accessed from multiple threads at the same time.
+class RAnsTableCache {
+ public:
+  // Default maximum number of tables stored in the cache.
+  static constexpr int kDefaultMaxNumTables = 256;
+
+  RAnsTableCache() : RAnsTableCache(kDefaultMaxNumTables) {}
+
+  // Creates a cache that stores at most |max_num_tables| tables.
+  explicit RAnsTableCache(int max_num_tables)
+      : max_num_tables_(max_num_tables) {}
+
+  // Returns a table that was built from the |serialized_table| data of
+  // |size| bytes by a decoder with |precision_bits| and
+  // |max_look_up_table_bits|, or nullptr if the table is not in the cache.
+  // The returned table becomes the most recently used one.
+  std::shared_ptr<const RAnsLookUpTable> Find(int precision_bits,
+                                              int max_look_up_table_bits,
+                                              const uint8_t *serialized_table,
+                                              size_t size);
+
+  // Adds a |table| built from the |serialized_table| data to the cache,
+  // evicting the least recently used table when the cache is full. See Find()
+  // for more details about the parameters.
+  void Insert(int precision_bits, int max_look_up_table_bits,
+              const uint8_t *serialized_table, size_t size,
+              std::shared_ptr<const RAnsLookUpTable> table);
+
+  // Returns the number of tables stored in the cache.
+  int num_tables() const;
+
+  // Removes all tables from the cache.
+  void Clear();
+
+ private:
+  struct Entry {
+    uint64_t hash;
+    int precision_bits;
+    int max_look_up_table_bits;
+    std::string serialized_table;
+    std::shared_ptr<const RAnsLookUpTable> table;
+  };
+
+  // Returns true when the |entry| has the given key.
+  static bool EntryMatches(const Entry &entry, int precision_bits,
+                           int max_look_up_table_bits,
+                           const uint8_t *serialized_table, size_t size);
+  static uint64_t ComputeHash(int precision_bits, int max_look_up_table_bits,
+                              const uint8_t *serialized_table, size_t size);
+
+  typedef std::list<Entry>::iterator EntryIterator;
+
+  // Returns the entry with the given key or entries_.end() if there is none.
+  EntryIterator FindEntry(uint64_t hash, int precision_bits,
+                          int max_look_up_table_bits,
+                          const uint8_t *serialized_table, size_t size);
+
+  // Removes the least recently used entry from the cache.
+  void EvictLeastRecentlyUsedEntry();
+
+  const int max_num_tables_;
+  // All entries ordered from the most to the least recently used one.
+  std::list<Entry> entries_;
+  // Entries indexed by the hash of their key. Multiple entries with the same
+  // hash are stored in a vector.
+  std::unordered_map<uint64_t, std::vector<EntryIterator>> entries_by_hash_;
+  mutable std::mutex mutex_;
+};
+
+}  // namespace draco
+
+#endif  // DRACO_COMPRESSION_ENTROPY_RANS_TABLE_CACHE_H_
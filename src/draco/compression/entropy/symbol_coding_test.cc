@@ -12,7 +12,10 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 //
+#include <cstring>
+
 #include "draco/compression/config/compression_shared.h"
+#include "draco/compression/entropy/ans.h"
 #include "draco/compression/entropy/symbol_decoding.h"
 #include "draco/compression/entropy/symbol_encoding.h"
 #include "draco/core/bit_utils.h"
@@ -90,6 +93,208 @@ TEST_F(SymbolCodingTest, TestManyNumbers) {
   }
 }
 
+TEST_F(SymbolCodingTest, TestInterleavedStates) {
+  // This test verifies that symbols encoded with interleaved rANS states are
+  // decoded correctly for all supported numbers of states and for inputs that
+  // are not a multiple of the number of states.
+  for (const int num_states : {4, 8}) {
+    for (const int num_values : {1, 3, 8, 13, 1000, 4097}) {
+      std::vector<uint32_t> in_values(num_values);
+      for (int i = 0; i < num_values; ++i) {
+        in_values[i] = (i * 7919) % 37;
+      }
+      Options options;
+      ASSERT_TRUE(SetSymbolEncodingInterleavedStates(&options, num_states));
+      SetSymbolEncodingMethod(&options, SYMBOL_CODING_INTERLEAVED);
+      EncoderBuffer eb;
+      ASSERT_TRUE(
+          EncodeSymbols(in_values.data(), num_values, 1, &options, &eb));
+      ASSERT_EQ(eb.data()[0], SYMBOL_CODING_INTERLEAVED);
+
+      std::vector<uint32_t> out_values(num_values);
+      DecoderBuffer db;
+      db.Init(eb.data(), eb.size());
+      db.set_bitstream_version(bitstream_version_);
+      ASSERT_TRUE(DecodeSymbols(num_values, 1, &db, &out_values[0]));
+      ASSERT_EQ(in_values, out_values);
+      ASSERT_EQ(db.remaining_size(), 0);
+    }
+  }
+  Options options;
+  ASSERT_FALSE(SetSymbolEncodingInterleavedStates(&options, 3));
+}
+
+TEST_F(SymbolCodingTest, TestInterleavedStatesLargeAlphabet) {
+  // Tests interleaved rANS states with a large skewed alphabet that results in
+  // a high rANS precision and in states that need to be renormalized with
+  // multiple bytes. This covers the batch decoding of symbols.
+  const int num_values = 100003;
+  std::vector<uint32_t> in_values(num_values);
+  for (int i = 0; i < num_values; ++i) {
+    // Mix long runs of a frequent symbol with rare large symbols.
+    in_values[i] = (i % 97 < 60) ? 0 : (i * 7919) % 20011;
+  }
+  for (const int num_states : {4, 8}) {
+    Options options;
+    ASSERT_TRUE(SetSymbolEncodingInterleavedStates(&options, num_states));
+    SetSymbolEncodingMethod(&options, SYMBOL_CODING_INTERLEAVED);
+    EncoderBuffer eb;
+    ASSERT_TRUE(EncodeSymbols(in_values.data(), num_values, 1, &options, &eb));
+
+    std::vector<uint32_t> out_values(num_values);
+    DecoderBuffer db;
+    db.Init(eb.data(), eb.size());
+    db.set_bitstream_version(bitstream_version_);
+    ASSERT_TRUE(DecodeSymbols(num_values, 1, &db, &out_values[0]));
+    ASSERT_EQ(in_values, out_values);
+  }
+}
+
+TEST_F(SymbolCodingTest, TestLimitedLookUpTable) {
+  // Tests that symbols are decoded correctly when the size of the rANS look up
+  // tables is limited to fewer entries than the precision of the coder.
+  const int num_values = 20000;
+  std::vector<uint32_t> in_values(num_values);
+  for (int i = 0; i < num_values; ++i) {
+    in_values[i] = (i % 7 < 3) ? i % 3 : (i * 7919) % 5003;
+  }
+  for (const SymbolCodingMethod method :
+       {SYMBOL_CODING_RAW, SYMBOL_CODING_TAGGED, SYMBOL_CODING_INTERLEAVED}) {
+    Options options;
+    ASSERT_TRUE(SetSymbolEncodingInterleavedStates(&options, 8));
+    SetSymbolEncodingMethod(&options, method);
+    EncoderBuffer eb;
+    ASSERT_TRUE(EncodeSymbols(in_values.data(), num_values, 1, &options, &eb));
+
+    for (const int max_bits : {8, 10, 32}) {
+      DecoderOptions decoder_options;
+      decoder_options.SetGlobalInt("rans_max_look_up_table_bits", max_bits);
+      std::vector<uint32_t> out_values(num_values);
+      DecoderBuffer db;
+      db.Init(eb.data(), eb.size());
+      db.set_bitstream_version(bitstream_version_);
+      ASSERT_TRUE(DecodeSymbols(num_values, 1, &decoder_options, &db,
+                                &out_values[0]));
+      ASSERT_EQ(in_values, out_values);
+    }
+  }
+}
+
+TEST_F(SymbolCodingTest, TestTableCache) {
+  // Tests that the rANS look up tables are shared through the table cache set
+  // in the DecoderOptions.
+  const int num_values = 5000;
+  std::vector<uint32_t> in_values_a(num_values);
+  std::vector<uint32_t> in_values_b(num_values);
+  for (int i = 0; i < num_values; ++i) {
+    in_values_a[i] = (i * 7919) % 1009;
+    in_values_b[i] = (i * 7919) % 31;
+  }
+  Options options;
+  SetSymbolEncodingMethod(&options, SYMBOL_CODING_RAW);
+  EncoderBuffer eb_a, eb_b;
+  ASSERT_TRUE(
+      EncodeSymbols(in_values_a.data(), num_values, 1, &options, &eb_a));
+  ASSERT_TRUE(
+      EncodeSymbols(in_values_b.data(), num_values, 1, &options, &eb_b));
+
+  std::shared_ptr<RAnsTableCache> cache(new RAnsTableCache());
+  DecoderOptions decoder_options;
+  decoder_options.SetRAnsTableCache(cache);
+  const auto decode = [&](const EncoderBuffer &eb,
+                          const std::vector<uint32_t> &in_values) {
+    std::vector<uint32_t> out_values(num_values);
+    DecoderBuffer db;
+    db.Init(eb.data(), eb.size());
+    db.set_bitstream_version(bitstream_version_);
+    ASSERT_TRUE(
+        DecodeSymbols(num_values, 1, &decoder_options, &db, &out_values[0]));
+    ASSERT_EQ(in_values, out_values);
+  };
+  for (int i = 0; i < 3; ++i) {
+    decode(eb_a, in_values_a);
+    ASSERT_EQ(cache->num_tables(), 1);
+  }
+  decode(eb_b, in_values_b);
+  ASSERT_EQ(cache->num_tables(), 2);
+
+  // Tables with a limited size are stored separately.
+  decoder_options.SetGlobalInt("rans_max_look_up_table_bits", 10);
+  decode(eb_a, in_values_a);
+  decode(eb_a, in_values_a);
+  ASSERT_EQ(cache->num_tables(), 3);
+
+  cache->Clear();
+  ASSERT_EQ(cache->num_tables(), 0);
+}
+
+TEST_F(SymbolCodingTest, TestLookUpTableSize) {
+  // Tests that the full rANS look up tables use 32 bits per entry, with fused
+  // entries for small alphabets and 12-bit precision.
+  std::vector<uint32_t> probs(256, (1 << 12) / 256);
+  RAnsDecoder<12> decoder_12;
+  ASSERT_TRUE(decoder_12.rans_build_look_up_table(probs.data(), probs.size()));
+  const RAnsLookUpTable &table_12 = *decoder_12.look_up_table();
+  ASSERT_EQ(table_12.lut_table.size() * sizeof(table_12.lut_table[0]),
+            4u << 12);
+  ASSERT_TRUE(table_12.symbol_table.empty());
+
+  // The default 20-bit precision table takes 4 MB and the symbols are stored
+  // separately.
+  probs.assign(5000, (1 << 20) / 5000);
+  probs[0] += (1 << 20) % 5000;
+  RAnsDecoder<20> decoder_20;
+  ASSERT_TRUE(decoder_20.rans_build_look_up_table(probs.data(), probs.size()));
+  const RAnsLookUpTable &table_20 = *decoder_20.look_up_table();
+  ASSERT_EQ(table_20.lut_table.size() * sizeof(table_20.lut_table[0]),
+            4u << 20);
+  ASSERT_EQ(table_20.symbol_table.size(), probs.size());
+
+  // Limited tables don't store the full look up table.
+  RAnsDecoder<20> limited_decoder_20;
+  limited_decoder_20.set_max_look_up_table_bits(10);
+  ASSERT_TRUE(
+      limited_decoder_20.rans_build_look_up_table(probs.data(), probs.size()));
+  const RAnsLookUpTable &limited_table_20 =
+      *limited_decoder_20.look_up_table();
+  ASSERT_TRUE(limited_table_20.lut_table.empty());
+  ASSERT_EQ(limited_table_20.bucket_table.size(), (1u << 10) + 1);
+}
+
+TEST_F(SymbolCodingTest, TestTableCacheEviction) {
+  // This test verifies that a full RAnsTableCache evicts the least recently
+  // used table when a new table is added.
+  RAnsTableCache cache(2);
+  const uint8_t keys[3] = {1, 2, 3};
+  std::shared_ptr<const RAnsLookUpTable> tables[3];
+  for (int i = 0; i < 3; ++i) {
+    tables[i].reset(new RAnsLookUpTable());
+  }
+  cache.Insert(12, 0, &keys[0], 1, tables[0]);
+  cache.Insert(12, 0, &keys[1], 1, tables[1]);
+  ASSERT_EQ(cache.num_tables(), 2);
+
+  // Use the first table so that the second one is the least recently used.
+  ASSERT_EQ(cache.Find(12, 0, &keys[0], 1), tables[0]);
+  cache.Insert(12, 0, &keys[2], 1, tables[2]);
+  ASSERT_EQ(cache.num_tables(), 2);
+  ASSERT_EQ(cache.Find(12, 0, &keys[0], 1), tables[0]);
+  ASSERT_EQ(cache.Find(12, 0, &keys[1], 1), nullptr);
+  ASSERT_EQ(cache.Find(12, 0, &keys[2], 1), tables[2]);
+
+  // Keep filling the cache well past its limit.
+  std::vector<uint8_t> key(4);
+  for (int i = 0; i < 100; ++i) {
+    memcpy(key.data(), &i, sizeof(i));
+    cache.Insert(12, 0, key.data(), key.size(),
+                 std::make_shared<const RAnsLookUpTable>());
+    ASSERT_EQ(cache.num_tables(), 2);
+    ASSERT_NE(cache.Find(12, 0, key.data(), key.size()), nullptr);
+  }
+  ASSERT_EQ(cache.Find(12, 0, &keys[0], 1), nullptr);
+  ASSERT_EQ(cache.Find(12, 0, &keys[2], 1), nullptr);
+}
+
 TEST_F(SymbolCodingTest, TestEmpty) {
   // This test verifies that SymbolCoding successfully encodes an empty array.
   EncoderBuffer eb;
@@ -23,14 +23,23 @@ namespace draco {
 
 template <template <int> class SymbolDecoderT>
 bool DecodeTaggedSymbols(uint32_t num_values, int num_components,
+                         const DecoderOptions *options,
                          DecoderBuffer *src_buffer, uint32_t *out_values);
 
 template <template <int> class SymbolDecoderT>
-bool DecodeRawSymbols(uint32_t num_values, DecoderBuffer *src_buffer,
+bool DecodeRawSymbols(uint32_t num_values, int num_states,
+                      const DecoderOptions *options, DecoderBuffer *src_buffer,
                       uint32_t *out_values);
 
 bool DecodeSymbols(uint32_t num_values, int num_components,
                    DecoderBuffer *src_buffer, uint32_t *out_values) {
+  return DecodeSymbols(num_values, num_components, nullptr, src_buffer,
+                       out_values);
+}
+
+bool DecodeSymbols(uint32_t num_values, int num_components,
+                   const DecoderOptions *options, DecoderBuffer *src_buffer,
+                   uint32_t *out_values) {
   if (num_values == 0) {
     return true;
   }
@@ -40,20 +49,47 @@ bool DecodeSymbols(uint32_t num_values, int num_components,
     return false;
   }
   if (scheme == SYMBOL_CODING_TAGGED) {
-    return DecodeTaggedSymbols<RAnsSymbolDecoder>(num_values, num_components,
-                                                  src_buffer, out_values);
+    return DecodeTaggedSymbols<RAnsSymbolDecoder>(
+        num_values, num_components, options, src_buffer, out_values);
   } else if (scheme == SYMBOL_CODING_RAW) {
-    return DecodeRawSymbols<RAnsSymbolDecoder>(num_values, src_buffer,
-                                               out_values);
+    return DecodeRawSymbols<RAnsSymbolDecoder>(num_values, 1, options,
+                                               src_buffer, out_values);
+  } else if (scheme == SYMBOL_CODING_INTERLEAVED) {
+    uint8_t num_states;
+    if (!src_buffer->Decode(&num_states)) {
+      return false;
+    }
+    if (num_states != 4 && num_states != 8) {
+      return false;
+    }
+    return DecodeRawSymbols<RAnsSymbolDecoder>(num_values, num_states, options,
+                                               src_buffer, out_values);
   }
   return false;
 }
 
+// Configures a symbol decoder using the decoder |options| (can be nullptr).
+template <class SymbolDecoderT>
+void ApplySymbolDecodingOptions(const DecoderOptions *options,
+                                SymbolDecoderT *decoder) {
+  if (options == nullptr) {
+    return;
+  }
+  const int max_look_up_table_bits =
+      options->GetGlobalInt("rans_max_look_up_table_bits", 0);
+  if (max_look_up_table_bits > 0) {
+    decoder->set_max_look_up_table_bits(max_look_up_table_bits);
+  }
+  decoder->set_table_cache(options->GetRAnsTableCache());
+}
+
 template <template <int> class SymbolDecoderT>
 bool DecodeTaggedSymbols(uint32_t num_values, int num_components,
+                         const DecoderOptions *options,
                          DecoderBuffer *src_buffer, uint32_t *out_values) {
   // Decode the encoded data.
   SymbolDecoderT<5> tag_decoder;
+  ApplySymbolDecodingOptions(options, &tag_decoder);
   if (!tag_decoder.Create(src_buffer)) {
     return false;
   }
@@ -88,9 +124,11 @@ bool DecodeTaggedSymbols(uint32_t num_values, int num_components,
 }
 
 template <class SymbolDecoderT>
-bool DecodeRawSymbolsInternal(uint32_t num_values, DecoderBuffer *src_buffer,
-                              uint32_t *out_values) {
+bool DecodeRawSymbolsInternal(uint32_t num_values, int num_states,
+                              const DecoderOptions *options,
+                              DecoderBuffer *src_buffer, uint32_t *out_values) {
   SymbolDecoderT decoder;
+  ApplySymbolDecodingOptions(options, &decoder);
   if (!decoder.Create(src_buffer)) {
     return false;
   }
@@ -99,20 +137,21 @@ bool DecodeRawSymbolsInternal(uint32_t num_values, DecoderBuffer *src_buffer,
     return false;  // Wrong number of symbols.
   }
 
-  if (!decoder.StartDecoding(src_buffer)) {
+  if (num_states > 1) {
+    if (!decoder.StartInterleavedDecoding(src_buffer, num_states)) {
+      return false;
+    }
+  } else if (!decoder.StartDecoding(src_buffer)) {
     return false;
   }
-  for (uint32_t i = 0; i < num_values; ++i) {
-    // Decode a symbol into the value.
-    const uint32_t value = decoder.DecodeSymbol();
-    out_values[i] = value;
-  }
+  decoder.DecodeSymbols(out_values, num_values);
   decoder.EndDecoding();
   return true;
 }
 
 template <template <int> class SymbolDecoderT>
-bool DecodeRawSymbols(uint32_t num_values, DecoderBuffer *src_buffer,
+bool DecodeRawSymbols(uint32_t num_values, int num_states,
+                      const DecoderOptions *options, DecoderBuffer *src_buffer,
                       uint32_t *out_values) {
   uint8_t max_bit_length;
   if (!src_buffer->Decode(&max_bit_length)) {
@@ -120,59 +159,59 @@ bool DecodeRawSymbols(uint32_t num_values, DecoderBuffer *src_buffer,
   }
   switch (max_bit_length) {
     case 1:
-      return DecodeRawSymbolsInternal<SymbolDecoderT<1>>(num_values, src_buffer,
-                                                         out_values);
+      return DecodeRawSymbolsInternal<SymbolDecoderT<1>>(
+          num_values, num_states, options, src_buffer, out_values);
     case 2:
-      return DecodeRawSymbolsInternal<SymbolDecoderT<2>>(num_values, src_buffer,
-                                                         out_values);
+      return DecodeRawSymbolsInternal<SymbolDecoderT<2>>(
+          num_values, num_states, options, src_buffer, out_values);
     case 3:
-      return DecodeRawSymbolsInternal<SymbolDecoderT<3>>(num_values, src_buffer,
-                                                         out_values);
+      return DecodeRawSymbolsInternal<SymbolDecoderT<3>>(
+          num_values, num_states, options, src_buffer, out_values);
     case 4:
-      return DecodeRawSymbolsInternal<SymbolDecoderT<4>>(num_values, src_buffer,
-                                                         out_values);
+      return DecodeRawSymbolsInternal<SymbolDecoderT<4>>(
+          num_values, num_states, options, src_buffer, out_values);
     case 5:
-      return DecodeRawSymbolsInternal<SymbolDecoderT<5>>(num_values, src_buffer,
-                                                         out_values);
+      return DecodeRawSymbolsInternal<SymbolDecoderT<5>>(
+          num_values, num_states, options, src_buffer, out_values);
     case 6:
-      return DecodeRawSymbolsInternal<SymbolDecoderT<6>>(num_values, src_buffer,
-                                                         out_values);
+      return DecodeRawSymbolsInternal<SymbolDecoderT<6>>(
+          num_values, num_states, options, src_buffer, out_values);
     case 7:
-      return DecodeRawSymbolsInternal<SymbolDecoderT<7>>(num_values, src_buffer,
-                                                         out_values);
+      return DecodeRawSymbolsInternal<SymbolDecoderT<7>>(
+          num_values, num_states, options, src_buffer, out_values);
     case 8:
-      return DecodeRawSymbolsInternal<SymbolDecoderT<8>>(num_values, src_buffer,
-                                                         out_values);
+      return DecodeRawSymbolsInternal<SymbolDecoderT<8>>(
+          num_values, num_states, options, src_buffer, out_values);
     case 9:
-      return DecodeRawSymbolsInternal<SymbolDecoderT<9>>(num_values, src_buffer,
-                                                         out_values);
+      return DecodeRawSymbolsInternal<SymbolDecoderT<9>>(
+          num_values, num_states, options, src_buffer, out_values);
     case 10:
       return DecodeRawSymbolsInternal<SymbolDecoderT<10>>(
-          num_values, src_buffer, out_values);
+          num_values, num_states, options, src_buffer, out_values);
     case 11:
       return DecodeRawSymbolsInternal<SymbolDecoderT<11>>(
-          num_values, src_buffer, out_values);
+          num_values, num_states, options, src_buffer, out_values);
     case 12:
       return DecodeRawSymbolsInternal<SymbolDecoderT<12>>(
-          num_values, src_buffer, out_values);
+          num_values, num_states, options, src_buffer, out_values);
     case 13:
       return DecodeRawSymbolsInternal<SymbolDecoderT<13>>(
-          num_values, src_buffer, out_values);
+          num_values, num_states, options, src_buffer, out_values);
     case 14:
       return DecodeRawSymbolsInternal<SymbolDecoderT<14>>(
-          num_values, src_buffer, out_values);
+          num_values, num_states, options, src_buffer, out_values);
     case 15:
       return DecodeRawSymbolsInternal<SymbolDecoderT<15>>(
-          num_values, src_buffer, out_values);
+          num_values, num_states, options, src_buffer, out_values);
     case 16:
       return DecodeRawSymbolsInternal<SymbolDecoderT<16>>(
-          num_values, src_buffer, out_values);
+          num_values, num_states, options, src_buffer, out_values);
     case 17:
       return DecodeRawSymbolsInternal<SymbolDecoderT<17>>(
-          num_values, src_buffer, out_values);
+          num_values, num_states, options, src_buffer, out_values);
     case 18:
       return DecodeRawSymbolsInternal<SymbolDecoderT<18>>(
-          num_values, src_buffer, out_values);
+          num_values, num_states, options, src_buffer, out_values);
     default:
       return false;
   }
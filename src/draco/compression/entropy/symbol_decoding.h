@@ -15,6 +15,7 @@
 #ifndef DRACO_COMPRESSION_ENTROPY_SYMBOL_DECODING_H_
 #define DRACO_COMPRESSION_ENTROPY_SYMBOL_DECODING_H_
 
+#include "draco/compression/config/decoder_options.h"
 #include "draco/core/decoder_buffer.h"
 
 namespace draco {
@@ -24,6 +25,20 @@ namespace draco {
 bool DecodeSymbols(uint32_t num_values, int num_components,
                    DecoderBuffer *src_buffer, uint32_t *out_values);
 
+// Same as above but the decoding can be controlled with the global decoder
+// |options| (can be nullptr). Supported options:
+//   "rans_max_look_up_table_bits" - Limits the size of the look up tables used
+//                                   by the rANS decoders to 2^bits entries.
+//                                   Smaller tables stay in the cache but the
+//                                   decoding of each symbol is slower. By
+//                                   default, the size of the tables is not
+//                                   limited.
+// In addition, the look up tables are shared through the cache set in
+// DecoderOptions::SetRAnsTableCache().
+bool DecodeSymbols(uint32_t num_values, int num_components,
+                   const DecoderOptions *options, DecoderBuffer *src_buffer,
+                   uint32_t *out_values);
+
 }  // namespace draco
 
 #endif  // DRACO_COMPRESSION_ENTROPY_SYMBOL_DECODING_H_
@@ -42,6 +42,13 @@ void SetSymbolEncodingMethod(Options *options, SymbolCodingMethod method);
 // Returns false if an invalid level has been set.
 bool SetSymbolEncodingCompressionLevel(Options *options, int compression_level);
 
+// Sets an option that makes the symbol encoder use |num_states| interleaved
+// rANS states whenever it would otherwise use the raw encoding method (see
+// SYMBOL_CODING_INTERLEAVED). Symbols encoded with interleaved states can be
+// decoded faster at the cost of a slightly larger output. Valid values of
+// |num_states| are 4 and 8. Returns false if an invalid value has been set.
+bool SetSymbolEncodingInterleavedStates(Options *options, int num_states);
+
 }  // namespace draco
 
 #endif  // DRACO_COMPRESSION_ENTROPY_SYMBOL_ENCODING_H_
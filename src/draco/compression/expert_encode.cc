@@ -91,6 +91,7 @@ Status ExpertEncoder::EncodePointCloudToBuffer(const PointCloud &pc, EncoderBuff
     encoder.reset(new PointCloudSequentialEncoder());
   }
   encoder->SetPointCloud(pc);
+  encoder->SetThreadPool(thread_pool_.get());
   DRACO_RETURN_IF_ERROR(encoder->Encode(options(), out_buffer));
 
   set_num_encoded_points(encoder->num_encoded_points());
@@ -123,6 +124,7 @@ Status ExpertEncoder::EncodeMeshToBuffer(const Mesh &m, EncoderBuffer *out_buffe
     encoder = std::unique_ptr<MeshEncoder>(new MeshSequentialEncoder());
 
   encoder->SetMesh(m);
+  encoder->SetThreadPool(thread_pool_.get());
 
   DRACO_RETURN_IF_ERROR(encoder->Encode(options(), out_buffer));
 
@@ -161,6 +163,15 @@ void ExpertEncoder::SetUseBuiltInAttributeCompression(bool enabled)
   options().SetGlobalBool("use_built_in_attribute_compression", enabled);
 }
 
+Status ExpertEncoder::SetInterleavedSymbolCoding(int num_states)
+{
+  if (num_states != 0 && num_states != 4 && num_states != 8)
+    return Status(Status::DRACO_ERROR, "Invalid number of interleaved states.");
+
+  options().SetGlobalInt("symbol_encoding_interleaved_states", num_states);
+  return OkStatus();
+}
+
 void ExpertEncoder::SetEncodingMethod(int encoding_method)
 {
   Base::SetEncodingMethod(encoding_method);
@@ -185,4 +196,9 @@ Status ExpertEncoder::SetAttributePredictionScheme(int32_t attribute_id, int pre
   return status;
 }
 
+void ExpertEncoder::SetThreadPool(std::shared_ptr<ThreadPool> thread_pool)
+{
+  thread_pool_ = std::move(thread_pool);
+}
+
 }  // namespace draco
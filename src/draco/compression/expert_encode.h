@@ -15,11 +15,14 @@
 #ifndef DRACO_SRC_DRACO_COMPRESSION_EXPERT_ENCODE_H_
 #define DRACO_SRC_DRACO_COMPRESSION_EXPERT_ENCODE_H_
 
+#include <memory>
+
 #include "draco/compression/config/compression_shared.h"
 #include "draco/compression/config/encoder_options.h"
 #include "draco/compression/encode_base.h"
 #include "draco/core/encoder_buffer.h"
 #include "draco/core/status.h"
+#include "draco/core/thread_pool.h"
 #include "draco/mesh/mesh.h"
 
 namespace draco {
@@ -80,6 +83,14 @@ class ExpertEncoder : public EncoderBase<EncoderOptions> {
   // compression is used on top of the Draco compression. Default: [true].
   void SetUseBuiltInAttributeCompression(bool enabled);
 
+  // Sets the number of interleaved rANS states used for entropy coding of
+  // attribute values. Interleaved states make the decoding of large attributes
+  // faster at the cost of a slightly larger output. Valid values are 4 and 8,
+  // 0 disables the interleaved coding. Default: [0].
+  // Encoded files with interleaved coding have the
+  // INTERLEAVED_SYMBOL_CODING_FLAG_MASK set in their header.
+  Status SetInterleavedSymbolCoding(int num_states);
+
   // Sets the desired encoding method for a given geometry. By default, encoding
   // method is selected based on the properties of the input geometry and based
   // on the other options selected in the used EncoderOptions (such as desired
@@ -132,6 +143,12 @@ class ExpertEncoder : public EncoderBase<EncoderOptions> {
   Status SetAttributePredictionScheme(int32_t attribute_id,
                                       int prediction_scheme_method);
 
+  // Sets a thread pool that is used to encode independent attributes in
+  // parallel. The encoded data is the same as when the attributes are encoded
+  // on the calling thread. Set to nullptr to disable the parallel encoding
+  // (default).
+  void SetThreadPool(std::shared_ptr<ThreadPool> thread_pool);
+
  private:
   Status EncodePointCloudToBuffer(const PointCloud &pc,
                                   EncoderBuffer *out_buffer);
@@ -140,6 +157,7 @@ class ExpertEncoder : public EncoderBase<EncoderOptions> {
 
   const PointCloud *point_cloud_;
   const Mesh *mesh_;
+  std::shared_ptr<ThreadPool> thread_pool_;
 };
 
 }  // namespace draco
@@ -20,7 +20,7 @@
 
 namespace draco {
 
-MeshEdgebreakerDecoder::MeshEdgebreakerDecoder() {}
+MeshEdgebreakerDecoder::MeshEdgebreakerDecoder() : impl_traversal_type_(-1) {}
 
 bool MeshEdgebreakerDecoder::CreateAttributesDecoder(int32_t att_decoder_id) {
   return impl_->CreateAttributesDecoder(att_decoder_id);
@@ -31,7 +31,13 @@ bool MeshEdgebreakerDecoder::InitializeDecoder() {
   if (!buffer()->Decode(&traversal_decoder_type)) {
     return false;
   }
+  if (impl_ != nullptr && traversal_decoder_type == impl_traversal_type_) {
+    // Reuse the implementation (and its allocated memory) from the previous
+    // decode.
+    return impl_->Init(this);
+  }
   impl_ = nullptr;
+  impl_traversal_type_ = -1;
   if (traversal_decoder_type == MESH_EDGEBREAKER_STANDARD_ENCODING) {
 #ifdef DRACO_STANDARD_EDGEBREAKER_SUPPORTED
     impl_ = std::unique_ptr<MeshEdgebreakerDecoderImplInterface>(
@@ -53,6 +59,7 @@ bool MeshEdgebreakerDecoder::InitializeDecoder() {
   if (!impl_) {
     return false;
   }
+  impl_traversal_type_ = traversal_decoder_type;
   if (!impl_->Init(this)) {
     return false;
   }
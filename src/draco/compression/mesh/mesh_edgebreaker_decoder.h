@@ -47,6 +47,10 @@ class MeshEdgebreakerDecoder : public MeshDecoder {
   bool OnAttributesDecoded() override;
 
   std::unique_ptr<MeshEdgebreakerDecoderImplInterface> impl_;
+
+  // Traversal decoder type of |impl_|. The implementation is reused when the
+  // decoder is used to decode multiple meshes with the same traversal type.
+  int impl_traversal_type_;
 };
 
 }  // namespace draco
@@ -241,7 +241,6 @@ bool MeshEdgebreakerDecoderImpl<TraversalDecoder>::CreateAttributesDecoder(
 template <class TraversalDecoder>
 bool MeshEdgebreakerDecoderImpl<TraversalDecoder>::DecodeConnectivity() {
   num_new_vertices_ = 0;
-  new_to_parent_vertex_map_.clear();
 #ifdef DRACO_BACKWARDS_COMPATIBILITY_SUPPORTED
   if (decoder_->bitstream_version() < DRACO_BITSTREAM_VERSION(2, 2)) {
     uint32_t num_new_verts;
@@ -351,9 +350,10 @@ bool MeshEdgebreakerDecoderImpl<TraversalDecoder>::DecodeConnectivity() {
 
   // Decode topology (connectivity).
   vertex_traversal_length_.clear();
-  corner_table_ = std::unique_ptr<CornerTable>(new CornerTable());
+  // The corner table and all other data structures are kept between decodes
+  // when the decoder is reused (see DecoderSession) and are only reset here.
   if (corner_table_ == nullptr) {
-    return false;
+    corner_table_ = std::unique_ptr<CornerTable>(new CornerTable());
   }
   processed_corner_ids_.clear();
   processed_corner_ids_.reserve(num_faces);
@@ -367,10 +367,16 @@ bool MeshEdgebreakerDecoderImpl<TraversalDecoder>::DecodeConnectivity() {
   last_symbol_id_ = -1;
   last_face_id_ = -1;
   last_vert_id_ = -1;
+  pos_data_decoder_id_ = -1;
 
-  attribute_data_.clear();
-  // Add one attribute data for each attribute decoder.
+  // Add one attribute data for each attribute decoder. Existing entries are
+  // reset so that their memory can be reused.
   attribute_data_.resize(num_attribute_data);
+  for (AttributeData &data : attribute_data_) {
+    data.decoder_id = -1;
+    data.is_connectivity_used = true;
+    data.attribute_seam_corners.clear();
+  }
 
   if (!corner_table_->Reset(
           num_faces, num_encoded_vertices_ + num_encoded_split_symbols)) {
@@ -398,7 +404,7 @@ bool MeshEdgebreakerDecoderImpl<TraversalDecoder>::DecodeConnectivity() {
       }
     }
     if (encoded_connectivity_size == 0 ||
-        encoded_connectivity_size > decoder_->buffer()->remaining_size()) {
+        !decoder_->buffer()->CheckRemainingSize(encoded_connectivity_size)) {
       return false;
     }
     DecoderBuffer event_buffer;
@@ -406,6 +412,8 @@ bool MeshEdgebreakerDecoderImpl<TraversalDecoder>::DecodeConnectivity() {
         decoder_->buffer()->data_head() + encoded_connectivity_size,
         decoder_->buffer()->remaining_size() - encoded_connectivity_size,
         decoder_->buffer()->bitstream_version());
+    event_buffer.set_missing_data_tracker(
+        decoder_->buffer()->missing_data_tracker());
     // Decode hole and topology split events.
     topology_split_decoded_bytes =
         DecodeHoleAndTopologySplitEvents(&event_buffer);
@@ -525,7 +533,7 @@ int MeshEdgebreakerDecoderImpl<TraversalDecoder>::DecodeConnectivity(
   // Additional active edges may be added as a result of topology split events.
   // They can be added in arbitrary order, but we always know the split symbol
   // id they belong to, so we can address them using this symbol id.
-  std::unordered_map<int, CornerIndex> topology_split_active_corners;
+  topology_split_active_corners_.assign(num_symbols, kInvalidCornerIndex);
 
   // Vector used for storing vertices that were marked as isolated during the
   // decoding process. Currently used only when the mesh doesn't contain any
@@ -662,10 +670,11 @@ int MeshEdgebreakerDecoderImpl<TraversalDecoder>::DecodeConnectivity(
 
       // Corner "a" can correspond either to a normal active edge, or to an edge
       // created from the topology split event.
-      const auto it = topology_split_active_corners.find(symbol_id);
-      if (it != topology_split_active_corners.end()) {
+      const CornerIndex split_corner =
+          topology_split_active_corners_[symbol_id];
+      if (split_corner != kInvalidCornerIndex) {
         // Topology split event. Move the retrieved edge to the stack.
-        active_corner_stack.push_back(it->second);
+        active_corner_stack.push_back(split_corner);
       }
       if (active_corner_stack.empty()) {
         return -1;
@@ -782,7 +791,10 @@ int MeshEdgebreakerDecoderImpl<TraversalDecoder>::DecodeConnectivity(
         // Convert the encoder split symbol id to decoder symbol id.
         const int decoder_split_symbol_id =
             num_symbols - encoder_split_symbol_id - 1;
-        topology_split_active_corners[decoder_split_symbol_id] =
+        if (decoder_split_symbol_id < 0) {
+          return -1;  // Split symbol id out of range.
+        }
+        topology_split_active_corners_[decoder_split_symbol_id] =
             new_active_corner;
       }
     }
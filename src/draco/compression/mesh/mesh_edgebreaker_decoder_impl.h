@@ -15,8 +15,8 @@
 #ifndef DRACO_COMPRESSION_MESH_MESH_EDGEBREAKER_DECODER_IMPL_H_
 #define DRACO_COMPRESSION_MESH_MESH_EDGEBREAKER_DECODER_IMPL_H_
 
-#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include "draco/compression/attributes/mesh_attribute_indices_encoding_data.h"
 #include "draco/compression/mesh/mesh_edgebreaker_decoder_impl_interface.h"
@@ -123,13 +123,6 @@ class MeshEdgebreakerDecoderImpl : public MeshEdgebreakerDecoderImplInterface {
   // Initializes mapping between corners and point ids.
   bool AssignPointsToCorners(int num_connectivity_verts);
 
-  bool IsFaceVisited(CornerIndex corner_id) const {
-    if (corner_id < 0) {
-      return true;  // Invalid corner signalizes that the face does not exist.
-    }
-    return visited_faces_[corner_table_->Face(corner_id).value()];
-  }
-
   void SetOppositeCorners(CornerIndex corner_0, CornerIndex corner_1) {
     corner_table_->SetOppositeCorner(corner_0, corner_1);
     corner_table_->SetOppositeCorner(corner_1, corner_0);
@@ -154,6 +147,11 @@ class MeshEdgebreakerDecoderImpl : public MeshEdgebreakerDecoderImplInterface {
   // List of decoded topology split events.
   std::vector<TopologySplitEventData> topology_split_data_;
 
+  // Additional active corners created by topology split events, indexed by
+  // the decoder id of the split symbol they belong to. Entries of symbols
+  // without a split event are set to kInvalidCornerIndex.
+  std::vector<CornerIndex> topology_split_active_corners_;
+
   // List of decoded hole events.
   std::vector<HoleEventData> hole_event_data_;
 
@@ -172,10 +170,6 @@ class MeshEdgebreakerDecoderImpl : public MeshEdgebreakerDecoderImplInterface {
   // Id of the last decoded face.
   int last_face_id_;
 
-  // Array for marking visited faces.
-  std::vector<bool> visited_faces_;
-  // Array for marking visited vertices.
-  std::vector<bool> visited_verts_;
   // Array for marking vertices on open boundaries.
   std::vector<bool> is_vert_hole_;
 
@@ -184,9 +178,6 @@ class MeshEdgebreakerDecoderImpl : public MeshEdgebreakerDecoderImplInterface {
   // If there are no non-manifold edges/vertices on the input mesh, this should
   // be 0.
   int num_new_vertices_;
-  // For every newly added vertex, this array stores it's mapping to the
-  // parent vertex id of the encoded mesh.
-  std::unordered_map<int, int> new_to_parent_vertex_map_;
   // The number of vertices that were encoded (can be different from the number
   // of vertices of the input mesh).
   int num_encoded_vertices_;
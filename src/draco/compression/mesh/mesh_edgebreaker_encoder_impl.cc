@@ -292,9 +292,9 @@ Status MeshEdgebreakerEncoderImpl<TraversalEncoder>::EncodeConnectivity() {
   // all attributes.
 
   if (use_single_connectivity_)
-    corner_table_ = CreateCornerTableFromAllAttributes(mesh_);
+    corner_table_ = CreateCornerTableFromAllAttributes(mesh_, encoder_->thread_pool());
   else
-    corner_table_ = CreateCornerTableFromPositionAttribute(mesh_);
+    corner_table_ = CreateCornerTableFromPositionAttribute(mesh_, encoder_->thread_pool());
 
   if (corner_table_ == nullptr || corner_table_->num_faces() == corner_table_->NumDegeneratedFaces())
   {
@@ -326,7 +326,7 @@ Status MeshEdgebreakerEncoderImpl<TraversalEncoder>::EncodeConnectivity() {
   last_encoded_symbol_id_ = -1;
   num_split_symbols_ = 0;
   topology_split_event_data_.clear();
-  face_to_split_symbol_map_.clear();
+  face_to_split_symbol_map_.assign(corner_table_->num_faces(), -1);
   visited_holes_.clear();
   vertex_hole_id_.assign(corner_table_->num_vertices(), -1);
   processed_connectivity_corners_.clear();
@@ -344,20 +344,19 @@ Status MeshEdgebreakerEncoderImpl<TraversalEncoder>::EncodeConnectivity() {
   encoder_->buffer()->Encode(num_attribute_data);
   traversal_encoder_.SetNumAttributeData(num_attribute_data);
 
-  const int num_corners = corner_table_->num_corners();
+  const size_t num_mesh_faces = corner_table_->num_faces();
 
   traversal_encoder_.Start();
 
   std::vector<CornerIndex> init_face_connectivity_corners;
 
-  // Traverse the surface starting from each unvisited corner.
-  for (int c_id = 0; c_id < num_corners; ++c_id)
+  // Traverse the surface starting from each unvisited face. Faces that have
+  // been already processed are skipped a whole word at a time.
+  for (size_t f = visited_faces_.FindNextUnset(0); f < num_mesh_faces;
+       f = visited_faces_.FindNextUnset(f + 1))
   {
-    CornerIndex corner_index(c_id);
-    const FaceIndex face_id = corner_table_->Face(corner_index);
-
-    if (visited_faces_[face_id.value()])
-      continue;  // Face has been already processed.
+    const FaceIndex face_id(static_cast<uint32_t>(f));
+    CornerIndex corner_index = corner_table_->FirstCorner(face_id);
 
     if (corner_table_->IsDegenerated(face_id))
       continue;  // Ignore degenerated faces.
@@ -377,15 +376,15 @@ Status MeshEdgebreakerEncoderImpl<TraversalEncoder>::EncodeConnectivity() {
 
       const VertexIndex prev_vert_id = corner_table_->Vertex(corner_table_->Previous(corner_index));
 
-      visited_vertex_ids_[vert_id.value()] = true;
-      visited_vertex_ids_[next_vert_id.value()] = true;
-      visited_vertex_ids_[prev_vert_id.value()] = true;
+      visited_vertex_ids_.set(vert_id.value());
+      visited_vertex_ids_.set(next_vert_id.value());
+      visited_vertex_ids_.set(prev_vert_id.value());
 
       // New traversal started. Initiate it's length with the first vertex.
       vertex_traversal_length_.push_back(1);
 
       // Mark the face as visited.
-      visited_faces_[face_id.value()] = true;
+      visited_faces_.set(face_id.value());
 
       // Start compressing from the opposite face of the "next" corner. This way
       // the first encoded corner corresponds to the tip corner of the regular
@@ -564,7 +563,7 @@ bool MeshEdgebreakerEncoderImpl<TraversalEncoder>::EncodeConnectivityFromCorner(
       ++last_encoded_symbol_id_;
 
       const FaceIndex face_id = corner_table_->Face(corner_id);
-      visited_faces_[face_id.value()] = true;
+      visited_faces_.set(face_id.value());
       processed_connectivity_corners_.push_back(corner_id);
       traversal_encoder_.NewCornerReached(corner_id);
       const VertexIndex vert_id = corner_table_->Vertex(corner_id);
@@ -574,7 +573,7 @@ bool MeshEdgebreakerEncoderImpl<TraversalEncoder>::EncodeConnectivityFromCorner(
       {
         // A new unvisited vertex has been reached. We need to store its
         // position difference using next, prev, and opposite vertices.
-        visited_vertex_ids_[vert_id.value()] = true;
+        visited_vertex_ids_.set(vert_id.value());
 
         if (!on_boundary)
         {
@@ -690,7 +689,7 @@ int MeshEdgebreakerEncoderImpl<TraversalEncoder>::EncodeHole(CornerIndex start_c
 
   if (encode_first_vertex)
   {
-    visited_vertex_ids_[start_vertex_id.value()] = true;
+    visited_vertex_ids_.set(start_vertex_id.value());
     ++num_encoded_hole_verts;
   }
 
@@ -710,7 +709,7 @@ int MeshEdgebreakerEncoderImpl<TraversalEncoder>::EncodeHole(CornerIndex start_c
     start_vert_id = act_vertex_id;
 
     // Mark the vertex as visited.
-    visited_vertex_ids_[act_vertex_id.value()] = true;
+    visited_vertex_ids_.set(act_vertex_id.value());
     ++num_encoded_hole_verts;
     corner_id = corner_table_->Next(corner_id);
 
@@ -823,12 +822,7 @@ bool MeshEdgebreakerEncoderImpl<TraversalEncoder>::FindHoles()
 template <class TraversalEncoder>
 int MeshEdgebreakerEncoderImpl<TraversalEncoder>::GetSplitSymbolIdOnFace(int face_id) const
 {
-  auto it = face_to_split_symbol_map_.find(face_id);
-
-  if (it == face_to_split_symbol_map_.end())
-    return -1;
-
-  return it->second;
+  return face_to_split_symbol_map_[face_id];
 }
 
 template <class TraversalEncoder>
@@ -895,7 +889,7 @@ bool MeshEdgebreakerEncoderImpl<TraversalEncoder>::EncodeAttributeConnectivities
   const CornerIndex corners[3] = {corner, corner_table_->Next(corner), corner_table_->Previous(corner)};
 
   const FaceIndex src_face_id = corner_table_->Face(corner);
-  visited_faces_[src_face_id.value()] = true;
+  visited_faces_.set(src_face_id.value());
 
   for (int c = 0; c < 3; ++c)
   {
@@ -15,13 +15,14 @@
 #ifndef DRACO_COMPRESSION_MESH_MESH_EDGEBREAKER_ENCODER_IMPL_H_
 #define DRACO_COMPRESSION_MESH_MESH_EDGEBREAKER_ENCODER_IMPL_H_
 
-#include <unordered_map>
+#include <vector>
 
 #include "draco/compression/attributes/mesh_attribute_indices_encoding_data.h"
 #include "draco/compression/config/compression_shared.h"
 #include "draco/compression/mesh/mesh_edgebreaker_encoder_impl_interface.h"
 #include "draco/compression/mesh/mesh_edgebreaker_shared.h"
 #include "draco/compression/mesh/traverser/mesh_traversal_sequencer.h"
+#include "draco/core/bit_vector.h"
 #include "draco/core/encoder_buffer.h"
 #include "draco/mesh/mesh_attribute_corner_table.h"
 
@@ -139,7 +140,7 @@ class MeshEdgebreakerEncoderImpl : public MeshEdgebreakerEncoderImplInterface {
   // memory overflow when compressing huge meshes.
   std::vector<CornerIndex> corner_traversal_stack_;
   // Array for marking visited faces.
-  std::vector<bool> visited_faces_;
+  BitVector visited_faces_;
 
   // Attribute data for position encoding.
   MeshAttributeIndicesEncodingData pos_encoding_data_;
@@ -153,16 +154,16 @@ class MeshEdgebreakerEncoderImpl : public MeshEdgebreakerEncoderImplInterface {
   std::vector<CornerIndex> processed_connectivity_corners_;
 
   // Array for storing visited vertex ids of all input vertices.
-  std::vector<bool> visited_vertex_ids_;
+  BitVector visited_vertex_ids_;
 
   // For each traversal, this array stores the number of visited vertices.
   std::vector<int> vertex_traversal_length_;
   // Array for storing all topology split events encountered during the mesh
   // traversal.
   std::vector<TopologySplitEventData> topology_split_event_data_;
-  // Map between face_id and symbol_id. Contains entries only for faces that
-  // were encoded with TOPOLOGY_S symbol.
-  std::unordered_map<int, int> face_to_split_symbol_map_;
+  // Map between face_id and symbol_id. Contains valid symbol ids only for
+  // faces that were encoded with TOPOLOGY_S symbol, other entries are -1.
+  std::vector<int> face_to_split_symbol_map_;
 
   // Array for marking holes that has been reached during the traversal.
   std::vector<bool> visited_holes_;
@@ -38,6 +38,8 @@ class MeshEdgebreakerTraversalDecoder {
     buffer_.Init(decoder->GetDecoder()->buffer()->data_head(),
                  decoder->GetDecoder()->buffer()->remaining_size(),
                  decoder->GetDecoder()->buffer()->bitstream_version());
+    buffer_.set_missing_data_tracker(
+        decoder->GetDecoder()->buffer()->missing_data_tracker());
   }
 
   // Returns the Draco bitstream version.
@@ -45,6 +47,11 @@ class MeshEdgebreakerTraversalDecoder {
     return decoder_impl_->GetDecoder()->bitstream_version();
   }
 
+  // Returns the options of the mesh decoder.
+  const DecoderOptions *GetDecoderOptions() const {
+    return decoder_impl_->GetDecoder()->options();
+  }
+
   // Used to tell the decoder what is the number of expected decoded vertices.
   // Ignored by default.
   void SetNumEncodedVertices(int /* num_vertices */) {}
@@ -144,7 +151,7 @@ class MeshEdgebreakerTraversalDecoder {
       return false;
     }
     buffer_ = symbol_buffer_;
-    if (traversal_size > static_cast<uint64_t>(buffer_.remaining_size())) {
+    if (!buffer_.CheckRemainingSize(traversal_size)) {
       return false;
     }
     buffer_.Advance(traversal_size);
@@ -161,7 +168,7 @@ class MeshEdgebreakerTraversalDecoder {
         return false;
       }
       buffer_ = start_face_buffer_;
-      if (traversal_size > static_cast<uint64_t>(buffer_.remaining_size())) {
+      if (!buffer_.CheckRemainingSize(traversal_size)) {
         return false;
       }
       buffer_.Advance(traversal_size);
@@ -14,6 +14,8 @@
 //
 #include "draco/compression/point_cloud/point_cloud_decoder.h"
 
+#include <algorithm>
+
 #include "draco/metadata/metadata_decoder.h"
 
 namespace draco {
@@ -23,7 +25,11 @@ PointCloudDecoder::PointCloudDecoder()
       buffer_(nullptr),
       version_major_(0),
       version_minor_(0),
-      options_(nullptr) {}
+      interleaved_symbol_coding_allowed_(false),
+      options_(nullptr),
+      geometry_data_decoded_(false),
+      num_decoded_attributes_decoders_(0),
+      geometry_data_end_(nullptr) {}
 
 Status PointCloudDecoder::DecodeHeader(DecoderBuffer *buffer,
                                        DracoHeader *out_header) {
@@ -69,6 +75,15 @@ Status PointCloudDecoder::Decode(const DecoderOptions &options,
   options_ = &options;
   buffer_ = in_buffer;
   point_cloud_ = out_point_cloud;
+  geometry_data_decoded_ = false;
+  num_decoded_attributes_decoders_ = 0;
+  geometry_data_end_ = nullptr;
+  attributes_decoder_data_ends_.clear();
+  attribute_outputs_.clear();
+  attribute_outputs_written_.clear();
+  attribute_output_status_ = OkStatus();
+  attributes_decoders_.clear();
+  attribute_to_decoder_map_.clear();
   DracoHeader header;
   DRACO_RETURN_IF_ERROR(DecodeHeader(buffer_, &header))
   // Sanity check that we are really using the right decoder (mostly for cases
@@ -81,6 +96,8 @@ Status PointCloudDecoder::Decode(const DecoderOptions &options,
   // don't expose the decoding method id.
   version_major_ = header.version_major;
   version_minor_ = header.version_minor;
+  interleaved_symbol_coding_allowed_ =
+      (header.flags & INTERLEAVED_SYMBOL_CODING_FLAG_MASK) != 0;
 
   const uint8_t max_supported_major_version =
       header.encoder_type == POINT_CLOUD ? kDracoPointCloudBitstreamVersionMajor
@@ -109,7 +126,12 @@ Status PointCloudDecoder::Decode(const DecoderOptions &options,
   if (!DecodeGeometryData()) {
     return Status(Status::DRACO_ERROR, "Failed to decode geometry data.");
   }
+  geometry_data_decoded_ = true;
+  geometry_data_end_ = buffer_->data_head();
   if (!DecodePointAttributes()) {
+    if (!attribute_output_status_.ok()) {
+      return attribute_output_status_;
+    }
     return Status(Status::DRACO_ERROR, "Failed to decode point attributes.");
   }
   return OkStatus();
@@ -155,6 +177,11 @@ bool PointCloudDecoder::DecodePointAttributes() {
     }
   }
 
+  attribute_output_status_ = InitAttributeOutputs();
+  if (!attribute_output_status_.ok()) {
+    return false;
+  }
+
   // Decode the actual attributes using the created attribute decoders.
   if (!DecodeAllAttributes()) {
     return false;
@@ -163,14 +190,124 @@ bool PointCloudDecoder::DecodePointAttributes() {
   if (!OnAttributesDecoded()) {
     return false;
   }
-  return true;
+  attribute_output_status_ = WriteRemainingAttributeOutputs();
+  return attribute_output_status_.ok();
+}
+
+Status PointCloudDecoder::InitAttributeOutputs() {
+  if (!attribute_output_callback_) {
+    return OkStatus();
+  }
+  std::vector<AttributeBufferLayout> outputs;
+  DRACO_RETURN_IF_ERROR(attribute_output_callback_(&outputs))
+  const int32_t num_attributes = point_cloud_->num_attributes();
+  attribute_outputs_.resize(num_attributes);
+  attribute_outputs_written_.assign(num_attributes, 0);
+  for (const AttributeBufferLayout &output : outputs) {
+    if (output.attribute_id < 0 || output.attribute_id >= num_attributes) {
+      return Status(Status::DRACO_ERROR, "Invalid attribute id.");
+    }
+    DRACO_RETURN_IF_ERROR(CheckAttributeBufferLayout(
+        output, point_cloud_->attribute(output.attribute_id)->num_components(),
+        point_cloud_->num_points()))
+    attribute_outputs_[output.attribute_id].push_back(output);
+  }
+  return OkStatus();
+}
+
+Status PointCloudDecoder::WriteRemainingAttributeOutputs() {
+  for (int32_t i = 0; i < static_cast<int32_t>(attribute_outputs_.size());
+       ++i) {
+    if (attribute_outputs_written_[i]) {
+      continue;
+    }
+    for (const AttributeBufferLayout &output : attribute_outputs_[i]) {
+      DRACO_RETURN_IF_ERROR(WriteAttributeToBuffer(
+          *point_cloud_->attribute(i), point_cloud_->num_points(), output))
+    }
+  }
+  return OkStatus();
 }
 
 bool PointCloudDecoder::DecodeAllAttributes() {
+  ThreadPool *const thread_pool =
+      options_ ? options_->GetThreadPool() : nullptr;
+  if (thread_pool != nullptr &&
+      bitstream_version() >= DRACO_BITSTREAM_VERSION(2, 0)) {
+    if (!DecodeAllAttributesInParallel(thread_pool)) {
+      return false;
+    }
+    num_decoded_attributes_decoders_ = num_attributes_decoders();
+    attributes_decoder_data_ends_.assign(num_decoded_attributes_decoders_,
+                                         buffer_->data_head());
+    return true;
+  }
   for (auto &att_dec : attributes_decoders_) {
     if (!att_dec->DecodeAttributes(buffer_)) {
       return false;
     }
+    ++num_decoded_attributes_decoders_;
+    attributes_decoder_data_ends_.push_back(buffer_->data_head());
+  }
+  return true;
+}
+
+bool PointCloudDecoder::DecodeAllAttributesInParallel(ThreadPool *thread_pool) {
+  // The encoded data doesn't store the size of the data of each attribute so
+  // it needs to be read in the original order.
+  for (auto &att_dec : attributes_decoders_) {
+    if (!att_dec->DecodeAttributesDeferred(buffer_)) {
+      return false;
+    }
+  }
+
+  // Split the attributes into stages where each stage contains attributes
+  // that depend only on attributes from the previous stages. Parent
+  // attributes are always decoded before their children so a single pass
+  // over all attributes is sufficient.
+  struct AttributeTask {
+    int decoder_id;
+    int local_id;
+  };
+  std::vector<std::vector<AttributeTask>> stages;
+  std::vector<int> attribute_stages(point_cloud_->num_attributes(), -1);
+  for (int d = 0; d < static_cast<int>(attributes_decoders_.size()); ++d) {
+    const AttributesDecoderInterface *const att_dec =
+        attributes_decoders_[d].get();
+    for (int i = 0; i < att_dec->GetNumAttributes(); ++i) {
+      int stage = 0;
+      for (const int32_t parent_id : att_dec->GetParentAttributeIds(i)) {
+        if (parent_id < 0 ||
+            parent_id >= static_cast<int32_t>(attribute_stages.size()) ||
+            attribute_stages[parent_id] < 0) {
+          return false;
+        }
+        stage = std::max(stage, attribute_stages[parent_id] + 1);
+      }
+      const int32_t att_id = att_dec->GetAttributeId(i);
+      if (att_id < 0 ||
+          att_id >= static_cast<int32_t>(attribute_stages.size())) {
+        return false;
+      }
+      attribute_stages[att_id] = stage;
+      if (stage >= static_cast<int>(stages.size())) {
+        stages.resize(stage + 1);
+      }
+      stages[stage].push_back({d, i});
+    }
+  }
+
+  for (const std::vector<AttributeTask> &tasks : stages) {
+    std::vector<uint8_t> results(tasks.size(), 0);
+    thread_pool->ParallelFor(static_cast<int>(tasks.size()), [&](int t) {
+      results[t] = attributes_decoders_[tasks[t].decoder_id]
+                       ->FinishAttributeDecoding(tasks[t].local_id);
+    });
+    for (const uint8_t result : results) {
+      if (!result) {
+        return false;
+      }
+    }
   }
   return true;
 }
@@ -15,10 +15,13 @@
 #ifndef DRACO_COMPRESSION_POINT_CLOUD_POINT_CLOUD_DECODER_H_
 #define DRACO_COMPRESSION_POINT_CLOUD_POINT_CLOUD_DECODER_H_
 
+#include <functional>
+
 #include "draco/compression/attributes/attributes_decoder_interface.h"
 #include "draco/compression/config/compression_shared.h"
 #include "draco/compression/config/decoder_options.h"
 #include "draco/core/status.h"
+#include "draco/mesh/mesh_buffer_layout.h"
 #include "draco/point_cloud/point_cloud.h"
 
 namespace draco {
@@ -27,6 +30,12 @@ namespace draco {
 // basic functionality that is shared between different decoders.
 class PointCloudDecoder {
  public:
+  // Callback used to request that the values of some attributes are written
+  // into caller-owned memory described by |out_outputs| (see
+  // SetAttributeOutputCallback()).
+  typedef std::function<Status(std::vector<AttributeBufferLayout> *out_outputs)>
+      AttributeOutputCallback;
+
   PointCloudDecoder();
   virtual ~PointCloudDecoder() = default;
 
@@ -40,6 +49,36 @@ class PointCloudDecoder {
   Status Decode(const DecoderOptions &options, DecoderBuffer *in_buffer,
                 PointCloud *out_point_cloud);
 
+  // Sets a |callback| that is called during Decode() once the number of points
+  // and the descriptors of all attributes are known but before any attribute
+  // values are decoded. The values of the attributes listed in the returned
+  // outputs are written to the caller-owned memory for all points of the
+  // decoded geometry. Attribute decoders that support it convert the values
+  // straight into the output memory and the corresponding attributes of the
+  // decoded geometry are left without any values.
+  void SetAttributeOutputCallback(const AttributeOutputCallback &callback) {
+    attribute_output_callback_ = callback;
+  }
+
+  // Returns the outputs requested for attribute |att_id| or nullptr when
+  // there are none.
+  const std::vector<AttributeBufferLayout> *GetAttributeOutputs(
+      int32_t att_id) const {
+    if (att_id < 0 ||
+        att_id >= static_cast<int32_t>(attribute_outputs_.size()) ||
+        attribute_outputs_[att_id].empty()) {
+      return nullptr;
+    }
+    return &attribute_outputs_[att_id];
+  }
+
+  // Called by attribute decoders that wrote the values of attribute |att_id|
+  // directly into its outputs. Can be called concurrently for different
+  // attributes.
+  void MarkAttributeOutputsWritten(int32_t att_id) {
+    attribute_outputs_written_[att_id] = 1;
+  }
+
   bool SetAttributesDecoder(
       int att_decoder_id, std::unique_ptr<AttributesDecoderInterface> decoder) {
     if (att_decoder_id < 0) {
@@ -64,6 +103,12 @@ class PointCloudDecoder {
     return DRACO_BITSTREAM_VERSION(version_major_, version_minor_);
   }
 
+  // Returns true when the header of the decoded data allows the use of
+  // SYMBOL_CODING_INTERLEAVED (see INTERLEAVED_SYMBOL_CODING_FLAG_MASK).
+  bool interleaved_symbol_coding_allowed() const {
+    return interleaved_symbol_coding_allowed_;
+  }
+
   const AttributesDecoderInterface *attributes_decoder(int dec_id) {
     return attributes_decoders_[dec_id].get();
   }
@@ -71,6 +116,25 @@ class PointCloudDecoder {
     return static_cast<int32_t>(attributes_decoders_.size());
   }
 
+  // Progress of the last Decode() call. When the decoding fails (e.g. because
+  // the input data is truncated), these can be used to determine which parts
+  // of the output geometry were already fully decoded. The geometry data is
+  // decoded first, followed by the attributes of each attributes decoder in
+  // the order of their ids.
+  bool is_geometry_data_decoded() const { return geometry_data_decoded_; }
+  int32_t num_decoded_attributes_decoders() const {
+    return num_decoded_attributes_decoders_;
+  }
+
+  // Returns the end of the input data that was read while decoding the
+  // geometry data and the attributes of the decoded attributes decoder
+  // |dec_id| respectively. Data of attributes decoded in parallel is read all
+  // at once so all these attributes decoders share the same end.
+  const char *geometry_data_end() const { return geometry_data_end_; }
+  const char *attributes_decoder_data_end(int dec_id) const {
+    return attributes_decoder_data_ends_[dec_id];
+  }
+
   // Get a mutable pointer to the decoded point cloud. This is intended to be
   // used mostly by other decoder subsystems.
   PointCloud *point_cloud() { return point_cloud_; }
@@ -92,9 +156,20 @@ class PointCloudDecoder {
   virtual bool DecodeAllAttributes();
   virtual bool OnAttributesDecoded() { return true; }
 
+  // Decodes all attributes using the |thread_pool|. Data of all attributes
+  // is read sequentially from the input buffer but the remaining decoding of
+  // attributes that don't depend on each other is done in parallel.
+  bool DecodeAllAttributesInParallel(ThreadPool *thread_pool);
+
   Status DecodeMetadata();
 
  private:
+  // Validates the outputs returned by |attribute_output_callback_|.
+  Status InitAttributeOutputs();
+  // Writes the values of all attributes whose outputs were not written by the
+  // attribute decoders.
+  Status WriteRemainingAttributeOutputs();
+
   // Point cloud that is being filled in by the decoder.
   PointCloud *point_cloud_;
 
@@ -110,7 +185,24 @@ class PointCloudDecoder {
   uint8_t version_major_;
   uint8_t version_minor_;
 
+  // Set from INTERLEAVED_SYMBOL_CODING_FLAG_MASK of the header.
+  bool interleaved_symbol_coding_allowed_;
+
   const DecoderOptions *options_;
+
+  bool geometry_data_decoded_;
+  int32_t num_decoded_attributes_decoders_;
+  const char *geometry_data_end_;
+  std::vector<const char *> attributes_decoder_data_ends_;
+
+  AttributeOutputCallback attribute_output_callback_;
+  // Outputs requested for each attribute.
+  std::vector<std::vector<AttributeBufferLayout>> attribute_outputs_;
+  // Non-zero for attributes whose outputs were already written. Stored as
+  // uint8_t so that different attributes can be marked concurrently.
+  std::vector<uint8_t> attribute_outputs_written_;
+  // Error reported by the attribute outputs, if any.
+  Status attribute_output_status_;
 };
 
 }  // namespace draco
@@ -20,7 +20,11 @@ namespace draco
 {
 
 PointCloudEncoder::PointCloudEncoder()
-    : point_cloud_(nullptr), buffer_(nullptr), num_encoded_points_(0) {}
+    : point_cloud_(nullptr),
+      buffer_(nullptr),
+      options_(nullptr),
+      thread_pool_(nullptr),
+      num_encoded_points_(0) {}
 
 void PointCloudEncoder::SetPointCloud(const PointCloud &pc)
 {
@@ -43,6 +47,11 @@ Status PointCloudEncoder::Encode(const EncoderOptions &options, EncoderBuffer *o
   DRACO_RETURN_IF_ERROR(EncodeHeader())
   DRACO_RETURN_IF_ERROR(EncodeMetadata())
 
+  // The encoded data is passed to the sink of |buffer_| (if any) after each
+  // part of the geometry is encoded.
+  if (!buffer_->Flush())
+    return Status(Status::IO_ERROR, "Failed to write encoded data.");
+
   if (!InitializeEncoder())
     return Status(Status::DRACO_ERROR, "Failed to initialize encoder.");
 
@@ -51,8 +60,21 @@ Status PointCloudEncoder::Encode(const EncoderOptions &options, EncoderBuffer *o
 
   DRACO_RETURN_IF_ERROR(EncodeGeometryData());
 
+  if (!buffer_->Flush())
+    return Status(Status::IO_ERROR, "Failed to write encoded data.");
+
   if (!EncodePointAttributes())
+  {
+    // Attributes are flushed as soon as they are encoded (see
+    // EncodeAllAttributes()).
+    if (buffer_->sink_failed())
+      return Status(Status::IO_ERROR, "Failed to write encoded data.");
+
     return Status(Status::DRACO_ERROR, "Failed to encode point attributes.");
+  }
+
+  if (!buffer_->Flush())
+    return Status(Status::IO_ERROR, "Failed to write encoded data.");
 
   if (options.GetGlobalBool("store_number_of_encoded_points", false))
     ComputeNumberOfEncodedPoints();
@@ -93,6 +115,10 @@ Status PointCloudEncoder::EncodeHeader()
   if (point_cloud_->GetMetadata())
     flags |= METADATA_FLAG_MASK;
 
+  // Second bit of |flags| signals interleaved entropy coding of attributes.
+  if (options_->GetGlobalInt("symbol_encoding_interleaved_states", 0) > 0)
+    flags |= INTERLEAVED_SYMBOL_CODING_FLAG_MASK;
+
   buffer_->Encode(flags);
   return OkStatus();
 }
@@ -171,10 +197,91 @@ bool PointCloudEncoder::GenerateAttributesEncoders()
 
 bool PointCloudEncoder::EncodeAllAttributes()
 {
+  if (thread_pool_)
+    return EncodeAllAttributesInParallel(thread_pool_);
+
   for (int att_encoder_id : attributes_encoder_ids_order_)
   {
     if (!attributes_encoders_[att_encoder_id]->EncodeAttributes(buffer_))
       return false;
+
+    if (!buffer_->Flush())
+      return false;
+  }
+
+  return true;
+}
+
+bool PointCloudEncoder::EncodeAllAttributesInParallel(ThreadPool *thread_pool)
+{
+  // Portable attributes can be used by predictors of other attributes so all
+  // of them are computed before the encoding starts.
+  for (int att_encoder_id : attributes_encoder_ids_order_)
+  {
+    if (!attributes_encoders_[att_encoder_id]->PrepareAttributesEncoding())
+      return false;
+  }
+
+  struct EncodingTask
+  {
+    AttributesEncoder *encoder;
+    int task_id;
+    EncoderBuffer data_buffer;
+    EncoderBuffer transform_buffer;
+    bool result;
+  };
+
+  // Tasks of all attribute encoders, stored in the encoding order.
+  std::vector<int> encoder_num_tasks;
+  int total_num_tasks = 0;
+
+  for (int att_encoder_id : attributes_encoder_ids_order_)
+  {
+    encoder_num_tasks.push_back(attributes_encoders_[att_encoder_id]->NumEncodingTasks());
+    total_num_tasks += encoder_num_tasks.back();
+  }
+
+  std::vector<EncodingTask> tasks(total_num_tasks);
+  int task_index = 0;
+
+  for (int att_encoder_id : attributes_encoder_ids_order_)
+  {
+    AttributesEncoder *const att_enc = attributes_encoders_[att_encoder_id].get();
+
+    for (int i = 0; i < att_enc->NumEncodingTasks(); ++i)
+    {
+      tasks[task_index].encoder = att_enc;
+      tasks[task_index].task_id = i;
+      tasks[task_index].result = false;
+      ++task_index;
+    }
+  }
+
+  thread_pool->ParallelFor(total_num_tasks, [&tasks](int t) {
+    EncodingTask &task = tasks[t];
+    task.result = task.encoder->EncodeAttributesTask(task.task_id, &task.data_buffer, &task.transform_buffer);
+  });
+
+  // Concatenate the encoded data in the same order as EncodeAllAttributes().
+  int first_task = 0;
+
+  for (const int num_tasks : encoder_num_tasks)
+  {
+    for (int i = first_task; i < first_task + num_tasks; ++i)
+    {
+      if (!tasks[i].result)
+        return false;
+
+      buffer_->Encode(tasks[i].data_buffer.data(), tasks[i].data_buffer.size());
+    }
+
+    for (int i = first_task; i < first_task + num_tasks; ++i)
+      buffer_->Encode(tasks[i].transform_buffer.data(), tasks[i].transform_buffer.size());
+
+    if (!buffer_->Flush())
+      return false;
+
+    first_task += num_tasks;
   }
 
   return true;
@@ -20,6 +20,7 @@
 #include "draco/compression/config/encoder_options.h"
 #include "draco/core/encoder_buffer.h"
 #include "draco/core/status.h"
+#include "draco/core/thread_pool.h"
 #include "draco/point_cloud/point_cloud.h"
 
 namespace draco {
@@ -35,6 +36,12 @@ class PointCloudEncoder {
   // Encode() method.
   void SetPointCloud(const PointCloud &pc);
 
+  // Sets a thread pool that is used to encode attributes and to build the mesh
+  // connectivity in parallel (can be nullptr). The encoded data is the same as
+  // when no thread pool is used.
+  void SetThreadPool(ThreadPool *thread_pool) { thread_pool_ = thread_pool; }
+  ThreadPool *thread_pool() const { return thread_pool_; }
+
   // The main entry point that encodes provided point cloud.
   Status Encode(const EncoderOptions &options, EncoderBuffer *out_buffer);
 
@@ -115,6 +122,11 @@ class PointCloudEncoder {
   // Encodes all the attribute data using the created attribute encoders.
   virtual bool EncodeAllAttributes();
 
+  // Same as EncodeAllAttributes() but the attributes are encoded by the
+  // |thread_pool| into separate buffers that are then concatenated in the
+  // encoding order.
+  bool EncodeAllAttributesInParallel(ThreadPool *thread_pool);
+
   // Computes and sets the num_encoded_points_ for the encoder.
   virtual void ComputeNumberOfEncodedPoints() = 0;
 
@@ -150,6 +162,8 @@ class PointCloudEncoder {
 
   const EncoderOptions *options_;
 
+  ThreadPool *thread_pool_;
+
   size_t num_encoded_points_;
 };
 
@@ -0,0 +1,169 @@
+// Copyright 2016 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/streaming_decode.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "draco/compression/chunked_decode.h"
+#include "draco/compression/config/compression_shared.h"
+
+#ifdef DRACO_MESH_COMPRESSION_SUPPORTED
+#include "draco/compression/mesh/mesh_edgebreaker_decoder.h"
+#include "draco/compression/mesh/mesh_sequential_decoder.h"
+#endif
+
+namespace draco {
+
+namespace {
+
+// Size of the encoded Draco header in bytes.
+constexpr size_t kDracoHeaderSize = 11;
+
+}  // namespace
+
+StreamingMeshDecoder::StreamingMeshDecoder()
+    : next_decoding_size_(kDracoHeaderSize), finished_(false), decoded_(false) {}
+
+Status StreamingMeshDecoder::AppendData(const char *data, size_t data_size) {
+  if (finished_) {
+    return Status(Status::DRACO_ERROR, "Data appended after Finish().");
+  }
+  data_.insert(data_.end(), data, data + data_size);
+  if (decoded_ || data_.size() < next_decoding_size_) {
+    return OkStatus();
+  }
+  return DecodeBufferedData();
+}
+
+Status StreamingMeshDecoder::Finish() {
+  finished_ = true;
+  if (!decoded_) {
+    DRACO_RETURN_IF_ERROR(DecodeBufferedData())
+  }
+  if (!decoded_) {
+    return Status(Status::DRACO_ERROR, "Incomplete mesh data.");
+  }
+  return OkStatus();
+}
+
+bool StreamingMeshDecoder::IsAttributeDecoded(int att_id) const {
+  if (att_id < 0 || att_id >= static_cast<int>(decoded_attributes_.size())) {
+    return false;
+  }
+  return decoded_attributes_[att_id];
+}
+
+int StreamingMeshDecoder::num_decoded_attributes() const {
+  return static_cast<int>(std::count(decoded_attributes_.begin(),
+                                     decoded_attributes_.end(), true));
+}
+
+std::unique_ptr<Mesh> StreamingMeshDecoder::ReleaseMesh() {
+  if (!decoded_) {
+    return nullptr;
+  }
+  decoded_attributes_.clear();
+  return std::move(mesh_);
+}
+
+Status StreamingMeshDecoder::DecodeBufferedData() {
+#ifdef DRACO_MESH_COMPRESSION_SUPPORTED
+  DecoderBuffer buffer;
+  buffer.Init(data_.data(), data_.size());
+  DracoHeader header;
+  DecoderBuffer header_buffer(buffer);
+  const Status header_status =
+      PointCloudDecoder::DecodeHeader(&header_buffer, &header);
+  if (!header_status.ok()) {
+    if (ChunkedMeshDecoder::IsChunkedMesh(&buffer)) {
+      return Status(Status::DRACO_ERROR, "Chunked meshes are not supported.");
+    }
+    if (data_.size() >= kDracoHeaderSize || finished_) {
+      return header_status;
+    }
+    next_decoding_size_ = kDracoHeaderSize;
+    return OkStatus();
+  }
+  if (header.encoder_type != TRIANGULAR_MESH) {
+    return Status(Status::DRACO_ERROR, "Input is not a mesh.");
+  }
+  std::unique_ptr<MeshDecoder> decoder;
+  if (header.encoder_method == MESH_SEQUENTIAL_ENCODING) {
+    decoder.reset(new MeshSequentialDecoder());
+  } else if (header.encoder_method == MESH_EDGEBREAKER_ENCODING) {
+    decoder.reset(new MeshEdgebreakerDecoder());
+  } else {
+    return Status(Status::DRACO_ERROR, "Unsupported encoding method.");
+  }
+
+  // Reads past the end of the buffered data either fail or, for bit
+  // sequences, return zeros. Both are reported to |missing_data|.
+  DecoderBuffer::MissingDataTracker missing_data = {data_.data(), -1};
+  buffer.set_missing_data_tracker(&missing_data);
+  std::unique_ptr<Mesh> mesh(new Mesh());
+  const Status status = decoder->Decode(options_, &buffer, mesh.get());
+  const bool data_missing =
+      missing_data.required_size > static_cast<int64_t>(data_.size());
+  if (status.ok() && !data_missing) {
+    decoded_ = true;
+  } else if (finished_) {
+    return status;
+  } else if (data_missing) {
+    next_decoding_size_ = std::max<size_t>(
+        static_cast<size_t>(std::min<int64_t>(
+            missing_data.required_size,
+            static_cast<int64_t>(std::numeric_limits<size_t>::max() / 2))),
+        data_.size() + data_.size() / 4);
+  } else {
+    // The decoder failed without telling how much data it needs.
+    next_decoding_size_ = 2 * data_.size();
+  }
+
+  // A part of the mesh that ended before the end of the buffered data was
+  // decoded from complete data and it is identical to the part decoded from
+  // all of the encoded data. A part that ended at the end of the buffered data
+  // may have been decoded from zeros padding the truncated data.
+  const char *const data_end = data_.data() + data_.size();
+  const auto is_part_decoded = [&](const char *part_end) {
+    return decoded_ || part_end < data_end;
+  };
+  if (!decoder->is_geometry_data_decoded() ||
+      !is_part_decoded(decoder->geometry_data_end())) {
+    return OkStatus();
+  }
+  std::vector<bool> decoded_attributes(mesh->num_attributes(), decoded_);
+  for (int d = 0; d < decoder->num_decoded_attributes_decoders(); ++d) {
+    if (!is_part_decoded(decoder->attributes_decoder_data_end(d))) {
+      break;
+    }
+    const AttributesDecoderInterface *const att_dec =
+        decoder->attributes_decoder(d);
+    for (int i = 0; i < att_dec->GetNumAttributes(); ++i) {
+      const int32_t att_id = att_dec->GetAttributeId(i);
+      if (att_id >= 0 && att_id < mesh->num_attributes()) {
+        decoded_attributes[att_id] = true;
+      }
+    }
+  }
+  mesh_ = std::move(mesh);
+  decoded_attributes_ = std::move(decoded_attributes);
+  return OkStatus();
+#else
+  return Status(Status::DRACO_ERROR, "Unsupported geometry type.");
+#endif
+}
+
+}  // namespace draco
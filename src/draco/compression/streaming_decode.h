@@ -0,0 +1,111 @@
+// Copyright 2016 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_COMPRESSION_STREAMING_DECODE_H_
+#define DRACO_COMPRESSION_STREAMING_DECODE_H_
+
+#include <memory>
+#include <vector>
+
+#include "draco/compression/config/decoder_options.h"
+#include "draco/core/status.h"
+#include "draco/mesh/mesh.h"
+
+namespace draco {
+
+// Incremental decoder for meshes encoded with the EncodeMeshToBuffer method in
+// encode.h. The encoded data can be passed to the decoder in arbitrary pieces
+// as they arrive (e.g. from a network stream) using AppendData(). The decoder
+// makes the decoded mesh available progressively: the connectivity is exposed
+// as soon as it was decoded and the attributes are exposed as their attribute
+// decoders complete.
+//
+// The encoded data doesn't store sizes of the individual parts of the mesh and
+// the decoders can't resume from a saved state, so each decoding attempt
+// decodes the buffered data from the beginning. An attempt that runs out of
+// data records the size of the data it needed (e.g. the declared size of an
+// entropy coded block) and the next attempt is made only once that much data
+// was buffered and the buffered data grew by a constant factor, which keeps
+// the total decoding cost proportional to the size of the input. Parts of the
+// mesh decoded from data that may be truncated are never exposed: a part is
+// exposed only when its encoded data ended before the end of the buffered data
+// or when no read ran past the end of the buffered data (bit sequences are
+// otherwise padded with zeros).
+//
+// The attributes are exposed per attributes decoder, i.e., attributes sharing
+// one decoder (such as all attributes without seams in the Edgebreaker
+// encoding) become available at the same time. When a thread pool is set in
+// the decoder options, all attributes become available at once.
+//
+// Chunked meshes (see ChunkedMeshEncoder) are not supported.
+class StreamingMeshDecoder {
+ public:
+  StreamingMeshDecoder();
+
+  // Appends |data_size| bytes of encoded data to the decoder and decodes as
+  // much of the mesh as possible. Returns an error when the data is not a
+  // Draco mesh. Errors in the encoded data that can't be distinguished from
+  // incomplete data are reported by Finish().
+  Status AppendData(const char *data, size_t data_size);
+
+  // Signals that all encoded data was appended. Decodes the remaining parts of
+  // the mesh and returns an error when the mesh could not be fully decoded.
+  Status Finish();
+
+  // Returns true when the connectivity of the mesh was decoded.
+  bool is_connectivity_decoded() const { return mesh_ != nullptr; }
+
+  // Returns true when the whole mesh was decoded.
+  bool is_decoded() const { return decoded_; }
+
+  // Returns true when the values of attribute |att_id| were decoded.
+  bool IsAttributeDecoded(int att_id) const;
+
+  // Returns the number of attributes with decoded values.
+  int num_decoded_attributes() const;
+
+  // Returns the partially decoded mesh or nullptr when the connectivity was
+  // not decoded yet. The mesh contains all faces and points and all
+  // attributes of the encoded mesh, but only the values of the attributes for
+  // which IsAttributeDecoded() returns true are valid. The returned pointer
+  // is invalidated by subsequent calls to AppendData() and Finish().
+  const Mesh *mesh() const { return mesh_.get(); }
+
+  // Returns the ownership of the decoded mesh. Can be called only after the
+  // whole mesh was decoded.
+  std::unique_ptr<Mesh> ReleaseMesh();
+
+  // Returns the options used by the decoder. Must be set before any data is
+  // appended.
+  DecoderOptions *options() { return &options_; }
+
+ private:
+  // Decodes the buffered data from the beginning.
+  Status DecodeBufferedData();
+
+  DecoderOptions options_;
+  std::vector<char> data_;
+
+  // Size of the buffered data that triggers the next decoding attempt.
+  size_t next_decoding_size_;
+  bool finished_;
+  bool decoded_;
+
+  std::unique_ptr<Mesh> mesh_;
+  std::vector<bool> decoded_attributes_;
+};
+
+}  // namespace draco
+
+#endif  // DRACO_COMPRESSION_STREAMING_DECODE_H_
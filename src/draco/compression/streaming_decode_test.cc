@@ -0,0 +1,230 @@
+// Copyright 2016 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/compression/streaming_decode.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "draco/compression/decode.h"
+#include "draco/compression/encode.h"
+#include "draco/core/draco_test_base.h"
+#include "draco/core/draco_test_utils.h"
+
+namespace {
+
+class StreamingDecodeTest : public ::testing::Test {
+ protected:
+  // Encodes |file_name| using the |encoding_method| with quantized attributes.
+  void EncodeTestMesh(const std::string &file_name, int encoding_method,
+                      draco::EncoderBuffer *buffer) {
+    const std::unique_ptr<draco::Mesh> mesh =
+        draco::ReadMeshFromTestFile(file_name);
+    ASSERT_NE(mesh, nullptr);
+    draco::Encoder encoder;
+    encoder.SetEncodingMethod(encoding_method);
+    encoder.SetAttributeQuantization(draco::GeometryAttribute::POSITION, 14);
+    encoder.SetAttributeQuantization(draco::GeometryAttribute::TEX_COORD, 12);
+    encoder.SetAttributeQuantization(draco::GeometryAttribute::NORMAL, 10);
+    DRACO_ASSERT_OK(encoder.EncodeMeshToBuffer(*mesh, buffer));
+  }
+
+  // Verifies that |mesh| is identical to |expected_mesh|.
+  void CompareMeshes(const draco::Mesh &expected_mesh,
+                     const draco::Mesh &mesh) {
+    ASSERT_EQ(mesh.num_faces(), expected_mesh.num_faces());
+    ASSERT_EQ(mesh.num_points(), expected_mesh.num_points());
+    ASSERT_EQ(mesh.num_attributes(), expected_mesh.num_attributes());
+    for (draco::FaceIndex f(0); f < mesh.num_faces(); ++f) {
+      ASSERT_EQ(mesh.face(f), expected_mesh.face(f));
+    }
+    for (int a = 0; a < mesh.num_attributes(); ++a) {
+      CompareAttributes(*expected_mesh.attribute(a), *mesh.attribute(a),
+                        mesh.num_points());
+    }
+  }
+
+  // Verifies that the values of |att| are identical to |expected_att|.
+  void CompareAttributes(const draco::PointAttribute &expected_att,
+                         const draco::PointAttribute &att, int num_points) {
+    ASSERT_EQ(att.size(), expected_att.size());
+    ASSERT_EQ(att.byte_stride(), expected_att.byte_stride());
+    for (draco::PointIndex pi(0); pi < num_points; ++pi) {
+      ASSERT_EQ(att.mapped_index(pi), expected_att.mapped_index(pi));
+    }
+    ASSERT_EQ(memcmp(att.GetAddress(draco::AttributeValueIndex(0)),
+                     expected_att.GetAddress(draco::AttributeValueIndex(0)),
+                     att.size() * att.byte_stride()),
+              0);
+  }
+
+  // Decodes every truncated prefix of |buffer| and verifies that the decoder
+  // never exposes parts of the mesh that differ from the complete mesh and
+  // that Finish() fails.
+  void TestTruncatedPrefixes(const draco::EncoderBuffer &buffer) {
+    draco::DecoderBuffer decoder_buffer;
+    decoder_buffer.Init(buffer.data(), buffer.size());
+    draco::Decoder decoder;
+    const std::unique_ptr<draco::Mesh> expected_mesh =
+        decoder.DecodeMeshFromBuffer(&decoder_buffer).value();
+    ASSERT_NE(expected_mesh, nullptr);
+
+    bool partial_mesh_seen = false;
+    for (size_t size = 0; size < buffer.size(); ++size) {
+      draco::StreamingMeshDecoder streaming_decoder;
+      DRACO_ASSERT_OK(streaming_decoder.AppendData(buffer.data(), size));
+      ASSERT_FALSE(streaming_decoder.is_decoded());
+      const draco::Mesh *const mesh = streaming_decoder.mesh();
+      if (mesh != nullptr) {
+        partial_mesh_seen = true;
+        ASSERT_EQ(mesh->num_faces(), expected_mesh->num_faces());
+        for (draco::FaceIndex f(0); f < mesh->num_faces(); ++f) {
+          ASSERT_EQ(mesh->face(f), expected_mesh->face(f));
+        }
+        for (int a = 0; a < mesh->num_attributes(); ++a) {
+          if (streaming_decoder.IsAttributeDecoded(a)) {
+            CompareAttributes(*expected_mesh->attribute(a),
+                              *mesh->attribute(a), mesh->num_points());
+          }
+        }
+      }
+      ASSERT_FALSE(streaming_decoder.Finish().ok());
+      ASSERT_EQ(streaming_decoder.ReleaseMesh(), nullptr);
+    }
+    ASSERT_TRUE(partial_mesh_seen);
+  }
+
+  // Decodes |buffer| by appending |piece_size| bytes at a time and compares
+  // the result with the regular decoder.
+  void TestStreamingDecoding(const draco::EncoderBuffer &buffer,
+                             size_t piece_size) {
+    draco::DecoderBuffer decoder_buffer;
+    decoder_buffer.Init(buffer.data(), buffer.size());
+    draco::Decoder decoder;
+    const std::unique_ptr<draco::Mesh> expected_mesh =
+        decoder.DecodeMeshFromBuffer(&decoder_buffer).value();
+    ASSERT_NE(expected_mesh, nullptr);
+
+    draco::StreamingMeshDecoder streaming_decoder;
+    bool partial_mesh_seen = false;
+    for (size_t offset = 0; offset < buffer.size(); offset += piece_size) {
+      const size_t size = std::min(piece_size, buffer.size() - offset);
+      DRACO_ASSERT_OK(
+          streaming_decoder.AppendData(buffer.data() + offset, size));
+      const draco::Mesh *const mesh = streaming_decoder.mesh();
+      if (mesh == nullptr) {
+        ASSERT_EQ(streaming_decoder.num_decoded_attributes(), 0);
+        continue;
+      }
+      // The connectivity must be complete as soon as it is exposed.
+      ASSERT_EQ(mesh->num_faces(), expected_mesh->num_faces());
+      ASSERT_EQ(mesh->num_points(), expected_mesh->num_points());
+      if (!streaming_decoder.is_decoded()) {
+        partial_mesh_seen = true;
+      }
+    }
+    DRACO_ASSERT_OK(streaming_decoder.Finish());
+    ASSERT_TRUE(streaming_decoder.is_decoded());
+    ASSERT_EQ(streaming_decoder.num_decoded_attributes(),
+              expected_mesh->num_attributes());
+    if (piece_size < buffer.size() / 4) {
+      ASSERT_TRUE(partial_mesh_seen);
+    }
+    const std::unique_ptr<draco::Mesh> mesh = streaming_decoder.ReleaseMesh();
+    ASSERT_NE(mesh, nullptr);
+    CompareMeshes(*expected_mesh, *mesh);
+  }
+};
+
+TEST_F(StreamingDecodeTest, TestEdgebreakerDecoding) {
+  draco::EncoderBuffer buffer;
+  EncodeTestMesh("cube_att.obj", draco::MESH_EDGEBREAKER_ENCODING, &buffer);
+  TestStreamingDecoding(buffer, 1);
+  TestStreamingDecoding(buffer, 7);
+  TestStreamingDecoding(buffer, buffer.size());
+}
+
+TEST_F(StreamingDecodeTest, TestSequentialDecoding) {
+  draco::EncoderBuffer buffer;
+  EncodeTestMesh("test_nm.obj", draco::MESH_SEQUENTIAL_ENCODING, &buffer);
+  TestStreamingDecoding(buffer, 1);
+  TestStreamingDecoding(buffer, 64);
+}
+
+TEST_F(StreamingDecodeTest, TestAttributesDecodedProgressively) {
+  // Tests that the attributes become available before the whole mesh is
+  // received.
+  draco::EncoderBuffer buffer;
+  EncodeTestMesh("cube_att.obj", draco::MESH_EDGEBREAKER_ENCODING, &buffer);
+  draco::StreamingMeshDecoder streaming_decoder;
+  int max_partially_decoded_attributes = 0;
+  for (size_t offset = 0; offset < buffer.size(); ++offset) {
+    DRACO_ASSERT_OK(streaming_decoder.AppendData(buffer.data() + offset, 1));
+    if (!streaming_decoder.is_decoded()) {
+      max_partially_decoded_attributes =
+          std::max(max_partially_decoded_attributes,
+                   streaming_decoder.num_decoded_attributes());
+    }
+  }
+  DRACO_ASSERT_OK(streaming_decoder.Finish());
+  ASSERT_GT(max_partially_decoded_attributes, 0);
+  ASSERT_TRUE(streaming_decoder.IsAttributeDecoded(0));
+}
+
+TEST_F(StreamingDecodeTest, TestTruncatedData) {
+  draco::EncoderBuffer buffer;
+  EncodeTestMesh("test_nm.obj", draco::MESH_EDGEBREAKER_ENCODING, &buffer);
+  draco::StreamingMeshDecoder streaming_decoder;
+  DRACO_ASSERT_OK(
+      streaming_decoder.AppendData(buffer.data(), buffer.size() - 1));
+  ASSERT_FALSE(streaming_decoder.is_decoded());
+  ASSERT_FALSE(streaming_decoder.Finish().ok());
+  ASSERT_EQ(streaming_decoder.ReleaseMesh(), nullptr);
+}
+
+TEST_F(StreamingDecodeTest, TestTruncatedPrefixes) {
+  // Tests that no prefix of the encoded data is decoded into wrong parts of
+  // the mesh, even when the truncated data ends inside of a bit sequence that
+  // is decoded with zero padding.
+  draco::EncoderBuffer buffer;
+  EncodeTestMesh("cube_att.obj", draco::MESH_EDGEBREAKER_ENCODING, &buffer);
+  TestTruncatedPrefixes(buffer);
+
+  // The compressed connectivity of the sequential encoding ends with a bit
+  // sequence of tagged symbols, so many truncated prefixes of this data decode
+  // the connectivity without errors.
+  const std::unique_ptr<draco::Mesh> mesh =
+      draco::ReadMeshFromTestFile("test_nm.obj");
+  ASSERT_NE(mesh, nullptr);
+  draco::Encoder encoder;
+  encoder.SetEncodingMethod(draco::MESH_SEQUENTIAL_ENCODING);
+  encoder.options().SetGlobalBool("compress_connectivity", true);
+  buffer.Clear();
+  DRACO_ASSERT_OK(encoder.EncodeMeshToBuffer(*mesh, &buffer));
+  TestTruncatedPrefixes(buffer);
+}
+
+TEST_F(StreamingDecodeTest, TestPointCloudInput) {
+  const std::unique_ptr<draco::PointCloud> pc =
+      draco::ReadPointCloudFromTestFile("point_cloud_test_pos.ply");
+  ASSERT_NE(pc, nullptr);
+  draco::Encoder encoder;
+  draco::EncoderBuffer buffer;
+  DRACO_ASSERT_OK(encoder.EncodePointCloudToBuffer(*pc, &buffer));
+  draco::StreamingMeshDecoder streaming_decoder;
+  ASSERT_FALSE(
+      streaming_decoder.AppendData(buffer.data(), buffer.size()).ok());
+}
+
+}  // namespace
@@ -0,0 +1,86 @@
+// Copyright 2016 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/core/arena.h"
+
+#include <algorithm>
+#include <new>
+
+namespace draco {
+
+namespace {
+
+// Alignment of all allocations.
+constexpr size_t kAlignment = alignof(std::max_align_t);
+
+// Default size of the arena blocks.
+constexpr size_t kDefaultBlockSize = 1 << 16;
+
+}  // namespace
+
+Arena::Arena(size_t block_size)
+    : block_size_(std::max<size_t>(block_size, kAlignment)),
+      block_offset_(0),
+      allocated_size_(0),
+      capacity_(0) {}
+
+Arena::Arena() : Arena(kDefaultBlockSize) {}
+
+void *Arena::Allocate(size_t size) {
+  if (size > SIZE_MAX - kAlignment) {
+    return nullptr;
+  }
+  const size_t aligned_size = (size + kAlignment - 1) & ~(kAlignment - 1);
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (blocks_.empty() || blocks_.back().size - block_offset_ < aligned_size) {
+    if (!AddBlock(aligned_size)) {
+      return nullptr;
+    }
+  }
+  uint8_t *const data = blocks_.back().data.get() + block_offset_;
+  block_offset_ += aligned_size;
+  allocated_size_ += aligned_size;
+  return data;
+}
+
+void Arena::Reset() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (blocks_.size() > 1) {
+    // Replace all blocks with a single one so that the same allocations fit
+    // into one block next time.
+    const size_t size = capacity_;
+    blocks_.clear();
+    capacity_ = 0;
+    AddBlock(size);
+  }
+  block_offset_ = 0;
+  allocated_size_ = 0;
+}
+
+bool Arena::AddBlock(size_t min_size) {
+  // Grow the blocks geometrically to keep their number low.
+  const size_t size = std::max(min_size, std::max(block_size_, capacity_));
+  Block block;
+  block.data.reset(new (std::nothrow) uint8_t[size]);
+  if (block.data == nullptr) {
+    return false;
+  }
+  block.size = size;
+  blocks_.push_back(std::move(block));
+  block_offset_ = 0;
+  capacity_ += size;
+  return true;
+}
+
+}  // namespace draco
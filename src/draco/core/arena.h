@@ -0,0 +1,92 @@
+// Copyright 2016 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_CORE_ARENA_H_
+#define DRACO_CORE_ARENA_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace draco {
+
+// Monotonic allocator for temporary data that shares one lifetime, such as
+// the intermediate buffers of a single decode (see DecoderOptions::SetArena()).
+// Memory is carved out of large blocks and individual allocations are never
+// freed. Instead, all memory is released at once by Reset(), which keeps the
+// blocks for reuse so that repeated decodes of similarly sized geometry don't
+// allocate any memory from the heap. Allocate() can be called from multiple
+// threads at the same time.
+class Arena {
+ public:
+  // Creates an arena that allocates blocks of at least |block_size| bytes.
+  explicit Arena(size_t block_size);
+  Arena();
+
+  // Returns |size| bytes of uninitialized memory aligned for any fundamental
+  // type. The memory is valid until the next call to Reset() or until the
+  // arena is destroyed. Returns nullptr when the memory can't be allocated.
+  void *Allocate(size_t size);
+
+  // Same as Allocate() for an array of |count| elements of type T.
+  template <typename T>
+  T *AllocateArray(size_t count) {
+    if (count > SIZE_MAX / sizeof(T)) {
+      return nullptr;
+    }
+    return static_cast<T *>(Allocate(count * sizeof(T)));
+  }
+
+  // Invalidates all memory returned by Allocate(). When the previous
+  // allocations spanned multiple blocks, they are merged into one block that
+  // can hold all of them.
+  void Reset();
+
+  // Returns the number of bytes allocated since the last Reset().
+  size_t allocated_size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return allocated_size_;
+  }
+
+  // Returns the total size of all blocks owned by the arena.
+  size_t capacity() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return capacity_;
+  }
+
+ private:
+  struct Block {
+    std::unique_ptr<uint8_t[]> data;
+    size_t size;
+  };
+
+  // Adds a new block that can hold at least |min_size| bytes.
+  bool AddBlock(size_t min_size);
+
+  size_t block_size_;
+  std::vector<Block> blocks_;
+  // Offset of the first free byte in the last block.
+  size_t block_offset_;
+  size_t allocated_size_;
+  size_t capacity_;
+  // Guards all members. Mutable so that the const accessors can be called
+  // while other threads allocate.
+  mutable std::mutex mutex_;
+};
+
+}  // namespace draco
+
+#endif  // DRACO_CORE_ARENA_H_
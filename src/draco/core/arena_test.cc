@@ -0,0 +1,121 @@
+// Copyright 2016 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/core/arena.h"
+
+#include <cstring>
+#include <utility>
+
+#include "draco/core/data_buffer.h"
+#include "draco/core/draco_test_base.h"
+
+namespace {
+
+class ArenaTest : public ::testing::Test {
+ protected:
+  ArenaTest() {}
+};
+
+TEST_F(ArenaTest, TestAllocate) {
+  draco::Arena arena(64);
+  uint8_t *const a = static_cast<uint8_t *>(arena.Allocate(10));
+  uint8_t *const b = static_cast<uint8_t *>(arena.Allocate(100));
+  int32_t *const c = arena.AllocateArray<int32_t>(1000);
+  ASSERT_NE(a, nullptr);
+  ASSERT_NE(b, nullptr);
+  ASSERT_NE(c, nullptr);
+  // All allocations are aligned.
+  ASSERT_EQ(reinterpret_cast<uintptr_t>(b) % alignof(std::max_align_t), 0);
+  ASSERT_EQ(reinterpret_cast<uintptr_t>(c) % alignof(std::max_align_t), 0);
+  memset(a, 1, 10);
+  memset(b, 2, 100);
+  memset(c, 3, 1000 * sizeof(int32_t));
+  ASSERT_EQ(a[9], 1);
+  ASSERT_EQ(b[0], 2);
+  ASSERT_GE(arena.allocated_size(), 10 + 100 + 4000);
+  ASSERT_GE(arena.capacity(), arena.allocated_size());
+}
+
+TEST_F(ArenaTest, TestResetReusesMemory) {
+  // After a reset, the same allocations fit into a single block and no new
+  // memory is allocated.
+  draco::Arena arena(64);
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_NE(arena.Allocate(100 * (i + 1)), nullptr);
+  }
+  arena.Reset();
+  ASSERT_EQ(arena.allocated_size(), 0);
+  const size_t capacity = arena.capacity();
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_NE(arena.Allocate(100 * (i + 1)), nullptr);
+  }
+  ASSERT_EQ(arena.capacity(), capacity);
+}
+
+TEST_F(ArenaTest, TestDataBufferFromArena) {
+  draco::Arena arena;
+  draco::DataBuffer buffer;
+  ASSERT_TRUE(buffer.AllocateFromArena(&arena, 16));
+  ASSERT_TRUE(buffer.is_external());
+  ASSERT_EQ(buffer.data_size(), 16);
+  for (size_t i = 0; i < buffer.data_size(); ++i) {
+    ASSERT_EQ(buffer.data()[i], 0);
+  }
+  const uint8_t values[4] = {1, 2, 3, 4};
+  ASSERT_TRUE(buffer.Update(values, 4, 12));
+  ASSERT_TRUE(buffer.is_external());
+  ASSERT_EQ(buffer.data()[15], 4);
+
+  // Copies of the buffer own their data.
+  const draco::DataBuffer copy = buffer;
+  ASSERT_FALSE(copy.is_external());
+  ASSERT_EQ(copy.data_size(), 16);
+  ASSERT_EQ(memcmp(copy.data(), buffer.data(), 16), 0);
+
+  // Growing the buffer beyond the external memory moves the data into the
+  // buffer's own storage.
+  ASSERT_TRUE(buffer.Update(values, 4, 16));
+  ASSERT_FALSE(buffer.is_external());
+  ASSERT_EQ(buffer.data_size(), 20);
+  ASSERT_EQ(buffer.data()[15], 4);
+  ASSERT_EQ(buffer.data()[19], 4);
+}
+
+TEST_F(ArenaTest, TestDataBufferExternalData) {
+  uint8_t memory[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+  draco::DataBuffer buffer;
+  buffer.SetExternalData(memory, 8);
+  ASSERT_EQ(buffer.data(), memory);
+  buffer.Resize(4);
+  ASSERT_EQ(buffer.data(), memory);
+  ASSERT_EQ(buffer.data_size(), 4);
+  // Newly exposed memory is zeroed.
+  buffer.Resize(6);
+  ASSERT_EQ(buffer.data(), memory);
+  ASSERT_EQ(memory[3], 4);
+  ASSERT_EQ(memory[4], 0);
+
+  // Moved buffers keep the external memory and the source becomes empty.
+  draco::DataBuffer moved(std::move(buffer));
+  ASSERT_EQ(moved.data(), memory);
+  ASSERT_EQ(moved.data_size(), 6);
+  ASSERT_FALSE(buffer.is_external());
+  ASSERT_EQ(buffer.data_size(), 0);
+  draco::DataBuffer assigned;
+  assigned = std::move(moved);
+  ASSERT_EQ(assigned.data(), memory);
+  ASSERT_FALSE(moved.is_external());
+}
+
+}  // namespace
@@ -74,6 +74,25 @@ inline int MostSignificantBit(uint32_t n) {
 #endif
 }
 
+// Returns the location of the least significant bit in the input integer |n|.
+// The functionality is not defined for |n == 0|.
+inline int LeastSignificantBit64(uint64_t n) {
+#if defined(__GNUC__)
+  return __builtin_ctzll(n);
+#elif defined(_MSC_VER) && defined(_WIN64)
+  unsigned long where;
+  _BitScanForward64(&where, n);
+  return (int)where;
+#else
+  int lsb = 0;
+  while ((n & 1) == 0) {
+    lsb++;
+    n >>= 1;
+  }
+  return lsb;
+#endif
+}
+
 // Helper function that converts signed integer values into unsigned integer
 // symbols that can be encoded using an entropy encoder.
 void ConvertSignedIntsToSymbols(const int32_t *in, int in_values,
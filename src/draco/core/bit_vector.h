@@ -0,0 +1,137 @@
+// Copyright 2016 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_CORE_BIT_VECTOR_H_
+#define DRACO_CORE_BIT_VECTOR_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "draco/core/bit_utils.h"
+
+namespace draco {
+
+// Fixed size array of bits stored in 64-bit words. Compared to
+// std::vector<bool>, the class exposes the underlying words so that unset or
+// set bits can be found with a single scan over whole words, which is used
+// for example to locate the next unvisited face during mesh traversals.
+class BitVector {
+ public:
+  static constexpr size_t kBitsPerWord = 64;
+
+  BitVector() : size_(0) {}
+  explicit BitVector(size_t size, bool value = false) : size_(0) {
+    assign(size, value);
+  }
+
+  // Resizes the vector to |size| bits and sets all of them to |value|.
+  void assign(size_t size, bool value) {
+    size_ = size;
+    words_.assign(NumWords(size), value ? ~static_cast<uint64_t>(0) : 0);
+    ClearUnusedBits();
+  }
+  void clear() {
+    size_ = 0;
+    words_.clear();
+  }
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  bool operator[](size_t i) const { return test(i); }
+  bool test(size_t i) const {
+    return (words_[i / kBitsPerWord] >> (i % kBitsPerWord)) & 1;
+  }
+  void set(size_t i) {
+    words_[i / kBitsPerWord] |= static_cast<uint64_t>(1) << (i % kBitsPerWord);
+  }
+  void reset(size_t i) {
+    words_[i / kBitsPerWord] &=
+        ~(static_cast<uint64_t>(1) << (i % kBitsPerWord));
+  }
+  void set(size_t i, bool value) {
+    if (value) {
+      set(i);
+    } else {
+      reset(i);
+    }
+  }
+
+  // Returns the index of the first set bit at position |start| or higher, or
+  // size() when there is no such bit.
+  size_t FindNextSet(size_t start) const { return FindNext(start, 0); }
+
+  // Returns the index of the first unset bit at position |start| or higher,
+  // or size() when there is no such bit.
+  size_t FindNextUnset(size_t start) const {
+    return FindNext(start, ~static_cast<uint64_t>(0));
+  }
+
+  // Returns the number of set bits.
+  size_t CountSetBits() const {
+    size_t count = 0;
+    for (const uint64_t word : words_) {
+      count += CountOneBits32(static_cast<uint32_t>(word)) +
+               CountOneBits32(static_cast<uint32_t>(word >> 32));
+    }
+    return count;
+  }
+
+  const uint64_t *words() const { return words_.data(); }
+  size_t num_words() const { return words_.size(); }
+
+ private:
+  static size_t NumWords(size_t size) {
+    return (size + kBitsPerWord - 1) / kBitsPerWord;
+  }
+
+  // Bits past size() are kept at zero so that word level operations do not
+  // need to mask the last word.
+  void ClearUnusedBits() {
+    const size_t tail = size_ % kBitsPerWord;
+    if (tail != 0) {
+      words_.back() &= (static_cast<uint64_t>(1) << tail) - 1;
+    }
+  }
+
+  // Finds the first bit at position |start| or higher that is set in the
+  // words xor-ed with |flip|.
+  size_t FindNext(size_t start, uint64_t flip) const {
+    if (start >= size_) {
+      return size_;
+    }
+    size_t word_id = start / kBitsPerWord;
+    // Ignore bits before |start| in the first word.
+    uint64_t word = (words_[word_id] ^ flip) &
+                    (~static_cast<uint64_t>(0) << (start % kBitsPerWord));
+    while (word == 0) {
+      if (++word_id == words_.size()) {
+        return size_;
+      }
+      word = words_[word_id] ^ flip;
+    }
+    const size_t pos = word_id * kBitsPerWord + LeastSignificantBit64(word);
+    // Flipped unused bits of the last word may be reported as unset.
+    return pos < size_ ? pos : size_;
+  }
+
+  std::vector<uint64_t> words_;
+  size_t size_;
+};
+
+}  // namespace draco
+
+#endif  // DRACO_CORE_BIT_VECTOR_H_
@@ -0,0 +1,90 @@
+// Copyright 2016 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/core/bit_vector.h"
+
+#include <vector>
+
+#include "draco/core/draco_test_base.h"
+
+namespace {
+
+class BitVectorTest : public ::testing::Test {
+ protected:
+  BitVectorTest() {}
+};
+
+TEST_F(BitVectorTest, TestSetAndReset) {
+  draco::BitVector bits(130);
+  ASSERT_EQ(bits.size(), 130);
+  ASSERT_EQ(bits.CountSetBits(), 0);
+  bits.set(0);
+  bits.set(64);
+  bits.set(129);
+  ASSERT_TRUE(bits[0]);
+  ASSERT_FALSE(bits[1]);
+  ASSERT_TRUE(bits[64]);
+  ASSERT_TRUE(bits[129]);
+  ASSERT_EQ(bits.CountSetBits(), 3);
+  bits.reset(64);
+  ASSERT_FALSE(bits[64]);
+  bits.set(5, true);
+  bits.set(0, false);
+  ASSERT_TRUE(bits[5]);
+  ASSERT_FALSE(bits[0]);
+  ASSERT_EQ(bits.CountSetBits(), 2);
+
+  // Bits past the size of the vector are not counted.
+  bits.assign(70, true);
+  ASSERT_EQ(bits.CountSetBits(), 70);
+}
+
+TEST_F(BitVectorTest, TestFindNext) {
+  // Compare the word scans against a simple per-bit search.
+  const size_t size = 200;
+  draco::BitVector bits(size);
+  std::vector<bool> ref(size, false);
+  for (size_t i = 0; i < size; i += 7) {
+    bits.set(i);
+    ref[i] = true;
+  }
+  for (size_t i = 60; i < 140; ++i) {
+    bits.set(i);
+    ref[i] = true;
+  }
+  for (size_t start = 0; start <= size; ++start) {
+    size_t expected_set = start;
+    while (expected_set < size && !ref[expected_set]) {
+      ++expected_set;
+    }
+    size_t expected_unset = start;
+    while (expected_unset < size && ref[expected_unset]) {
+      ++expected_unset;
+    }
+    ASSERT_EQ(bits.FindNextSet(start), expected_set);
+    ASSERT_EQ(bits.FindNextUnset(start), expected_unset);
+  }
+}
+
+TEST_F(BitVectorTest, TestFindNextUnsetOnFullVector) {
+  draco::BitVector bits(100, true);
+  ASSERT_EQ(bits.FindNextUnset(0), 100);
+  bits.reset(99);
+  ASSERT_EQ(bits.FindNextUnset(0), 99);
+  ASSERT_EQ(bits.FindNextSet(99), 100);
+  draco::BitVector empty;
+  ASSERT_EQ(empty.FindNextUnset(0), 0);
+}
+
+}  // namespace
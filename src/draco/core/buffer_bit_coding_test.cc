@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 //
+#include <algorithm>
+
 #include "draco/core/decoder_buffer.h"
 #include "draco/core/draco_test_base.h"
 #include "draco/core/encoder_buffer.h"
@@ -35,6 +37,7 @@ TEST_F(BufferBitCodingTest, TestBitCodersByteAligned) {
     encoder.PutBits(data[i], sizeof(data[i]) * 8);
     ASSERT_EQ((i + 1) * sizeof(data[i]) * 8, encoder.Bits());
   }
+  encoder.Flush(0);
 
   BitDecoder decoder;
   decoder.reset(static_cast<const void *>(buffer), bytes_to_encode);
@@ -61,6 +64,7 @@ TEST_F(BufferBitCodingTest, TestBitCodersNonByte) {
                              : bits_to_encode - encoder.Bits();
     encoder.PutBits(data[i], num_bits);
   }
+  encoder.Flush(0);
 
   BitDecoder decoder;
   decoder.reset(static_cast<const void *>(buffer), bytes_to_encode);
@@ -112,4 +116,71 @@ TEST_F(BufferBitCodingTest, TestMultipleBits) {
   }
 }
 
+TEST_F(BufferBitCodingTest, TestUnalignedReadsMatchBitByBit) {
+  // Reads variable sized bit groups at every possible bit alignment, including
+  // groups that cross the end of the buffer, and compares them against values
+  // assembled one bit at a time.
+  uint8_t data[19];
+  for (int i = 0; i < static_cast<int>(sizeof(data)); ++i) {
+    data[i] = static_cast<uint8_t>(i * 37 + 11);
+  }
+  const uint64_t total_bits = sizeof(data) * 8;
+  for (int nbits = 0; nbits <= 32; ++nbits) {
+    BitDecoder decoder;
+    decoder.reset(static_cast<const void *>(data), sizeof(data));
+    uint64_t offset = 0;
+    while (offset < total_bits) {
+      uint32_t expected = 0;
+      for (int bit = 0; bit < nbits && offset + bit < total_bits; ++bit) {
+        const uint64_t pos = offset + bit;
+        expected |= ((data[pos >> 3] >> (pos & 7)) & 1u) << bit;
+      }
+      uint32_t x = 0;
+      ASSERT_TRUE(decoder.GetBits(nbits, &x));
+      ASSERT_EQ(expected, x);
+      offset = std::min(offset + nbits, total_bits);
+      ASSERT_EQ(offset, decoder.BitsDecoded());
+      if (nbits == 0) {
+        break;
+      }
+    }
+  }
+}
+
+TEST_F(BufferBitCodingTest, TestEncoderBufferBitSequenceSize) {
+  // Encodes bit sequences whose actual size needs fewer or the same number of
+  // varint bytes as the reserved size and checks they can be decoded back.
+  for (const int num_values : {3, 100, 1000}) {
+    for (const int64_t reserved_bits : {num_values * 9, num_values * 300}) {
+      EncoderBuffer encoder_buffer;
+      encoder_buffer.Encode(static_cast<uint8_t>(0xab));
+      ASSERT_TRUE(encoder_buffer.StartBitEncoding(reserved_bits, true));
+      for (int i = 0; i < num_values; ++i) {
+        encoder_buffer.EncodeLeastSignificantBits32(9, i * 7);
+      }
+      encoder_buffer.EndBitEncoding();
+      encoder_buffer.Encode(static_cast<uint8_t>(0xcd));
+
+      DecoderBuffer decoder_buffer;
+      decoder_buffer.Init(encoder_buffer.data(), encoder_buffer.size(),
+                          DRACO_BITSTREAM_VERSION(2, 2));
+      uint8_t marker;
+      ASSERT_TRUE(decoder_buffer.Decode(&marker));
+      ASSERT_EQ(marker, 0xab);
+      uint64_t encoded_size = 0;
+      ASSERT_TRUE(decoder_buffer.StartBitDecoding(true, &encoded_size));
+      ASSERT_EQ(encoded_size, (num_values * 9 + 7) / 8);
+      for (int i = 0; i < num_values; ++i) {
+        uint32_t value;
+        ASSERT_TRUE(decoder_buffer.DecodeLeastSignificantBits32(9, &value));
+        ASSERT_EQ(value, static_cast<uint32_t>(i * 7) & 0x1ff);
+      }
+      decoder_buffer.EndBitDecoding();
+      ASSERT_TRUE(decoder_buffer.Decode(&marker));
+      ASSERT_EQ(marker, 0xcd);
+      ASSERT_EQ(decoder_buffer.remaining_size(), 0);
+    }
+  }
+}
+
 }  // namespace draco
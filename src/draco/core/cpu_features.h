@@ -0,0 +1,49 @@
+// Copyright 2016 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_CORE_CPU_FEATURES_H_
+#define DRACO_CORE_CPU_FEATURES_H_
+
+// Runtime detection of optional instruction set extensions. Code that uses
+// the extensions must be compiled for the specific target (see the
+// DRACO_TARGET_* macros below) and it can be called only when the
+// corresponding Cpu*Supported() function returns true.
+
+#if (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || \
+     defined(_M_IX86)) &&                                           \
+    !defined(__EMSCRIPTEN__)
+#define DRACO_X86_SIMD_SUPPORTED 1
+#endif
+
+#ifdef DRACO_X86_SIMD_SUPPORTED
+#if defined(__GNUC__) || defined(__clang__)
+#define DRACO_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define DRACO_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define DRACO_TARGET_SSE41
+#define DRACO_TARGET_AVX2
+#endif
+#endif
+
+namespace draco {
+
+// Returns true when the SSE4.1 instructions can be used on the current CPU.
+bool CpuSse41Supported();
+
+// Returns true when the AVX2 instructions can be used on the current CPU.
+bool CpuAvx2Supported();
+
+}  // namespace draco
+
+#endif  // DRACO_CORE_CPU_FEATURES_H_
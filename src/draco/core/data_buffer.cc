@@ -15,10 +15,57 @@
 #include "draco/core/data_buffer.h"
 
 #include <algorithm>
+#include <utility>
 
 namespace draco {
 
-DataBuffer::DataBuffer() {}
+DataBuffer::DataBuffer()
+    : external_data_(nullptr), external_size_(0), external_capacity_(0) {}
+
+DataBuffer::DataBuffer(const DataBuffer &buffer)
+    : data_(buffer.data(), buffer.data() + buffer.data_size()),
+      external_data_(nullptr),
+      external_size_(0),
+      external_capacity_(0),
+      descriptor_(buffer.descriptor_) {}
+
+DataBuffer &DataBuffer::operator=(const DataBuffer &buffer) {
+  if (this != &buffer) {
+    data_.assign(buffer.data(), buffer.data() + buffer.data_size());
+    descriptor_ = buffer.descriptor_;
+    external_data_ = nullptr;
+    external_size_ = 0;
+    external_capacity_ = 0;
+  }
+  return *this;
+}
+
+DataBuffer::DataBuffer(DataBuffer &&buffer) noexcept
+    : data_(std::move(buffer.data_)),
+      external_data_(buffer.external_data_),
+      external_size_(buffer.external_size_),
+      external_capacity_(buffer.external_capacity_),
+      descriptor_(buffer.descriptor_) {
+  buffer.data_.clear();
+  buffer.external_data_ = nullptr;
+  buffer.external_size_ = 0;
+  buffer.external_capacity_ = 0;
+}
+
+DataBuffer &DataBuffer::operator=(DataBuffer &&buffer) noexcept {
+  if (this != &buffer) {
+    data_ = std::move(buffer.data_);
+    external_data_ = buffer.external_data_;
+    external_size_ = buffer.external_size_;
+    external_capacity_ = buffer.external_capacity_;
+    descriptor_ = buffer.descriptor_;
+    buffer.data_.clear();
+    buffer.external_data_ = nullptr;
+    buffer.external_size_ = 0;
+    buffer.external_capacity_ = 0;
+  }
+  return *this;
+}
 
 bool DataBuffer::Update(const void *data, int64_t size) {
   const int64_t offset = 0;
@@ -31,31 +78,79 @@ bool DataBuffer::Update(const void *data, int64_t size, int64_t offset) {
       return false;
     }
     // If no data is provided, just resize the buffer.
-    data_.resize(size + offset);
+    ResizeStorage(size + offset);
   } else {
     if (size < 0) {
       return false;
     }
-    if (size + offset > static_cast<int64_t>(data_.size())) {
-      data_.resize(size + offset);
+    if (size + offset > static_cast<int64_t>(data_size())) {
+      ResizeStorage(size + offset);
     }
     const uint8_t *const byte_data = static_cast<const uint8_t *>(data);
-    std::copy(byte_data, byte_data + size, data_.data() + offset);
+    std::copy(byte_data, byte_data + size, this->data() + offset);
   }
   descriptor_.buffer_update_count++;
   return true;
 }
 
 void DataBuffer::Resize(int64_t size) {
-  data_.resize(size);
+  ResizeStorage(size);
   descriptor_.buffer_update_count++;
 }
 
+void DataBuffer::ResizeStorage(int64_t size) {
+  if (external_data_ != nullptr) {
+    if (size <= external_capacity_) {
+      if (size > external_size_) {
+        // Newly exposed bytes are zeroed the same way as by data_.resize().
+        memset(external_data_ + external_size_, 0, size - external_size_);
+      }
+      external_size_ = size;
+    } else {
+      ReleaseExternalData(size);
+    }
+  } else {
+    data_.resize(size);
+  }
+}
+
+void DataBuffer::SetExternalData(void *data, int64_t size) {
+  data_.clear();
+  data_.shrink_to_fit();
+  external_data_ = static_cast<uint8_t *>(data);
+  external_size_ = data == nullptr ? 0 : size;
+  external_capacity_ = external_size_;
+  descriptor_.buffer_update_count++;
+}
+
+bool DataBuffer::AllocateFromArena(Arena *arena, int64_t size) {
+  if (arena == nullptr || size < 0) {
+    return false;
+  }
+  // Always allocate at least one byte so that the buffer is marked as
+  // external.
+  void *const data = arena->Allocate(std::max<int64_t>(size, 1));
+  if (data == nullptr) {
+    return false;
+  }
+  memset(data, 0, size);
+  SetExternalData(data, size);
+  return true;
+}
+
+void DataBuffer::ReleaseExternalData(int64_t new_size) {
+  data_.assign(external_data_, external_data_ + external_size_);
+  data_.resize(new_size);
+  external_data_ = nullptr;
+  external_size_ = 0;
+  external_capacity_ = 0;
+}
+
 void DataBuffer::WriteDataToStream(std::ostream &stream) {
-  if (data_.size() == 0) {
+  if (data_size() == 0) {
     return;
   }
-  stream.write(reinterpret_cast<char *>(data_.data()), data_.size());
+  stream.write(reinterpret_cast<char *>(data()), data_size());
 }
 
 }  // namespace draco
@@ -19,6 +19,7 @@
 #include <ostream>
 #include <vector>
 
+#include "draco/core/arena.h"
 #include "draco/core/draco_types.h"
 
 namespace draco {
@@ -32,17 +33,40 @@ struct DataBufferDescriptor {
   int64_t buffer_update_count;
 };
 
-// Class used for storing raw buffer data.
+// Class used for storing raw buffer data. By default the data is owned by the
+// buffer, but the buffer can also use memory owned by someone else, such as an
+// Arena (see SetExternalData()).
 class DataBuffer
 {
  public:
   DataBuffer();
+  // Copies always own their data.
+  DataBuffer(const DataBuffer &buffer);
+  DataBuffer &operator=(const DataBuffer &buffer);
+  // Moved buffers keep using the same external memory, if any.
+  DataBuffer(DataBuffer &&buffer) noexcept;
+  DataBuffer &operator=(DataBuffer &&buffer) noexcept;
+
   bool Update(const void *data, int64_t size);
   bool Update(const void *data, int64_t size, int64_t offset);
 
   // Reallocate the buffer storage to a new size keeping the data unchanged.
   void Resize(int64_t new_size);
 
+  // Makes the buffer use |size| bytes of external memory at |data|. The
+  // caller must keep the memory alive for the lifetime of the buffer. The
+  // buffer switches back to its own storage (copying the data) when it needs
+  // to grow beyond |size|.
+  void SetExternalData(void *data, int64_t size);
+
+  // Makes the buffer use |size| zero-initialized bytes allocated from
+  // |arena|. The buffer must not be used after the arena is reset. Returns
+  // false when the memory can't be allocated.
+  bool AllocateFromArena(Arena *arena, int64_t size);
+
+  // Returns true when the buffer uses external memory.
+  bool is_external() const { return external_data_ != nullptr; }
+
   void WriteDataToStream(std::ostream &stream);
 
   // Reads data from the buffer. Potentially unsafe, called needs to ensure
@@ -72,19 +96,36 @@ class DataBuffer
 
   int64_t update_count() const { return descriptor_.buffer_update_count; }
 
-  size_t data_size() const { return data_.size(); }
+  size_t data_size() const {
+    return external_data_ ? external_size_ : data_.size();
+  }
 
-  const uint8_t *data() const { return data_.data(); }
+  const uint8_t *data() const {
+    return external_data_ ? external_data_ : data_.data();
+  }
 
-  uint8_t *data() { return &data_[0]; }
+  uint8_t *data() { return external_data_ ? external_data_ : data_.data(); }
 
   int64_t buffer_id() const { return descriptor_.buffer_id; }
 
   void set_buffer_id(int64_t buffer_id) { descriptor_.buffer_id = buffer_id; }
 
  private:
+  // Resizes the used storage without updating the descriptor.
+  void ResizeStorage(int64_t new_size);
+
+  // Moves the external data into |data_| resized to |new_size|.
+  void ReleaseExternalData(int64_t new_size);
+
   std::vector<uint8_t> data_;
 
+  // External memory used instead of |data_| when not null.
+  uint8_t *external_data_;
+  int64_t external_size_;
+  // Size of the external memory block. |external_size_| can be smaller after
+  // the buffer was shrunk.
+  int64_t external_capacity_;
+
   // Counter incremented by Update() calls.
   DataBufferDescriptor descriptor_;
 };
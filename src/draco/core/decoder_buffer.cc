@@ -24,7 +24,8 @@ DecoderBuffer::DecoderBuffer()
       data_size_(0),
       pos_(0),
       bit_mode_(false),
-      bitstream_version_(0) {}
+      bitstream_version_(0),
+      missing_data_tracker_(nullptr) {}
 
 void DecoderBuffer::Init(const char *data, size_t data_size) {
   Init(data, data_size, bitstream_version_);
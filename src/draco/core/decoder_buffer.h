@@ -29,6 +29,17 @@ namespace draco {
 // basic interface for decoding either typed or variable-bit sized data.
 class DecoderBuffer {
  public:
+  // Records how much input data a decoder needed when it ran out of data.
+  // |data| is the beginning of the whole input data and |required_size| is
+  // the smallest size of the input data, counted from |data|, that the most
+  // recent failed read would need. |required_size| is -1 when no read ran out
+  // of data. Used by incremental decoders to wait for enough data before
+  // decoding again.
+  struct MissingDataTracker {
+    const char *data;
+    int64_t required_size;
+  };
+
   DecoderBuffer();
   DecoderBuffer(const DecoderBuffer &buf) = default;
 
@@ -58,6 +69,10 @@ class DecoderBuffer {
     if (!bit_decoder_active()) {
       return false;
     }
+    if (static_cast<uint64_t>(nbits) > bit_decoder_.AvailBits()) {
+      // The missing bits are decoded as zeros.
+      ReportMissingData((bit_decoder_.BitsDecoded() + nbits + 7) / 8);
+    }
     bit_decoder_.GetBits(nbits, out_value);
     return true;
   }
@@ -76,6 +91,7 @@ class DecoderBuffer {
 
   bool Decode(void *out_data, size_t size_to_decode) {
     if (data_size_ < static_cast<int64_t>(pos_ + size_to_decode)) {
+      ReportMissingData(size_to_decode);
       return false;  // Buffer overflow.
     }
     memcpy(out_data, (data_ + pos_), size_to_decode);
@@ -88,6 +104,7 @@ class DecoderBuffer {
   bool Peek(T *out_val) {
     const size_t size_to_decode = sizeof(T);
     if (data_size_ < static_cast<int64_t>(pos_ + size_to_decode)) {
+      ReportMissingData(size_to_decode);
       return false;  // Buffer overflow.
     }
     memcpy(out_val, (data_ + pos_), size_to_decode);
@@ -96,12 +113,24 @@ class DecoderBuffer {
 
   bool Peek(void *out_data, size_t size_to_peek) {
     if (data_size_ < static_cast<int64_t>(pos_ + size_to_peek)) {
+      ReportMissingData(size_to_peek);
       return false;  // Buffer overflow.
     }
     memcpy(out_data, (data_ + pos_), size_to_peek);
     return true;
   }
 
+  // Returns true when at least |size| bytes remain in the buffer. Otherwise
+  // reports the missing data to the missing data tracker and returns false.
+  // Used to validate sizes of encoded data declared in the input.
+  bool CheckRemainingSize(uint64_t size) {
+    if (static_cast<uint64_t>(remaining_size()) < size) {
+      ReportMissingData(size);
+      return false;
+    }
+    return true;
+  }
+
   // Discards #bytes from the input buffer.
   void Advance(int64_t bytes) { pos_ += bytes; }
 
@@ -120,7 +149,30 @@ class DecoderBuffer {
   // Returns the bitstream associated with the data. Returns 0 if unknown.
   uint16_t bitstream_version() const { return bitstream_version_; }
 
+  // Sets the tracker that receives the sizes of data missing in the buffer.
+  // The tracker is shared by all copies of the buffer and it is kept across
+  // calls to Init(), so |tracker->data| must point to the beginning of the
+  // data that the buffer is initialized with. Can be nullptr.
+  void set_missing_data_tracker(MissingDataTracker *tracker) {
+    missing_data_tracker_ = tracker;
+  }
+  MissingDataTracker *missing_data_tracker() const {
+    return missing_data_tracker_;
+  }
+
  private:
+  // Reports that |size| bytes were needed at the current position.
+  void ReportMissingData(uint64_t size) {
+    if (missing_data_tracker_ == nullptr) {
+      return;
+    }
+    const int64_t offset = (data_ - missing_data_tracker_->data) + pos_;
+    missing_data_tracker_->required_size =
+        size > static_cast<uint64_t>(INT64_MAX - offset)
+            ? INT64_MAX
+            : offset + static_cast<int64_t>(size);
+  }
+
   // Internal helper class to decode bits from a bit buffer.
   class BitDecoder {
    public:
@@ -147,12 +199,7 @@ class DecoderBuffer {
     inline uint32_t EnsureBits(int k) {
       DRACO_DCHECK_LE(k, 24);
       DRACO_DCHECK_LE(static_cast<uint64_t>(k), AvailBits());
-
-      uint32_t buf = 0;
-      for (int i = 0; i < k; ++i) {
-        buf |= PeekBit(i) << i;
-      }
-      return buf;  // Okay to return extra bits
+      return static_cast<uint32_t>(PeekWord() & LowBitsMask(k));
     }
 
     inline void ConsumeBits(int k) { bit_offset_ += k; }
@@ -161,38 +208,45 @@ class DecoderBuffer {
     inline bool GetBits(int32_t nbits, uint32_t *x) {
       DRACO_DCHECK_GE(nbits, 0);
       DRACO_DCHECK_LE(nbits, 32);
-      uint32_t value = 0;
-      for (int32_t bit = 0; bit < nbits; ++bit) {
-        value |= GetBit() << bit;
+      *x = static_cast<uint32_t>(PeekWord() & LowBitsMask(nbits));
+      // Bits past the end of the buffer are read as zeros and they do not
+      // advance the bit offset.
+      const uint64_t total_bits =
+          static_cast<uint64_t>(bit_buffer_end_ - bit_buffer_) * 8;
+      if (bit_offset_ < total_bits) {
+        const uint64_t avail_bits = total_bits - bit_offset_;
+        bit_offset_ += static_cast<uint64_t>(nbits) < avail_bits
+                           ? nbits
+                           : static_cast<size_t>(avail_bits);
       }
-      *x = value;
       return true;
     }
 
    private:
-    // TODO(fgalligan): Add support for error reporting on range check.
-    // Returns one bit from the bit buffer.
-    inline int GetBit() {
-      const size_t off = bit_offset_;
-      const size_t byte_offset = off >> 3;
-      const int bit_shift = static_cast<int>(off & 0x7);
-      if (bit_buffer_ + byte_offset < bit_buffer_end_) {
-        const int bit = (bit_buffer_[byte_offset] >> bit_shift) & 1;
-        bit_offset_ = off + 1;
-        return bit;
-      }
-      return 0;
+    static inline uint64_t LowBitsMask(int nbits) {
+      return (static_cast<uint64_t>(1) << nbits) - 1;
     }
 
-    inline int PeekBit(int offset) {
-      const size_t off = bit_offset_ + offset;
-      const size_t byte_offset = off >> 3;
-      const int bit_shift = static_cast<int>(off & 0x7);
-      if (bit_buffer_ + byte_offset < bit_buffer_end_) {
-        const int bit = (bit_buffer_[byte_offset] >> bit_shift) & 1;
-        return bit;
+    // TODO(fgalligan): Add support for error reporting on range check.
+    // Returns at least 57 bits starting at the current bit offset without
+    // advancing it. The whole word is fetched with a single unaligned load
+    // except near the end of the buffer, where the missing bytes are padded
+    // with zeros.
+    inline uint64_t PeekWord() const {
+      const size_t buffer_size = bit_buffer_end_ - bit_buffer_;
+      const size_t byte_offset = bit_offset_ >> 3;
+      const int bit_shift = static_cast<int>(bit_offset_ & 0x7);
+      uint64_t word = 0;
+      if (byte_offset + sizeof(word) <= buffer_size) {
+        // The bit stream is stored in little endian order.
+        memcpy(&word, bit_buffer_ + byte_offset, sizeof(word));
+      } else {
+        for (size_t i = byte_offset; i < buffer_size; ++i) {
+          word |= static_cast<uint64_t>(bit_buffer_[i])
+                  << (8 * (i - byte_offset));
+        }
       }
-      return 0;
+      return word >> bit_shift;
     }
 
     const uint8_t *bit_buffer_;
@@ -209,6 +263,7 @@ class DecoderBuffer {
   BitDecoder bit_decoder_;
   bool bit_mode_;
   uint16_t bitstream_version_;
+  MissingDataTracker *missing_data_tracker_;
 };
 
 }  // namespace draco
@@ -21,15 +21,46 @@
 namespace draco {
 
 EncoderBuffer::EncoderBuffer()
-    : bit_encoder_reserved_bytes_(false), encode_bit_sequence_size_(false) {}
+    : bit_encoder_reserved_bytes_(false),
+      encode_bit_sequence_size_(false),
+      flushed_size_(0),
+      sink_failed_(false) {}
 
 void EncoderBuffer::Clear() {
   buffer_.clear();
   bit_encoder_reserved_bytes_ = 0;
+  flushed_size_ = 0;
+  sink_failed_ = false;
 }
 
 void EncoderBuffer::Resize(int64_t nbytes) { buffer_.resize(nbytes); }
 
+bool EncoderBuffer::Flush() {
+  if (!sink_ || buffer_.empty()) {
+    return true;
+  }
+  if (bit_encoder_active()) {
+    return false;
+  }
+  const int64_t size = static_cast<int64_t>(buffer_.size());
+  if (!sink_(&buffer_)) {
+    sink_failed_ = true;
+    return false;
+  }
+  flushed_size_ += size;
+  buffer_.clear();
+  return true;
+}
+
+uint32_t EncoderBuffer::VarintSize(uint64_t val) {
+  uint32_t num_bytes = 1;
+  while (val >= (1 << 7)) {
+    val >>= 7;
+    ++num_bytes;
+  }
+  return num_bytes;
+}
+
 bool EncoderBuffer::StartBitEncoding(int64_t required_bits, bool encode_size) {
   if (bit_encoder_active()) {
     return false;  // Bit encoding mode already active.
@@ -43,8 +74,9 @@ bool EncoderBuffer::StartBitEncoding(int64_t required_bits, bool encode_size) {
   uint64_t buffer_start_size = buffer_.size();
   if (encode_size) {
     // Reserve memory for storing the encoded bit sequence size. It will be
-    // filled once the bit encoding ends.
-    buffer_start_size += sizeof(uint64_t);
+    // filled once the bit encoding ends. The encoded size can't be larger than
+    // |required_bytes| so its varint encoding always fits into the slot.
+    buffer_start_size += VarintSize(required_bytes);
   }
   // Resize buffer to fit the maximum size of encoded bit data.
   buffer_.resize(buffer_start_size + required_bytes);
@@ -66,16 +98,23 @@ void EncoderBuffer::EndBitEncoding() {
   bit_encoder_->Flush(0);
   // Encode size if needed.
   if (encode_bit_sequence_size_) {
+    const uint32_t slot_len = VarintSize(bit_encoder_reserved_bytes_);
     char *out_mem = const_cast<char *>(data() + size());
     // Make the out_mem point to the memory reserved for storing the size.
-    out_mem = out_mem - (bit_encoder_reserved_bytes_ + sizeof(uint64_t));
+    out_mem = out_mem - (bit_encoder_reserved_bytes_ + slot_len);
 
     EncoderBuffer var_size_buffer;
     EncodeVarint(encoded_bytes, &var_size_buffer);
     const uint32_t size_len = static_cast<uint32_t>(var_size_buffer.size());
-    char *const dst = out_mem + size_len;
-    const char *const src = out_mem + sizeof(uint64_t);
-    memmove(dst, src, encoded_bytes);
+    if (size_len < slot_len) {
+      // The size needs fewer bytes than we have reserved. Move the encoded
+      // data right behind the size. This happens only when the varint
+      // encoding of the actual size is shorter than the one of the reserved
+      // size.
+      char *const dst = out_mem + size_len;
+      const char *const src = out_mem + slot_len;
+      memmove(dst, src, encoded_bytes);
+    }
 
     // Store the size of the encoded data.
     memcpy(out_mem, var_size_buffer.data(), size_len);
@@ -83,7 +122,7 @@ void EncoderBuffer::EndBitEncoding() {
     // We need to account for the difference between the preallocated and actual
     // storage needed for storing the encoded length. This will be used later to
     // compute the correct size of |buffer_|.
-    bit_encoder_reserved_bytes_ += sizeof(uint64_t) - size_len;
+    bit_encoder_reserved_bytes_ += slot_len - size_len;
   }
   // Resize the underlying buffer to match the number of encoded bits.
   buffer_.resize(buffer_.size() - bit_encoder_reserved_bytes_ + encoded_bytes);
@@ -15,6 +15,8 @@
 #ifndef DRACO_CORE_ENCODER_BUFFER_H_
 #define DRACO_CORE_ENCODER_BUFFER_H_
 
+#include <cstring>
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -28,15 +30,41 @@ namespace draco {
 // bit data.
 class EncoderBuffer {
  public:
+  // Function receiving encoded data flushed from the buffer (see SetSink()).
+  // The sink can take ownership of the contents of |data|. Returns false on
+  // error.
+  typedef std::function<bool(std::vector<char> *data)> Sink;
+
   EncoderBuffer();
   void Clear();
   void Resize(int64_t nbytes);
 
+  // Sets a |sink| that receives the encoded data whenever Flush() is called.
+  // This allows encoding of large geometry without keeping all of the
+  // encoded data in a single contiguous buffer.
+  void SetSink(Sink sink) { sink_ = std::move(sink); }
+  bool has_sink() const { return static_cast<bool>(sink_); }
+
+  // Passes all data in the buffer to the sink and clears the buffer. After
+  // the call, data() and size() refer only to data encoded after the flush.
+  // Encoders call this only at points where no previously encoded data is
+  // going to be modified. Does nothing when no sink is set. Returns false
+  // when the sink fails or when the bit encoding is active.
+  bool Flush();
+
+  // Returns the number of bytes that were passed to the sink.
+  int64_t flushed_size() const { return flushed_size_; }
+
+  // Returns true when the sink failed to receive flushed data. Encoders use it
+  // to report write errors as Status::IO_ERROR.
+  bool sink_failed() const { return sink_failed_; }
+
   // Start encoding a bit sequence. A maximum size of the sequence needs to
   // be known upfront.
   // If encode_size is true, the size of encoded bit sequence is stored before
   // the sequence. Decoder can then use this size to skip over the bit sequence
-  // if needed.
+  // if needed. Space for the size is reserved upfront and patched in
+  // EndBitEncoding().
   // Returns false on error.
   bool StartBitEncoding(int64_t required_bits, bool encode_size);
 
@@ -80,28 +108,51 @@ class EncoderBuffer {
   std::vector<char> *buffer() { return &buffer_; }
 
  private:
+  // Returns the number of bytes needed to store |val| with EncodeVarint().
+  static uint32_t VarintSize(uint64_t val);
+
   // Internal helper class to encode bits to a bit buffer.
   class BitEncoder {
    public:
     // |data| is the buffer to write the bits into.
-    explicit BitEncoder(char *data) : bit_buffer_(data), bit_offset_(0) {}
+    explicit BitEncoder(char *data)
+        : bit_buffer_(data), bit_offset_(0), acc_(0), num_acc_bits_(0) {}
 
     // Write |nbits| of |data| into the bit buffer.
     void PutBits(uint32_t data, int32_t nbits) {
       DRACO_DCHECK_GE(nbits, 0);
       DRACO_DCHECK_LE(nbits, 32);
-      for (int32_t bit = 0; bit < nbits; ++bit) {
-        PutBit((data >> bit) & 1);
+      if (nbits == 0) {
+        return;
+      }
+      const uint64_t mask = (static_cast<uint64_t>(1) << nbits) - 1;
+      const uint64_t value = static_cast<uint64_t>(data) & mask;
+      acc_ |= value << num_acc_bits_;
+      num_acc_bits_ += nbits;
+      if (num_acc_bits_ >= 64) {
+        // The accumulator is full. Store it as one 64-bit word and keep the
+        // bits of |value| that did not fit into it.
+        FlushWord();
+        num_acc_bits_ -= 64;
+        acc_ = num_acc_bits_ > 0 ? value >> (nbits - num_acc_bits_) : 0;
       }
     }
 
     // Return number of bits encoded so far.
-    uint64_t Bits() const { return static_cast<uint64_t>(bit_offset_); }
+    uint64_t Bits() const {
+      return static_cast<uint64_t>(bit_offset_) + num_acc_bits_;
+    }
 
-    // TODO(fgalligan): Remove this function once we know we do not need the
-    // old API anymore.
-    // This is a function of an old API, that currently does nothing.
-    void Flush(int /* left_over_bit_value */) {}
+    // Writes all bits that are still held in the accumulator to the bit
+    // buffer. Must be called before the encoded data is accessed. Encoding
+    // can continue after the call.
+    void Flush(int /* left_over_bit_value */) {
+      const int num_bytes = (num_acc_bits_ + 7) / 8;
+      for (int i = 0; i < num_bytes; ++i) {
+        bit_buffer_[(bit_offset_ >> 3) + i] =
+            static_cast<char>((acc_ >> (8 * i)) & 0xff);
+      }
+    }
 
     // Return the number of bits required to store the given number
     static uint32_t BitsRequired(uint32_t x) {
@@ -109,23 +160,18 @@ class EncoderBuffer {
     }
 
    private:
-    void PutBit(uint8_t value) {
-      const int byte_size = 8;
-      const uint64_t off = static_cast<uint64_t>(bit_offset_);
-      const uint64_t byte_offset = off / byte_size;
-      const int bit_shift = off % byte_size;
-
-      // TODO(fgalligan): Check performance if we add a branch and only do one
-      // memory write if bit_shift is 7. Also try using a temporary variable to
-      // hold the bits before writing to the buffer.
-
-      bit_buffer_[byte_offset] &= ~(1 << bit_shift);
-      bit_buffer_[byte_offset] |= value << bit_shift;
-      bit_offset_++;
+    void FlushWord() {
+      // The bit stream is stored in little endian order.
+      memcpy(bit_buffer_ + (bit_offset_ >> 3), &acc_, sizeof(acc_));
+      bit_offset_ += 64;
     }
 
     char *bit_buffer_;
+    // Number of bits already stored in |bit_buffer_|. Always a multiple of 64.
     size_t bit_offset_;
+    // Bits that were not yet stored in |bit_buffer_|.
+    uint64_t acc_;
+    int num_acc_bits_;
   };
   friend class BufferBitCodingTest;
   // All data is stored in this vector.
@@ -145,6 +191,10 @@ class EncoderBuffer {
   // Flag used indicating that we need to store the length of the currently
   // processed bit sequence.
   bool encode_bit_sequence_size_;
+
+  Sink sink_;
+  int64_t flushed_size_;
+  bool sink_failed_;
 };
 
 }  // namespace draco
@@ -0,0 +1,182 @@
+// Copyright 2016 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_CORE_FLAT_HASH_INDEX_H_
+#define DRACO_CORE_FLAT_HASH_INDEX_H_
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "draco/core/thread_pool.h"
+
+namespace draco {
+
+// Open addressing hash table that stores 32-bit indices of entries of an
+// external array. The table doesn't store the entries themselves; instead,
+// the caller provides a hash of each entry and a function for comparing two
+// entries given their indices. Together with the lower 32 bits of the hash
+// that are stored for each index, this keeps the table small (8 bytes per
+// slot) and avoids most of the entry comparisons.
+class FlatHashIndex {
+ public:
+  static constexpr uint32_t kInvalidIndex = 0xffffffff;
+
+  // Creates a table that can hold |expected_num_indices| without growing.
+  explicit FlatHashIndex(uint32_t expected_num_indices) : num_indices_(0) {
+    size_t num_slots = 16;
+    while (num_slots < 2 * static_cast<size_t>(expected_num_indices)) {
+      num_slots *= 2;
+    }
+    slots_.assign(num_slots, Slot());
+  }
+
+  // Returns the index of a stored entry that is equal to the entry |index|,
+  // as reported by |equal(stored_index, index)|. If there is no such entry,
+  // |index| is inserted and returned. |hash| must be the hash of the entry
+  // |index| and equal entries must have equal hashes.
+  template <class EqualFunctionT>
+  uint32_t FindOrInsert(uint64_t hash, uint32_t index,
+                        const EqualFunctionT &equal) {
+    const uint32_t slot_hash = static_cast<uint32_t>(hash);
+    const size_t mask = slots_.size() - 1;
+    for (size_t s = slot_hash & mask;; s = (s + 1) & mask) {
+      Slot &slot = slots_[s];
+      if (slot.index == kInvalidIndex) {
+        slot.hash = slot_hash;
+        slot.index = index;
+        if (2 * ++num_indices_ > slots_.size()) {
+          Grow();
+        }
+        return index;
+      }
+      if (slot.hash == slot_hash && equal(slot.index, index)) {
+        return slot.index;
+      }
+    }
+  }
+
+  size_t num_indices() const { return num_indices_; }
+
+ private:
+  struct Slot {
+    Slot() : hash(0), index(kInvalidIndex) {}
+    uint32_t hash;
+    uint32_t index;
+  };
+
+  // Doubles the number of slots. Indices are re-inserted using their stored
+  // hashes so the entries don't need to be hashed again.
+  void Grow() {
+    std::vector<Slot> old_slots(2 * slots_.size());
+    old_slots.swap(slots_);
+    const size_t mask = slots_.size() - 1;
+    for (const Slot &slot : old_slots) {
+      if (slot.index == kInvalidIndex) {
+        continue;
+      }
+      size_t s = slot.hash & mask;
+      while (slots_[s].index != kInvalidIndex) {
+        s = (s + 1) & mask;
+      }
+      slots_[s] = slot;
+    }
+  }
+
+  std::vector<Slot> slots_;
+  size_t num_indices_;
+};
+
+// For each of |num_entries| entries, finds the index of the first entry that
+// is equal to it and stores it in |out_first_indices|. Unique entries (and
+// the first entry of each group of equal entries) point to themselves. The
+// entries are hashed with |hash(index)| and compared with |equal(i0, i1)|.
+// When |thread_pool| is not null, large inputs are split by their hashes into
+// independent partitions that are processed in parallel, with the same
+// result.
+template <class HashFunctionT, class EqualFunctionT>
+void FindFirstEqualEntries(uint32_t num_entries, const HashFunctionT &hash,
+                           const EqualFunctionT &equal,
+                           ThreadPool *thread_pool,
+                           std::vector<uint32_t> *out_first_indices) {
+  out_first_indices->resize(num_entries);
+  uint32_t *const first_indices = out_first_indices->data();
+  // Minimum number of entries processed in parallel.
+  const uint32_t kMinParallelEntries = 1 << 16;
+  if (thread_pool == nullptr || thread_pool->num_threads() == 0 ||
+      num_entries < kMinParallelEntries) {
+    FlatHashIndex table(num_entries);
+    for (uint32_t i = 0; i < num_entries; ++i) {
+      first_indices[i] = table.FindOrInsert(hash(i), i, equal);
+    }
+    return;
+  }
+
+  const int num_tasks = 4 * (thread_pool->num_threads() + 1);
+  const uint32_t chunk_size = (num_entries + num_tasks - 1) / num_tasks;
+  // Equal entries have equal hashes so they always end up in the same
+  // partition. The upper bits of the hash are used to select the partition
+  // because the lower bits are used by the hash table.
+  const auto partition = [num_tasks](uint64_t hash) {
+    return static_cast<int>((hash >> 40) % num_tasks);
+  };
+  // Hash the entries and count the entries of each partition in each chunk.
+  std::vector<uint64_t> hashes(num_entries);
+  std::vector<uint32_t> offsets(num_tasks * num_tasks, 0);
+  thread_pool->ParallelFor(num_tasks, [&](int t) {
+    uint32_t *const counts = &offsets[t * num_tasks];
+    const uint32_t end = std::min(num_entries, (t + 1) * chunk_size);
+    for (uint32_t i = t * chunk_size; i < end; ++i) {
+      hashes[i] = hash(i);
+      ++counts[partition(hashes[i])];
+    }
+  });
+  // Turn the counts into the offsets where each chunk stores the entries of
+  // each partition, so that entries of a partition stay in original order.
+  std::vector<uint32_t> partition_begin(num_tasks + 1);
+  uint32_t offset = 0;
+  for (int p = 0; p < num_tasks; ++p) {
+    partition_begin[p] = offset;
+    for (int t = 0; t < num_tasks; ++t) {
+      const uint32_t count = offsets[t * num_tasks + p];
+      offsets[t * num_tasks + p] = offset;
+      offset += count;
+    }
+  }
+  partition_begin[num_tasks] = offset;
+  std::vector<uint32_t> partitioned_indices(num_entries);
+  thread_pool->ParallelFor(num_tasks, [&](int t) {
+    uint32_t *const chunk_offsets = &offsets[t * num_tasks];
+    const uint32_t end = std::min(num_entries, (t + 1) * chunk_size);
+    for (uint32_t i = t * chunk_size; i < end; ++i) {
+      partitioned_indices[chunk_offsets[partition(hashes[i])]++] = i;
+    }
+  });
+  // Entries of each partition are processed in their original order which
+  // guarantees that the first equal entry is found.
+  thread_pool->ParallelFor(num_tasks, [&](int t) {
+    const uint32_t begin = partition_begin[t];
+    const uint32_t end = partition_begin[t + 1];
+    FlatHashIndex table(end - begin);
+    for (uint32_t j = begin; j < end; ++j) {
+      const uint32_t i = partitioned_indices[j];
+      first_indices[i] = table.FindOrInsert(hashes[i], i, equal);
+    }
+  });
+}
+
+}  // namespace draco
+
+#endif  // DRACO_CORE_FLAT_HASH_INDEX_H_
@@ -0,0 +1,84 @@
+// Copyright 2016 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/core/flat_hash_index.h"
+
+#include <vector>
+
+#include "draco/core/draco_test_base.h"
+#include "draco/core/hash_utils.h"
+
+namespace {
+
+class FlatHashIndexTest : public ::testing::Test {
+ protected:
+  FlatHashIndexTest() {}
+
+  // Returns |num_values| values with many duplicates.
+  static std::vector<uint32_t> GenerateValues(int num_values, int max_value) {
+    std::vector<uint32_t> values(num_values);
+    uint32_t seed = 7;
+    for (int i = 0; i < num_values; ++i) {
+      seed = seed * 1103515245 + 12345;
+      values[i] = (seed >> 8) % max_value;
+    }
+    return values;
+  }
+};
+
+TEST_F(FlatHashIndexTest, TestFindOrInsert) {
+  const std::vector<uint32_t> values = GenerateValues(1000, 100);
+  const auto equal = [&](uint32_t i0, uint32_t i1) {
+    return values[i0] == values[i1];
+  };
+  // Start with a small table to test growing of the table.
+  draco::FlatHashIndex table(1);
+  std::vector<uint32_t> first_index(100, draco::FlatHashIndex::kInvalidIndex);
+  for (uint32_t i = 0; i < values.size(); ++i) {
+    const uint32_t found = table.FindOrInsert(
+        draco::HashCombine64(0, values[i]), i, equal);
+    if (first_index[values[i]] == draco::FlatHashIndex::kInvalidIndex) {
+      first_index[values[i]] = i;
+    }
+    ASSERT_EQ(found, first_index[values[i]]);
+  }
+  ASSERT_EQ(table.num_indices(), 100);
+}
+
+TEST_F(FlatHashIndexTest, TestFindFirstEqualEntriesInParallel) {
+  // The parallel search must find the same entries as the serial one. The
+  // number of values is large enough to use the parallel code path.
+  const std::vector<uint32_t> values = GenerateValues(100000, 5000);
+  const auto hash = [&](uint32_t i) {
+    return draco::HashCombine64(0, values[i]);
+  };
+  const auto equal = [&](uint32_t i0, uint32_t i1) {
+    return values[i0] == values[i1];
+  };
+  std::vector<uint32_t> serial;
+  draco::FindFirstEqualEntries(static_cast<uint32_t>(values.size()), hash,
+                               equal, nullptr, &serial);
+  draco::ThreadPool thread_pool(3);
+  std::vector<uint32_t> parallel;
+  draco::FindFirstEqualEntries(static_cast<uint32_t>(values.size()), hash,
+                               equal, &thread_pool, &parallel);
+  ASSERT_EQ(serial, parallel);
+  for (uint32_t i = 0; i < values.size(); ++i) {
+    ASSERT_LE(serial[i], i);
+    ASSERT_EQ(values[serial[i]], values[i]);
+    ASSERT_EQ(serial[serial[i]], serial[i]);
+  }
+}
+
+}  // namespace
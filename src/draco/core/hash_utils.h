@@ -17,6 +17,7 @@
 
 #include <stdint.h>
 
+#include <cstddef>
 #include <functional>
 
 // TODO(fgalligan): Move this to core.
@@ -40,6 +41,24 @@ inline uint64_t HashCombine(uint64_t a, uint64_t b) {
   return (a + 1013) ^ (b + 107) << 1;
 }
 
+// Mixes all bits of |h| so that each input bit affects all output bits
+// (finalizer of MurmurHash3).
+inline uint64_t MixHash64(uint64_t h) {
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdull;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ull;
+  h ^= h >> 33;
+  return h;
+}
+
+// Combines |hash| with |value|. Unlike HashCombine(), the result is well
+// distributed over all 64 bits and it can be used directly in open addressing
+// hash tables.
+inline uint64_t HashCombine64(uint64_t hash, uint64_t value) {
+  return MixHash64(hash ^ (value * 0x9e3779b97f4a7c15ull));
+}
+
 // Will never return 1 or 0.
 uint64_t FingerprintString(const char *s, size_t len);
 
@@ -14,8 +14,148 @@
 //
 #include "draco/core/quantization_utils.h"
 
+#include <cfloat>
+
+#include "draco/core/cpu_features.h"
+
+// The SIMD kernels are bit-exact with the scalar code only when the scalar
+// float arithmetic is evaluated in single precision (e.g. not with the x87
+// instructions).
+#if defined(DRACO_X86_SIMD_SUPPORTED) && defined(FLT_EVAL_METHOD) && \
+    FLT_EVAL_METHOD == 0
+#define DRACO_QUANTIZATION_SIMD_SUPPORTED 1
+#include <immintrin.h>
+#endif
+
 namespace draco {
 
+#ifdef DRACO_QUANTIZATION_SIMD_SUPPORTED
+
+// All kernels process the values in blocks of |num_components| vectors, so
+// that each block starts with the first component of an entry. The offsets
+// are provided in |offset_pattern| where offset_pattern[i] is the offset of
+// the i-th value of a block. Each kernel performs exactly the same sequence
+// of single precision operations as the scalar code. Note that fused
+// multiply-add instructions must not be used because they would change the
+// rounding of the results. The kernels return the number of processed
+// values.
+
+namespace {
+
+// Maximum number of components supported by the kernels.
+constexpr int kMaxSimdComponents = 16;
+
+// Maximum number of values in a vector used by any of the kernels.
+constexpr int kMaxSimdLanes = 8;
+
+void ComputeOffsetPattern(const float *offsets, int num_components,
+                          float *offset_pattern) {
+  for (int i = 0; i < kMaxSimdLanes * num_components; ++i) {
+    offset_pattern[i] = offsets[i % num_components];
+  }
+}
+
+DRACO_TARGET_AVX2 size_t QuantizeFloatsAvx2(const float *values,
+                                            size_t num_values,
+                                            int num_components,
+                                            const float *offset_pattern,
+                                            float inverse_delta,
+                                            int32_t *out_values) {
+  constexpr int kNumLanes = 8;
+  const size_t block_size = kNumLanes * num_components;
+  const __m256 scale = _mm256_set1_ps(inverse_delta);
+  const __m256 half = _mm256_set1_ps(0.5f);
+  size_t i = 0;
+  for (; i + block_size <= num_values; i += block_size) {
+    for (int k = 0; k < num_components; ++k) {
+      const size_t j = i + k * kNumLanes;
+      __m256 value =
+          _mm256_sub_ps(_mm256_loadu_ps(values + j),
+                        _mm256_loadu_ps(offset_pattern + k * kNumLanes));
+      value = _mm256_mul_ps(value, scale);
+      value = _mm256_floor_ps(_mm256_add_ps(value, half));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(out_values + j),
+                          _mm256_cvttps_epi32(value));
+    }
+  }
+  return i;
+}
+
+DRACO_TARGET_SSE41 size_t QuantizeFloatsSse41(const float *values,
+                                              size_t num_values,
+                                              int num_components,
+                                              const float *offset_pattern,
+                                              float inverse_delta,
+                                              int32_t *out_values) {
+  constexpr int kNumLanes = 4;
+  const size_t block_size = kNumLanes * num_components;
+  const __m128 scale = _mm_set1_ps(inverse_delta);
+  const __m128 half = _mm_set1_ps(0.5f);
+  size_t i = 0;
+  for (; i + block_size <= num_values; i += block_size) {
+    for (int k = 0; k < num_components; ++k) {
+      const size_t j = i + k * kNumLanes;
+      __m128 value = _mm_sub_ps(_mm_loadu_ps(values + j),
+                                _mm_loadu_ps(offset_pattern + k * kNumLanes));
+      value = _mm_mul_ps(value, scale);
+      value = _mm_floor_ps(_mm_add_ps(value, half));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(out_values + j),
+                       _mm_cvttps_epi32(value));
+    }
+  }
+  return i;
+}
+
+DRACO_TARGET_AVX2 size_t DequantizeFloatsAvx2(const int32_t *values,
+                                              size_t num_values,
+                                              int num_components,
+                                              const float *offset_pattern,
+                                              float delta, float *out_values) {
+  constexpr int kNumLanes = 8;
+  const size_t block_size = kNumLanes * num_components;
+  const __m256 scale = _mm256_set1_ps(delta);
+  size_t i = 0;
+  for (; i + block_size <= num_values; i += block_size) {
+    for (int k = 0; k < num_components; ++k) {
+      const size_t j = i + k * kNumLanes;
+      __m256 value = _mm256_cvtepi32_ps(
+          _mm256_loadu_si256(reinterpret_cast<const __m256i *>(values + j)));
+      value = _mm256_mul_ps(value, scale);
+      value =
+          _mm256_add_ps(value, _mm256_loadu_ps(offset_pattern + k * kNumLanes));
+      _mm256_storeu_ps(out_values + j, value);
+    }
+  }
+  return i;
+}
+
+DRACO_TARGET_SSE41 size_t DequantizeFloatsSse41(const int32_t *values,
+                                                size_t num_values,
+                                                int num_components,
+                                                const float *offset_pattern,
+                                                float delta,
+                                                float *out_values) {
+  constexpr int kNumLanes = 4;
+  const size_t block_size = kNumLanes * num_components;
+  const __m128 scale = _mm_set1_ps(delta);
+  size_t i = 0;
+  for (; i + block_size <= num_values; i += block_size) {
+    for (int k = 0; k < num_components; ++k) {
+      const size_t j = i + k * kNumLanes;
+      __m128 value = _mm_cvtepi32_ps(
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(values + j)));
+      value = _mm_mul_ps(value, scale);
+      value = _mm_add_ps(value, _mm_loadu_ps(offset_pattern + k * kNumLanes));
+      _mm_storeu_ps(out_values + j, value);
+    }
+  }
+  return i;
+}
+
+}  // namespace
+
+#endif  // DRACO_QUANTIZATION_SIMD_SUPPORTED
+
 Quantizer::Quantizer() : inverse_delta_(1.f) {}
 
 void Quantizer::Init(float range, int32_t max_quantized_value) {
@@ -24,6 +164,32 @@ void Quantizer::Init(float range, int32_t max_quantized_value) {
 
 void Quantizer::Init(float delta) { inverse_delta_ = 1.f / delta; }
 
+void Quantizer::QuantizeFloats(const float *values, size_t num_entries,
+                               int num_components, const float *offsets,
+                               int32_t *out_values) const {
+  const size_t num_values = num_entries * num_components;
+  size_t i = 0;
+#ifdef DRACO_QUANTIZATION_SIMD_SUPPORTED
+  if (num_components <= kMaxSimdComponents) {
+    float offset_pattern[kMaxSimdLanes * kMaxSimdComponents];
+    ComputeOffsetPattern(offsets, num_components, offset_pattern);
+    if (CpuAvx2Supported()) {
+      i = QuantizeFloatsAvx2(values, num_values, num_components,
+                             offset_pattern, inverse_delta_, out_values);
+    } else if (CpuSse41Supported()) {
+      i = QuantizeFloatsSse41(values, num_values, num_components,
+                              offset_pattern, inverse_delta_, out_values);
+    }
+  }
+#endif
+  // Quantize the remaining values. |i| is always at the start of an entry.
+  while (i < num_values) {
+    for (int c = 0; c < num_components; ++c, ++i) {
+      out_values[i] = QuantizeFloat(values[i] - offsets[c]);
+    }
+  }
+}
+
 Dequantizer::Dequantizer() : delta_(1.f) {}
 
 bool Dequantizer::Init(float range, int32_t max_quantized_value) {
@@ -39,4 +205,30 @@ bool Dequantizer::Init(float delta) {
   return true;
 }
 
+void Dequantizer::DequantizeFloats(const int32_t *values, size_t num_entries,
+                                   int num_components, const float *offsets,
+                                   float *out_values) const {
+  const size_t num_values = num_entries * num_components;
+  size_t i = 0;
+#ifdef DRACO_QUANTIZATION_SIMD_SUPPORTED
+  if (num_components <= kMaxSimdComponents) {
+    float offset_pattern[kMaxSimdLanes * kMaxSimdComponents];
+    ComputeOffsetPattern(offsets, num_components, offset_pattern);
+    if (CpuAvx2Supported()) {
+      i = DequantizeFloatsAvx2(values, num_values, num_components,
+                               offset_pattern, delta_, out_values);
+    } else if (CpuSse41Supported()) {
+      i = DequantizeFloatsSse41(values, num_values, num_components,
+                                offset_pattern, delta_, out_values);
+    }
+  }
+#endif
+  // Dequantize the remaining values. |i| is always at the start of an entry.
+  while (i < num_values) {
+    for (int c = 0; c < num_components; ++c, ++i) {
+      out_values[i] = DequantizeFloat(values[i]) + offsets[c];
+    }
+  }
+}
+
 }  // namespace draco
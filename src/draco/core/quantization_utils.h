@@ -21,6 +21,7 @@
 #ifndef DRACO_CORE_QUANTIZATION_UTILS_H_
 #define DRACO_CORE_QUANTIZATION_UTILS_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include <cmath>
@@ -50,6 +51,15 @@ class Quantizer {
   }
   inline int32_t operator()(float val) const { return QuantizeFloat(val); }
 
+  // Quantizes |num_entries| entries with |num_components| components stored in
+  // |values|. |offsets| are subtracted from the components before the
+  // quantization. The results are the same as QuantizeFloat(value - offset)
+  // computed for each component, but the values are processed with SIMD
+  // instructions when they are supported by the CPU.
+  void QuantizeFloats(const float *values, size_t num_entries,
+                      int num_components, const float *offsets,
+                      int32_t *out_values) const;
+
  private:
   float inverse_delta_;
 };
@@ -73,6 +83,15 @@ class Dequantizer {
   }
   inline float operator()(int32_t val) const { return DequantizeFloat(val); }
 
+  // Dequantizes |num_entries| entries with |num_components| components stored
+  // in |values| and adds |offsets| to the dequantized components. The results
+  // are the same as DequantizeFloat(value) + offset computed for each
+  // component, but the values are processed with SIMD instructions when they
+  // are supported by the CPU.
+  void DequantizeFloats(const int32_t *values, size_t num_entries,
+                        int num_components, const float *offsets,
+                        float *out_values) const;
+
  private:
   float delta_;
 };
@@ -14,6 +14,9 @@
 //
 #include "draco/core/quantization_utils.h"
 
+#include <cstring>
+#include <vector>
+
 #include "draco/core/draco_test_base.h"
 
 namespace draco {
@@ -88,4 +91,49 @@ TEST_F(QuantizationUtilsTest, TestDeltaQuantization) {
             dequantizer_range.DequantizeFloat(0));
 }
 
+TEST_F(QuantizationUtilsTest, TestBatchQuantization) {
+  // Tests that the batch quantization and dequantization produce exactly the
+  // same results as the scalar code for various numbers of components and
+  // entries.
+  Quantizer quantizer;
+  quantizer.Init(10.f, (1 << 14) - 1);
+  Dequantizer dequantizer;
+  ASSERT_TRUE(dequantizer.Init(10.f, (1 << 14) - 1));
+  uint32_t random_state = 1;
+  for (const int num_components : {1, 2, 3, 4, 5, 16, 17}) {
+    for (const size_t num_entries : {0, 1, 7, 33, 1000}) {
+      std::vector<float> offsets(num_components);
+      for (int c = 0; c < num_components; ++c) {
+        offsets[c] = -5.f + 0.37f * c;
+      }
+      const size_t num_values = num_entries * num_components;
+      std::vector<float> values(num_values);
+      for (size_t i = 0; i < num_values; ++i) {
+        random_state = random_state * 1664525u + 1013904223u;
+        values[i] = offsets[i % num_components] +
+                    10.f * static_cast<float>(random_state >> 8) / (1 << 24);
+        if (i % 7 == 0) {
+          // Values that lie exactly between two quantized values.
+          values[i] = offsets[i % num_components] + 0.5f * 10.f / 16383.f;
+        }
+      }
+      std::vector<int32_t> quantized(num_values);
+      quantizer.QuantizeFloats(values.data(), num_entries, num_components,
+                               offsets.data(), quantized.data());
+      std::vector<float> dequantized(num_values);
+      dequantizer.DequantizeFloats(quantized.data(), num_entries,
+                                   num_components, offsets.data(),
+                                   dequantized.data());
+      for (size_t i = 0; i < num_values; ++i) {
+        const int c = static_cast<int>(i % num_components);
+        ASSERT_EQ(quantized[i],
+                  quantizer.QuantizeFloat(values[i] - offsets[c]));
+        const float expected =
+            dequantizer.DequantizeFloat(quantized[i]) + offsets[c];
+        ASSERT_EQ(memcmp(&dequantized[i], &expected, sizeof(float)), 0);
+      }
+    }
+  }
+}
+
 }  // namespace draco
@@ -0,0 +1,107 @@
+// Copyright 2016 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/core/thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+namespace draco {
+
+ThreadPool::ThreadPool(int num_threads) : stopping_(false) {
+  for (int i = 0; i < num_threads; ++i) {
+    threads_.emplace_back(&ThreadPool::RunWorker, this);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  condition_.notify_all();
+  for (std::thread &thread : threads_) {
+    thread.join();
+  }
+}
+
+void ThreadPool::Schedule(std::function<void()> task) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_.push_back(std::move(task));
+  }
+  condition_.notify_one();
+}
+
+void ThreadPool::ParallelFor(int num_tasks,
+                             const std::function<void(int)> &task) {
+  if (num_tasks <= 0) {
+    return;
+  }
+  // State shared by all threads executing the tasks. Helper threads can still
+  // access the state after the last task is finished, so it is reference
+  // counted.
+  struct State {
+    std::atomic<int> next_task;
+    int num_finished_tasks;
+    std::mutex mutex;
+    std::condition_variable finished;
+  };
+  std::shared_ptr<State> state(new State());
+  state->next_task = 0;
+  state->num_finished_tasks = 0;
+  const std::function<void(int)> *const task_ptr = &task;
+  const auto run_tasks = [state, task_ptr, num_tasks]() {
+    int num_run_tasks = 0;
+    for (int i = state->next_task++; i < num_tasks; i = state->next_task++) {
+      (*task_ptr)(i);
+      ++num_run_tasks;
+    }
+    if (num_run_tasks > 0) {
+      std::lock_guard<std::mutex> lock(state->mutex);
+      state->num_finished_tasks += num_run_tasks;
+      if (state->num_finished_tasks == num_tasks) {
+        state->finished.notify_all();
+      }
+    }
+  };
+  const int num_helpers = std::min(num_threads(), num_tasks - 1);
+  for (int i = 0; i < num_helpers; ++i) {
+    Schedule(run_tasks);
+  }
+  run_tasks();
+  std::unique_lock<std::mutex> lock(state->mutex);
+  state->finished.wait(lock, [&state, num_tasks]() {
+    return state->num_finished_tasks == num_tasks;
+  });
+}
+
+void ThreadPool::RunWorker() {
+  while (true) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      condition_.wait(lock, [this]() { return stopping_ || !tasks_.empty(); });
+      if (tasks_.empty()) {
+        return;  // The pool is stopping and there are no more tasks.
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+    task();
+  }
+}
+
+}  // namespace draco
@@ -0,0 +1,61 @@
+// Copyright 2016 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_CORE_THREAD_POOL_H_
+#define DRACO_CORE_THREAD_POOL_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace draco {
+
+// Simple pool of worker threads that can be used by the encoder and the decoder
+// to process independent tasks in parallel. The same pool can be shared by
+// multiple encoders and decoders.
+class ThreadPool {
+ public:
+  // Creates a pool with |num_threads| worker threads.
+  explicit ThreadPool(int num_threads);
+
+  // Waits for all scheduled tasks to finish and stops the worker threads.
+  ~ThreadPool();
+
+  int num_threads() const { return static_cast<int>(threads_.size()); }
+
+  // Schedules |task| to be executed on one of the worker threads.
+  void Schedule(std::function<void()> task);
+
+  // Executes |task| for all indices in the range [0, |num_tasks|) and waits
+  // until all of them are finished. The tasks are distributed between the
+  // calling thread and the worker threads, so the function can be safely
+  // called from within a task running on the same pool.
+  void ParallelFor(int num_tasks, const std::function<void(int)> &task);
+
+ private:
+  void RunWorker();
+
+  std::vector<std::thread> threads_;
+  std::deque<std::function<void()>> tasks_;
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  bool stopping_;
+};
+
+}  // namespace draco
+
+#endif  // DRACO_CORE_THREAD_POOL_H_
@@ -0,0 +1,64 @@
+// Copyright 2016 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/core/thread_pool.h"
+
+#include <atomic>
+#include <vector>
+
+#include "draco/core/draco_test_base.h"
+
+namespace {
+
+class ThreadPoolTest : public ::testing::Test {
+ protected:
+  ThreadPoolTest() {}
+};
+
+TEST_F(ThreadPoolTest, TestParallelFor) {
+  // Tests that all tasks are executed exactly once.
+  draco::ThreadPool pool(3);
+  ASSERT_EQ(pool.num_threads(), 3);
+  std::vector<int> counters(100, 0);
+  pool.ParallelFor(static_cast<int>(counters.size()),
+                   [&counters](int i) { counters[i]++; });
+  for (const int counter : counters) {
+    ASSERT_EQ(counter, 1);
+  }
+}
+
+TEST_F(ThreadPoolTest, TestNestedParallelFor) {
+  // Tests that ParallelFor() can be called from a task running on the same
+  // pool without a deadlock.
+  draco::ThreadPool pool(2);
+  std::atomic<int> num_tasks(0);
+  pool.ParallelFor(4, [&pool, &num_tasks](int) {
+    pool.ParallelFor(8, [&num_tasks](int) { num_tasks++; });
+  });
+  ASSERT_EQ(num_tasks.load(), 32);
+}
+
+TEST_F(ThreadPoolTest, TestSchedule) {
+  // Tests that all scheduled tasks are executed before the pool is destroyed.
+  std::atomic<int> num_tasks(0);
+  {
+    draco::ThreadPool pool(2);
+    for (int i = 0; i < 10; ++i) {
+      pool.Schedule([&num_tasks]() { num_tasks++; });
+    }
+  }
+  ASSERT_EQ(num_tasks.load(), 10);
+}
+
+}  // namespace
@@ -392,6 +392,69 @@ namespace dracosharp
         return dracoMesh->num_faces;
     }
 
+    int EXPORT_API DecodeDracoMeshToBuffers(char* inputData, unsigned int length, DracoAttributeBuffer* attributes,
+            int num_attributes, DracoBuffersCallback callback, void* user_data)
+    {
+        if (callback == nullptr || (attributes == nullptr && num_attributes > 0))
+            return -1;
+
+        draco::DecoderBuffer buffer;
+        buffer.Init(inputData, length);
+        auto type_statusOr = draco::Decoder::GetEncodedGeometryType(&buffer);
+
+        if (!type_statusOr.ok())
+            return -2;
+
+        if (type_statusOr.value() != draco::TRIANGULAR_MESH)
+            return -3;
+
+        int num_faces = 0;
+        draco::Decoder decoder;
+        const draco::Status status = decoder.DecodeMeshToBuffers(&buffer,
+                [&](const draco::Mesh& mesh, draco::MeshBufferLayout* layout)
+                {
+                    for (int i = 0; i < num_attributes; ++i)
+                    {
+                        attributes[i].found = mesh.GetNamedAttributeId(attributes[i].attribute_type) >= 0;
+                        attributes[i].data = nullptr;
+                        attributes[i].data_size = 0;
+                    }
+
+                    void* indices = nullptr;
+                    if (!callback(mesh.num_faces(), mesh.num_points(), &indices, attributes, num_attributes, user_data))
+                        return draco::Status(draco::Status::DRACO_ERROR, "Decoding cancelled.");
+
+                    num_faces = mesh.num_faces();
+                    layout->index_type = draco::DT_UINT32;
+                    layout->indices = indices;
+                    layout->indices_size = static_cast<size_t>(num_faces) * 3 * sizeof(uint32_t);
+
+                    for (int i = 0; i < num_attributes; ++i)
+                    {
+                        const DracoAttributeBuffer& att = attributes[i];
+                        if (!att.found || att.data == nullptr)
+                            continue;
+
+                        draco::AttributeBufferLayout att_layout;
+                        att_layout.attribute_id = mesh.GetNamedAttributeId(att.attribute_type);
+                        att_layout.data_type = att.data_type;
+                        att_layout.num_components = att.num_components;
+                        att_layout.data = att.data;
+                        att_layout.data_size = att.data_size;
+                        att_layout.byte_offset = att.byte_offset;
+                        att_layout.byte_stride = att.byte_stride;
+                        layout->attributes.push_back(att_layout);
+                    }
+
+                    return draco::OkStatus();
+                });
+
+        if (!status.ok())
+            return -4;
+
+        return num_faces;
+    }
+
     bool EXPORT_API GetAttribute(const DracoMesh mesh, int index, DracoAttribute* attribute)
     {
         if (attribute == nullptr)
@@ -75,6 +75,44 @@ struct EXPORT_API DracoMesh {
   void *private_mesh;
 };
 
+// Struct describing the output memory of one attribute for
+// DecodeDracoMeshToBuffers().
+struct EXPORT_API DracoAttributeBuffer {
+  DracoAttributeBuffer()
+      : attribute_type(draco::GeometryAttribute::INVALID),
+        data_type(draco::DT_FLOAT32),
+        num_components(0),
+        byte_offset(0),
+        byte_stride(0),
+        found(0),
+        data(nullptr),
+        data_size(0) {}
+
+  // The values of the first attribute of |attribute_type| are written.
+  draco::GeometryAttribute::Type attribute_type;
+  draco::DataType data_type;
+  // When 0, all components of the attribute are written.
+  int num_components;
+  int byte_offset;
+  // When 0, the values are tightly packed.
+  int byte_stride;
+  // Set to 1 before the DracoBuffersCallback is called when the mesh contains
+  // the attribute.
+  int found;
+  // Set by the DracoBuffersCallback. Attributes with null |data| are skipped.
+  void *data;
+  int data_size;
+};
+
+// Called by DecodeDracoMeshToBuffers() once the number of faces and vertices
+// of the decoded mesh is known. Must set |indices| to memory for
+// |num_faces| * 3 uint32 indices and the |data| and |data_size| of the
+// |attributes| that should be written. Returning false cancels the decoding.
+typedef bool (*DracoBuffersCallback)(int num_faces, int num_vertices,
+                                     void **indices,
+                                     DracoAttributeBuffer *attributes,
+                                     int num_attributes, void *user_data);
+
 struct EXPORT_API Vertex
 {
   float position[3] = {}; // 3f
@@ -155,6 +193,18 @@ struct EXPORT_API GLTFDracoOptions{
 // must be null. The returned |mesh| must be released with ReleaseDracoMesh.
 int EXPORT_API DecodeDracoMesh(char *data, unsigned int length, DracoMesh *mesh);
 
+// Decodes compressed Draco mesh in |data| directly into the memory provided by
+// |callback| for the requested |attributes|. The attribute values are written
+// by the attribute decoders without an intermediate DracoMesh, so this should
+// be preferred over DecodeDracoMesh() followed by GetMeshIndices() and
+// GetAttributeData(). Returns the number of faces or a negative value on
+// error.
+int EXPORT_API DecodeDracoMeshToBuffers(char *data, unsigned int length,
+                                        DracoAttributeBuffer *attributes,
+                                        int num_attributes,
+                                        DracoBuffersCallback callback,
+                                        void *user_data);
+
 // Encodes given CsMesh to DracoMesh
 void EXPORT_API EncodeToBuffer(const char* outputData, GLTFDracoOptions gltfDracoOptions, CsMesh mesh);
 
@@ -0,0 +1,74 @@
+// Copyright 2016 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/io/block_writer.h"
+
+#include <algorithm>
+
+namespace draco {
+
+BlockWriter::BlockWriter(FileWriterInterface *file)
+    : file_(file),
+      out_buffer_(nullptr),
+      block_(kBlockSize),
+      data_(&block_),
+      data_size_(0),
+      ok_(true) {}
+
+BlockWriter::BlockWriter(EncoderBuffer *out_buffer)
+    : file_(nullptr),
+      out_buffer_(out_buffer),
+      data_(out_buffer->buffer()),
+      data_size_(out_buffer->size()),
+      ok_(true) {}
+
+BlockWriter::~BlockWriter() { Flush(); }
+
+bool BlockWriter::Flush() {
+  if (file_ != nullptr) {
+    if (data_size_ > 0 && !file_->Write(block_.data(), data_size_)) {
+      ok_ = false;
+    }
+    data_size_ = 0;
+  } else {
+    // Remove the uncommitted part of the buffer.
+    data_->resize(data_size_);
+  }
+  return ok_;
+}
+
+void BlockWriter::Grow(size_t size) {
+  if (file_ != nullptr) {
+    Flush();
+    if (block_.size() < size) {
+      block_.resize(size);
+    }
+    return;
+  }
+  if (out_buffer_->has_sink() && data_size_ >= kBlockSize) {
+    // Pass the committed data to the sink of the buffer instead of growing
+    // the buffer.
+    data_->resize(data_size_);
+    if (!out_buffer_->Flush()) {
+      ok_ = false;
+    }
+    data_size_ = out_buffer_->size();
+    data_->resize(std::max(data_size_ + size, kBlockSize));
+    return;
+  }
+  // Grow the buffer geometrically to keep the cost of resizing low.
+  data_->resize(std::max(data_size_ + size, 2 * data_->size()));
+}
+
+}  // namespace draco
@@ -0,0 +1,100 @@
+// Copyright 2016 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_IO_BLOCK_WRITER_H_
+#define DRACO_IO_BLOCK_WRITER_H_
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "draco/core/encoder_buffer.h"
+#include "draco/io/file_writer_interface.h"
+
+namespace draco {
+
+// Class for writing of large outputs such as OBJ and PLY files. The data is
+// written either to a file through a reusable block of memory that is flushed
+// to the file whenever it gets full, or directly to the memory of an encoder
+// buffer. Callers can reserve space for a record, format it in place and
+// commit only the written part, which avoids any intermediate strings.
+class BlockWriter {
+ public:
+  // Size of the block used for writing to files.
+  static constexpr size_t kBlockSize = 1 << 20;
+
+  // Creates a writer that streams the data to |file|.
+  explicit BlockWriter(FileWriterInterface *file);
+
+  // Creates a writer that appends the data to |out_buffer|. When the buffer has
+  // a sink, blocks of data are passed to the sink as they are written.
+  explicit BlockWriter(EncoderBuffer *out_buffer);
+
+  // Flushes all remaining data.
+  ~BlockWriter();
+
+  BlockWriter(const BlockWriter &) = delete;
+  BlockWriter &operator=(const BlockWriter &) = delete;
+
+  // Returns a pointer to memory where up to |size| bytes can be written. The
+  // written bytes become part of the output after a call to Commit() with a
+  // pointer past the last written byte. The pointer is valid only until the
+  // next call to any other method of the writer.
+  char *Reserve(size_t size) {
+    if (size > data_->size() - data_size_) {
+      Grow(size);
+    }
+    return data_->data() + data_size_;
+  }
+  void Commit(const char *end) { data_size_ = end - data_->data(); }
+
+  void Write(const char *data, size_t size) {
+    char *const out = Reserve(size);
+    memcpy(out, data, size);
+    Commit(out + size);
+  }
+  void Write(const std::string &str) { Write(str.data(), str.size()); }
+  void Write(char c) {
+    char *const out = Reserve(1);
+    *out = c;
+    Commit(out + 1);
+  }
+
+  // Writes all data to the output. Returns false when any data couldn't be
+  // written to the output file or to the sink of the output buffer. Data left
+  // in the output buffer is not passed to its sink.
+  bool Flush();
+
+ private:
+  // Makes room for at least |size| bytes after the committed data.
+  void Grow(size_t size);
+
+  FileWriterInterface *file_;
+  EncoderBuffer *out_buffer_;
+
+  // Block used for writing to |file_|.
+  std::vector<char> block_;
+
+  // Memory that is currently being written, either |block_| or the memory of
+  // |out_buffer_|. Only the first |data_size_| bytes are committed.
+  std::vector<char> *data_;
+  size_t data_size_;
+
+  // Set to false when writing to |file_| failed.
+  bool ok_;
+};
+
+}  // namespace draco
+
+#endif  // DRACO_IO_BLOCK_WRITER_H_
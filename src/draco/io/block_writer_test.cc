@@ -0,0 +1,132 @@
+// Copyright 2016 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/io/block_writer.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "draco/core/draco_test_base.h"
+
+namespace {
+
+// File writer that stores all written data in memory.
+class MemoryFileWriter : public draco::FileWriterInterface {
+ public:
+  MemoryFileWriter() : num_writes_(0), fail_(false) {}
+
+  bool Write(const char *buffer, size_t size) override {
+    ++num_writes_;
+    if (fail_) {
+      return false;
+    }
+    data_.append(buffer, size);
+    return true;
+  }
+
+  const std::string &data() const { return data_; }
+  int num_writes() const { return num_writes_; }
+  void set_fail(bool fail) { fail_ = fail; }
+
+ private:
+  std::string data_;
+  int num_writes_;
+  bool fail_;
+};
+
+// Writes |num_records| records of different sizes to |writer| and returns the
+// expected output.
+std::string WriteRecords(int num_records, draco::BlockWriter *writer) {
+  std::string expected;
+  for (int i = 0; i < num_records; ++i) {
+    const std::string record(i % 100, static_cast<char>('a' + i % 26));
+    if (i % 2 == 0) {
+      writer->Write(record);
+    } else {
+      // Reserve more space than needed and commit only the record.
+      char *const out = writer->Reserve(record.size() + 50);
+      memcpy(out, record.data(), record.size());
+      writer->Commit(out + record.size());
+    }
+    writer->Write('\n');
+    expected += record + '\n';
+  }
+  return expected;
+}
+
+TEST(BlockWriterTest, TestWriteToFile) {
+  MemoryFileWriter file;
+  std::string expected;
+  {
+    draco::BlockWriter writer(&file);
+    expected = WriteRecords(50000, &writer);
+    // Records larger than the block are supported.
+    const std::string large_record(3 * draco::BlockWriter::kBlockSize, 'x');
+    writer.Write(large_record);
+    expected += large_record;
+    ASSERT_TRUE(writer.Flush());
+    ASSERT_EQ(file.data(), expected);
+    // The data was written in blocks.
+    ASSERT_GT(file.num_writes(), 1);
+    ASSERT_LT(file.num_writes(), 10);
+    writer.Write("end", 3);
+    expected += "end";
+  }
+  // The remaining data is written when the writer is destroyed.
+  ASSERT_EQ(file.data(), expected);
+}
+
+TEST(BlockWriterTest, TestWriteToFileFailure) {
+  MemoryFileWriter file;
+  draco::BlockWriter writer(&file);
+  writer.Write("data", 4);
+  file.set_fail(true);
+  ASSERT_FALSE(writer.Flush());
+}
+
+TEST(BlockWriterTest, TestWriteToBuffer) {
+  draco::EncoderBuffer buffer;
+  buffer.Encode("header", 6);
+  std::string expected = "header";
+  {
+    draco::BlockWriter writer(&buffer);
+    expected += WriteRecords(1000, &writer);
+    ASSERT_TRUE(writer.Flush());
+    ASSERT_EQ(std::string(buffer.data(), buffer.size()), expected);
+    writer.Write("end", 3);
+    expected += "end";
+  }
+  ASSERT_EQ(std::string(buffer.data(), buffer.size()), expected);
+}
+
+TEST(BlockWriterTest, TestWriteToBufferWithSink) {
+  draco::EncoderBuffer buffer;
+  std::string sink_data;
+  int num_flushes = 0;
+  buffer.SetSink([&](std::vector<char> *data) {
+    sink_data.append(data->data(), data->size());
+    ++num_flushes;
+    return true;
+  });
+  draco::BlockWriter writer(&buffer);
+  const std::string expected = WriteRecords(100000, &writer);
+  ASSERT_TRUE(writer.Flush());
+  // Blocks of the data were passed to the sink while they were written.
+  ASSERT_GT(num_flushes, 1);
+  ASSERT_LT(buffer.size(), expected.size());
+  ASSERT_EQ(sink_data + std::string(buffer.data(), buffer.size()), expected);
+}
+
+}  // namespace
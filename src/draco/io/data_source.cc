@@ -0,0 +1,149 @@
+// Copyright 2016 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/io/data_source.h"
+
+#include <algorithm>
+#include <cerrno>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/stat.h>
+#include <unistd.h>
+#define DRACO_FILE_DESCRIPTOR_SUPPORTED
+#endif
+
+namespace draco {
+
+namespace {
+
+// Number of bytes requested from a data source at once.
+constexpr size_t kReadChunkSize = 1 << 16;
+
+}  // namespace
+
+int64_t IstreamDataSource::Read(char *out_data, size_t max_size) {
+  if (is_ == nullptr || is_->bad()) {
+    return -1;
+  }
+  if (is_->eof()) {
+    return 0;
+  }
+  is_->read(out_data, max_size);
+  if (is_->bad()) {
+    return -1;
+  }
+  return is_->gcount();
+}
+
+int64_t IstreamDataSource::GetRemainingSize() {
+  if (is_ == nullptr || !is_->good()) {
+    return -1;
+  }
+  // tellg() fails without changing the state of non-seekable streams.
+  const std::streampos pos = is_->tellg();
+  if (pos == std::streampos(-1)) {
+    return -1;
+  }
+  is_->seekg(0, std::ios_base::end);
+  const std::streampos end = is_->tellg();
+  is_->seekg(pos);
+  if (!is_->good() || end == std::streampos(-1) || end < pos) {
+    is_->clear();
+    is_->seekg(pos);
+    return -1;
+  }
+  return static_cast<int64_t>(end - pos);
+}
+
+int64_t FileDescriptorDataSource::Read(char *out_data, size_t max_size) {
+#ifdef DRACO_FILE_DESCRIPTOR_SUPPORTED
+  while (true) {
+    const ssize_t num_read = read(fd_, out_data, max_size);
+    if (num_read < 0 && errno == EINTR) {
+      continue;  // Interrupted by a signal before any data was read.
+    }
+    return num_read < 0 ? -1 : static_cast<int64_t>(num_read);
+  }
+#else
+  return -1;
+#endif
+}
+
+int64_t FileDescriptorDataSource::GetRemainingSize() {
+#ifdef DRACO_FILE_DESCRIPTOR_SUPPORTED
+  struct stat file_stat;
+  if (fstat(fd_, &file_stat) != 0 || !S_ISREG(file_stat.st_mode)) {
+    return -1;
+  }
+  const off_t pos = lseek(fd_, 0, SEEK_CUR);
+  if (pos < 0 || pos > file_stat.st_size) {
+    return -1;
+  }
+  return static_cast<int64_t>(file_stat.st_size - pos);
+#else
+  return -1;
+#endif
+}
+
+bool ReadDataSourceToBuffer(DataSourceInterface *source,
+                            std::vector<char> *out_data) {
+  if (source == nullptr || out_data == nullptr) {
+    return false;
+  }
+  size_t size = out_data->size();
+  const int64_t remaining_size = source->GetRemainingSize();
+  if (remaining_size >= 0) {
+    // Read the data directly into a buffer of the exact size.
+    out_data->resize(size + static_cast<size_t>(remaining_size));
+    while (size < out_data->size()) {
+      const int64_t num_read =
+          source->Read(out_data->data() + size, out_data->size() - size);
+      if (num_read <= 0) {
+        out_data->resize(size);
+        return num_read == 0;
+      }
+      size += static_cast<size_t>(num_read);
+    }
+    // Make sure that the end of the data was reached. Any data appended to
+    // the source in the meantime is read in chunks below.
+    char next;
+    const int64_t num_read = source->Read(&next, 1);
+    if (num_read <= 0) {
+      return num_read == 0;
+    }
+    out_data->push_back(next);
+    ++size;
+  }
+  while (true) {
+    if (out_data->size() < size + kReadChunkSize) {
+      // Grow the buffer geometrically to keep the number of reallocations
+      // logarithmic in the size of the data.
+      out_data->resize(std::max(size + kReadChunkSize, 2 * size));
+    }
+    const int64_t num_read =
+        source->Read(out_data->data() + size, out_data->size() - size);
+    if (num_read < 0) {
+      out_data->resize(size);
+      return false;
+    }
+    if (num_read == 0) {
+      break;
+    }
+    size += static_cast<size_t>(num_read);
+  }
+  out_data->resize(size);
+  return true;
+}
+
+}  // namespace draco
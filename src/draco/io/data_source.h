@@ -0,0 +1,79 @@
+// Copyright 2016 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_IO_DATA_SOURCE_H_
+#define DRACO_IO_DATA_SOURCE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <vector>
+
+namespace draco {
+
+// Interface for sequential sources of encoded data, such as streams, pipes or
+// sockets, that are read in chunks without knowing their size in advance and
+// without seeking.
+class DataSourceInterface {
+ public:
+  virtual ~DataSourceInterface() = default;
+
+  // Reads up to |max_size| bytes into |out_data|. Returns the number of bytes
+  // read, 0 when the end of the data was reached or -1 on error.
+  virtual int64_t Read(char *out_data, size_t max_size) = 0;
+
+  // Returns the number of bytes remaining in the source or -1 when it is not
+  // known, e.g. for pipes. Sources that know their size are read in one go.
+  virtual int64_t GetRemainingSize() { return -1; }
+};
+
+// Data source reading from a std::istream. The stream doesn't need to be
+// seekable. The remaining size of seekable streams is determined with
+// tellg() and seekg().
+class IstreamDataSource : public DataSourceInterface {
+ public:
+  explicit IstreamDataSource(std::istream *is) : is_(is) {}
+
+  int64_t Read(char *out_data, size_t max_size) override;
+  int64_t GetRemainingSize() override;
+
+ private:
+  std::istream *is_;
+};
+
+// Data source reading from a file descriptor, e.g. a pipe or a socket, using
+// read(). Supported only on POSIX platforms, elsewhere Read() always fails.
+// The remaining size is known only for descriptors of regular files. The
+// descriptor is not closed by the data source.
+class FileDescriptorDataSource : public DataSourceInterface {
+ public:
+  explicit FileDescriptorDataSource(int fd) : fd_(fd) {}
+
+  int64_t Read(char *out_data, size_t max_size) override;
+  int64_t GetRemainingSize() override;
+
+ private:
+  int fd_;
+};
+
+// Reads all remaining data from |source| and appends it to |out_data|. When
+// the remaining size of |source| is known, |out_data| is grown only once to
+// the exact size. Otherwise the data is read in chunks into a geometrically
+// grown buffer. Returns false on error.
+bool ReadDataSourceToBuffer(DataSourceInterface *source,
+                            std::vector<char> *out_data);
+
+}  // namespace draco
+
+#endif  // DRACO_IO_DATA_SOURCE_H_
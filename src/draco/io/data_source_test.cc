@@ -0,0 +1,129 @@
+// Copyright 2016 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/io/data_source.h"
+
+#include <sstream>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+#include "draco/core/draco_test_base.h"
+#include "draco/core/draco_test_utils.h"
+#include "draco/io/file_utils.h"
+#include "draco/io/mesh_io.h"
+
+namespace draco {
+namespace {
+
+// Stream buffer that provides the data one byte at a time and doesn't support
+// seeking, similarly to a pipe.
+class NonSeekableStreamBuf : public std::streambuf {
+ public:
+  explicit NonSeekableStreamBuf(const std::vector<char> &data)
+      : data_(data), pos_(0) {}
+
+ protected:
+  int_type underflow() override {
+    if (pos_ >= data_.size()) {
+      return traits_type::eof();
+    }
+    current_ = data_[pos_++];
+    setg(&current_, &current_, &current_ + 1);
+    return traits_type::to_int_type(current_);
+  }
+
+ private:
+  const std::vector<char> &data_;
+  size_t pos_;
+  char current_;
+};
+
+TEST(DataSourceTest, ReadIstream) {
+  std::vector<char> data;
+  ASSERT_TRUE(ReadFileToBuffer(GetTestFileFullPath("car.drc"), &data));
+  NonSeekableStreamBuf stream_buf(data);
+  std::istream is(&stream_buf);
+  IstreamDataSource source(&is);
+  std::vector<char> read_data;
+  ASSERT_TRUE(ReadDataSourceToBuffer(&source, &read_data));
+  ASSERT_EQ(read_data, data);
+}
+
+TEST(DataSourceTest, ReadSeekableIstream) {
+  std::vector<char> data;
+  ASSERT_TRUE(ReadFileToBuffer(GetTestFileFullPath("car.drc"), &data));
+  std::istringstream is(std::string(data.data(), data.size()));
+  is.ignore(10);
+  IstreamDataSource source(&is);
+  ASSERT_EQ(source.GetRemainingSize(), static_cast<int64_t>(data.size()) - 10);
+  std::vector<char> read_data;
+  ASSERT_TRUE(ReadDataSourceToBuffer(&source, &read_data));
+  ASSERT_EQ(read_data, std::vector<char>(data.begin() + 10, data.end()));
+  // The buffer is allocated once with the exact size of the data.
+  ASSERT_EQ(read_data.capacity(), read_data.size());
+
+  // The size of non-seekable streams is not known.
+  NonSeekableStreamBuf stream_buf(data);
+  std::istream non_seekable_is(&stream_buf);
+  IstreamDataSource non_seekable_source(&non_seekable_is);
+  ASSERT_EQ(non_seekable_source.GetRemainingSize(), -1);
+  ASSERT_TRUE(non_seekable_is.good());
+}
+
+TEST(DataSourceTest, ReadMeshFromNonSeekableStream) {
+  std::vector<char> data;
+  ASSERT_TRUE(ReadFileToBuffer(GetTestFileFullPath("car.drc"), &data));
+  NonSeekableStreamBuf stream_buf(data);
+  std::istream is(&stream_buf);
+  std::unique_ptr<Mesh> mesh;
+  ReadMeshFromStream(&mesh, is);
+  ASSERT_TRUE(is.good());
+  ASSERT_NE(mesh, nullptr);
+  ASSERT_GT(mesh->num_faces(), 0);
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+TEST(DataSourceTest, ReadMeshFromPipe) {
+  std::vector<char> data;
+  ASSERT_TRUE(ReadFileToBuffer(GetTestFileFullPath("car.drc"), &data));
+  int fds[2];
+  ASSERT_EQ(pipe(fds), 0);
+  // Write the data from another thread as it may not fit into the pipe.
+  std::thread writer([&]() {
+    size_t pos = 0;
+    while (pos < data.size()) {
+      const ssize_t num_written =
+          write(fds[1], data.data() + pos, data.size() - pos);
+      if (num_written <= 0) {
+        break;
+      }
+      pos += num_written;
+    }
+    close(fds[1]);
+  });
+  FileDescriptorDataSource source(fds[0]);
+  auto statusor = ReadMeshFromDataSource(&source);
+  writer.join();
+  close(fds[0]);
+  DRACO_ASSERT_OK(statusor.status());
+  ASSERT_NE(statusor.value(), nullptr);
+  ASSERT_GT(statusor.value()->num_faces(), 0);
+}
+#endif  // defined(__unix__) || defined(__APPLE__)
+
+}  // namespace
+}  // namespace draco
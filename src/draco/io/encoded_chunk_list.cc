@@ -0,0 +1,112 @@
+// Copyright 2016 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/io/encoded_chunk_list.h"
+
+#include <algorithm>
+#include <cerrno>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <limits.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#define DRACO_FILE_DESCRIPTOR_SUPPORTED
+#endif
+
+namespace draco {
+
+EncoderBuffer::Sink EncodedChunkList::sink() {
+  return [this](std::vector<char> *data) { return AppendChunk(data); };
+}
+
+void EncodedChunkList::Append(EncoderBuffer *buffer) {
+  AppendChunk(buffer->buffer());
+  buffer->Clear();
+}
+
+bool EncodedChunkList::AppendChunk(std::vector<char> *data) {
+  if (data->empty()) {
+    return true;
+  }
+  size_ += data->size();
+  chunks_.push_back(std::vector<char>());
+  chunks_.back().swap(*data);
+  return true;
+}
+
+bool EncodedChunkList::WriteToFileDescriptor(int fd) const {
+#ifdef DRACO_FILE_DESCRIPTOR_SUPPORTED
+#ifdef IOV_MAX
+  const size_t max_iov = IOV_MAX;
+#else
+  const size_t max_iov = 16;
+#endif
+  std::vector<struct iovec> iov;
+  size_t chunk_id = 0;
+  while (chunk_id < chunks_.size()) {
+    // Gather the next batch of chunks into a single writev() call.
+    iov.clear();
+    for (size_t i = chunk_id; i < chunks_.size() && iov.size() < max_iov;
+         ++i) {
+      struct iovec v;
+      v.iov_base = const_cast<char *>(chunks_[i].data());
+      v.iov_len = chunks_[i].size();
+      iov.push_back(v);
+    }
+    size_t iov_start = 0;
+    while (iov_start < iov.size()) {
+      const ssize_t num_written =
+          writev(fd, &iov[iov_start], static_cast<int>(iov.size() - iov_start));
+      if (num_written < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        return false;
+      }
+      // Skip all fully written chunks and adjust the partially written one.
+      size_t remaining = static_cast<size_t>(num_written);
+      while (iov_start < iov.size() && remaining >= iov[iov_start].iov_len) {
+        remaining -= iov[iov_start].iov_len;
+        ++iov_start;
+      }
+      if (iov_start < iov.size()) {
+        iov[iov_start].iov_base =
+            static_cast<char *>(iov[iov_start].iov_base) + remaining;
+        iov[iov_start].iov_len -= remaining;
+      }
+    }
+    chunk_id += iov.size();
+  }
+  return true;
+#else
+  (void)fd;
+  return false;
+#endif
+}
+
+std::vector<char> EncodedChunkList::ToVector() const {
+  std::vector<char> data;
+  data.reserve(size_);
+  for (const std::vector<char> &chunk : chunks_) {
+    data.insert(data.end(), chunk.begin(), chunk.end());
+  }
+  return data;
+}
+
+void EncodedChunkList::Clear() {
+  chunks_.clear();
+  size_ = 0;
+}
+
+}  // namespace draco
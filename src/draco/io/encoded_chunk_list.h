@@ -0,0 +1,73 @@
+// Copyright 2016 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_IO_ENCODED_CHUNK_LIST_H_
+#define DRACO_IO_ENCODED_CHUNK_LIST_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "draco/core/encoder_buffer.h"
+
+namespace draco {
+
+// Collects encoded data flushed from an EncoderBuffer as a list of separately
+// allocated chunks. This avoids a single contiguous allocation (and its
+// repeated growth) when encoding very large geometry. Usage:
+//
+//   EncodedChunkList chunks;
+//   EncoderBuffer buffer;
+//   buffer.SetSink(chunks.sink());
+//   encoder.EncodeToBuffer(&buffer);
+//   chunks.Append(&buffer);  // Takes any data that was not flushed yet.
+//   chunks.WriteToFileDescriptor(fd);
+//
+// The list must outlive the EncoderBuffer the sink was set to.
+class EncodedChunkList {
+ public:
+  EncodedChunkList() : size_(0) {}
+
+  // Returns a sink that moves the flushed data into this list without
+  // copying it.
+  EncoderBuffer::Sink sink();
+
+  // Moves all remaining data of |buffer| to the end of the list.
+  void Append(EncoderBuffer *buffer);
+
+  // Writes all chunks to the file descriptor |fd| using scatter-gather
+  // writes (writev()). Supported only on POSIX platforms, elsewhere the
+  // function always fails. Returns false on error.
+  bool WriteToFileDescriptor(int fd) const;
+
+  // Returns the chunks concatenated into a single buffer.
+  std::vector<char> ToVector() const;
+
+  void Clear();
+
+  const std::vector<std::vector<char>> &chunks() const { return chunks_; }
+  size_t num_chunks() const { return chunks_.size(); }
+
+  // Total number of bytes in all chunks.
+  int64_t size() const { return size_; }
+
+ private:
+  bool AppendChunk(std::vector<char> *data);
+
+  std::vector<std::vector<char>> chunks_;
+  int64_t size_;
+};
+
+}  // namespace draco
+
+#endif  // DRACO_IO_ENCODED_CHUNK_LIST_H_
@@ -0,0 +1,126 @@
+// Copyright 2016 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/io/encoded_chunk_list.h"
+
+#include <sstream>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+#include "draco/compression/encode.h"
+#include "draco/core/draco_test_base.h"
+#include "draco/core/draco_test_utils.h"
+#include "draco/io/data_source.h"
+#include "draco/io/mesh_io.h"
+
+namespace draco {
+namespace {
+
+class EncodedChunkListTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    mesh_ = ReadMeshFromTestFile("test_nm.obj");
+    ASSERT_NE(mesh_, nullptr);
+    EncoderBuffer buffer;
+    DRACO_ASSERT_OK(encoder_.EncodeMeshToBuffer(*mesh_, &buffer));
+    expected_data_.assign(buffer.data(), buffer.data() + buffer.size());
+  }
+
+  std::unique_ptr<Mesh> mesh_;
+  Encoder encoder_;
+  std::vector<char> expected_data_;
+};
+
+TEST_F(EncodedChunkListTest, EncodeIntoChunks) {
+  // Encoding into a buffer with a sink must produce the same data as the
+  // encoding into a contiguous buffer.
+  EncodedChunkList chunks;
+  EncoderBuffer buffer;
+  buffer.SetSink(chunks.sink());
+  DRACO_ASSERT_OK(encoder_.EncodeMeshToBuffer(*mesh_, &buffer));
+  chunks.Append(&buffer);
+  ASSERT_EQ(buffer.size(), 0);
+  ASSERT_GT(chunks.num_chunks(), 1);
+  ASSERT_EQ(chunks.size(), expected_data_.size());
+  ASSERT_EQ(chunks.ToVector(), expected_data_);
+}
+
+TEST_F(EncodedChunkListTest, FailingSink) {
+  EncoderBuffer buffer;
+  buffer.SetSink([](std::vector<char> *) { return false; });
+  const Status status = encoder_.EncodeMeshToBuffer(*mesh_, &buffer);
+  ASSERT_EQ(status.code(), Status::IO_ERROR);
+  ASSERT_TRUE(buffer.sink_failed());
+
+  // Failures of the sink at any flush, including the flushes between the
+  // attributes, are reported as IO_ERROR.
+  int num_failure_points = 0;
+  for (int fail_at = 0;; ++fail_at) {
+    int num_calls = 0;
+    EncoderBuffer failing_buffer;
+    failing_buffer.SetSink([&num_calls, fail_at](std::vector<char> *data) {
+      data->clear();
+      return num_calls++ != fail_at;
+    });
+    const Status failing_status =
+        encoder_.EncodeMeshToBuffer(*mesh_, &failing_buffer);
+    if (num_calls <= fail_at) {
+      // All flushes succeeded.
+      DRACO_ASSERT_OK(failing_status);
+      break;
+    }
+    ASSERT_EQ(failing_status.code(), Status::IO_ERROR);
+    ++num_failure_points;
+  }
+  ASSERT_GT(num_failure_points, 3);
+}
+
+TEST_F(EncodedChunkListTest, WriteMeshIntoStream) {
+  std::stringstream ss;
+  WriteMeshIntoStream(mesh_.get(), ss, MESH_EDGEBREAKER_ENCODING);
+  ASSERT_TRUE(ss.good());
+  const std::string data = ss.str();
+  ASSERT_EQ(std::vector<char>(data.begin(), data.end()), expected_data_);
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+TEST_F(EncodedChunkListTest, WriteToFileDescriptor) {
+  EncodedChunkList chunks;
+  EncoderBuffer buffer;
+  buffer.SetSink(chunks.sink());
+  DRACO_ASSERT_OK(encoder_.EncodeMeshToBuffer(*mesh_, &buffer));
+  chunks.Append(&buffer);
+
+  int fds[2];
+  ASSERT_EQ(pipe(fds), 0);
+  std::vector<char> read_data;
+  // Read the data from another thread as it may not fit into the pipe.
+  std::thread reader([&]() {
+    FileDescriptorDataSource source(fds[0]);
+    ReadDataSourceToBuffer(&source, &read_data);
+  });
+  const bool written = chunks.WriteToFileDescriptor(fds[1]);
+  close(fds[1]);
+  reader.join();
+  close(fds[0]);
+  ASSERT_TRUE(written);
+  ASSERT_EQ(read_data, expected_data_);
+}
+#endif  // defined(__unix__) || defined(__APPLE__)
+
+}  // namespace
+}  // namespace draco
@@ -25,6 +25,11 @@ class FileReaderInterface {
 
   // Returns the size of the file.
   virtual size_t GetFileSize() = 0;
+
+  // Returns a pointer to the entire contents of the file that remains valid
+  // for the lifetime of the reader, or nullptr when the reader can't provide
+  // direct access to the contents (ReadFileToBuffer() must be used instead).
+  virtual const char *GetFileData() { return nullptr; }
 };
 
 }  // namespace draco
@@ -18,6 +18,7 @@
 #include "draco/io/file_reader_interface.h"
 #include "draco/io/file_writer_factory.h"
 #include "draco/io/file_writer_interface.h"
+#include "draco/io/mmap_file_reader.h"
 #include "draco/io/parser_utils.h"
 
 namespace draco
@@ -101,6 +102,37 @@ bool ReadFileToBuffer(const std::string &file_name, std::vector<uint8_t> *buffer
   return file_reader->ReadFileToBuffer(buffer);
 }
 
+std::unique_ptr<FileReaderInterface> ReadFileToDecoderBuffer(const std::string &file_name,
+                                                             std::vector<char> *storage,
+                                                             DecoderBuffer *out_buffer)
+{
+  // Map the file directly when possible so that its contents are not copied.
+  // The memory mapped reader is not registered in draco::FileReaderFactory
+  // where the order of readers registered by static initializers is
+  // unspecified.
+  std::unique_ptr<FileReaderInterface> file_reader = MmapFileReader::Open(file_name);
+
+  if (file_reader == nullptr)
+    file_reader = FileReaderFactory::OpenReader(file_name);
+
+  if (file_reader == nullptr)
+    return nullptr;
+
+  const char *const file_data = file_reader->GetFileData();
+
+  if (file_data != nullptr)
+  {
+    out_buffer->Init(file_data, file_reader->GetFileSize());
+    return file_reader;
+  }
+
+  if (!file_reader->ReadFileToBuffer(storage))
+    return nullptr;
+
+  out_buffer->Init(storage->data(), storage->size());
+  return file_reader;
+}
+
 bool WriteBufferToFile(const char *buffer, size_t buffer_size, const std::string &file_name)
 {
   std::unique_ptr<FileWriterInterface> file_writer = FileWriterFactory::OpenWriter(file_name);
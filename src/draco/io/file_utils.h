@@ -15,9 +15,13 @@
 #ifndef DRACO_IO_FILE_UTILS_H_
 #define DRACO_IO_FILE_UTILS_H_
 
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "draco/core/decoder_buffer.h"
+#include "draco/io/file_reader_interface.h"
+
 namespace draco {
 
 // Splits full path to a file into a folder path + file name.
@@ -54,6 +58,16 @@ bool ReadFileToBuffer(const std::string &file_name, std::vector<char> *buffer);
 bool ReadFileToBuffer(const std::string &file_name,
                       std::vector<uint8_t> *buffer);
 
+// Convenience method. Initializes |out_buffer| with the entire contents of the
+// file referenced by |file_name|. Regular files are memory mapped (see
+// MmapFileReader) when the platform supports it and their contents are not
+// copied. Otherwise draco::FileReaderFactory is used to open the file and its
+// contents are read into |storage|. The returned reader must outlive
+// |out_buffer|. Returns nullptr on error.
+std::unique_ptr<FileReaderInterface> ReadFileToDecoderBuffer(
+    const std::string &file_name, std::vector<char> *storage,
+    DecoderBuffer *out_buffer);
+
 // Convenience method. Uses draco::FileWriterFactory internally. Writes contents
 // of |buffer| to file referred to by |file_name|. File is overwritten if it
 // exists. Returns true after successful write.
@@ -23,6 +23,18 @@
 
 namespace draco {
 
+StatusOr<std::unique_ptr<Mesh>> ReadMeshFromDataSource(
+    DataSourceInterface *source) {
+  std::vector<char> data;
+  if (!ReadDataSourceToBuffer(source, &data)) {
+    return Status(Status::IO_ERROR, "Unable to read input data.");
+  }
+  DecoderBuffer buffer;
+  buffer.Init(data.data(), data.size());
+  Decoder decoder;
+  return decoder.DecodeMeshFromBuffer(&buffer);
+}
+
 StatusOr<std::unique_ptr<Mesh>> ReadMeshFromFile(const std::string &file_name) {
   const Options options;
   return ReadMeshFromFile(file_name, options, nullptr);
@@ -77,13 +89,15 @@ StatusOr<std::unique_ptr<Mesh>> ReadMeshFromFile(const std::string &file_name,
 
   // Otherwise not an obj file. Assume the file was encoded with one of the
   // draco encoding methods.
+  // The data is decoded directly from the file when it can be memory mapped.
   std::vector<char> file_data;
+  DecoderBuffer buffer;
+  const std::unique_ptr<FileReaderInterface> file_reader =
+      ReadFileToDecoderBuffer(file_name, &file_data, &buffer);
 
-  if (!ReadFileToBuffer(file_name, &file_data))
+  if (file_reader == nullptr)
     return Status(Status::DRACO_ERROR, "Unable to read input file.");
 
-  DecoderBuffer buffer;
-  buffer.Init(file_data.data(), file_data.size());
   Decoder decoder;
 
   auto statusor = decoder.DecodeMeshFromBuffer(&buffer);
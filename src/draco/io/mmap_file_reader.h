@@ -0,0 +1,71 @@
+// Copyright 2016 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_IO_MMAP_FILE_READER_H_
+#define DRACO_IO_MMAP_FILE_READER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "draco/io/file_reader_interface.h"
+
+namespace draco {
+
+// File reader that maps the whole input file into memory. The contents of the
+// file can be accessed directly using GetFileData() without copying them into
+// a separate buffer. Supported only on POSIX platforms, elsewhere Open()
+// always returns nullptr.
+class MmapFileReader : public FileReaderInterface {
+ public:
+  // Creates and returns a MmapFileReader that reads from |file_name|.
+  // Returns nullptr when the file does not exist, is empty or cannot be
+  // mapped.
+  static std::unique_ptr<FileReaderInterface> Open(
+      const std::string &file_name);
+
+  MmapFileReader() = delete;
+  MmapFileReader(const MmapFileReader &) = delete;
+  MmapFileReader &operator=(const MmapFileReader &) = delete;
+
+  MmapFileReader(MmapFileReader &&) = delete;
+  MmapFileReader &operator=(MmapFileReader &&) = delete;
+
+  // Unmaps the file.
+  ~MmapFileReader() override;
+
+  // Copies the entire contents of the input file into |buffer| and returns
+  // true.
+  bool ReadFileToBuffer(std::vector<char> *buffer) override;
+  bool ReadFileToBuffer(std::vector<uint8_t> *buffer) override;
+
+  // Returns the size of the file.
+  size_t GetFileSize() override { return file_size_; }
+
+  // Returns the mapped contents of the file.
+  const char *GetFileData() override { return data_; }
+
+ private:
+  MmapFileReader(const char *data, size_t file_size)
+      : data_(data), file_size_(file_size) {}
+
+  const char *data_ = nullptr;
+  size_t file_size_ = 0;
+};
+
+}  // namespace draco
+
+#endif  // DRACO_IO_MMAP_FILE_READER_H_
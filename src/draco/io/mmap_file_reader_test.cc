@@ -0,0 +1,80 @@
+// Copyright 2016 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/io/mmap_file_reader.h"
+
+#include <cstring>
+
+#include "draco/core/draco_test_base.h"
+#include "draco/core/draco_test_utils.h"
+#include "draco/io/file_reader_test_common.h"
+#include "draco/io/file_utils.h"
+#include "draco/io/mesh_io.h"
+
+namespace draco {
+namespace {
+
+#if defined(__unix__) || defined(__APPLE__)
+
+TEST(MmapFileReaderTest, FailOpen) {
+  EXPECT_EQ(MmapFileReader::Open(""), nullptr);
+  EXPECT_EQ(MmapFileReader::Open("fake file"), nullptr);
+}
+
+TEST(MmapFileReaderTest, ReadFile) {
+  std::vector<char> buffer;
+
+  auto reader = MmapFileReader::Open(GetTestFileFullPath("car.drc"));
+  ASSERT_NE(reader, nullptr);
+  EXPECT_TRUE(reader->ReadFileToBuffer(&buffer));
+  EXPECT_EQ(buffer.size(), kFileSizeCarDrc);
+
+  reader = MmapFileReader::Open(GetTestFileFullPath("cube_pc.drc"));
+  ASSERT_NE(reader, nullptr);
+  EXPECT_TRUE(reader->ReadFileToBuffer(&buffer));
+  EXPECT_EQ(buffer.size(), kFileSizeCubePcDrc);
+}
+
+TEST(MmapFileReaderTest, GetFileData) {
+  // Tests that the mapped data matches the data read by the default reader.
+  std::vector<char> buffer;
+  ASSERT_TRUE(ReadFileToBuffer(GetTestFileFullPath("car.drc"), &buffer));
+  auto reader = MmapFileReader::Open(GetTestFileFullPath("car.drc"));
+  ASSERT_NE(reader, nullptr);
+  ASSERT_EQ(reader->GetFileSize(), kFileSizeCarDrc);
+  ASSERT_NE(reader->GetFileData(), nullptr);
+  EXPECT_EQ(memcmp(reader->GetFileData(), buffer.data(), buffer.size()), 0);
+}
+
+TEST(MmapFileReaderTest, ReadFileToDecoderBuffer) {
+  std::vector<char> storage;
+  DecoderBuffer buffer;
+  const auto reader = ReadFileToDecoderBuffer(GetTestFileFullPath("car.drc"),
+                                              &storage, &buffer);
+  ASSERT_NE(reader, nullptr);
+  EXPECT_EQ(buffer.remaining_size(), kFileSizeCarDrc);
+  // The mapped data must be used directly instead of being copied.
+  ASSERT_NE(reader->GetFileData(), nullptr);
+  EXPECT_TRUE(storage.empty());
+  EXPECT_EQ(buffer.data_head(), reader->GetFileData());
+  Decoder decoder;
+  DRACO_ASSERT_OK(decoder.DecodeMeshFromBuffer(&buffer).status());
+
+  EXPECT_EQ(ReadFileToDecoderBuffer("fake file", &storage, &buffer), nullptr);
+}
+
+#endif  // defined(__unix__) || defined(__APPLE__)
+
+}  // namespace
+}  // namespace draco
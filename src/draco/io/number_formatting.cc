@@ -0,0 +1,108 @@
+// Copyright 2016 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/io/number_formatting.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace draco {
+
+namespace {
+
+// Pairs of decimal digits for all numbers in range [0, 99].
+const char kDigitPairs[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+// Writes exactly |num_digits| least significant decimal digits of |value|,
+// padded with zeros.
+char *FormatDigits(uint32_t value, int num_digits, char *out) {
+  char *ptr = out + num_digits;
+  while (ptr - out >= 2) {
+    ptr -= 2;
+    memcpy(ptr, kDigitPairs + 2 * (value % 100), 2);
+    value /= 100;
+  }
+  if (ptr != out) {
+    *out = static_cast<char>('0' + value % 10);
+  }
+  return out + num_digits;
+}
+
+}  // namespace
+
+char *FormatFloat(float value, char *out) {
+  // Any finite float multiplied by 10^6 = 15625 * 2^6 is exactly representable
+  // by a double, because the 24 bit mantissa of the float times the 14 bit
+  // odd part of 10^6 fits into the 53 bit mantissa of the double. Rounding of
+  // the exact scaled value to an integer therefore produces the same six
+  // decimal digits as printf(), which also rounds the exact binary value
+  // using the current rounding mode.
+  const double scaled = static_cast<double>(value) * 1e6;
+  const double kMaxExactInteger = 9007199254740992.0;  // 2^53.
+  if (!(std::fabs(scaled) < kMaxExactInteger)) {
+    // Large values, infinities and NaNs.
+    char buffer[kMaxFormattedNumberSize + 16];
+    const int size = snprintf(buffer, sizeof(buffer), "%f", value);
+    if (size < 0) {
+      return out;
+    }
+    memcpy(out, buffer, size);
+    return out + size;
+  }
+  if (std::signbit(value)) {
+    // printf() prints the sign also for negative values that round to zero.
+    *out++ = '-';
+  }
+  const uint64_t fixed_point =
+      static_cast<uint64_t>(std::nearbyint(std::fabs(scaled)));
+  out = FormatUnsignedInt(fixed_point / 1000000, out);
+  *out++ = '.';
+  return FormatDigits(static_cast<uint32_t>(fixed_point % 1000000), 6, out);
+}
+
+char *FormatInt(int64_t value, char *out) {
+  if (value < 0) {
+    *out++ = '-';
+    return FormatUnsignedInt(~static_cast<uint64_t>(value) + 1, out);
+  }
+  return FormatUnsignedInt(static_cast<uint64_t>(value), out);
+}
+
+char *FormatUnsignedInt(uint64_t value, char *out) {
+  // Split the value into parts of at most 8 digits that fit into uint32_t.
+  if (value >= 100000000) {
+    out = FormatUnsignedInt(value / 100000000, out);
+    return FormatDigits(static_cast<uint32_t>(value % 100000000), 8, out);
+  }
+  const uint32_t small_value = static_cast<uint32_t>(value);
+  int num_digits = 1;
+  for (uint32_t limit = 10; num_digits < 8 && small_value >= limit;
+       limit *= 10) {
+    ++num_digits;
+  }
+  return FormatDigits(small_value, num_digits, out);
+}
+
+}  // namespace draco
@@ -0,0 +1,38 @@
+// Copyright 2016 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_IO_NUMBER_FORMATTING_H_
+#define DRACO_IO_NUMBER_FORMATTING_H_
+
+#include <cstdint>
+
+namespace draco {
+
+// Maximum number of characters written by FormatFloat() and FormatInt().
+constexpr int kMaxFormattedNumberSize = 48;
+
+// Writes |value| to |out| in the same format as printf("%f") and returns a
+// pointer past the last written character. No terminating null character is
+// written. The output is exactly the same as the output of snprintf(), but
+// most values are formatted without any calls to the C library.
+char *FormatFloat(float value, char *out);
+
+// Writes decimal representation of |value| to |out| and returns a pointer past
+// the last written character. No terminating null character is written.
+char *FormatInt(int64_t value, char *out);
+char *FormatUnsignedInt(uint64_t value, char *out);
+
+}  // namespace draco
+
+#endif  // DRACO_IO_NUMBER_FORMATTING_H_
@@ -0,0 +1,99 @@
+// Copyright 2016 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/io/number_formatting.h"
+
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <string>
+
+#include "draco/core/draco_test_base.h"
+
+namespace {
+
+std::string FormatFloatToString(float value) {
+  char buffer[draco::kMaxFormattedNumberSize];
+  return std::string(buffer, draco::FormatFloat(value, buffer));
+}
+
+std::string PrintFloat(float value) {
+  char buffer[draco::kMaxFormattedNumberSize + 16];
+  snprintf(buffer, sizeof(buffer), "%f", value);
+  return buffer;
+}
+
+std::string FormatIntToString(int64_t value) {
+  char buffer[draco::kMaxFormattedNumberSize];
+  return std::string(buffer, draco::FormatInt(value, buffer));
+}
+
+TEST(NumberFormattingTest, TestFormatFloat) {
+  const float kValues[] = {0.f,
+                           -0.f,
+                           1.f,
+                           -1.f,
+                           0.5f,
+                           0.1f,
+                           -0.1f,
+                           1e-7f,
+                           -1e-7f,
+                           4.9999997e-7f,
+                           0.0078125f,  // 7812.5e-6 is rounded to even.
+                           0.0234375f,  // 23437.5e-6 is rounded to even.
+                           123456.789f,
+                           9.99999e9f,
+                           1e10f,
+                           -3.4e38f,
+                           std::numeric_limits<float>::max(),
+                           std::numeric_limits<float>::min(),
+                           std::numeric_limits<float>::denorm_min(),
+                           std::numeric_limits<float>::infinity(),
+                           -std::numeric_limits<float>::infinity(),
+                           std::numeric_limits<float>::quiet_NaN()};
+  for (const float value : kValues) {
+    ASSERT_EQ(FormatFloatToString(value), PrintFloat(value)) << value;
+  }
+}
+
+TEST(NumberFormattingTest, TestFormatFloatSamples) {
+  // Compares the output with printf() for a sample of all float bit patterns.
+  for (uint64_t bits = 0; bits <= 0xffffffffull; bits += 65537) {
+    const uint32_t value_bits = static_cast<uint32_t>(bits);
+    float value;
+    memcpy(&value, &value_bits, sizeof(value));
+    ASSERT_EQ(FormatFloatToString(value), PrintFloat(value)) << value_bits;
+  }
+}
+
+TEST(NumberFormattingTest, TestFormatInt) {
+  ASSERT_EQ(FormatIntToString(0), "0");
+  ASSERT_EQ(FormatIntToString(7), "7");
+  ASSERT_EQ(FormatIntToString(-7), "-7");
+  ASSERT_EQ(FormatIntToString(10), "10");
+  ASSERT_EQ(FormatIntToString(99999999), "99999999");
+  ASSERT_EQ(FormatIntToString(100000000), "100000000");
+  ASSERT_EQ(FormatIntToString(-1234567890123), "-1234567890123");
+  ASSERT_EQ(FormatIntToString(std::numeric_limits<int64_t>::max()),
+            "9223372036854775807");
+  ASSERT_EQ(FormatIntToString(std::numeric_limits<int64_t>::min()),
+            "-9223372036854775808");
+  char buffer[draco::kMaxFormattedNumberSize];
+  ASSERT_EQ(std::string(buffer, draco::FormatUnsignedInt(
+                                    std::numeric_limits<uint64_t>::max(),
+                                    buffer)),
+            "18446744073709551615");
+}
+
+}  // namespace
@@ -14,8 +14,10 @@
 //
 #include "draco/io/obj_decoder.h"
 
+#include <algorithm>
 #include <cctype>
 #include <cmath>
+#include <memory>
 
 #include "draco/io/file_utils.h"
 #include "draco/io/parser_utils.h"
@@ -23,9 +25,15 @@
 
 namespace draco {
 
+namespace {
+
+// Minimum size of the input chunks parsed in parallel.
+constexpr int64_t kMinParallelChunkSize = 1 << 20;
+
+}  // namespace
+
 ObjDecoder::ObjDecoder()
-    : counting_mode_(true),
-      num_obj_faces_(0),
+    : num_obj_faces_(0),
       num_positions_(0),
       num_tex_coords_(0),
       num_normals_(0),
@@ -39,6 +47,8 @@ ObjDecoder::ObjDecoder()
       deduplicate_input_values_(true),
       last_material_id_(0),
       use_metadata_(false),
+      parsing_chunk_(false),
+      thread_pool_(nullptr),
       out_mesh_(nullptr),
       out_point_cloud_(nullptr) {}
 
@@ -74,17 +84,33 @@ Status ObjDecoder::DecodeFromBuffer(DecoderBuffer *buffer,
 }
 
 Status ObjDecoder::DecodeInternal() {
-  // In the first pass, count the number of different elements in the geometry.
+  // Parse all definitions in a single pass. The parsed data is stored in
+  // growable arrays and it is copied to the output geometry once the number
+  // of the different elements is known.
   // In case the desired output is just a point cloud (i.e., when
   // out_mesh_ == nullptr) the decoder will ignore all information about the
   // connectivity that may be included in the source data.
-  counting_mode_ = true;
   ResetCounters();
   material_name_to_id_.clear();
   last_sub_obj_id_ = 0;
+  pos_att_id_ = -1;
+  tex_att_id_ = -1;
+  norm_att_id_ = -1;
+  material_att_id_ = -1;
+  sub_obj_att_id_ = -1;
+  positions_.clear();
+  tex_coords_.clear();
+  normals_.clear();
+  corner_indices_.clear();
+  face_material_ids_.clear();
+  face_sub_obj_ids_.clear();
+  corner_relative_indices_.clear();
+  deferred_definitions_.clear();
   // Parse all lines.
   Status status(Status::OK);
-  while (ParseDefinition(&status) && status.ok()) {
+  if (!ParseDefinitionsInParallel(&status)) {
+    while (ParseDefinition(&status) && status.ok()) {
+    }
   }
   if (!status.ok()) {
     return status;
@@ -131,6 +157,9 @@ Status ObjDecoder::DecodeInternal() {
             sizeof(float) * 3, 0);
     pos_att_id_ = out_point_cloud_->AddAttribute(va, use_identity_mapping,
                                                  num_positions_);
+    out_point_cloud_->attribute(pos_att_id_)
+        ->buffer()
+        ->Write(0, positions_.data(), sizeof(float) * positions_.size());
   }
   if (num_tex_coords_ > 0) {
     GeometryAttribute va;
@@ -138,6 +167,9 @@ Status ObjDecoder::DecodeInternal() {
             sizeof(float) * 2, 0);
     tex_att_id_ = out_point_cloud_->AddAttribute(va, use_identity_mapping,
                                                  num_tex_coords_);
+    out_point_cloud_->attribute(tex_att_id_)
+        ->buffer()
+        ->Write(0, tex_coords_.data(), sizeof(float) * tex_coords_.size());
   }
   if (num_normals_ > 0) {
     GeometryAttribute va;
@@ -145,6 +177,9 @@ Status ObjDecoder::DecodeInternal() {
             sizeof(float) * 3, 0);
     norm_att_id_ =
         out_point_cloud_->AddAttribute(va, use_identity_mapping, num_normals_);
+    out_point_cloud_->attribute(norm_att_id_)
+        ->buffer()
+        ->Write(0, normals_.data(), sizeof(float) * normals_.size());
   }
   if (num_materials_ > 0 && num_obj_faces_ > 0) {
     GeometryAttribute va;
@@ -213,15 +248,8 @@ Status ObjDecoder::DecodeInternal() {
     }
   }
 
-  // Perform a second iteration of parsing and fill all the data.
-  counting_mode_ = false;
-  ResetCounters();
-  // Start parsing from the beginning of the buffer again.
-  buffer()->StartDecodingFrom(0);
-  while (ParseDefinition(&status) && status.ok()) {
-  }
-  if (!status.ok()) {
-    return status;
+  if (num_obj_faces_ > 0) {
+    MapPointsToVertexIndices();
   }
   if (out_mesh_) {
     // Add faces with identity mapping between vertex and corner indices.
@@ -237,15 +265,133 @@ Status ObjDecoder::DecodeInternal() {
 
 #ifdef DRACO_ATTRIBUTE_VALUES_DEDUPLICATION_SUPPORTED
   if (deduplicate_input_values_) {
-    out_point_cloud_->DeduplicateAttributeValues();
+    out_point_cloud_->DeduplicateAttributeValues(thread_pool_);
   }
 #endif
 #ifdef DRACO_ATTRIBUTE_INDICES_DEDUPLICATION_SUPPORTED
-  out_point_cloud_->DeduplicatePointIds();
+  out_point_cloud_->DeduplicatePointIds(thread_pool_);
 #endif
   return status;
 }
 
+bool ObjDecoder::ParseDefinitionsInParallel(Status *status) {
+  if (thread_pool_ == nullptr) {
+    return false;
+  }
+  const int64_t data_offset = buffer()->decoded_size();
+  const char *const data = buffer()->data_head();
+  const int64_t data_size = buffer()->remaining_size();
+  const int64_t max_num_chunks = std::min<int64_t>(
+      thread_pool_->num_threads() + 1, data_size / kMinParallelChunkSize);
+  if (max_num_chunks <= 1) {
+    return false;
+  }
+
+  // Split the input into chunks that start at the beginning of a line.
+  std::vector<int64_t> chunk_starts(1, 0);
+  for (int64_t i = 1; i < max_num_chunks; ++i) {
+    const char *line = data + data_size * i / max_num_chunks;
+    parser::SkipLine(&line, data + data_size);
+    if (line - data > chunk_starts.back() && line - data < data_size) {
+      chunk_starts.push_back(line - data);
+    }
+  }
+  chunk_starts.push_back(data_size);
+  const int num_chunks = static_cast<int>(chunk_starts.size()) - 1;
+
+  std::vector<std::unique_ptr<ObjDecoder>> chunks(num_chunks);
+  std::vector<Status> chunk_statuses(num_chunks, OkStatus());
+  std::vector<int64_t> parsed_sizes(num_chunks);
+  thread_pool_->ParallelFor(num_chunks, [&](int i) {
+    chunks[i].reset(new ObjDecoder());
+    parsed_sizes[i] = chunks[i]->ParseChunk(
+        data + chunk_starts[i], chunk_starts[i + 1] - chunk_starts[i],
+        data_size - chunk_starts[i], &chunk_statuses[i]);
+  });
+
+  // Make sure the chunks were parsed in the same way as the whole input would
+  // be. Errors are always reported by the serial parser. Each chunk must end
+  // exactly where the parsing of the next chunk starts, i.e., no definition
+  // can continue into the next chunk.
+  for (int i = 0; i < num_chunks; ++i) {
+    if (!chunk_statuses[i].ok()) {
+      return false;
+    }
+    if (i + 1 < num_chunks) {
+      const char *next_chunk = data + chunk_starts[i + 1];
+      parser::SkipWhitespace(&next_chunk, data + data_size);
+      if (chunk_starts[i] + parsed_sizes[i] != next_chunk - data) {
+        return false;
+      }
+    }
+  }
+
+  for (int i = 0; i < num_chunks; ++i) {
+    MergeChunk(*chunks[i], data_offset + chunk_starts[i], status);
+    if (!status->ok()) {
+      break;
+    }
+  }
+  return true;
+}
+
+int64_t ObjDecoder::ParseChunk(const char *data, int64_t chunk_size,
+                               int64_t data_size, Status *status) {
+  parsing_chunk_ = true;
+  buffer_.Init(data, data_size);
+  while (status->ok()) {
+    parser::SkipWhitespace(buffer());
+    if (buffer()->decoded_size() >= chunk_size || !ParseDefinition(status)) {
+      break;
+    }
+  }
+  return buffer()->decoded_size();
+}
+
+void ObjDecoder::MergeChunk(const ObjDecoder &chunk, int64_t chunk_offset,
+                            Status *status) {
+  // Relative indices of the chunk are offset by the number of values parsed
+  // in all previous chunks.
+  const int value_offsets[3] = {num_positions_, num_tex_coords_,
+                                num_normals_};
+  positions_.insert(positions_.end(), chunk.positions_.begin(),
+                    chunk.positions_.end());
+  tex_coords_.insert(tex_coords_.end(), chunk.tex_coords_.begin(),
+                     chunk.tex_coords_.end());
+  normals_.insert(normals_.end(), chunk.normals_.begin(),
+                  chunk.normals_.end());
+  num_positions_ += chunk.num_positions_;
+  num_tex_coords_ += chunk.num_tex_coords_;
+  num_normals_ += chunk.num_normals_;
+  for (size_t c = 0; c < chunk.corner_indices_.size(); ++c) {
+    std::array<int32_t, 3> indices = chunk.corner_indices_[c];
+    for (int i = 0; i < 3; ++i) {
+      if (chunk.corner_relative_indices_[c] & (1 << i)) {
+        indices[i] += value_offsets[i];
+      }
+    }
+    corner_indices_.push_back(indices);
+  }
+
+  // Process the deferred definitions in their original order and assign the
+  // active material and sub-object to all faces of the chunk.
+  const int first_face = num_obj_faces_;
+  for (const auto &definition : chunk.deferred_definitions_) {
+    face_material_ids_.resize(first_face + definition.second,
+                              last_material_id_);
+    face_sub_obj_ids_.resize(first_face + definition.second,
+                             last_sub_obj_id_);
+    buffer()->StartDecodingFrom(chunk_offset + definition.first);
+    ParseDefinition(status);
+    if (!status->ok()) {
+      return;
+    }
+  }
+  num_obj_faces_ += chunk.num_obj_faces_;
+  face_material_ids_.resize(num_obj_faces_, last_material_id_);
+  face_sub_obj_ids_.resize(num_obj_faces_, last_sub_obj_id_);
+}
+
 void ObjDecoder::ResetCounters() {
   num_obj_faces_ = 0;
   num_positions_ = 0;
@@ -279,6 +425,26 @@ bool ObjDecoder::ParseDefinition(Status *status) {
   if (ParseFace(status)) {
     return true;
   }
+  if (parsing_chunk_) {
+    // Material and sub-object definitions are processed when the chunks are
+    // merged. All other definitions are ignored.
+    if (c == 'u' || c == 'm' || c == 'o') {
+      const int64_t definition_offset = buffer()->decoded_size();
+      std::string mat_name;
+      if (ParseMaterialName(&mat_name) && mat_name.empty()) {
+        // The whole input parser skips also the line following a material
+        // definition without a name, which can't be reproduced within the
+        // chunk. Fail the chunk so that the input is parsed serially.
+        *status = Status(Status::DRACO_ERROR, "Unsupported material name.");
+        return false;
+      }
+      buffer()->StartDecodingFrom(definition_offset);
+      deferred_definitions_.push_back(
+          std::make_pair(definition_offset, num_obj_faces_));
+    }
+    parser::SkipLine(buffer());
+    return true;
+  }
   if (ParseMaterial(status)) {
     return true;
   }
@@ -303,20 +469,17 @@ bool ObjDecoder::ParseVertexPosition(Status *status) {
   }
   // Vertex definition found!
   buffer()->Advance(2);
-  if (!counting_mode_) {
-    // Parse three float numbers for vertex position coordinates.
-    float val[3];
-    for (int i = 0; i < 3; ++i) {
-      parser::SkipWhitespace(buffer());
-      if (!parser::ParseFloat(buffer(), val + i)) {
-        *status = Status(Status::DRACO_ERROR, "Failed to parse a float number");
-        // The definition is processed so return true.
-        return true;
-      }
+  // Parse three float numbers for vertex position coordinates.
+  float val[3];
+  for (int i = 0; i < 3; ++i) {
+    parser::SkipWhitespace(buffer());
+    if (!parser::ParseFloat(buffer(), val + i)) {
+      *status = Status(Status::DRACO_ERROR, "Failed to parse a float number");
+      // The definition is processed so return true.
+      return true;
     }
-    out_point_cloud_->attribute(pos_att_id_)
-        ->SetAttributeValue(AttributeValueIndex(num_positions_), val);
   }
+  positions_.insert(positions_.end(), val, val + 3);
   ++num_positions_;
   parser::SkipLine(buffer());
   return true;
@@ -332,20 +495,17 @@ bool ObjDecoder::ParseNormal(Status *status) {
   }
   // Normal definition found!
   buffer()->Advance(2);
-  if (!counting_mode_) {
-    // Parse three float numbers for the normal vector.
-    float val[3];
-    for (int i = 0; i < 3; ++i) {
-      parser::SkipWhitespace(buffer());
-      if (!parser::ParseFloat(buffer(), val + i)) {
-        *status = Status(Status::DRACO_ERROR, "Failed to parse a float number");
-        // The definition is processed so return true.
-        return true;
-      }
+  // Parse three float numbers for the normal vector.
+  float val[3];
+  for (int i = 0; i < 3; ++i) {
+    parser::SkipWhitespace(buffer());
+    if (!parser::ParseFloat(buffer(), val + i)) {
+      *status = Status(Status::DRACO_ERROR, "Failed to parse a float number");
+      // The definition is processed so return true.
+      return true;
     }
-    out_point_cloud_->attribute(norm_att_id_)
-        ->SetAttributeValue(AttributeValueIndex(num_normals_), val);
   }
+  normals_.insert(normals_.end(), val, val + 3);
   ++num_normals_;
   parser::SkipLine(buffer());
   return true;
@@ -361,20 +521,17 @@ bool ObjDecoder::ParseTexCoord(Status *status) {
   }
   // Texture coord definition found!
   buffer()->Advance(2);
-  if (!counting_mode_) {
-    // Parse two float numbers for the texture coordinate.
-    float val[2];
-    for (int i = 0; i < 2; ++i) {
-      parser::SkipWhitespace(buffer());
-      if (!parser::ParseFloat(buffer(), val + i)) {
-        *status = Status(Status::DRACO_ERROR, "Failed to parse a float number");
-        // The definition is processed so return true.
-        return true;
-      }
+  // Parse two float numbers for the texture coordinate.
+  float val[2];
+  for (int i = 0; i < 2; ++i) {
+    parser::SkipWhitespace(buffer());
+    if (!parser::ParseFloat(buffer(), val + i)) {
+      *status = Status(Status::DRACO_ERROR, "Failed to parse a float number");
+      // The definition is processed so return true.
+      return true;
     }
-    out_point_cloud_->attribute(tex_att_id_)
-        ->SetAttributeValue(AttributeValueIndex(num_tex_coords_), val);
   }
+  tex_coords_.insert(tex_coords_.end(), val, val + 2);
   ++num_tex_coords_;
   parser::SkipLine(buffer());
   return true;
@@ -390,67 +547,61 @@ bool ObjDecoder::ParseFace(Status *status) {
   }
   // Face definition found!
   buffer()->Advance(1);
-  if (!counting_mode_) {
-    std::array<int32_t, 3> indices[4];
-    // Parse face indices (we try to look for up to four to support quads).
-    int num_valid_indices = 0;
-    for (int i = 0; i < 4; ++i) {
-      if (!ParseVertexIndices(&indices[i])) {
-        if (i == 3) {
-          break;  // It's OK if there is no fourth vertex index.
-        }
-        *status = Status(Status::DRACO_ERROR, "Failed to parse vertex indices");
-        return true;
+  // Determine how many triangles are in the obj face. Go over the line and
+  // check how many gaps there are between non-empty sub-strings.
+  const char *data = buffer()->data_head();
+  const char *const end = data + buffer()->remaining_size();
+  parser::SkipWhitespace(&data, end);
+  int num_indices = 0;
+  while (data < end && *data != '\n') {
+    if (parser::IsWhitespace(*data)) {
+      ++data;
+    } else {
+      // Non-whitespace reached.. assume it's index declaration, skip it.
+      num_indices++;
+      while (data < end && !parser::IsWhitespace(*data)) {
+        ++data;
       }
-      ++num_valid_indices;
-    }
-    // Process the first face.
-    for (int i = 0; i < 3; ++i) {
-      const PointIndex vert_id(3 * num_obj_faces_ + i);
-      MapPointToVertexIndices(vert_id, indices[i]);
-    }
-    ++num_obj_faces_;
-    if (num_valid_indices == 4) {
-      // Add an additional triangle for the quad.
-      //
-      //   3----2
-      //   |  / |
-      //   | /  |
-      //   0----1
-      //
-      const PointIndex vert_id(3 * num_obj_faces_);
-      MapPointToVertexIndices(vert_id, indices[0]);
-      MapPointToVertexIndices(vert_id + 1, indices[2]);
-      MapPointToVertexIndices(vert_id + 2, indices[3]);
-      ++num_obj_faces_;
     }
-  } else {
-    // We are in the counting mode.
-    // We need to determine how many triangles are in the obj face.
-    // Go over the line and check how many gaps there are between non-empty
-    // sub-strings.
-    parser::SkipWhitespace(buffer());
-    int num_indices = 0;
-    bool is_end = false;
-    while (buffer()->Peek(&c) && c != '\n') {
-      if (parser::PeekWhitespace(buffer(), &is_end)) {
-        buffer()->Advance(1);
-      } else {
-        // Non-whitespace reached.. assume it's index declaration, skip it.
-        num_indices++;
-        while (!parser::PeekWhitespace(buffer(), &is_end) && !is_end) {
-          buffer()->Advance(1);
-        }
+  }
+  if (num_indices < 3 || num_indices > 4) {
+    *status =
+        Status(Status::DRACO_ERROR, "Invalid number of indices on a face");
+    return true;
+  }
+  std::array<int32_t, 3> indices[4];
+  // Parse face indices (we try to look for up to four to support quads).
+  int num_valid_indices = 0;
+  for (int i = 0; i < 4; ++i) {
+    if (!ParseVertexIndices(&indices[i])) {
+      if (i == 3) {
+        break;  // It's OK if there is no fourth vertex index.
       }
+      *status = Status(Status::DRACO_ERROR, "Failed to parse vertex indices");
+      return true;
     }
-    if (num_indices < 3 || num_indices > 4) {
-      *status =
-          Status(Status::DRACO_ERROR, "Invalid number of indices on a face");
-      return false;
-    }
-    // Either one or two new triangles.
-    num_obj_faces_ += num_indices - 2;
+    ++num_valid_indices;
+  }
+  // Process the first face.
+  for (int i = 0; i < 3; ++i) {
+    AddCorner(indices[i]);
+  }
+  ++num_obj_faces_;
+  if (num_valid_indices == 4) {
+    // Add an additional triangle for the quad.
+    //
+    //   3----2
+    //   |  / |
+    //   | /  |
+    //   0----1
+    //
+    AddCorner(indices[0]);
+    AddCorner(indices[2]);
+    AddCorner(indices[3]);
+    ++num_obj_faces_;
   }
+  face_material_ids_.resize(num_obj_faces_, last_material_id_);
+  face_sub_obj_ids_.resize(num_obj_faces_, last_sub_obj_id_);
   parser::SkipLine(buffer());
   return true;
 }
@@ -486,11 +637,7 @@ bool ObjDecoder::ParseMaterialLib(Status *status) {
   return true;
 }
 
-bool ObjDecoder::ParseMaterial(Status * /* status */) {
-  // In second pass, skip when we don't use materials.
-  if (!counting_mode_ && material_att_id_ < 0) {
-    return false;
-  }
+bool ObjDecoder::ParseMaterialName(std::string *out_name) {
   std::array<char, 6> c;
   if (!buffer()->Peek(&c)) {
     return false;
@@ -501,15 +648,19 @@ bool ObjDecoder::ParseMaterial(Status * /* status */) {
   buffer()->Advance(6);
   DecoderBuffer line_buffer = parser::ParseLineIntoDecoderBuffer(buffer());
   parser::SkipWhitespace(&line_buffer);
+  parser::ParseLine(&line_buffer, out_name);
+  return true;
+}
+
+bool ObjDecoder::ParseMaterial(Status * /* status */) {
   std::string mat_name;
-  parser::ParseLine(&line_buffer, &mat_name);
-  if (mat_name.length() == 0) {
+  if (!ParseMaterialName(&mat_name) || mat_name.length() == 0) {
     return false;
   }
   auto it = material_name_to_id_.find(mat_name);
   if (it == material_name_to_id_.end()) {
-    // In first pass, materials found in obj that's not in the .mtl file
-    // will be added to the list.
+    // Materials found in obj that's not in the .mtl file will be added to the
+    // list.
     last_material_id_ = num_materials_;
     material_name_to_id_[mat_name] = num_materials_++;
 
@@ -593,65 +744,66 @@ bool ObjDecoder::ParseVertexIndices(std::array<int32_t, 3> *out_indices) {
   return true;
 }
 
-void ObjDecoder::MapPointToVertexIndices(
-    PointIndex vert_id, const std::array<int32_t, 3> &indices) {
-  // Use face entries to store mapping between vertex and attribute indices
-  // (positions, texture coordinates and normal indices).
+void ObjDecoder::AddCorner(const std::array<int32_t, 3> &indices) {
+  // Convert the parsed indices to attribute value indices.
   // Any given index is used when indices[x] != 0. For positive values, the
-  // point is mapped directly to the specified attribute index. Negative input
+  // corner is mapped directly to the specified attribute index. Negative input
   // indices indicate addressing from the last element (e.g. -1 is the last
-  // attribute value of a given type, -2 the second last, etc.).
-  if (indices[0] > 0) {
-    out_point_cloud_->attribute(pos_att_id_)
-        ->SetPointMapEntry(vert_id, AttributeValueIndex(indices[0] - 1));
-  } else if (indices[0] < 0) {
-    out_point_cloud_->attribute(pos_att_id_)
-        ->SetPointMapEntry(vert_id,
-                           AttributeValueIndex(num_positions_ + indices[0]));
-  }
-
-  if (tex_att_id_ >= 0) {
-    if (indices[1] > 0) {
-      out_point_cloud_->attribute(tex_att_id_)
-          ->SetPointMapEntry(vert_id, AttributeValueIndex(indices[1] - 1));
-    } else if (indices[1] < 0) {
-      out_point_cloud_->attribute(tex_att_id_)
-          ->SetPointMapEntry(vert_id,
-                             AttributeValueIndex(num_tex_coords_ + indices[1]));
+  // attribute value of a given type, -2 the second last, etc.). Texture
+  // coordinate and normal indices that are not provided are mapped to the
+  // default entry 0.
+  const int num_values[3] = {num_positions_, num_tex_coords_, num_normals_};
+  std::array<int32_t, 3> value_indices;
+  uint8_t relative_indices = 0;
+  for (int i = 0; i < 3; ++i) {
+    if (indices[i] > 0) {
+      value_indices[i] = indices[i] - 1;
+    } else if (indices[i] < 0) {
+      value_indices[i] = num_values[i] + indices[i];
+      relative_indices |= 1 << i;
     } else {
-      // Texture index not provided but expected. Insert 0 entry as the
-      // default value.
-      out_point_cloud_->attribute(tex_att_id_)
-          ->SetPointMapEntry(vert_id, AttributeValueIndex(0));
+      value_indices[i] = 0;
     }
   }
+  corner_indices_.push_back(value_indices);
+  if (parsing_chunk_) {
+    corner_relative_indices_.push_back(relative_indices);
+  }
+}
 
-  if (norm_att_id_ >= 0) {
-    if (indices[2] > 0) {
-      out_point_cloud_->attribute(norm_att_id_)
-          ->SetPointMapEntry(vert_id, AttributeValueIndex(indices[2] - 1));
-    } else if (indices[2] < 0) {
-      out_point_cloud_->attribute(norm_att_id_)
-          ->SetPointMapEntry(vert_id,
-                             AttributeValueIndex(num_normals_ + indices[2]));
-    } else {
-      // Normal index not provided but expected. Insert 0 entry as the default
-      // value.
-      out_point_cloud_->attribute(norm_att_id_)
-          ->SetPointMapEntry(vert_id, AttributeValueIndex(0));
+void ObjDecoder::MapPointsToVertexIndices() {
+  // Use face entries to store mapping between vertex and attribute indices
+  // (positions, texture coordinates and normal indices).
+  const int att_ids[3] = {pos_att_id_, tex_att_id_, norm_att_id_};
+  for (int i = 0; i < 3; ++i) {
+    if (att_ids[i] < 0) {
+      continue;
+    }
+    PointAttribute *const att = out_point_cloud_->attribute(att_ids[i]);
+    for (PointIndex vert_id(0); vert_id < 3 * num_obj_faces_; ++vert_id) {
+      att->SetPointMapEntry(
+          vert_id, AttributeValueIndex(corner_indices_[vert_id.value()][i]));
     }
   }
 
-  // Assign material index to the point if it is available.
+  // Assign material index to the points if it is available.
   if (material_att_id_ >= 0) {
-    out_point_cloud_->attribute(material_att_id_)
-        ->SetPointMapEntry(vert_id, AttributeValueIndex(last_material_id_));
+    PointAttribute *const att = out_point_cloud_->attribute(material_att_id_);
+    for (PointIndex vert_id(0); vert_id < 3 * num_obj_faces_; ++vert_id) {
+      const int face_id = vert_id.value() / 3;
+      att->SetPointMapEntry(vert_id,
+                            AttributeValueIndex(face_material_ids_[face_id]));
+    }
   }
 
-  // Assign sub-object index to the point if it is available.
+  // Assign sub-object index to the points if it is available.
   if (sub_obj_att_id_ >= 0) {
-    out_point_cloud_->attribute(sub_obj_att_id_)
-        ->SetPointMapEntry(vert_id, AttributeValueIndex(last_sub_obj_id_));
+    PointAttribute *const att = out_point_cloud_->attribute(sub_obj_att_id_);
+    for (PointIndex vert_id(0); vert_id < 3 * num_obj_faces_; ++vert_id) {
+      const int face_id = vert_id.value() / 3;
+      att->SetPointMapEntry(vert_id,
+                            AttributeValueIndex(face_sub_obj_ids_[face_id]));
+    }
   }
 }
 
@@ -15,11 +15,14 @@
 #ifndef DRACO_IO_OBJ_DECODER_H_
 #define DRACO_IO_OBJ_DECODER_H_
 
+#include <array>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "draco/core/decoder_buffer.h"
 #include "draco/core/status.h"
+#include "draco/core/thread_pool.h"
 #include "draco/draco_features.h"
 #include "draco/mesh/mesh.h"
 
@@ -51,6 +54,12 @@ class ObjDecoder {
   // file, e.g. material names, object names.
   void set_use_metadata(bool flag) { use_metadata_ = flag; }
 
+  // Sets a thread pool that is used to parse large files and to deduplicate
+  // the decoded data in parallel (can be nullptr). The input is split into
+  // line-aligned chunks that are parsed independently and then merged. The
+  // decoded geometry is the same as when no thread pool is used.
+  void set_thread_pool(ThreadPool *thread_pool) { thread_pool_ = thread_pool; }
+
  protected:
   Status DecodeInternal();
   DecoderBuffer *buffer() { return &buffer_; }
@@ -64,6 +73,24 @@ class ObjDecoder {
   // Returns false when the end of file was reached.
   bool ParseDefinition(Status *status);
 
+  // Parses all definitions in parallel on |thread_pool_|. Returns false when
+  // the input can't be split into chunks that are parsed exactly as the whole
+  // file would be, in which case no data has been parsed and the input must
+  // be parsed serially.
+  bool ParseDefinitionsInParallel(Status *status);
+
+  // Parses definitions of a single chunk of the input stored in |data|. The
+  // chunk ends after |chunk_size| bytes, but definitions that start in the
+  // chunk can continue up to |data_size| bytes. Returns the number of bytes
+  // parsed, including all whitespace that follows the last definition.
+  int64_t ParseChunk(const char *data, int64_t chunk_size, int64_t data_size,
+                     Status *status);
+
+  // Appends data parsed by |chunk| to the data of this decoder. |chunk_offset|
+  // is the position of the chunk in the input buffer.
+  void MergeChunk(const ObjDecoder &chunk, int64_t chunk_offset,
+                  Status *status);
+
   // Attempts to parse definition of position, normal, tex coord, or face
   // respectively.
   // Returns false when the parsed data didn't contain the given definition.
@@ -75,22 +102,27 @@ class ObjDecoder {
   bool ParseMaterial(Status *status);
   bool ParseObject(Status *status);
 
+  // Parses the name of a "usemtl" definition into |out_name|. The name is
+  // empty when the definition doesn't contain one. Returns false when the
+  // parsed data didn't contain the definition.
+  bool ParseMaterialName(std::string *out_name);
+
   // Parses triplet of position, tex coords and normal indices.
   // Returns false on error.
   bool ParseVertexIndices(std::array<int32_t, 3> *out_indices);
 
-  // Maps specified point index to the parsed vertex indices (triplet of
-  // position, texture coordinate, and normal indices) .
-  void MapPointToVertexIndices(PointIndex vert_id,
-                               const std::array<int32_t, 3> &indices);
+  // Adds a new face corner for the parsed vertex indices (triplet of
+  // position, texture coordinate, and normal indices).
+  void AddCorner(const std::array<int32_t, 3> &indices);
+
+  // Maps all points of the parsed faces to the attribute values referenced by
+  // the face corners.
+  void MapPointsToVertexIndices();
 
   // Parses material file definitions from a separate file.
   bool ParseMaterialFile(const std::string &file_name, Status *status);
   bool ParseMaterialFileDefinition(Status *status);
 
-  // If set to true, the parser will count the number of various definitions
-  // but it will not parse the actual data or add any new entries to the mesh.
-  bool counting_mode_;
   int num_obj_faces_;
   int num_positions_;
   int num_tex_coords_;
@@ -116,6 +148,31 @@ class ObjDecoder {
 
   bool use_metadata_;
 
+  // Data parsed from the input file. The arrays are grown as new definitions
+  // are parsed and their content is copied to the output geometry once the
+  // whole file is processed.
+  std::vector<float> positions_;
+  std::vector<float> tex_coords_;
+  std::vector<float> normals_;
+  // Position, texture coordinate and normal value index for each face corner.
+  std::vector<std::array<int32_t, 3>> corner_indices_;
+  // Material and sub-object id for each face.
+  std::vector<int> face_material_ids_;
+  std::vector<int> face_sub_obj_ids_;
+
+  // Set for decoders of individual chunks of the input in the parallel mode.
+  // Definitions that depend on the data of other chunks are not processed
+  // but they are deferred until the chunks are merged.
+  bool parsing_chunk_;
+  // Bits set for each face corner of a chunk that was specified with relative
+  // (negative) indices. Bit i corresponds to corner_indices_[corner][i].
+  std::vector<uint8_t> corner_relative_indices_;
+  // Offsets of the deferred definitions in the chunk and the number of faces
+  // parsed before each of them.
+  std::vector<std::pair<int64_t, int>> deferred_definitions_;
+
+  ThreadPool *thread_pool_;
+
   DecoderBuffer buffer_;
 
   // Data structure that stores the decoded data. |out_point_cloud_| must be
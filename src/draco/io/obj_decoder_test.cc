@@ -14,15 +14,67 @@
 //
 #include "draco/io/obj_decoder.h"
 
+#include <cstring>
 #include <sstream>
 
 #include "draco/core/draco_test_base.h"
 #include "draco/core/draco_test_utils.h"
+#include "draco/core/thread_pool.h"
 
 namespace draco {
 
 class ObjDecoderTest : public ::testing::Test {
  protected:
+  // Decodes |data| serially and on |thread_pool| and verifies that both
+  // decoded meshes are the same.
+  void TestParallelDecoding(const std::string &data,
+                            ThreadPool *thread_pool) const {
+    std::unique_ptr<Mesh> meshes[2];
+    for (int i = 0; i < 2; ++i) {
+      DecoderBuffer buffer;
+      buffer.Init(data.data(), data.size());
+      ObjDecoder decoder;
+      decoder.set_use_metadata(true);
+      decoder.set_thread_pool(i == 0 ? nullptr : thread_pool);
+      meshes[i].reset(new Mesh());
+      const Status status = decoder.DecodeFromBuffer(&buffer, meshes[i].get());
+      ASSERT_TRUE(status.ok()) << status;
+    }
+    const Mesh &serial = *meshes[0];
+    const Mesh &parallel = *meshes[1];
+    ASSERT_GT(serial.num_faces(), 0);
+    ASSERT_EQ(serial.num_faces(), parallel.num_faces());
+    ASSERT_EQ(serial.num_points(), parallel.num_points());
+    ASSERT_EQ(serial.num_attributes(), 5);
+    ASSERT_EQ(serial.num_attributes(), parallel.num_attributes());
+    for (FaceIndex fi(0); fi < serial.num_faces(); ++fi) {
+      ASSERT_EQ(serial.face(fi), parallel.face(fi));
+    }
+    for (int att_id = 0; att_id < serial.num_attributes(); ++att_id) {
+      const PointAttribute *const att = serial.attribute(att_id);
+      const PointAttribute *const parallel_att = parallel.attribute(att_id);
+      ASSERT_EQ(att->size(), parallel_att->size());
+      ASSERT_EQ(att->byte_stride(), parallel_att->byte_stride());
+      for (PointIndex pi(0); pi < serial.num_points(); ++pi) {
+        ASSERT_EQ(att->mapped_index(pi), parallel_att->mapped_index(pi));
+      }
+      ASSERT_EQ(memcmp(att->GetAddress(AttributeValueIndex(0)),
+                       parallel_att->GetAddress(AttributeValueIndex(0)),
+                       att->size() * att->byte_stride()),
+                0);
+    }
+    for (int m = 0; m < 7; ++m) {
+      const std::string name = "mat" + std::to_string(m);
+      int32_t material_id = -1;
+      int32_t parallel_material_id = -1;
+      ASSERT_TRUE(serial.GetAttributeMetadataByAttributeId(3)->GetEntryInt(
+          name, &material_id));
+      ASSERT_TRUE(parallel.GetAttributeMetadataByAttributeId(3)->GetEntryInt(
+          name, &parallel_material_id));
+      ASSERT_EQ(material_id, parallel_material_id);
+    }
+  }
+
   template <class Geometry>
   std::unique_ptr<Geometry> DecodeObj(const std::string &file_name) const {
     return DecodeObj<Geometry>(file_name, false);
@@ -164,6 +216,146 @@ TEST_F(ObjDecoderTest, WrongAttributeMapping) {
   ASSERT_EQ(mesh->attribute(0)->size(), 3);
 }
 
+TEST_F(ObjDecoderTest, DecodeFromBuffer) {
+  // Tests decoding of an obj with relative indices, mixed triangles and quads
+  // and missing texture coordinate indices.
+  const std::string data =
+      "# Test mesh.\n"
+      "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\n"
+      "vt 0 0\nvt 1 0\nvt 1 1\n"
+      "f 1/1 2/2 3/3\n"
+      "f -4 -3 -2 -1\n"
+      "o second\n"
+      "f 1/-3 3/-1 4/-2\r\n";
+  DecoderBuffer buffer;
+  buffer.Init(data.data(), data.size());
+  ObjDecoder decoder;
+  decoder.set_deduplicate_input_values(false);
+  Mesh mesh;
+  ASSERT_TRUE(decoder.DecodeFromBuffer(&buffer, &mesh).ok());
+  ASSERT_EQ(mesh.num_faces(), 4);
+  const PointAttribute *const pos_att =
+      mesh.GetNamedAttribute(GeometryAttribute::POSITION);
+  const PointAttribute *const tex_att =
+      mesh.GetNamedAttribute(GeometryAttribute::TEX_COORD);
+  ASSERT_NE(pos_att, nullptr);
+  ASSERT_NE(tex_att, nullptr);
+  ASSERT_EQ(pos_att->size(), 4);
+  ASSERT_EQ(tex_att->size(), 3);
+  // Expected position and texture coordinate value indices of all corners.
+  const int expected_pos[4][3] = {{0, 1, 2}, {0, 1, 2}, {0, 2, 3}, {0, 2, 3}};
+  const int expected_tex[4][3] = {{0, 1, 2}, {0, 0, 0}, {0, 0, 0}, {0, 2, 1}};
+  for (FaceIndex fi(0); fi < mesh.num_faces(); ++fi) {
+    for (int c = 0; c < 3; ++c) {
+      const PointIndex pi = mesh.face(fi)[c];
+      ASSERT_EQ(pos_att->mapped_index(pi).value(),
+                expected_pos[fi.value()][c]);
+      ASSERT_EQ(tex_att->mapped_index(pi).value(),
+                expected_tex[fi.value()][c]);
+    }
+  }
+  float pos[3];
+  pos_att->GetMappedValue(mesh.face(FaceIndex(3))[2], pos);
+  ASSERT_EQ(pos[0], 0.f);
+  ASSERT_EQ(pos[1], 1.f);
+}
+
+TEST_F(ObjDecoderTest, InvalidFaceFromBuffer) {
+  // Tests that faces with too many indices are rejected.
+  const std::string data = "v 0 0 0\nv 1 0 0\nv 1 1 0\nf 1 2 3 1 2\n";
+  DecoderBuffer buffer;
+  buffer.Init(data.data(), data.size());
+  ObjDecoder decoder;
+  Mesh mesh;
+  ASSERT_FALSE(decoder.DecodeFromBuffer(&buffer, &mesh).ok());
+}
+
+TEST_F(ObjDecoderTest, DecodeInParallel) {
+  // Tests that a large obj decoded on a thread pool is the same as the obj
+  // decoded serially. The data uses both absolute and relative indices,
+  // multiple materials and sub-objects, quads, comments and empty lines.
+  std::string data = "# Large test mesh.\n\n";
+  const int num_rows = 300;
+  const int num_cols = 200;
+  int num_vertices = 0;
+  for (int r = 0; r < num_rows; ++r) {
+    if (r % 37 == 0) {
+      data += "o part" + std::to_string(r % 5) + "\n";
+    }
+    if (r % 23 == 0) {
+      data += "usemtl mat" + std::to_string(r % 7) + "\n\n";
+    }
+    for (int c = 0; c < num_cols; ++c) {
+      data += "v " + std::to_string(c * 0.5) + " " + std::to_string(r) +
+              " " + std::to_string((r * c) % 17 * 0.125) + "\n";
+      data += "vt " + std::to_string(c * 0.001) + " " +
+              std::to_string(r * 0.002) + "\n";
+      data += "vn 0 " + std::to_string((r + c) % 3) + " 1\n";
+      ++num_vertices;
+    }
+    if (r == 0) {
+      continue;
+    }
+    for (int c = 0; c + 1 < num_cols; ++c) {
+      if (c % 2 == 0) {
+        // Quad with absolute indices.
+        const int v0 = num_vertices - 2 * num_cols + c + 1;
+        const int v1 = v0 + 1;
+        const int v2 = v1 + num_cols;
+        const int v3 = v0 + num_cols;
+        data += "f " + std::to_string(v0) + "/" + std::to_string(v0) + "/" +
+                std::to_string(v0) + " " + std::to_string(v1) + "//" +
+                std::to_string(v1) + " " + std::to_string(v2) + "/" +
+                std::to_string(v2) + " " + std::to_string(v3) + "\n";
+      } else {
+        // Triangle with relative indices.
+        const int v0 = -(num_cols - c);
+        const int v1 = v0 + 1;
+        const int v2 = v0 - num_cols;
+        data += "f " + std::to_string(v0) + "/" + std::to_string(v0) + "/" +
+                std::to_string(v0) + " " + std::to_string(v1) + "/" +
+                std::to_string(v1) + "/" + std::to_string(v1) + " " +
+                std::to_string(v2) + "/" + std::to_string(v2) + "/" +
+                std::to_string(v2) + "\n";
+      }
+    }
+  }
+  ASSERT_GT(data.size(), 4u << 20);
+
+  ThreadPool thread_pool(3);
+  TestParallelDecoding(data, &thread_pool);
+
+  // A "usemtl" definition without a name makes the parser skip also the
+  // following line. Test it in the middle of a chunk and as the last line of
+  // the first chunk (the input is split into four chunks at line boundaries).
+  {
+    std::string data_2 = data;
+    data_2.insert(data_2.find("\nv ", data_2.size() / 3) + 1,
+                  "usemtl\nv 9 9 9\n");
+    TestParallelDecoding(data_2, &thread_pool);
+  }
+  {
+    const std::string empty_material = "usemtl" + std::string(128, ' ') + "\n";
+    const size_t chunk_end = (data.size() + empty_material.size()) / 4;
+    std::string data_2 = data;
+    data_2.insert(data_2.rfind('\n', chunk_end - 1) + 1, empty_material);
+    TestParallelDecoding(data_2, &thread_pool);
+  }
+
+  // Errors are reported in the same way.
+  data += "f 1 2\n";
+  for (ThreadPool *const pool : {static_cast<ThreadPool *>(nullptr),
+                                 &thread_pool}) {
+    DecoderBuffer buffer;
+    buffer.Init(data.data(), data.size());
+    ObjDecoder decoder;
+    decoder.set_thread_pool(pool);
+    Mesh mesh;
+    const Status status = decoder.DecodeFromBuffer(&buffer, &mesh);
+    ASSERT_EQ(status.error_msg_string(), "Invalid number of indices on a face");
+  }
+}
+
 TEST_F(ObjDecoderTest, TestObjDecodingAll) {
   // test if we can read all obj that are currently in test folder.
   test_decoding("bunny_norm.obj");
@@ -14,21 +14,65 @@
 //
 #include "draco/io/obj_encoder.h"
 
+#include <algorithm>
+#include <array>
+#include <cstring>
 #include <memory>
 
 #include "draco/io/file_writer_factory.h"
 #include "draco/io/file_writer_interface.h"
+#include "draco/io/number_formatting.h"
 #include "draco/metadata/geometry_metadata.h"
 
 namespace draco {
 
+namespace {
+
+// Minimum number of entries (attribute values or faces) encoded by a single
+// task when the encoding runs in parallel.
+constexpr int kMinEntriesPerTask = 16384;
+
+// Upper bounds of the number of characters of a single attribute value line
+// and a single face line.
+constexpr size_t kMaxValueLineSize = 4 + 3 * (kMaxFormattedNumberSize + 1);
+constexpr size_t kMaxFaceLineSize = 2 + 3 * (3 * 12 + 3);
+
+// Encodes lines with attribute values in range [begin, end) of |att|. Each
+// line starts with |prefix| followed by |num_components_t| numbers.
+template <int num_components_t>
+bool EncodeAttributeValues(const PointAttribute &att, const char *prefix,
+                           int begin, int end, BlockWriter *writer) {
+  const size_t prefix_size = strlen(prefix);
+  std::array<float, num_components_t> value;
+  for (AttributeValueIndex i(begin); i < end; ++i) {
+    if (!att.ConvertValue<float, num_components_t>(i, &value[0])) {
+      return false;
+    }
+    char *out = writer->Reserve(kMaxValueLineSize);
+    memcpy(out, prefix, prefix_size);
+    out += prefix_size;
+    for (int c = 0; c < num_components_t; ++c) {
+      if (c > 0) {
+        *out++ = ' ';
+      }
+      out = FormatFloat(value[c], out);
+    }
+    *out++ = '\n';
+    writer->Commit(out);
+  }
+  return true;
+}
+
+}  // namespace
+
 ObjEncoder::ObjEncoder()
     : pos_att_(nullptr),
       tex_coord_att_(nullptr),
       normal_att_(nullptr),
       material_att_(nullptr),
       sub_obj_att_(nullptr),
-      out_buffer_(nullptr),
+      writer_(nullptr),
+      thread_pool_(nullptr),
       in_point_cloud_(nullptr),
       in_mesh_(nullptr),
       current_sub_obj_id_(-1),
@@ -39,17 +83,12 @@ bool ObjEncoder::EncodeToFile(const PointCloud &pc,
   std::unique_ptr<FileWriterInterface> file =
       FileWriterFactory::OpenWriter(file_name);
   if (!file) {
-    return false;  // File could not be opened.
+    return ExitAndCleanup(false);  // File could not be opened.
   }
   file_name_ = file_name;
-  // Encode the mesh into a buffer.
-  EncoderBuffer buffer;
-  if (!EncodeToBuffer(pc, &buffer)) {
-    return false;
-  }
-  // Write the buffer into the file.
-  file->Write(buffer.data(), buffer.size());
-  return true;
+  // Stream the encoded data directly into the file.
+  BlockWriter writer(file.get());
+  return EncodeToWriter(pc, &writer);
 }
 
 bool ObjEncoder::EncodeToFile(const Mesh &mesh, const std::string &file_name) {
@@ -59,17 +98,56 @@ bool ObjEncoder::EncodeToFile(const Mesh &mesh, const std::string &file_name) {
 
 bool ObjEncoder::EncodeToBuffer(const PointCloud &pc,
                                 EncoderBuffer *out_buffer) {
+  BlockWriter writer(out_buffer);
+  return EncodeToWriter(pc, &writer);
+}
+
+bool ObjEncoder::EncodeToBuffer(const Mesh &mesh, EncoderBuffer *out_buffer) {
+  in_mesh_ = &mesh;
+  return EncodeToBuffer(static_cast<const PointCloud &>(mesh), out_buffer);
+}
+
+bool ObjEncoder::EncodeToWriter(const PointCloud &pc, BlockWriter *writer) {
   in_point_cloud_ = &pc;
-  out_buffer_ = out_buffer;
+  writer_ = writer;
   if (!EncodeInternal()) {
     return ExitAndCleanup(false);
   }
-  return ExitAndCleanup(true);
+  return ExitAndCleanup(writer->Flush());
 }
 
-bool ObjEncoder::EncodeToBuffer(const Mesh &mesh, EncoderBuffer *out_buffer) {
-  in_mesh_ = &mesh;
-  return EncodeToBuffer(static_cast<const PointCloud &>(mesh), out_buffer);
+bool ObjEncoder::EncodeEntries(
+    int num_entries,
+    const std::function<bool(int, int, BlockWriter *)> &encode_range) {
+  int num_tasks = 1;
+  if (thread_pool_ != nullptr) {
+    num_tasks = std::min(thread_pool_->num_threads() + 1,
+                         num_entries / kMinEntriesPerTask);
+  }
+  if (num_tasks <= 1) {
+    return encode_range(0, num_entries, writer());
+  }
+  // Each task encodes its range into a separate buffer. The buffers are then
+  // written to the output in order.
+  std::vector<EncoderBuffer> task_buffers(num_tasks);
+  std::vector<uint8_t> task_encoded(num_tasks);
+  thread_pool_->ParallelFor(num_tasks, [&](int task) {
+    BlockWriter task_writer(&task_buffers[task]);
+    const int64_t begin = static_cast<int64_t>(num_entries) * task / num_tasks;
+    const int64_t end =
+        static_cast<int64_t>(num_entries) * (task + 1) / num_tasks;
+    task_encoded[task] =
+        encode_range(static_cast<int>(begin), static_cast<int>(end),
+                     &task_writer) &&
+        task_writer.Flush();
+  });
+  for (int task = 0; task < num_tasks; ++task) {
+    if (!task_encoded[task]) {
+      return false;
+    }
+    writer()->Write(task_buffers[task].data(), task_buffers[task].size());
+  }
+  return true;
 }
 
 bool ObjEncoder::EncodeInternal() {
@@ -104,7 +182,7 @@ bool ObjEncoder::EncodeInternal() {
 bool ObjEncoder::ExitAndCleanup(bool return_value) {
   in_mesh_ = nullptr;
   in_point_cloud_ = nullptr;
-  out_buffer_ = nullptr;
+  writer_ = nullptr;
   pos_att_ = nullptr;
   tex_coord_att_ = nullptr;
   normal_att_ = nullptr;
@@ -157,9 +235,9 @@ bool ObjEncoder::EncodeMaterialFileName() {
   }
   if (!material_metadata->GetEntryString("file_name", &material_file_name))
     return false;
-  buffer()->Encode("mtllib ", 7);
-  buffer()->Encode(material_file_name.c_str(), material_file_name.size());
-  buffer()->Encode("\n", 1);
+  writer()->Write("mtllib ", 7);
+  writer()->Write(material_file_name);
+  writer()->Write('\n');
   material_id_to_name_.clear();
   for (const auto &entry : material_metadata->entries()) {
     // Material id must be int.
@@ -184,14 +262,12 @@ bool ObjEncoder::EncodePositions() {
   if (att == nullptr || att->size() == 0) {
     return false;  // Position attribute must be valid.
   }
-  std::array<float, 3> value;
-  for (AttributeValueIndex i(0); i < static_cast<uint32_t>(att->size()); ++i) {
-    if (!att->ConvertValue<float, 3>(i, &value[0])) {
-      return false;
-    }
-    buffer()->Encode("v ", 2);
-    EncodeFloatList(&value[0], 3);
-    buffer()->Encode("\n", 1);
+  if (!EncodeEntries(static_cast<int>(att->size()),
+                     [att](int begin, int end, BlockWriter *writer) {
+                       return EncodeAttributeValues<3>(*att, "v ", begin, end,
+                                                        writer);
+                     })) {
+    return false;
   }
   pos_att_ = att;
   return true;
@@ -203,14 +279,12 @@ bool ObjEncoder::EncodeTextureCoordinates() {
   if (att == nullptr || att->size() == 0) {
     return true;  // It's OK if we don't have texture coordinates.
   }
-  std::array<float, 2> value;
-  for (AttributeValueIndex i(0); i < static_cast<uint32_t>(att->size()); ++i) {
-    if (!att->ConvertValue<float, 2>(i, &value[0])) {
-      return false;
-    }
-    buffer()->Encode("vt ", 3);
-    EncodeFloatList(&value[0], 2);
-    buffer()->Encode("\n", 1);
+  if (!EncodeEntries(static_cast<int>(att->size()),
+                     [att](int begin, int end, BlockWriter *writer) {
+                       return EncodeAttributeValues<2>(*att, "vt ", begin, end,
+                                                        writer);
+                     })) {
+    return false;
   }
   tex_coord_att_ = att;
   return true;
@@ -222,21 +296,31 @@ bool ObjEncoder::EncodeNormals() {
   if (att == nullptr || att->size() == 0) {
     return true;  // It's OK if we don't have normals.
   }
-  std::array<float, 3> value;
-  for (AttributeValueIndex i(0); i < static_cast<uint32_t>(att->size()); ++i) {
-    if (!att->ConvertValue<float, 3>(i, &value[0])) {
-      return false;
-    }
-    buffer()->Encode("vn ", 3);
-    EncodeFloatList(&value[0], 3);
-    buffer()->Encode("\n", 1);
+  if (!EncodeEntries(static_cast<int>(att->size()),
+                     [att](int begin, int end, BlockWriter *writer) {
+                       return EncodeAttributeValues<3>(*att, "vn ", begin, end,
+                                                        writer);
+                     })) {
+    return false;
   }
   normal_att_ = att;
   return true;
 }
 
 bool ObjEncoder::EncodeFaces() {
-  for (FaceIndex i(0); i < in_mesh_->num_faces(); ++i) {
+  if (sub_obj_att_ || material_att_) {
+    // Sub-object and material definitions depend on the previous faces so the
+    // faces must be encoded sequentially.
+    return EncodeFaceRange(0, in_mesh_->num_faces(), writer());
+  }
+  return EncodeEntries(in_mesh_->num_faces(),
+                       [this](int begin, int end, BlockWriter *writer) {
+                         return EncodeFaceRange(begin, end, writer);
+                       });
+}
+
+bool ObjEncoder::EncodeFaceRange(int begin, int end, BlockWriter *writer) {
+  for (FaceIndex i(begin); i < end; ++i) {
     if (sub_obj_att_) {
       if (!EncodeSubObject(i)) {
         return false;
@@ -247,13 +331,13 @@ bool ObjEncoder::EncodeFaces() {
         return false;
       }
     }
-    buffer()->Encode('f');
+    char *out = writer->Reserve(kMaxFaceLineSize);
+    *out++ = 'f';
     for (int j = 0; j < 3; ++j) {
-      if (!EncodeFaceCorner(i, j)) {
-        return false;
-      }
+      out = EncodeFaceCorner(i, j, out);
     }
-    buffer()->Encode("\n", 1);
+    *out++ = '\n';
+    writer->Commit(out);
   }
   return true;
 }
@@ -269,14 +353,14 @@ bool ObjEncoder::EncodeMaterial(FaceIndex face_id) {
 
   if (material_id != current_material_id_) {
     // Update material information.
-    buffer()->Encode("usemtl ", 7);
+    writer()->Write("usemtl ", 7);
     const auto mat_ptr = material_id_to_name_.find(material_id);
     // If the material id is not found.
     if (mat_ptr == material_id_to_name_.end()) {
       return false;
     }
-    buffer()->Encode(mat_ptr->second.c_str(), mat_ptr->second.size());
-    buffer()->Encode("\n", 1);
+    writer()->Write(mat_ptr->second);
+    writer()->Write('\n');
     current_material_id_ = material_id;
   }
   return true;
@@ -291,56 +375,39 @@ bool ObjEncoder::EncodeSubObject(FaceIndex face_id) {
     return false;
   }
   if (sub_obj_id != current_sub_obj_id_) {
-    buffer()->Encode("o ", 2);
+    writer()->Write("o ", 2);
     const auto sub_obj_ptr = sub_obj_id_to_name_.find(sub_obj_id);
     if (sub_obj_ptr == sub_obj_id_to_name_.end()) {
       return false;
     }
-    buffer()->Encode(sub_obj_ptr->second.c_str(), sub_obj_ptr->second.size());
-    buffer()->Encode("\n", 1);
+    writer()->Write(sub_obj_ptr->second);
+    writer()->Write('\n');
     current_sub_obj_id_ = sub_obj_id;
   }
   return true;
 }
 
-bool ObjEncoder::EncodeFaceCorner(FaceIndex face_id, int local_corner_id) {
-  buffer()->Encode(' ');
+char *ObjEncoder::EncodeFaceCorner(FaceIndex face_id, int local_corner_id,
+                                   char *out) const {
+  *out++ = ' ';
   const PointIndex vert_index = in_mesh_->face(face_id)[local_corner_id];
   // Note that in the OBJ format, all indices are encoded starting from index 1.
   // Encode position index.
-  EncodeInt(pos_att_->mapped_index(vert_index).value() + 1);
+  out = FormatInt(pos_att_->mapped_index(vert_index).value() + 1, out);
   if (tex_coord_att_ || normal_att_) {
     // Encoding format is pos_index/tex_coord_index/normal_index.
     // If tex_coords are not present, we must encode pos_index//normal_index.
-    buffer()->Encode('/');
+    *out++ = '/';
     if (tex_coord_att_) {
-      EncodeInt(tex_coord_att_->mapped_index(vert_index).value() + 1);
+      out = FormatInt(tex_coord_att_->mapped_index(vert_index).value() + 1,
+                      out);
     }
     if (normal_att_) {
-      buffer()->Encode('/');
-      EncodeInt(normal_att_->mapped_index(vert_index).value() + 1);
+      *out++ = '/';
+      out = FormatInt(normal_att_->mapped_index(vert_index).value() + 1, out);
     }
   }
-  return true;
-}
-
-void ObjEncoder::EncodeFloat(float val) {
-  snprintf(num_buffer_, sizeof(num_buffer_), "%f", val);
-  buffer()->Encode(num_buffer_, strlen(num_buffer_));
-}
-
-void ObjEncoder::EncodeFloatList(float *vals, int num_vals) {
-  for (int i = 0; i < num_vals; ++i) {
-    if (i > 0) {
-      buffer()->Encode(' ');
-    }
-    EncodeFloat(vals[i]);
-  }
-}
-
-void ObjEncoder::EncodeInt(int32_t val) {
-  snprintf(num_buffer_, sizeof(num_buffer_), "%d", val);
-  buffer()->Encode(num_buffer_, strlen(num_buffer_));
+  return out;
 }
 
 }  // namespace draco
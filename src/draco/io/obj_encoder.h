@@ -15,9 +15,12 @@
 #ifndef DRACO_IO_OBJ_ENCODER_H_
 #define DRACO_IO_OBJ_ENCODER_H_
 
+#include <functional>
 #include <unordered_map>
 
 #include "draco/core/encoder_buffer.h"
+#include "draco/core/thread_pool.h"
+#include "draco/io/block_writer.h"
 #include "draco/mesh/mesh.h"
 
 namespace draco {
@@ -28,7 +31,8 @@ class ObjEncoder {
  public:
   ObjEncoder();
 
-  // Encodes the mesh or a point cloud  and saves it into a file.
+  // Encodes the mesh or a point cloud  and saves it into a file. The data is
+  // streamed to the file as it is encoded.
   // Returns false when either the encoding failed or when the file couldn't be
   // opened.
   bool EncodeToFile(const PointCloud &pc, const std::string &file_name);
@@ -38,25 +42,38 @@ class ObjEncoder {
   bool EncodeToBuffer(const PointCloud &pc, EncoderBuffer *out_buffer);
   bool EncodeToBuffer(const Mesh &mesh, EncoderBuffer *out_buffer);
 
+  // Sets a thread pool that is used to format attribute values and faces of
+  // large inputs in parallel (can be nullptr). The output is the same as when
+  // no thread pool is used.
+  void set_thread_pool(ThreadPool *thread_pool) { thread_pool_ = thread_pool; }
+
  protected:
   bool EncodeInternal();
-  EncoderBuffer *buffer() const { return out_buffer_; }
+  BlockWriter *writer() const { return writer_; }
   bool ExitAndCleanup(bool return_value);
 
  private:
+  // Encodes the point cloud (or the mesh set in |in_mesh_|) into |writer|.
+  bool EncodeToWriter(const PointCloud &pc, BlockWriter *writer);
+
+  // Encodes |num_entries| entries using |encode_range| that encodes entries
+  // in range [begin, end) into the provided writer. When |thread_pool_| is
+  // set, large inputs are split into ranges that are encoded in parallel.
+  bool EncodeEntries(
+      int num_entries,
+      const std::function<bool(int, int, BlockWriter *)> &encode_range);
+
   bool GetSubObjects();
   bool EncodeMaterialFileName();
   bool EncodePositions();
   bool EncodeTextureCoordinates();
   bool EncodeNormals();
   bool EncodeFaces();
+  bool EncodeFaceRange(int begin, int end, BlockWriter *writer);
   bool EncodeSubObject(FaceIndex face_id);
   bool EncodeMaterial(FaceIndex face_id);
-  bool EncodeFaceCorner(FaceIndex face_id, int local_corner_id);
-
-  void EncodeFloat(float val);
-  void EncodeFloatList(float *vals, int num_vals);
-  void EncodeInt(int32_t val);
+  char *EncodeFaceCorner(FaceIndex face_id, int local_corner_id,
+                         char *out) const;
 
   // Various attributes used by the encoder. If an attribute is not used, it is
   // set to nullptr.
@@ -66,10 +83,8 @@ class ObjEncoder {
   const PointAttribute *material_att_;
   const PointAttribute *sub_obj_att_;
 
-  // Buffer used for encoding float/int numbers.
-  char num_buffer_[20];
-
-  EncoderBuffer *out_buffer_;
+  BlockWriter *writer_;
+  ThreadPool *thread_pool_;
 
   const PointCloud *in_point_cloud_;
   const Mesh *in_mesh_;
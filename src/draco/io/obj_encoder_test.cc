@@ -18,8 +18,10 @@
 
 #include "draco/core/draco_test_base.h"
 #include "draco/core/draco_test_utils.h"
+#include "draco/core/thread_pool.h"
 #include "draco/io/file_reader_factory.h"
 #include "draco/io/file_reader_interface.h"
+#include "draco/io/file_utils.h"
 #include "draco/io/obj_decoder.h"
 
 namespace draco {
@@ -84,6 +86,55 @@ TEST_F(ObjEncoderTest, HasMaterial) {
   ASSERT_EQ(mesh1->attribute(1)->size(), 7);
 }
 
+TEST_F(ObjEncoderTest, EncodeInParallel) {
+  // Tests that a large mesh encoded on a thread pool or streamed to a file is
+  // encoded to the same data as a mesh encoded serially to a buffer.
+  std::string data;
+  const int num_rows = 200;
+  const int num_cols = 200;
+  for (int r = 0; r < num_rows; ++r) {
+    for (int c = 0; c < num_cols; ++c) {
+      data += "v " + std::to_string(c * 0.37) + " " + std::to_string(-r) +
+              " " + std::to_string((r * c) % 13 * 0.25) + "\n";
+      data += "vt " + std::to_string(c * 0.001) + " 0.5\n";
+    }
+  }
+  for (int r = 1; r < num_rows; ++r) {
+    for (int c = 1; c < num_cols; ++c) {
+      const int v0 = (r - 1) * num_cols + c;
+      const int v1 = r * num_cols + c;
+      data += "f " + std::to_string(v0) + "/" + std::to_string(v0) + " " +
+              std::to_string(v0 + 1) + "/" + std::to_string(v0 + 1) + " " +
+              std::to_string(v1 + 1) + "/" + std::to_string(v1 + 1) + " " +
+              std::to_string(v1) + "/" + std::to_string(v1) + "\n";
+    }
+  }
+  DecoderBuffer decoder_buffer;
+  decoder_buffer.Init(data.data(), data.size());
+  Mesh mesh;
+  ObjDecoder decoder;
+  ASSERT_TRUE(decoder.DecodeFromBuffer(&decoder_buffer, &mesh).ok());
+
+  EncoderBuffer serial_buffer;
+  ObjEncoder encoder;
+  ASSERT_TRUE(encoder.EncodeToBuffer(mesh, &serial_buffer));
+  ASSERT_GT(serial_buffer.size(), 0);
+
+  ThreadPool thread_pool(3);
+  EncoderBuffer parallel_buffer;
+  encoder.set_thread_pool(&thread_pool);
+  ASSERT_TRUE(encoder.EncodeToBuffer(mesh, &parallel_buffer));
+  ASSERT_EQ(std::string(serial_buffer.data(), serial_buffer.size()),
+            std::string(parallel_buffer.data(), parallel_buffer.size()));
+
+  const std::string file_name = GetTestTempFileFullPath("parallel.obj");
+  ASSERT_TRUE(encoder.EncodeToFile(mesh, file_name));
+  std::vector<char> file_data;
+  ASSERT_TRUE(ReadFileToBuffer(file_name, &file_data));
+  ASSERT_EQ(std::string(serial_buffer.data(), serial_buffer.size()),
+            std::string(file_data.data(), file_data.size()));
+}
+
 TEST_F(ObjEncoderTest, TestObjEncodingAll) {
   // Test decoded mesh from encoded obj file stays the same.
   test_encoding("bunny_norm.obj");
@@ -17,94 +17,213 @@
 #include <algorithm>
 #include <cctype>
 #include <cmath>
+#include <cstring>
 #include <iterator>
+#include <limits>
 
 namespace draco {
 namespace parser {
 
+namespace {
+
+// Runs |parse_function| on the remaining data of |buffer| and advances the
+// buffer past all characters consumed by the function.
+template <typename ParseFunctionT>
+auto ParseFromBuffer(DecoderBuffer *buffer,
+                     const ParseFunctionT &parse_function)
+    -> decltype(parse_function(nullptr, nullptr)) {
+  const char *const head = buffer->data_head();
+  const char *data = head;
+  const auto result = parse_function(&data, head + buffer->remaining_size());
+  buffer->Advance(data - head);
+  return result;
+}
+
+// Maximum number of leading digits of an integer that can be accumulated in an
+// integer variable while all intermediate values remain exactly representable
+// by a double (10^15 < 2^53).
+constexpr int kMaxExactDoubleDigits = 15;
+
+}  // namespace
+
 void SkipCharacters(DecoderBuffer *buffer, const char *skip_chars) {
+  ParseFromBuffer(buffer, [skip_chars](const char **data, const char *end) {
+    SkipCharacters(data, end, skip_chars);
+    return true;
+  });
+}
+
+void SkipWhitespace(DecoderBuffer *buffer) {
+  ParseFromBuffer(buffer, [](const char **data, const char *end) {
+    SkipWhitespace(data, end);
+    return true;
+  });
+}
+
+bool PeekWhitespace(DecoderBuffer *buffer, bool *end_reached) {
+  char c;
+  if (!buffer->Peek(&c)) {
+    *end_reached = true;
+    return false;  // eof reached.
+  }
+  if (!IsWhitespace(c)) {
+    return false;  // Non-whitespace character reached.
+  }
+  return true;
+}
+
+void SkipLine(DecoderBuffer *buffer) {
+  ParseFromBuffer(buffer, [](const char **data, const char *end) {
+    SkipLine(data, end);
+    return true;
+  });
+}
+
+bool ParseFloat(DecoderBuffer *buffer, float *value) {
+  return ParseFromBuffer(buffer, [value](const char **data, const char *end) {
+    return ParseFloat(data, end, value);
+  });
+}
+
+bool ParseSignedInt(DecoderBuffer *buffer, int32_t *value) {
+  return ParseFromBuffer(buffer, [value](const char **data, const char *end) {
+    return ParseSignedInt(data, end, value);
+  });
+}
+
+bool ParseUnsignedInt(DecoderBuffer *buffer, uint32_t *value) {
+  return ParseFromBuffer(buffer, [value](const char **data, const char *end) {
+    return ParseUnsignedInt(data, end, value);
+  });
+}
+
+int GetSignValue(char c) {
+  if (c == '-') {
+    return -1;
+  }
+  if (c == '+') {
+    return 1;
+  }
+  return 0;
+}
+
+bool ParseString(DecoderBuffer *buffer, std::string *out_string) {
+  return ParseFromBuffer(
+      buffer, [out_string](const char **data, const char *end) {
+        return ParseString(data, end, out_string);
+      });
+}
+
+void ParseLine(DecoderBuffer *buffer, std::string *out_string) {
+  out_string->clear();
+  const char *const head = buffer->data_head();
+  const char *const end = head + buffer->remaining_size();
+  const char *line_end = head;
+  SkipLine(&line_end, end);
+  buffer->Advance(line_end - head);
+  for (const char *c = head; c < line_end; ++c) {
+    if (*c == '\n') {
+      return;  // Return at the end of line.
+    }
+    if (*c == '\r') {
+      continue;  // Ignore extra line ending characters.
+    }
+    *out_string += *c;
+  }
+}
+
+DecoderBuffer ParseLineIntoDecoderBuffer(DecoderBuffer *buffer) {
+  const char *const head = buffer->data_head();
+  SkipLine(buffer);
+  DecoderBuffer out_buffer;
+  out_buffer.Init(head, buffer->data_head() - head);
+  return out_buffer;
+}
+
+std::string ToLower(const std::string &str) {
+  std::string out;
+  std::transform(str.begin(), str.end(), std::back_inserter(out), tolower);
+  return out;
+}
+
+void SkipCharacters(const char **data, const char *end,
+                    const char *skip_chars) {
   if (skip_chars == nullptr) {
     return;
   }
   const int num_skip_chars = static_cast<int>(strlen(skip_chars));
-  char c;
-  while (buffer->Peek(&c)) {
+  const char *d = *data;
+  while (d < end) {
     // Check all characters in the pattern.
     bool skip = false;
     for (int i = 0; i < num_skip_chars; ++i) {
-      if (c == skip_chars[i]) {
+      if (*d == skip_chars[i]) {
         skip = true;
         break;
       }
     }
     if (!skip) {
-      return;
+      break;
     }
-    buffer->Advance(1);
+    ++d;
   }
+  *data = d;
 }
 
-void SkipWhitespace(DecoderBuffer *buffer) {
-  bool end_reached = false;
-  while (PeekWhitespace(buffer, &end_reached) && !end_reached) {
-    // Skip the whitespace character
-    buffer->Advance(1);
+void SkipWhitespace(const char **data, const char *end) {
+  const char *d = *data;
+  while (d < end && IsWhitespace(*d)) {
+    ++d;
   }
+  *data = d;
 }
 
-bool PeekWhitespace(DecoderBuffer *buffer, bool *end_reached) {
-  uint8_t c;
-  if (!buffer->Peek(&c)) {
-    *end_reached = true;
-    return false;  // eof reached.
-  }
-  if (!isspace(c)) {
-    return false;  // Non-whitespace character reached.
-  }
-  return true;
-}
-
-void SkipLine(DecoderBuffer *buffer) {
-  char c;
-  while (buffer->Peek(&c)) {
-    // Skip the character.
-    buffer->Advance(1);
-    if (c == '\n') {
-      return;  // Return at the end of line
-    }
-  }
+void SkipLine(const char **data, const char *end) {
+  // memchr() is usually vectorized so it can find the end of the line much
+  // faster than a loop over individual characters.
+  const void *const line_end = memchr(*data, '\n', end - *data);
+  *data = line_end ? static_cast<const char *>(line_end) + 1 : end;
 }
 
-bool ParseFloat(DecoderBuffer *buffer, float *value) {
-  // Read optional sign.
-  char ch;
-  if (!buffer->Peek(&ch)) {
+bool ParseFloat(const char **data, const char *end, float *value) {
+  const char *d = *data;
+  if (d == end) {
     return false;
   }
-  int sign = GetSignValue(ch);
+  // Read optional sign.
+  int sign = GetSignValue(*d);
   if (sign != 0) {
-    buffer->Advance(1);
+    ++d;
   } else {
     sign = 1;
   }
 
-  // Parse integer component.
-  bool have_digits = false;
-  double v = 0.0;
-  while (buffer->Peek(&ch) && ch >= '0' && ch <= '9') {
+  // Parse integer component. The leading digits are accumulated in an integer
+  // which gives the same result as accumulating them in a double as long as
+  // the value is exactly representable. The remaining digits are added to the
+  // double value one by one.
+  const char *const digits_begin = d;
+  uint64_t int_part = 0;
+  while (d < end && d - digits_begin < kMaxExactDoubleDigits && *d >= '0' &&
+         *d <= '9') {
+    int_part = int_part * 10 + (*d - '0');
+    ++d;
+  }
+  double v = static_cast<double>(int_part);
+  while (d < end && *d >= '0' && *d <= '9') {
     v *= 10.0;
-    v += (ch - '0');
-    buffer->Advance(1);
-    have_digits = true;
+    v += (*d - '0');
+    ++d;
   }
-  if (ch == '.') {
+  bool have_digits = d != digits_begin;
+  if (d < end && *d == '.') {
     // Parse fractional component.
-    buffer->Advance(1);
+    ++d;
     double fraction = 1.0;
-    while (buffer->Peek(&ch) && ch >= '0' && ch <= '9') {
+    while (d < end && *d >= '0' && *d <= '9') {
       fraction *= 0.1;
-      v += (ch - '0') * fraction;
-      buffer->Advance(1);
+      v += (*d - '0') * fraction;
+      ++d;
       have_digits = true;
     }
   }
@@ -112,7 +231,9 @@ bool ParseFloat(DecoderBuffer *buffer, float *value) {
   if (!have_digits) {
     // Check for special constants (inf, nan, ...).
     std::string text;
-    if (!ParseString(buffer, &text)) {
+    const bool text_parsed = ParseString(&d, end, &text);
+    *data = d;
+    if (!text_parsed) {
       return false;
     }
     if (text == "inf" || text == "Inf") {
@@ -125,126 +246,75 @@ bool ParseFloat(DecoderBuffer *buffer, float *value) {
     }
   } else {
     // Handle exponent if present.
-    if (ch == 'e' || ch == 'E') {
-      buffer->Advance(1);  // Skip 'e' marker.
+    if (d < end && (*d == 'e' || *d == 'E')) {
+      ++d;  // Skip 'e' marker.
 
       // Parse integer exponent.
       int32_t exponent = 0;
-      if (!ParseSignedInt(buffer, &exponent)) {
+      const bool exponent_parsed = ParseSignedInt(&d, end, &exponent);
+      *data = d;
+      if (!exponent_parsed) {
         return false;
       }
 
       // Apply exponent scaling to value.
       v *= pow(static_cast<double>(10.0), exponent);
     }
+    *data = d;
   }
 
   *value = (sign < 0) ? static_cast<float>(-v) : static_cast<float>(v);
   return true;
 }
 
-bool ParseSignedInt(DecoderBuffer *buffer, int32_t *value) {
+bool ParseSignedInt(const char **data, const char *end, int32_t *value) {
   // Parse any explicit sign and set the appropriate largest magnitude
   // value that can be represented without overflow.
-  char ch;
-  if (!buffer->Peek(&ch)) {
+  if (*data == end) {
     return false;
   }
-  const int sign = GetSignValue(ch);
+  const int sign = GetSignValue(**data);
   if (sign != 0) {
-    buffer->Advance(1);
+    ++*data;
   }
 
   // Attempt to parse integer body.
   uint32_t v;
-  if (!ParseUnsignedInt(buffer, &v)) {
+  if (!ParseUnsignedInt(data, end, &v)) {
     return false;
   }
   *value = (sign < 0) ? -v : v;
   return true;
 }
 
-bool ParseUnsignedInt(DecoderBuffer *buffer, uint32_t *value) {
+bool ParseUnsignedInt(const char **data, const char *end, uint32_t *value) {
   // Parse the number until we run out of digits.
+  const char *d = *data;
   uint32_t v = 0;
-  char ch;
-  bool have_digits = false;
-  while (buffer->Peek(&ch) && ch >= '0' && ch <= '9') {
+  while (d < end && *d >= '0' && *d <= '9') {
     v *= 10;
-    v += (ch - '0');
-    buffer->Advance(1);
-    have_digits = true;
+    v += (*d - '0');
+    ++d;
   }
-  if (!have_digits) {
+  if (d == *data) {
     return false;
   }
+  *data = d;
   *value = v;
   return true;
 }
 
-int GetSignValue(char c) {
-  if (c == '-') {
-    return -1;
-  }
-  if (c == '+') {
-    return 1;
-  }
-  return 0;
-}
-
-bool ParseString(DecoderBuffer *buffer, std::string *out_string) {
-  out_string->clear();
-  SkipWhitespace(buffer);
-  bool end_reached = false;
-  while (!PeekWhitespace(buffer, &end_reached) && !end_reached) {
-    char c;
-    if (!buffer->Decode(&c)) {
-      return false;
-    }
-    *out_string += c;
+bool ParseString(const char **data, const char *end, std::string *out_string) {
+  SkipWhitespace(data, end);
+  const char *const begin = *data;
+  const char *d = begin;
+  while (d < end && !IsWhitespace(*d)) {
+    ++d;
   }
+  out_string->assign(begin, d);
+  *data = d;
   return true;
 }
 
-void ParseLine(DecoderBuffer *buffer, std::string *out_string) {
-  out_string->clear();
-  char c;
-  while (buffer->Peek(&c)) {
-    // Skip the character.
-    buffer->Advance(1);
-    if (c == '\n') {
-      return;  // Return at the end of line.
-    }
-    if (c == '\r') {
-      continue;  // Ignore extra line ending characters.
-    }
-    *out_string += c;
-  }
-}
-
-DecoderBuffer ParseLineIntoDecoderBuffer(DecoderBuffer *buffer) {
-  const char *const head = buffer->data_head();
-  char c;
-  while (buffer->Peek(&c)) {
-    // Skip the character.
-    buffer->Advance(1);
-    if (c == '\n') {
-      break;  // End of the line reached.
-    }
-    if (c == '\r') {
-      continue;  // Ignore extra line ending characters.
-    }
-  }
-  DecoderBuffer out_buffer;
-  out_buffer.Init(head, buffer->data_head() - head);
-  return out_buffer;
-}
-
-std::string ToLower(const std::string &str) {
-  std::string out;
-  std::transform(str.begin(), str.end(), std::back_inserter(out), tolower);
-  return out;
-}
-
 }  // namespace parser
 }  // namespace draco
@@ -15,6 +15,8 @@
 #ifndef DRACO_IO_PARSER_UTILS_H_
 #define DRACO_IO_PARSER_UTILS_H_
 
+#include <string>
+
 #include "draco/core/decoder_buffer.h"
 
 namespace draco {
@@ -58,6 +60,25 @@ DecoderBuffer ParseLineIntoDecoderBuffer(DecoderBuffer *buffer);
 // Returns a string with all characters converted to lower case.
 std::string ToLower(const std::string &str);
 
+// Variants of the functions above that operate directly on the characters in
+// range [*data, end). |*data| is advanced past all consumed characters. The
+// functions that take DecoderBuffer are implemented on top of these and they
+// produce exactly the same results.
+void SkipCharacters(const char **data, const char *end,
+                    const char *skip_chars);
+void SkipWhitespace(const char **data, const char *end);
+void SkipLine(const char **data, const char *end);
+bool ParseFloat(const char **data, const char *end, float *value);
+bool ParseSignedInt(const char **data, const char *end, int32_t *value);
+bool ParseUnsignedInt(const char **data, const char *end, uint32_t *value);
+bool ParseString(const char **data, const char *end, std::string *out_string);
+
+// Returns true if |c| is a whitespace character. Same as isspace() in the
+// default "C" locale, but it avoids the locale lookup for each character.
+inline bool IsWhitespace(char c) {
+  return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
 }  // namespace parser
 }  // namespace draco
 
@@ -0,0 +1,154 @@
+// Copyright 2016 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/io/parser_utils.h"
+
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "draco/core/draco_test_base.h"
+
+namespace {
+
+// Parses |text| with the DecoderBuffer based parser::ParseFloat() and returns
+// the number of consumed characters.
+int ParseFloatFromString(const std::string &text, float *value, bool *ok) {
+  draco::DecoderBuffer buffer;
+  buffer.Init(text.data(), text.size());
+  *ok = draco::parser::ParseFloat(&buffer, value);
+  return static_cast<int>(buffer.decoded_size());
+}
+
+// Reference parser that accumulates all digits in a double one by one.
+float ReferenceParseFloat(const std::string &text) {
+  size_t i = 0;
+  const int sign = text[0] == '-' ? -1 : 1;
+  if (text[0] == '-' || text[0] == '+') {
+    ++i;
+  }
+  double v = 0.0;
+  for (; i < text.size() && isdigit(text[i]); ++i) {
+    v *= 10.0;
+    v += (text[i] - '0');
+  }
+  if (i < text.size() && text[i] == '.') {
+    double fraction = 1.0;
+    for (++i; i < text.size() && isdigit(text[i]); ++i) {
+      fraction *= 0.1;
+      v += (text[i] - '0') * fraction;
+    }
+  }
+  if (i < text.size() && (text[i] == 'e' || text[i] == 'E')) {
+    v *= pow(10.0, atoi(text.c_str() + i + 1));
+  }
+  return sign < 0 ? static_cast<float>(-v) : static_cast<float>(v);
+}
+
+TEST(ParserUtilsTest, TestParseFloat) {
+  const char *const inputs[] = {"0",
+                                "1",
+                                "-1.5",
+                                "+2.25",
+                                "0.000001",
+                                "3.14159265358979",
+                                "123456789012345",
+                                "1234567890123456",
+                                "98765432109876543210.123456789",
+                                "-9007199254740993",
+                                "1e3",
+                                "-2.5E-3",
+                                ".5",
+                                "7."};
+  for (const char *const input : inputs) {
+    float value = 0.f;
+    bool ok = false;
+    const int num_parsed = ParseFloatFromString(input, &value, &ok);
+    ASSERT_TRUE(ok) << input;
+    ASSERT_EQ(num_parsed, static_cast<int>(strlen(input))) << input;
+    const float expected = ReferenceParseFloat(input);
+    ASSERT_EQ(memcmp(&value, &expected, sizeof(float)), 0) << input;
+  }
+}
+
+TEST(ParserUtilsTest, TestParseFloatStopsAtNonDigit) {
+  float value = 0.f;
+  bool ok = false;
+  ASSERT_EQ(ParseFloatFromString("1.25 2", &value, &ok), 4);
+  ASSERT_TRUE(ok);
+  ASSERT_EQ(value, 1.25f);
+  ASSERT_EQ(ParseFloatFromString("-3/4", &value, &ok), 2);
+  ASSERT_TRUE(ok);
+  ASSERT_EQ(value, -3.f);
+}
+
+TEST(ParserUtilsTest, TestParseSpecialFloats) {
+  float value = 0.f;
+  bool ok = false;
+  ParseFloatFromString("inf", &value, &ok);
+  ASSERT_TRUE(ok);
+  ASSERT_TRUE(std::isinf(value));
+  ASSERT_GT(value, 0.f);
+  ParseFloatFromString("-Inf", &value, &ok);
+  ASSERT_TRUE(ok);
+  ASSERT_TRUE(std::isinf(value));
+  ASSERT_LT(value, 0.f);
+  ParseFloatFromString("NaN", &value, &ok);
+  ASSERT_TRUE(ok);
+  ASSERT_TRUE(std::isnan(value));
+  ParseFloatFromString("abc", &value, &ok);
+  ASSERT_FALSE(ok);
+  ParseFloatFromString("", &value, &ok);
+  ASSERT_FALSE(ok);
+  ParseFloatFromString("1e", &value, &ok);
+  ASSERT_FALSE(ok);
+}
+
+TEST(ParserUtilsTest, TestParseSignedInt) {
+  const std::string text = "-12/+7 x";
+  const char *data = text.data();
+  const char *const end = data + text.size();
+  int32_t value = 0;
+  ASSERT_TRUE(draco::parser::ParseSignedInt(&data, end, &value));
+  ASSERT_EQ(value, -12);
+  ASSERT_EQ(*data, '/');
+  ++data;
+  ASSERT_TRUE(draco::parser::ParseSignedInt(&data, end, &value));
+  ASSERT_EQ(value, 7);
+  draco::parser::SkipWhitespace(&data, end);
+  ASSERT_FALSE(draco::parser::ParseSignedInt(&data, end, &value));
+  ASSERT_EQ(*data, 'x');
+}
+
+TEST(ParserUtilsTest, TestLines) {
+  const std::string text = "first line\r\nsecond\n\nlast";
+  draco::DecoderBuffer buffer;
+  buffer.Init(text.data(), text.size());
+  std::string line;
+  draco::parser::ParseLine(&buffer, &line);
+  ASSERT_EQ(line, "first line");
+  draco::parser::SkipLine(&buffer);
+  draco::parser::ParseLine(&buffer, &line);
+  ASSERT_EQ(line, "");
+  draco::DecoderBuffer line_buffer =
+      draco::parser::ParseLineIntoDecoderBuffer(&buffer);
+  ASSERT_EQ(line_buffer.remaining_size(), 4);
+  ASSERT_EQ(buffer.remaining_size(), 0);
+  draco::parser::SkipLine(&buffer);
+  ASSERT_EQ(buffer.remaining_size(), 0);
+}
+
+}  // namespace
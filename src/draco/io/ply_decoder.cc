@@ -21,7 +21,8 @@
 
 namespace draco {
 
-PlyDecoder::PlyDecoder() : out_mesh_(nullptr), out_point_cloud_(nullptr) {}
+PlyDecoder::PlyDecoder()
+    : out_mesh_(nullptr), out_point_cloud_(nullptr), thread_pool_(nullptr) {}
 
 Status PlyDecoder::DecodeFromFile(const std::string &file_name,
                                   Mesh *out_mesh) {
@@ -53,6 +54,7 @@ Status PlyDecoder::DecodeFromBuffer(DecoderBuffer *buffer,
 
 Status PlyDecoder::DecodeInternal() {
   PlyReader ply_reader;
+  ply_reader.set_thread_pool(thread_pool_);
   DRACO_RETURN_IF_ERROR(ply_reader.Read(buffer()));
   // First, decode the connectivity data.
   if (out_mesh_)
@@ -64,13 +66,13 @@ Status PlyDecoder::DecodeInternal() {
   // not require deduplication.
   if (out_mesh_ && out_mesh_->num_faces() != 0) {
 #ifdef DRACO_ATTRIBUTE_VALUES_DEDUPLICATION_SUPPORTED
-    if (!out_point_cloud_->DeduplicateAttributeValues()) {
+    if (!out_point_cloud_->DeduplicateAttributeValues(thread_pool_)) {
       return Status(Status::DRACO_ERROR,
                     "Could not deduplicate attribute values");
     }
 #endif
 #ifdef DRACO_ATTRIBUTE_INDICES_DEDUPLICATION_SUPPORTED
-    out_point_cloud_->DeduplicatePointIds();
+    out_point_cloud_->DeduplicatePointIds(thread_pool_);
 #endif
   }
   return OkStatus();
@@ -93,8 +95,23 @@ Status PlyDecoder::DecodeFaceData(const PlyElement *face_element) {
     return Status(Status::DRACO_ERROR, "No faces defined");
   }
 
-  PlyPropertyReader<PointIndex::ValueType> vertex_index_reader(vertex_indices);
   Mesh::Face face;
+  if (vertex_indices->list_num_values() == 3 &&
+      (vertex_indices->data_type() == DT_INT32 ||
+       vertex_indices->data_type() == DT_UINT32)) {
+    // All faces are triangles and the indices can be copied directly.
+    const uint32_t *const indices = static_cast<const uint32_t *>(
+        vertex_indices->GetDataEntryAddress(0));
+    for (FaceIndex i(0); i < num_faces; ++i) {
+      for (int c = 0; c < 3; ++c) {
+        face[c] = indices[3 * i.value() + c];
+      }
+      out_mesh_->SetFace(i, face);
+    }
+    return OkStatus();
+  }
+
+  PlyPropertyReader<PointIndex::ValueType> vertex_index_reader(vertex_indices);
   FaceIndex face_index(0);
   for (int i = 0; i < num_faces; ++i) {
     const int64_t list_offset = vertex_indices->GetListEntryOffset(i);
@@ -118,6 +135,30 @@ template <typename DataTypeT>
 bool PlyDecoder::ReadPropertiesToAttribute(
     const std::vector<const PlyProperty *> &properties,
     PointAttribute *attribute, int num_vertices) {
+  bool same_data_types = true;
+  for (size_t prop = 0; prop < properties.size(); ++prop) {
+    if (properties[prop]->data_type() != attribute->data_type()) {
+      same_data_types = false;
+    }
+  }
+  if (same_data_types) {
+    // No conversion is needed, interleave the values of all properties
+    // directly into the attribute buffer.
+    const int num_properties = static_cast<int>(properties.size());
+    std::vector<const DataTypeT *> values(num_properties);
+    for (int prop = 0; prop < num_properties; ++prop) {
+      values[prop] = static_cast<const DataTypeT *>(
+          properties[prop]->GetDataEntryAddress(0));
+    }
+    DataTypeT *const out_values =
+        reinterpret_cast<DataTypeT *>(attribute->buffer()->data());
+    for (int i = 0; i < num_vertices; ++i) {
+      for (int prop = 0; prop < num_properties; ++prop) {
+        out_values[i * num_properties + prop] = values[prop][i];
+      }
+    }
+    return true;
+  }
   std::vector<std::unique_ptr<PlyPropertyReader<DataTypeT>>> readers;
   readers.reserve(properties.size());
   for (int prop = 0; prop < properties.size(); ++prop) {
@@ -192,21 +233,16 @@ Status PlyDecoder::DecodeVertexData(const PlyElement *vertex_element) {
     if (n_x_prop->data_type() == DT_FLOAT32 &&
         n_y_prop->data_type() == DT_FLOAT32 &&
         n_z_prop->data_type() == DT_FLOAT32) {
-      PlyPropertyReader<float> x_reader(n_x_prop);
-      PlyPropertyReader<float> y_reader(n_y_prop);
-      PlyPropertyReader<float> z_reader(n_z_prop);
       GeometryAttribute va;
       va.Init(GeometryAttribute::NORMAL, nullptr, 3, DT_FLOAT32, false,
               sizeof(float) * 3, 0);
       const int att_id = out_point_cloud_->AddAttribute(va, true, num_vertices);
-      for (PointIndex::ValueType i = 0; i < num_vertices; ++i) {
-        std::array<float, 3> val;
-        val[0] = x_reader.ReadValue(i);
-        val[1] = y_reader.ReadValue(i);
-        val[2] = z_reader.ReadValue(i);
-        out_point_cloud_->attribute(att_id)->SetAttributeValue(
-            AttributeValueIndex(i), &val[0]);
-      }
+      std::vector<const PlyProperty *> properties;
+      properties.push_back(n_x_prop);
+      properties.push_back(n_y_prop);
+      properties.push_back(n_z_prop);
+      ReadPropertiesToAttribute<float>(
+          properties, out_point_cloud_->attribute(att_id), num_vertices);
     }
   }
 
@@ -230,7 +266,7 @@ Status PlyDecoder::DecodeVertexData(const PlyElement *vertex_element) {
   }
 
   if (num_colors) {
-    std::vector<std::unique_ptr<PlyPropertyReader<uint8_t>>> color_readers;
+    std::vector<const PlyProperty *> color_properties;
     const PlyProperty *p;
     if (r_prop) {
       p = r_prop;
@@ -240,8 +276,7 @@ Status PlyDecoder::DecodeVertexData(const PlyElement *vertex_element) {
         return Status(Status::INVALID_PARAMETER,
                       "Type of 'red' property must be uint8");
       }
-      color_readers.push_back(std::unique_ptr<PlyPropertyReader<uint8_t>>(
-          new PlyPropertyReader<uint8_t>(p)));
+      color_properties.push_back(p);
     }
     if (g_prop) {
       p = g_prop;
@@ -251,8 +286,7 @@ Status PlyDecoder::DecodeVertexData(const PlyElement *vertex_element) {
         return Status(Status::INVALID_PARAMETER,
                       "Type of 'green' property must be uint8");
       }
-      color_readers.push_back(std::unique_ptr<PlyPropertyReader<uint8_t>>(
-          new PlyPropertyReader<uint8_t>(p)));
+      color_properties.push_back(p);
     }
     if (b_prop) {
       p = b_prop;
@@ -262,8 +296,7 @@ Status PlyDecoder::DecodeVertexData(const PlyElement *vertex_element) {
         return Status(Status::INVALID_PARAMETER,
                       "Type of 'blue' property must be uint8");
       }
-      color_readers.push_back(std::unique_ptr<PlyPropertyReader<uint8_t>>(
-          new PlyPropertyReader<uint8_t>(p)));
+      color_properties.push_back(p);
     }
     if (a_prop) {
       p = a_prop;
@@ -273,8 +306,7 @@ Status PlyDecoder::DecodeVertexData(const PlyElement *vertex_element) {
         return Status(Status::INVALID_PARAMETER,
                       "Type of 'alpha' property must be uint8");
       }
-      color_readers.push_back(std::unique_ptr<PlyPropertyReader<uint8_t>>(
-          new PlyPropertyReader<uint8_t>(p)));
+      color_properties.push_back(p);
     }
 
     GeometryAttribute va;
@@ -282,14 +314,8 @@ Status PlyDecoder::DecodeVertexData(const PlyElement *vertex_element) {
             sizeof(uint8_t) * num_colors, 0);
     const int32_t att_id =
         out_point_cloud_->AddAttribute(va, true, num_vertices);
-    for (PointIndex::ValueType i = 0; i < num_vertices; ++i) {
-      std::array<uint8_t, 4> val;
-      for (int j = 0; j < num_colors; j++) {
-        val[j] = color_readers[j]->ReadValue(i);
-      }
-      out_point_cloud_->attribute(att_id)->SetAttributeValue(
-          AttributeValueIndex(i), &val[0]);
-    }
+    ReadPropertiesToAttribute<uint8_t>(
+        color_properties, out_point_cloud_->attribute(att_id), num_vertices);
   }
 
   return OkStatus();
@@ -19,6 +19,7 @@
 
 #include "draco/core/decoder_buffer.h"
 #include "draco/core/status.h"
+#include "draco/core/thread_pool.h"
 #include "draco/draco_features.h"
 #include "draco/io/ply_reader.h"
 #include "draco/mesh/mesh.h"
@@ -42,6 +43,11 @@ class PlyDecoder {
   Status DecodeFromBuffer(DecoderBuffer *buffer, Mesh *out_mesh);
   Status DecodeFromBuffer(DecoderBuffer *buffer, PointCloud *out_point_cloud);
 
+  // Sets a thread pool that is used to parse large ascii files and to
+  // deduplicate the decoded data in parallel (can be nullptr). The decoded
+  // geometry doesn't depend on whether the thread pool is used.
+  void set_thread_pool(ThreadPool *thread_pool) { thread_pool_ = thread_pool; }
+
  protected:
   Status DecodeInternal();
   DecoderBuffer *buffer() { return &buffer_; }
@@ -61,6 +67,8 @@ class PlyDecoder {
   // always set but |out_mesh_| is optional.
   Mesh *out_mesh_;
   PointCloud *out_point_cloud_;
+
+  ThreadPool *thread_pool_;
 };
 
 }  // namespace draco
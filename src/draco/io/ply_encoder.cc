@@ -14,6 +14,7 @@
 //
 #include "draco/io/ply_encoder.h"
 
+#include <cstring>
 #include <memory>
 #include <sstream>
 
@@ -23,23 +24,18 @@
 namespace draco {
 
 PlyEncoder::PlyEncoder()
-    : out_buffer_(nullptr), in_point_cloud_(nullptr), in_mesh_(nullptr) {}
+    : writer_(nullptr), in_point_cloud_(nullptr), in_mesh_(nullptr) {}
 
 bool PlyEncoder::EncodeToFile(const PointCloud &pc,
                               const std::string &file_name) {
   std::unique_ptr<FileWriterInterface> file =
       FileWriterFactory::OpenWriter(file_name);
   if (!file) {
-    return false;  // File couldn't be opened.
+    return ExitAndCleanup(false);  // File couldn't be opened.
   }
-  // Encode the mesh into a buffer.
-  EncoderBuffer buffer;
-  if (!EncodeToBuffer(pc, &buffer)) {
-    return false;
-  }
-  // Write the buffer into the file.
-  file->Write(buffer.data(), buffer.size());
-  return true;
+  // Stream the encoded data directly into the file.
+  BlockWriter writer(file.get());
+  return EncodeToWriter(pc, &writer);
 }
 
 bool PlyEncoder::EncodeToFile(const Mesh &mesh, const std::string &file_name) {
@@ -49,18 +45,24 @@ bool PlyEncoder::EncodeToFile(const Mesh &mesh, const std::string &file_name) {
 
 bool PlyEncoder::EncodeToBuffer(const PointCloud &pc,
                                 EncoderBuffer *out_buffer) {
-  in_point_cloud_ = &pc;
-  out_buffer_ = out_buffer;
-  if (!EncodeInternal()) {
-    return ExitAndCleanup(false);
-  }
-  return ExitAndCleanup(true);
+  BlockWriter writer(out_buffer);
+  return EncodeToWriter(pc, &writer);
 }
 
 bool PlyEncoder::EncodeToBuffer(const Mesh &mesh, EncoderBuffer *out_buffer) {
   in_mesh_ = &mesh;
   return EncodeToBuffer(static_cast<const PointCloud &>(mesh), out_buffer);
 }
+
+bool PlyEncoder::EncodeToWriter(const PointCloud &pc, BlockWriter *writer) {
+  in_point_cloud_ = &pc;
+  writer_ = writer;
+  if (!EncodeInternal()) {
+    return ExitAndCleanup(false);
+  }
+  return ExitAndCleanup(writer->Flush());
+}
+
 bool PlyEncoder::EncodeInternal() {
   // Write PLY header.
   // TODO(ostava): Currently works only for xyz positions and rgb(a) colors.
@@ -140,47 +142,61 @@ bool PlyEncoder::EncodeInternal() {
   // Not very efficient but the header should be small so just copy the stream
   // to a string.
   const std::string header_str = out.str();
-  buffer()->Encode(header_str.data(), header_str.length());
-
-  // Store point attributes.
-  for (PointIndex v(0); v < in_point_cloud_->num_points(); ++v) {
-    const auto *const pos_att = in_point_cloud_->attribute(pos_att_id);
-    buffer()->Encode(pos_att->GetAddress(pos_att->mapped_index(v)),
-                     pos_att->byte_stride());
-    if (normal_att_id >= 0) {
-      const auto *const normal_att = in_point_cloud_->attribute(normal_att_id);
-      buffer()->Encode(normal_att->GetAddress(normal_att->mapped_index(v)),
-                       normal_att->byte_stride());
+  writer()->Write(header_str);
+
+  // Store point attributes. Values of all attributes of a point are copied
+  // directly into the output.
+  const PointAttribute *point_atts[3] = {nullptr, nullptr, nullptr};
+  int num_point_atts = 0;
+  size_t point_size = 0;
+  for (const int att_id : {pos_att_id, normal_att_id, color_att_id}) {
+    if (att_id >= 0) {
+      point_atts[num_point_atts] = in_point_cloud_->attribute(att_id);
+      point_size += point_atts[num_point_atts]->byte_stride();
+      ++num_point_atts;
     }
-    if (color_att_id >= 0) {
-      const auto *const color_att = in_point_cloud_->attribute(color_att_id);
-      buffer()->Encode(color_att->GetAddress(color_att->mapped_index(v)),
-                       color_att->byte_stride());
+  }
+  for (PointIndex v(0); v < in_point_cloud_->num_points(); ++v) {
+    char *out = writer()->Reserve(point_size);
+    for (int i = 0; i < num_point_atts; ++i) {
+      const PointAttribute *const att = point_atts[i];
+      memcpy(out, att->GetAddress(att->mapped_index(v)), att->byte_stride());
+      out += att->byte_stride();
     }
+    writer()->Commit(out);
   }
 
   if (in_mesh_) {
     // Write face data.
+    const PointAttribute *const tex_att =
+        tex_coord_att_id >= 0 ? in_point_cloud_->attribute(tex_coord_att_id)
+                              : nullptr;
+    size_t face_size = 1 + 3 * sizeof(uint32_t);
+    if (tex_att) {
+      face_size += 1 + 3 * tex_att->byte_stride();
+    }
     for (FaceIndex i(0); i < in_mesh_->num_faces(); ++i) {
+      char *out = writer()->Reserve(face_size);
       // Write the number of face indices (always 3).
-      buffer()->Encode(static_cast<uint8_t>(3));
+      *out++ = 3;
 
       const auto &f = in_mesh_->face(i);
-      buffer()->Encode(f[0]);
-      buffer()->Encode(f[1]);
-      buffer()->Encode(f[2]);
+      for (int c = 0; c < 3; ++c) {
+        const uint32_t index = f[c].value();
+        memcpy(out, &index, sizeof(index));
+        out += sizeof(index);
+      }
 
-      if (tex_coord_att_id >= 0) {
+      if (tex_att) {
         // Two coordinates for every corner -> 6.
-        buffer()->Encode(static_cast<uint8_t>(6));
-
-        const auto *const tex_att =
-            in_point_cloud_->attribute(tex_coord_att_id);
+        *out++ = 6;
         for (int c = 0; c < 3; ++c) {
-          buffer()->Encode(tex_att->GetAddress(tex_att->mapped_index(f[c])),
-                           tex_att->byte_stride());
+          memcpy(out, tex_att->GetAddress(tex_att->mapped_index(f[c])),
+                 tex_att->byte_stride());
+          out += tex_att->byte_stride();
         }
       }
+      writer()->Commit(out);
     }
   }
   return true;
@@ -189,7 +205,7 @@ bool PlyEncoder::EncodeInternal() {
 bool PlyEncoder::ExitAndCleanup(bool return_value) {
   in_mesh_ = nullptr;
   in_point_cloud_ = nullptr;
-  out_buffer_ = nullptr;
+  writer_ = nullptr;
   return return_value;
 }
 
@@ -16,6 +16,7 @@
 #define DRACO_IO_PLY_ENCODER_H_
 
 #include "draco/core/encoder_buffer.h"
+#include "draco/io/block_writer.h"
 #include "draco/mesh/mesh.h"
 
 namespace draco {
@@ -25,7 +26,8 @@ class PlyEncoder {
  public:
   PlyEncoder();
 
-  // Encodes the mesh or a point cloud  and saves it into a file.
+  // Encodes the mesh or a point cloud  and saves it into a file. The data is
+  // streamed to the file as it is encoded.
   // Returns false when either the encoding failed or when the file couldn't be
   // opened.
   bool EncodeToFile(const PointCloud &pc, const std::string &file_name);
@@ -37,13 +39,16 @@ class PlyEncoder {
 
  protected:
   bool EncodeInternal();
-  EncoderBuffer *buffer() const { return out_buffer_; }
+  BlockWriter *writer() const { return writer_; }
   bool ExitAndCleanup(bool return_value);
 
  private:
+  // Encodes the point cloud (or the mesh set in |in_mesh_|) into |writer|.
+  bool EncodeToWriter(const PointCloud &pc, BlockWriter *writer);
+
   const char *GetAttributeDataType(int attribute);
 
-  EncoderBuffer *out_buffer_;
+  BlockWriter *writer_;
 
   const PointCloud *in_point_cloud_;
   const Mesh *in_mesh_;
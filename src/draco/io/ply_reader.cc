@@ -14,18 +14,177 @@
 //
 #include "draco/io/ply_reader.h"
 
+#include <algorithm>
 #include <array>
+#include <cstring>
+#include <memory>
 #include <regex>
 
+#include "draco/core/cpu_features.h"
 #include "draco/core/status.h"
 #include "draco/io/parser_utils.h"
 #include "draco/io/ply_property_writer.h"
 
+#ifdef DRACO_X86_SIMD_SUPPORTED
+#include <immintrin.h>
+#endif
+
 namespace draco {
 
+namespace {
+
+// Number of entries of a fixed size element that are de-interleaved at once.
+// The source data of a block stays in the cache while all properties of the
+// block are copied.
+constexpr int64_t kFixedSizeElementBlockSize = 1024;
+
+// Reads the length of a list entry stored in |num_bytes| bytes at |data|.
+int64_t ReadListNumValues(const uint8_t *data, int num_bytes,
+                          bool big_endian) {
+  int64_t num_values = 0;
+  for (int i = 0; i < num_bytes; ++i) {
+    const int byte_index = big_endian ? num_bytes - 1 - i : i;
+    num_values |= static_cast<int64_t>(data[byte_index]) << (8 * i);
+  }
+  return num_values;
+}
+
+// Copies |num_values| values of |kNumBytes| bytes that are |src_stride| bytes
+// apart in |src| into a contiguous array |dst|.
+template <int kNumBytes>
+void CopyStridedValues(const uint8_t *src, int64_t src_stride,
+                       int64_t num_values, uint8_t *dst) {
+  for (int64_t i = 0; i < num_values; ++i) {
+    memcpy(dst + i * kNumBytes, src + i * src_stride, kNumBytes);
+  }
+}
+
+void CopyStridedValues(const uint8_t *src, int64_t src_stride,
+                       int64_t num_bytes, int64_t num_values, uint8_t *dst) {
+  switch (num_bytes) {
+    case 1:
+      return CopyStridedValues<1>(src, src_stride, num_values, dst);
+    case 2:
+      return CopyStridedValues<2>(src, src_stride, num_values, dst);
+    case 4:
+      return CopyStridedValues<4>(src, src_stride, num_values, dst);
+    case 8:
+      return CopyStridedValues<8>(src, src_stride, num_values, dst);
+    case 12:
+      return CopyStridedValues<12>(src, src_stride, num_values, dst);
+    default:
+      for (int64_t i = 0; i < num_values; ++i) {
+        memcpy(dst + i * num_bytes, src + i * src_stride, num_bytes);
+      }
+  }
+}
+
+#ifdef DRACO_X86_SIMD_SUPPORTED
+// Reverses the byte order of 2, 4 or 8 byte values in |data|, 16 bytes at a
+// time. Returns the number of processed bytes.
+DRACO_TARGET_SSE41 int64_t SwapBytesSse41(uint8_t *data, int64_t num_bytes,
+                                          int value_size) {
+  __m128i shuffle;
+  if (value_size == 2) {
+    shuffle = _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15,
+                            14);
+  } else if (value_size == 4) {
+    shuffle = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13,
+                            12);
+  } else {
+    shuffle = _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9,
+                            8);
+  }
+  int64_t i = 0;
+  for (; i + 16 <= num_bytes; i += 16) {
+    __m128i *const ptr = reinterpret_cast<__m128i *>(data + i);
+    _mm_storeu_si128(ptr, _mm_shuffle_epi8(_mm_loadu_si128(ptr), shuffle));
+  }
+  return i;
+}
+#endif
+
+// Converts |num_values| big endian values of |value_size| bytes stored in
+// |data| to the little endian byte order (or vice versa).
+void SwapBytes(uint8_t *data, int64_t num_values, int value_size) {
+  if (value_size <= 1) {
+    return;
+  }
+  const int64_t num_bytes = num_values * value_size;
+  int64_t i = 0;
+#ifdef DRACO_X86_SIMD_SUPPORTED
+  if (value_size <= 8 && CpuSse41Supported()) {
+    i = SwapBytesSse41(data, num_bytes, value_size);
+  }
+#endif
+  for (; i < num_bytes; i += value_size) {
+    std::reverse(data + i, data + i + value_size);
+  }
+}
+
+// Minimum number of ascii entries parsed by a single task.
+constexpr int64_t kMinAsciiEntriesPerTask = 16384;
+
+// Parses a single value of an ascii property with |data_type|. The value is
+// converted to double in the same way as values written through
+// PlyPropertyWriter<double>.
+bool ParseAsciiValue(const char **data, const char *end, DataType data_type,
+                     double *value) {
+  parser::SkipWhitespace(data, end);
+  if (data_type == DT_FLOAT32 || data_type == DT_FLOAT64) {
+    float val;
+    if (!parser::ParseFloat(data, end, &val)) {
+      return false;
+    }
+    *value = val;
+  } else {
+    int32_t val;
+    if (!parser::ParseSignedInt(data, end, &val)) {
+      return false;
+    }
+    *value = val;
+  }
+  return true;
+}
+
+template <typename DataTypeT>
+void WriteValue(double value, uint8_t *dst) {
+  const DataTypeT typed_value = static_cast<DataTypeT>(value);
+  memcpy(dst, &typed_value, sizeof(DataTypeT));
+}
+
+// Stores |value| converted to |data_type| at |dst|.
+void WriteConvertedValue(double value, DataType data_type, uint8_t *dst) {
+  switch (data_type) {
+    case DT_UINT8:
+      return WriteValue<uint8_t>(value, dst);
+    case DT_INT8:
+      return WriteValue<int8_t>(value, dst);
+    case DT_UINT16:
+      return WriteValue<uint16_t>(value, dst);
+    case DT_INT16:
+      return WriteValue<int16_t>(value, dst);
+    case DT_UINT32:
+      return WriteValue<uint32_t>(value, dst);
+    case DT_INT32:
+      return WriteValue<int32_t>(value, dst);
+    case DT_FLOAT32:
+      return WriteValue<float>(value, dst);
+    case DT_FLOAT64:
+      return WriteValue<double>(value, dst);
+    default:
+      break;
+  }
+}
+
+}  // namespace
+
 PlyProperty::PlyProperty(const std::string &name, DataType data_type,
                          DataType list_type)
-    : name_(name), data_type_(data_type), list_data_type_(list_type) {
+    : name_(name),
+      list_num_values_(-1),
+      data_type_(data_type),
+      list_data_type_(list_type) {
   data_type_num_bytes_ = DataTypeLength(data_type);
   list_data_type_num_bytes_ = DataTypeLength(list_type);
 }
@@ -33,7 +192,7 @@ PlyProperty::PlyProperty(const std::string &name, DataType data_type,
 PlyElement::PlyElement(const std::string &name, int64_t num_entries)
     : name_(name), num_entries_(num_entries) {}
 
-PlyReader::PlyReader() : format_(kLittleEndian) {}
+PlyReader::PlyReader() : format_(kLittleEndian), thread_pool_(nullptr) {}
 
 Status PlyReader::Read(DecoderBuffer *buffer) {
   std::string value;
@@ -56,13 +215,10 @@ Status PlyReader::Read(DecoderBuffer *buffer) {
   if (version != "1.0") {
     return Status(Status::UNSUPPORTED_VERSION, "Unsupported PLY version");
   }
-  if (format == "binary_big_endian") {
-    return Status(Status::UNSUPPORTED_VERSION,
-                  "Unsupported format. Currently we support only ascii and"
-                  " binary_little_endian format.");
-  }
   if (format == "ascii") {
     format_ = kAscii;
+  } else if (format == "binary_big_endian") {
+    format_ = kBigEndian;
   } else {
     format_ = kLittleEndian;
   }
@@ -172,7 +328,7 @@ StatusOr<bool> PlyReader::ParseProperty(DecoderBuffer *buffer) {
 
 bool PlyReader::ParsePropertiesData(DecoderBuffer *buffer) {
   for (int i = 0; i < static_cast<int>(elements_.size()); ++i) {
-    if (format_ == kLittleEndian) {
+    if (format_ == kLittleEndian || format_ == kBigEndian) {
       if (!ParseElementData(buffer, i)) {
         return false;
       }
@@ -186,43 +342,150 @@ bool PlyReader::ParsePropertiesData(DecoderBuffer *buffer) {
 }
 
 bool PlyReader::ParseElementData(DecoderBuffer *buffer, int element_index) {
+  if (ParseFixedSizeElementData(buffer, element_index)) {
+    return true;
+  }
   PlyElement &element = elements_[element_index];
+  const bool big_endian = format_ == kBigEndian;
   for (int entry = 0; entry < element.num_entries(); ++entry) {
     for (int i = 0; i < element.num_properties(); ++i) {
       PlyProperty &prop = element.property(i);
+      int64_t num_entries = 1;
       if (prop.is_list()) {
         // Parse the number of entries for the list element.
-        int64_t num_entries = 0;
-        buffer->Decode(&num_entries, prop.list_data_type_num_bytes());
+        if (buffer->remaining_size() < prop.list_data_type_num_bytes()) {
+          return false;
+        }
+        num_entries = ReadListNumValues(
+            reinterpret_cast<const uint8_t *>(buffer->data_head()),
+            prop.list_data_type_num_bytes(), big_endian);
+        buffer->Advance(prop.list_data_type_num_bytes());
         // Store offset to the main data entry.
         prop.list_data_.push_back(prop.data_.size() /
                                   prop.data_type_num_bytes_);
         // Store the number of entries.
         prop.list_data_.push_back(num_entries);
-        // Read and store the actual property data
-        const int64_t num_bytes_to_read =
-            prop.data_type_num_bytes() * num_entries;
-        prop.data_.insert(prop.data_.end(), buffer->data_head(),
-                          buffer->data_head() + num_bytes_to_read);
-        buffer->Advance(num_bytes_to_read);
-      } else {
-        // Non-list property
-        prop.data_.insert(prop.data_.end(), buffer->data_head(),
-                          buffer->data_head() + prop.data_type_num_bytes());
-        buffer->Advance(prop.data_type_num_bytes());
+      }
+      // Read and store the actual property data.
+      const int64_t num_bytes_to_read =
+          prop.data_type_num_bytes() * num_entries;
+      if (buffer->remaining_size() < num_bytes_to_read) {
+        return false;
+      }
+      const size_t data_offset = prop.data_.size();
+      prop.data_.insert(prop.data_.end(), buffer->data_head(),
+                        buffer->data_head() + num_bytes_to_read);
+      buffer->Advance(num_bytes_to_read);
+      if (big_endian) {
+        SwapBytes(prop.data_.data() + data_offset, num_entries,
+                  prop.data_type_num_bytes());
+      }
+    }
+  }
+  return true;
+}
+
+bool PlyReader::ParseFixedSizeElementData(DecoderBuffer *buffer,
+                                          int element_index) {
+  PlyElement &element = elements_[element_index];
+  const int64_t num_entries = element.num_entries();
+  if (num_entries <= 0) {
+    return false;
+  }
+  const bool big_endian = format_ == kBigEndian;
+  const uint8_t *const data =
+      reinterpret_cast<const uint8_t *>(buffer->data_head());
+  const int64_t data_size = buffer->remaining_size();
+
+  // Compute the layout of the first entry. The lengths of its lists are
+  // expected to be the same in all other entries.
+  const int num_properties = element.num_properties();
+  std::vector<int64_t> value_offsets(num_properties);
+  std::vector<int64_t> num_values(num_properties, 1);
+  int64_t entry_size = 0;
+  for (int i = 0; i < num_properties; ++i) {
+    const PlyProperty &prop = element.property(i);
+    if (prop.is_list()) {
+      if (data_size - entry_size < prop.list_data_type_num_bytes()) {
+        return false;
+      }
+      num_values[i] = ReadListNumValues(
+          data + entry_size, prop.list_data_type_num_bytes(), big_endian);
+      entry_size += prop.list_data_type_num_bytes();
+    }
+    value_offsets[i] = entry_size;
+    entry_size += num_values[i] * prop.data_type_num_bytes();
+  }
+  if (entry_size == 0 || data_size / entry_size < num_entries) {
+    return false;
+  }
+
+  // Verify that all lists have the same length in all entries.
+  for (int i = 0; i < num_properties; ++i) {
+    const PlyProperty &prop = element.property(i);
+    if (!prop.is_list()) {
+      continue;
+    }
+    const uint8_t *const list_data =
+        data + value_offsets[i] - prop.list_data_type_num_bytes();
+    for (int64_t entry = 1; entry < num_entries; ++entry) {
+      if (ReadListNumValues(list_data + entry * entry_size,
+                            prop.list_data_type_num_bytes(),
+                            big_endian) != num_values[i]) {
+        return false;
       }
     }
   }
+
+  // Presize the storage of all properties.
+  for (int i = 0; i < num_properties; ++i) {
+    PlyProperty &prop = element.property(i);
+    prop.data_.resize(num_entries * num_values[i] * prop.data_type_num_bytes());
+    if (prop.is_list()) {
+      prop.list_data_.clear();
+      prop.list_num_values_ = num_values[i];
+    }
+  }
+
+  // De-interleave the entries block by block.
+  for (int64_t block_start = 0; block_start < num_entries;
+       block_start += kFixedSizeElementBlockSize) {
+    const int64_t block_size =
+        std::min(kFixedSizeElementBlockSize, num_entries - block_start);
+    const uint8_t *const block_data = data + block_start * entry_size;
+    for (int i = 0; i < num_properties; ++i) {
+      PlyProperty &prop = element.property(i);
+      const int64_t value_bytes = num_values[i] * prop.data_type_num_bytes();
+      if (value_bytes == 0) {
+        continue;
+      }
+      uint8_t *const dst = prop.data_.data() + block_start * value_bytes;
+      CopyStridedValues(block_data + value_offsets[i], entry_size, value_bytes,
+                        block_size, dst);
+      if (big_endian) {
+        SwapBytes(dst, block_size * num_values[i], prop.data_type_num_bytes());
+      }
+    }
+  }
+  buffer->Advance(num_entries * entry_size);
   return true;
 }
 
 bool PlyReader::ParseElementDataAscii(DecoderBuffer *buffer,
                                       int element_index) {
+  if (ParseElementDataAsciiLines(buffer, element_index)) {
+    return true;
+  }
   PlyElement &element = elements_[element_index];
+  std::vector<std::unique_ptr<PlyPropertyWriter<double>>> prop_writers;
+  for (int i = 0; i < element.num_properties(); ++i) {
+    prop_writers.push_back(std::unique_ptr<PlyPropertyWriter<double>>(
+        new PlyPropertyWriter<double>(&element.property(i))));
+  }
   for (int entry = 0; entry < element.num_entries(); ++entry) {
     for (int i = 0; i < element.num_properties(); ++i) {
       PlyProperty &prop = element.property(i);
-      PlyPropertyWriter<double> prop_writer(&prop);
+      const PlyPropertyWriter<double> &prop_writer = *prop_writers[i];
       int32_t num_entries = 1;
       if (prop.is_list()) {
         parser::SkipWhitespace(buffer);
@@ -259,6 +522,132 @@ bool PlyReader::ParseElementDataAscii(DecoderBuffer *buffer,
   return true;
 }
 
+bool PlyReader::ParseElementDataAsciiLines(DecoderBuffer *buffer,
+                                           int element_index) {
+  PlyElement &element = elements_[element_index];
+  const int64_t num_entries = element.num_entries();
+  if (num_entries <= 0) {
+    return false;
+  }
+  const char *const data = buffer->data_head();
+  const char *const end = data + buffer->remaining_size();
+
+  // Find the beginning of all lines.
+  std::vector<const char *> line_starts(num_entries + 1);
+  const char *line = data;
+  for (int64_t entry = 0; entry < num_entries; ++entry) {
+    if (line == end) {
+      return false;
+    }
+    line_starts[entry] = line;
+    parser::SkipLine(&line, end);
+  }
+  line_starts[num_entries] = line;
+
+  // Get the lengths of the lists from the first entry.
+  const int num_properties = element.num_properties();
+  std::vector<int64_t> num_values(num_properties, 1);
+  const char *first_line = line_starts[0];
+  for (int i = 0; i < num_properties; ++i) {
+    const PlyProperty &prop = element.property(i);
+    if (prop.is_list()) {
+      int32_t num_list_values;
+      parser::SkipWhitespace(&first_line, line_starts[1]);
+      if (!parser::ParseSignedInt(&first_line, line_starts[1],
+                                  &num_list_values) ||
+          num_list_values < 0) {
+        return false;
+      }
+      num_values[i] = num_list_values;
+    }
+    for (int64_t v = 0; v < num_values[i]; ++v) {
+      double value;
+      if (!ParseAsciiValue(&first_line, line_starts[1], prop.data_type(),
+                           &value)) {
+        return false;
+      }
+    }
+  }
+
+  // Presize the storage of all properties.
+  for (int i = 0; i < num_properties; ++i) {
+    PlyProperty &prop = element.property(i);
+    prop.data_.resize(num_entries * num_values[i] * prop.data_type_num_bytes());
+  }
+
+  // Parses entries in range [first_entry, last_entry). Returns false when any
+  // of the lines doesn't contain exactly one entry.
+  const auto parse_entries = [&](int64_t first_entry, int64_t last_entry) {
+    for (int64_t entry = first_entry; entry < last_entry; ++entry) {
+      const char *entry_data = line_starts[entry];
+      const char *const line_end = line_starts[entry + 1];
+      for (int i = 0; i < num_properties; ++i) {
+        PlyProperty &prop = element.property(i);
+        if (prop.is_list()) {
+          int32_t num_list_values;
+          parser::SkipWhitespace(&entry_data, line_end);
+          if (!parser::ParseSignedInt(&entry_data, line_end,
+                                      &num_list_values) ||
+              num_list_values != num_values[i]) {
+            return false;
+          }
+        }
+        uint8_t *dst = prop.data_.data() +
+                       entry * num_values[i] * prop.data_type_num_bytes();
+        for (int64_t v = 0; v < num_values[i]; ++v) {
+          double value;
+          if (!ParseAsciiValue(&entry_data, line_end, prop.data_type(),
+                               &value)) {
+            return false;
+          }
+          WriteConvertedValue(value, prop.data_type(), dst);
+          dst += prop.data_type_num_bytes();
+        }
+      }
+      // Nothing else can follow the entry on the same line.
+      parser::SkipWhitespace(&entry_data, line_end);
+      if (entry_data != line_end) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  int num_tasks = 1;
+  if (thread_pool_ != nullptr) {
+    num_tasks = static_cast<int>(
+        std::min<int64_t>(thread_pool_->num_threads() + 1,
+                          num_entries / kMinAsciiEntriesPerTask));
+  }
+  bool parsed = true;
+  if (num_tasks <= 1) {
+    parsed = parse_entries(0, num_entries);
+  } else {
+    std::vector<uint8_t> task_parsed(num_tasks);
+    thread_pool_->ParallelFor(num_tasks, [&](int task) {
+      task_parsed[task] = parse_entries(num_entries * task / num_tasks,
+                                        num_entries * (task + 1) / num_tasks);
+    });
+    parsed = std::find(task_parsed.begin(), task_parsed.end(), 0) ==
+             task_parsed.end();
+  }
+  if (!parsed) {
+    // Revert the element to its original state.
+    for (int i = 0; i < num_properties; ++i) {
+      element.property(i).data_.clear();
+    }
+    return false;
+  }
+  for (int i = 0; i < num_properties; ++i) {
+    PlyProperty &prop = element.property(i);
+    if (prop.is_list()) {
+      prop.list_num_values_ = num_values[i];
+    }
+  }
+  buffer->Advance(line_starts[num_entries] - data);
+  return true;
+}
+
 std::vector<std::string> PlyReader::SplitWords(const std::string &line) {
   std::vector<std::string> output;
   std::string::size_type start = 0;
@@ -14,9 +14,8 @@
 //
 // File contains helper classes used for parsing of PLY files. The classes are
 // used by the PlyDecoder (ply_decoder.h) to read a point cloud or mesh from a
-// source PLY file.
-// TODO(ostava): Currently, we support only binary PLYs encoded in the little
-// endian format ("format binary_little_endian 1.0").
+// source PLY file. Supported are the ascii, binary_little_endian and
+// binary_big_endian formats.
 
 #ifndef DRACO_IO_PLY_READER_H_
 #define DRACO_IO_PLY_READER_H_
@@ -28,6 +27,7 @@
 #include "draco/core/draco_types.h"
 #include "draco/core/status.h"
 #include "draco/core/status_or.h"
+#include "draco/core/thread_pool.h"
 
 namespace draco {
 
@@ -44,11 +44,21 @@ class PlyProperty {
   }
 
   int64_t GetListEntryOffset(int entry_id) const {
+    if (list_num_values_ >= 0) {
+      return entry_id * list_num_values_;
+    }
     return list_data_[entry_id * 2];
   }
   int64_t GetListEntryNumValues(int entry_id) const {
+    if (list_num_values_ >= 0) {
+      return list_num_values_;
+    }
     return list_data_[entry_id * 2 + 1];
   }
+  // Returns the number of values of all list entries when all of them have
+  // the same length (e.g. vertex indices of triangular faces), or -1 when the
+  // length of each entry must be queried with GetListEntryNumValues().
+  int64_t list_num_values() const { return list_num_values_; }
   const void *GetDataEntryAddress(int entry_id) const {
     return data_.data() + entry_id * data_type_num_bytes_;
   }
@@ -69,6 +79,9 @@ class PlyProperty {
   std::vector<uint8_t> data_;
   // List data contain pairs of <offset, number_of_values>
   std::vector<int64_t> list_data_;
+  // Length of all list entries when they have the same length. In such case
+  // |list_data_| is empty.
+  int64_t list_num_values_;
   DataType data_type_;
   int data_type_num_bytes_;
   DataType list_data_type_;
@@ -117,6 +130,10 @@ class PlyReader {
   PlyReader();
   Status Read(DecoderBuffer *buffer);
 
+  // Sets a thread pool that is used to parse large ascii elements in parallel
+  // (can be nullptr).
+  void set_thread_pool(ThreadPool *thread_pool) { thread_pool_ = thread_pool; }
+
   const PlyElement *GetElementByName(const std::string &name) const {
     const auto it = element_index_.find(name);
     if (it != element_index_.end()) {
@@ -131,7 +148,7 @@ class PlyReader {
   }
 
  private:
-  enum Format { kLittleEndian = 0, kAscii };
+  enum Format { kLittleEndian = 0, kAscii, kBigEndian };
 
   Status ParseHeader(DecoderBuffer *buffer);
   StatusOr<bool> ParseEndHeader(DecoderBuffer *buffer);
@@ -139,7 +156,19 @@ class PlyReader {
   StatusOr<bool> ParseProperty(DecoderBuffer *buffer);
   bool ParsePropertiesData(DecoderBuffer *buffer);
   bool ParseElementData(DecoderBuffer *buffer, int element_index);
+  // Parses data of a binary element whose entries all have the same size,
+  // i.e., when the element has no list properties or when all of its lists
+  // have the same length in all entries. The entries are de-interleaved into
+  // the property storage in bulk. Returns false when the element doesn't have
+  // this layout, in which case |buffer| is not modified.
+  bool ParseFixedSizeElementData(DecoderBuffer *buffer, int element_index);
   bool ParseElementDataAscii(DecoderBuffer *buffer, int element_index);
+  // Parses data of an ascii element with one entry per line. All lines are
+  // located first and then they are parsed independently, in parallel when
+  // |thread_pool_| is set. Lists are expected to have the same length in all
+  // entries. Returns false when the data doesn't have this layout, in which
+  // case |buffer| is not modified.
+  bool ParseElementDataAsciiLines(DecoderBuffer *buffer, int element_index);
 
   // Splits |line| by whitespace characters.
   std::vector<std::string> SplitWords(const std::string &line);
@@ -148,6 +177,7 @@ class PlyReader {
   std::vector<PlyElement> elements_;
   std::map<std::string, int> element_index_;
   Format format_;
+  ThreadPool *thread_pool_;
 };
 
 }  // namespace draco
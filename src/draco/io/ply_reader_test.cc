@@ -14,6 +14,11 @@
 //
 #include "draco/io/ply_reader.h"
 
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
 #include "draco/core/draco_test_base.h"
 #include "draco/core/draco_test_utils.h"
 #include "draco/io/file_utils.h"
@@ -23,6 +28,42 @@ namespace draco {
 
 class PlyReaderTest : public ::testing::Test {
  protected:
+  // Appends |value| to |data| in the little or big endian byte order.
+  template <typename T>
+  static void AppendValue(T value, bool big_endian, std::string *data) {
+    char bytes[sizeof(T)];
+    memcpy(bytes, &value, sizeof(T));
+    if (big_endian) {
+      std::reverse(bytes, bytes + sizeof(T));
+    }
+    data->append(bytes, sizeof(T));
+  }
+
+  // Returns a binary PLY with two vertices and faces with |face_sizes|
+  // vertex indices each.
+  static std::string CreateBinaryPly(bool big_endian,
+                                     const std::vector<int> &face_sizes) {
+    std::string data = "ply\nformat ";
+    data += big_endian ? "binary_big_endian" : "binary_little_endian";
+    data += " 1.0\nelement vertex 2\nproperty float x\nproperty short s\n";
+    data += "property uchar red\nelement face " +
+            std::to_string(face_sizes.size()) +
+            "\nproperty list uchar int vertex_indices\nend_header\n";
+    for (int i = 0; i < 2; ++i) {
+      AppendValue<float>(1.5f + i, big_endian, &data);
+      AppendValue<int16_t>(-300 + i, big_endian, &data);
+      AppendValue<uint8_t>(200 + i, big_endian, &data);
+    }
+    int index = 0;
+    for (const int face_size : face_sizes) {
+      AppendValue<uint8_t>(face_size, big_endian, &data);
+      for (int c = 0; c < face_size; ++c) {
+        AppendValue<int32_t>(index++, big_endian, &data);
+      }
+    }
+    return data;
+  }
+
   std::vector<char> ReadPlyFile(const std::string &file_name) const {
     const std::string path = GetTestFileFullPath(file_name);
 
@@ -140,4 +181,118 @@ TEST_F(PlyReaderTest, TestReaderMoreDataTypes) {
   }
 }
 
+TEST_F(PlyReaderTest, TestReaderBinaryFormats) {
+  // Tests that little and big endian binary files are decoded to the same
+  // values.
+  for (const bool big_endian : {false, true}) {
+    const std::string data = CreateBinaryPly(big_endian, {3, 3, 3});
+    DecoderBuffer buf;
+    buf.Init(data.data(), data.size());
+    PlyReader reader;
+    const Status status = reader.Read(&buf);
+    ASSERT_TRUE(status.ok()) << status;
+    ASSERT_EQ(reader.num_elements(), 2);
+    const PlyElement &vertex = reader.element(0);
+    PlyPropertyReader<float> x_reader(vertex.GetPropertyByName("x"));
+    PlyPropertyReader<int32_t> s_reader(vertex.GetPropertyByName("s"));
+    PlyPropertyReader<int32_t> red_reader(vertex.GetPropertyByName("red"));
+    for (int i = 0; i < 2; ++i) {
+      ASSERT_EQ(x_reader.ReadValue(i), 1.5f + i);
+      ASSERT_EQ(s_reader.ReadValue(i), -300 + i);
+      ASSERT_EQ(red_reader.ReadValue(i), 200 + i);
+    }
+    const PlyProperty &indices = reader.element(1).property(0);
+    ASSERT_EQ(indices.list_num_values(), 3);
+    PlyPropertyReader<int32_t> index_reader(&indices);
+    for (int f = 0; f < 3; ++f) {
+      ASSERT_EQ(indices.GetListEntryOffset(f), 3 * f);
+      ASSERT_EQ(indices.GetListEntryNumValues(f), 3);
+      for (int c = 0; c < 3; ++c) {
+        ASSERT_EQ(index_reader.ReadValue(3 * f + c), 3 * f + c);
+      }
+    }
+  }
+}
+
+TEST_F(PlyReaderTest, TestReaderMixedListLengths) {
+  // Tests decoding of lists with different lengths in different entries.
+  for (const bool big_endian : {false, true}) {
+    const std::string data = CreateBinaryPly(big_endian, {3, 4, 3});
+    DecoderBuffer buf;
+    buf.Init(data.data(), data.size());
+    PlyReader reader;
+    const Status status = reader.Read(&buf);
+    ASSERT_TRUE(status.ok()) << status;
+    const PlyProperty &indices = reader.element(1).property(0);
+    ASSERT_EQ(indices.list_num_values(), -1);
+    ASSERT_EQ(indices.GetListEntryOffset(1), 3);
+    ASSERT_EQ(indices.GetListEntryNumValues(1), 4);
+    ASSERT_EQ(indices.GetListEntryOffset(2), 7);
+    PlyPropertyReader<int32_t> index_reader(&indices);
+    for (int i = 0; i < 10; ++i) {
+      ASSERT_EQ(index_reader.ReadValue(i), i);
+    }
+  }
+}
+
+TEST_F(PlyReaderTest, TestReaderTruncatedData) {
+  // Tests that binary files with missing element data are rejected.
+  const std::string data = CreateBinaryPly(false, {3, 4, 3});
+  for (const size_t size : {data.size() - 1, data.size() - 20}) {
+    DecoderBuffer buf;
+    buf.Init(data.data(), size);
+    PlyReader reader;
+    ASSERT_FALSE(reader.Read(&buf).ok());
+  }
+}
+
+TEST_F(PlyReaderTest, TestReaderAsciiLayouts) {
+  // Tests that ascii data is parsed to the same values regardless of the
+  // layout of the entries and of the use of a thread pool.
+  const int num_vertices = 40000;
+  std::string header = "ply\nformat ascii 1.0\nelement vertex " +
+                       std::to_string(num_vertices) +
+                       "\nproperty float x\nproperty int16 s\n"
+                       "element face 2\n"
+                       "property list uchar int vertex_indices\nend_header\n";
+  std::string one_entry_per_line = header;
+  std::string split_entries = header;
+  for (int i = 0; i < num_vertices; ++i) {
+    const std::string x = std::to_string(i * 0.25f - 100.f);
+    const std::string s = std::to_string(i % 1000 - 500);
+    one_entry_per_line += x + " " + s + "\n";
+    split_entries += x + "\n" + s + "\n";
+  }
+  one_entry_per_line += "3 0 1 2\n3 2 1 3\n";
+  split_entries += "3 0 1\n2 3 2 1 3\n";
+
+  ThreadPool thread_pool(2);
+  for (const std::string &data : {one_entry_per_line, split_entries}) {
+    for (ThreadPool *const pool : {static_cast<ThreadPool *>(nullptr),
+                                   &thread_pool}) {
+      DecoderBuffer buf;
+      buf.Init(data.data(), data.size());
+      PlyReader reader;
+      reader.set_thread_pool(pool);
+      const Status status = reader.Read(&buf);
+      ASSERT_TRUE(status.ok()) << status;
+      const PlyElement &vertex = reader.element(0);
+      PlyPropertyReader<float> x_reader(vertex.GetPropertyByName("x"));
+      PlyPropertyReader<int32_t> s_reader(vertex.GetPropertyByName("s"));
+      for (int i = 0; i < num_vertices; ++i) {
+        ASSERT_EQ(x_reader.ReadValue(i), i * 0.25f - 100.f);
+        ASSERT_EQ(s_reader.ReadValue(i), i % 1000 - 500);
+      }
+      const PlyProperty &indices = reader.element(1).property(0);
+      ASSERT_EQ(indices.GetListEntryNumValues(1), 3);
+      ASSERT_EQ(indices.GetListEntryOffset(1), 3);
+      PlyPropertyReader<int32_t> index_reader(&indices);
+      const int expected_indices[] = {0, 1, 2, 2, 1, 3};
+      for (int i = 0; i < 6; ++i) {
+        ASSERT_EQ(index_reader.ReadValue(i), expected_indices[i]);
+      }
+    }
+  }
+}
+
 }  // namespace draco
@@ -21,6 +21,18 @@
 
 namespace draco {
 
+StatusOr<std::unique_ptr<PointCloud>> ReadPointCloudFromDataSource(
+    DataSourceInterface *source) {
+  std::vector<char> data;
+  if (!ReadDataSourceToBuffer(source, &data)) {
+    return Status(Status::IO_ERROR, "Unable to read input data.");
+  }
+  DecoderBuffer buffer;
+  buffer.Init(data.data(), data.size());
+  Decoder decoder;
+  return decoder.DecodePointCloudFromBuffer(&buffer);
+}
+
 StatusOr<std::unique_ptr<PointCloud>> ReadPointCloudFromFile(
     const std::string &file_name) {
   std::unique_ptr<PointCloud> pc(new PointCloud());
@@ -44,12 +56,14 @@ StatusOr<std::unique_ptr<PointCloud>> ReadPointCloudFromFile(
     return std::move(pc);
   }
 
+  // The data is decoded directly from the file when it can be memory mapped.
   std::vector<char> buffer;
-  if (!ReadFileToBuffer(file_name, &buffer)) {
+  DecoderBuffer decoder_buffer;
+  const std::unique_ptr<FileReaderInterface> file_reader =
+      ReadFileToDecoderBuffer(file_name, &buffer, &decoder_buffer);
+  if (file_reader == nullptr) {
     return Status(Status::DRACO_ERROR, "Unable to read input file.");
   }
-  DecoderBuffer decoder_buffer;
-  decoder_buffer.Init(buffer.data(), buffer.size());
   Decoder decoder;
   auto status_or = decoder.DecodePointCloudFromBuffer(&decoder_buffer);
   return std::move(status_or).value();
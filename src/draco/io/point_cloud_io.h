@@ -18,25 +18,35 @@
 #include "draco/compression/config/compression_shared.h"
 #include "draco/compression/decode.h"
 #include "draco/compression/expert_encode.h"
+#include "draco/io/data_source.h"
 
 namespace draco {
 
+// Encodes the point cloud and writes it into |os|. The encoded data is written
+// as soon as each part of the geometry is encoded, so the complete output is
+// never held in memory. On failure, the badbit of |os| is set and the data
+// written before the failure is left in |os|, so the output is truncated.
+// Callers that need all-or-nothing output should encode into an EncoderBuffer
+// without a sink and write its data only after the encoding succeeds.
 template <typename OutStreamT>
 OutStreamT WritePointCloudIntoStream(const PointCloud *pc, OutStreamT &&os,
                                      PointCloudEncodingMethod method,
                                      const EncoderOptions &options) {
   EncoderBuffer buffer;
+  buffer.SetSink([&os](std::vector<char> *data) {
+    os.write(data->data(), data->size());
+    data->clear();
+    return !os.fail();
+  });
   EncoderOptions local_options = options;
   ExpertEncoder encoder(*pc);
   encoder.Reset(local_options);
   encoder.SetEncodingMethod(method);
-  if (!encoder.EncodeToBuffer(&buffer).ok()) {
+  if (!encoder.EncodeToBuffer(&buffer).ok() || !buffer.Flush()) {
     os.setstate(std::ios_base::badbit);
     return os;
   }
 
-  os.write(static_cast<const char *>(buffer.data()), buffer.size());
-
   return os;
 }
 
@@ -52,22 +62,21 @@ OutStreamT &WritePointCloudIntoStream(const PointCloud *pc, OutStreamT &&os) {
   return WritePointCloudIntoStream(pc, os, POINT_CLOUD_SEQUENTIAL_ENCODING);
 }
 
+// Reads all data from |source| and decodes it into a point cloud. Unlike
+// ReadPointCloudFromFile(), the data must be encoded by a Draco encoder.
+StatusOr<std::unique_ptr<PointCloud>> ReadPointCloudFromDataSource(
+    DataSourceInterface *source);
+
+// Reads a point cloud from all remaining data of the input stream |is|.
+// Seekable streams are read in one go into a buffer of the exact size. Other
+// streams (e.g. pipes) are read in chunks.
 template <typename InStreamT>
 InStreamT &ReadPointCloudFromStream(std::unique_ptr<PointCloud> *point_cloud,
                                     InStreamT &&is) {
-  // Determine size of stream and write into a vector
-  const auto start_pos = is.tellg();
-  is.seekg(0, std::ios::end);
-  const std::streampos is_size = is.tellg() - start_pos;
-  is.seekg(start_pos);
-  std::vector<char> data(is_size);
-  is.read(&data[0], is_size);
-
-  // Create a point cloud from that data.
-  DecoderBuffer buffer;
-  buffer.Init(&data[0], data.size());
-  Decoder decoder;
-  auto statusor = decoder.DecodePointCloudFromBuffer(&buffer);
+  IstreamDataSource source(&is);
+  auto statusor = ReadPointCloudFromDataSource(&source);
+  // Reaching the end of the stream is expected.
+  is.clear(is.rdstate() & std::ios_base::badbit);
   *point_cloud = std::move(statusor).value();
   if (!statusor.ok() || *point_cloud == nullptr) {
     is.setstate(std::ios_base::badbit);
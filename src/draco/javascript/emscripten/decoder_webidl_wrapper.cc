@@ -25,6 +25,65 @@ using draco::PointAttribute;
 using draco::PointCloud;
 using draco::Status;
 
+DracoMeshBuffers::DracoMeshBuffers() : num_faces_(0), num_points_(0) {}
+
+long DracoMeshBuffers::AddAttribute(draco_GeometryAttribute_Type att_type,
+                                    draco_DataType data_type,
+                                    long num_components) {
+  attributes_.push_back({att_type, data_type,
+                         static_cast<int>(num_components),
+                         std::vector<uint8_t>()});
+  return attributes_.size() - 1;
+}
+
+void *DracoMeshBuffers::GetAttributeData(long request_id) {
+  if (request_id < 0 || request_id >= attributes_.size() ||
+      attributes_[request_id].data.empty()) {
+    return nullptr;
+  }
+  return attributes_[request_id].data.data();
+}
+
+long DracoMeshBuffers::GetAttributeDataSize(long request_id) const {
+  if (request_id < 0 || request_id >= attributes_.size()) {
+    return 0;
+  }
+  return attributes_[request_id].data.size();
+}
+
+Status DracoMeshBuffers::AllocateBuffers(const Mesh &mesh,
+                                         draco::MeshBufferLayout *out_layout) {
+  num_faces_ = mesh.num_faces();
+  num_points_ = mesh.num_points();
+  indices_.resize(3 * num_faces_);
+  out_layout->index_type = draco::DT_UINT32;
+  out_layout->indices = indices_.data();
+  out_layout->indices_size = indices_.size() * sizeof(uint32_t);
+  for (AttributeRequest &request : attributes_) {
+    request.data.clear();
+    const int att_id = mesh.GetNamedAttributeId(request.attribute_type);
+    if (att_id < 0) {
+      continue;
+    }
+    const int data_type_length = draco::DataTypeLength(request.data_type);
+    if (data_type_length <= 0 || request.num_components < 0) {
+      return Status(Status::DRACO_ERROR, "Unsupported attribute request.");
+    }
+    draco::AttributeBufferLayout att_layout;
+    att_layout.attribute_id = att_id;
+    att_layout.data_type = request.data_type;
+    att_layout.num_components = request.num_components;
+    const int num_components = att_layout.GetNumComponents(
+        mesh.attribute(att_id)->num_components());
+    request.data.resize(static_cast<size_t>(num_points_) * num_components *
+                        data_type_length);
+    att_layout.data = request.data.data();
+    att_layout.data_size = request.data.size();
+    out_layout->attributes.push_back(att_layout);
+  }
+  return draco::OkStatus();
+}
+
 MetadataQuerier::MetadataQuerier() : entry_names_metadata_(nullptr) {}
 
 bool MetadataQuerier::HasEntry(const Metadata &metadata,
@@ -107,6 +166,16 @@ const Status *Decoder::DecodeBufferToMesh(DecoderBuffer *in_buffer,
   return &last_status_;
 }
 
+const Status *Decoder::DecodeBufferToMeshBuffers(
+    DecoderBuffer *in_buffer, DracoMeshBuffers *out_buffers) {
+  last_status_ = decoder_.DecodeMeshToBuffers(
+      in_buffer, [out_buffers](const Mesh &mesh,
+                               draco::MeshBufferLayout *out_layout) {
+        return out_buffers->AllocateBuffers(mesh, out_layout);
+      });
+  return &last_status_;
+}
+
 long Decoder::GetAttributeId(const PointCloud &pc,
                              draco_GeometryAttribute_Type type) const {
   return pc.GetNamedAttributeId(type);
@@ -23,6 +23,7 @@
 #include "draco/compression/decode.h"
 #include "draco/core/decoder_buffer.h"
 #include "draco/mesh/mesh.h"
+#include "draco/mesh/mesh_buffer_layout.h"
 
 typedef draco::AttributeTransformType draco_AttributeTransformType;
 typedef draco::GeometryAttribute draco_GeometryAttribute;
@@ -60,6 +61,53 @@ using DracoUInt16Array = DracoArray<uint16_t>;
 using DracoInt32Array = DracoArray<int32_t>;
 using DracoUInt32Array = DracoArray<uint32_t>;
 
+// Memory on the emscripten heap into which Decoder::DecodeBufferToMeshBuffers()
+// writes the faces and the requested attributes of a decoded mesh. The
+// attribute decoders write the values directly into this memory which can be
+// accessed from JavaScript through views of the heap (e.g. HEAPF32) at the
+// addresses returned by GetIndices() and GetAttributeData().
+class DracoMeshBuffers {
+ public:
+  DracoMeshBuffers();
+
+  // Requests the values of the first attribute of type |att_type| to be
+  // written as |num_components| values of |data_type| per point. When
+  // |num_components| is 0, all components of the attribute are written.
+  // Returns the id of the request used by the getters below.
+  long AddAttribute(draco_GeometryAttribute_Type att_type,
+                    draco_DataType data_type, long num_components);
+
+  long num_faces() const { return num_faces_; }
+  long num_points() const { return num_points_; }
+
+  // Returns the uint32 point indices of all faces (three per face).
+  void *GetIndices() { return indices_.data(); }
+  long GetIndicesSize() const { return indices_.size() * sizeof(uint32_t); }
+
+  // Returns the values of the attribute requested by |request_id| for all
+  // points or nullptr when the decoded mesh doesn't contain the attribute.
+  void *GetAttributeData(long request_id);
+  long GetAttributeDataSize(long request_id) const;
+
+  // Allocates the memory for the faces and the requested attributes of |mesh|
+  // and describes it in |out_layout|.
+  draco::Status AllocateBuffers(const draco::Mesh &mesh,
+                                draco::MeshBufferLayout *out_layout);
+
+ private:
+  struct AttributeRequest {
+    draco::GeometryAttribute::Type attribute_type;
+    draco::DataType data_type;
+    int num_components;
+    std::vector<uint8_t> data;
+  };
+
+  long num_faces_;
+  long num_points_;
+  std::vector<uint32_t> indices_;
+  std::vector<AttributeRequest> attributes_;
+};
+
 class MetadataQuerier {
  public:
   MetadataQuerier();
@@ -114,6 +162,13 @@ class Decoder {
   const draco::Status *DecodeBufferToMesh(draco::DecoderBuffer *in_buffer,
                                           draco::Mesh *out_mesh);
 
+  // Decodes a triangular mesh from the provided buffer directly into
+  // |out_buffers| without creating an intermediate draco::Mesh for the
+  // attribute values. This should be preferred over DecodeBufferToMesh()
+  // followed by the Get*ForAllPoints() methods below.
+  const draco::Status *DecodeBufferToMeshBuffers(
+      draco::DecoderBuffer *in_buffer, DracoMeshBuffers *out_buffers);
+
   // Returns an attribute id for the first attribute of a given type.
   long GetAttributeId(const draco::PointCloud &pc,
                       draco_GeometryAttribute_Type type) const;
@@ -14,6 +14,7 @@
 //
 #include "draco/mesh/corner_table.h"
 
+#include <algorithm>
 #include <limits>
 
 #include "draco/attributes/geometry_indices.h"
@@ -25,6 +26,8 @@ CornerTable::CornerTable()
     : num_original_vertices_(0),
       num_degenerated_faces_(0),
       num_isolated_vertices_(0),
+      opposite_corners_method_(OPPOSITE_CORNERS_INCREMENTAL),
+      thread_pool_(nullptr),
       valence_cache_(*this) {}
 
 std::unique_ptr<CornerTable> CornerTable::Create(const IndexTypeVector<FaceIndex, FaceType> &faces)
@@ -37,6 +40,19 @@ std::unique_ptr<CornerTable> CornerTable::Create(const IndexTypeVector<FaceIndex
   return ct;
 }
 
+std::unique_ptr<CornerTable> CornerTable::Create(const IndexTypeVector<FaceIndex, FaceType> &faces,
+                                                 OppositeCornersMethod method, ThreadPool *thread_pool)
+{
+  std::unique_ptr<CornerTable> ct(new CornerTable());
+  ct->set_opposite_corners_method(method);
+  ct->set_thread_pool(thread_pool);
+
+  if (!ct->Init(faces))
+    return nullptr;
+
+  return ct;
+}
+
 bool CornerTable::Init(const IndexTypeVector<FaceIndex, FaceType> &faces)
 {
   valence_cache_.ClearValenceCache();
@@ -78,7 +94,12 @@ bool CornerTable::Reset(int num_faces, int num_vertices)
 
   corner_to_vertex_map_.assign(num_faces * 3, kInvalidVertexIndex);
   opposite_corners_.assign(num_faces * 3, kInvalidCornerIndex);
+  vertex_corners_.clear();
   vertex_corners_.reserve(num_vertices);
+  non_manifold_vertex_parents_.clear();
+  num_original_vertices_ = 0;
+  num_degenerated_faces_ = 0;
+  num_isolated_vertices_ = 0;
   valence_cache_.ClearValenceCache();
   valence_cache_.ClearValenceCacheInaccurate();
 
@@ -92,6 +113,12 @@ bool CornerTable::ComputeOppositeCorners(int *num_vertices)
   if (num_vertices == nullptr)
     return false;
 
+  if (opposite_corners_method_ == OPPOSITE_CORNERS_SORTED)
+    return ComputeOppositeCornersSorted(num_vertices);
+
+  if (opposite_corners_method_ == OPPOSITE_CORNERS_SORTED_LOW_MEMORY)
+    return ComputeOppositeCornersSortedLowMemory(num_vertices);
+
   opposite_corners_.resize(num_corners(), kInvalidCornerIndex);
 
   // Out implementation for finding opposite corners is based on keeping track
@@ -244,6 +271,215 @@ bool CornerTable::ComputeOppositeCorners(int *num_vertices)
   return true;
 }
 
+int CornerTable::CountVerticesAndDegeneratedFaces()
+{
+  int num_vertices = 0;
+
+  for (FaceIndex f(0); f < static_cast<uint32_t>(num_faces()); ++f)
+  {
+    const CornerIndex c = FirstCorner(f);
+    const VertexIndex v0 = corner_to_vertex_map_[c];
+    const VertexIndex v1 = corner_to_vertex_map_[c + 1];
+    const VertexIndex v2 = corner_to_vertex_map_[c + 2];
+
+    num_vertices = std::max(num_vertices, static_cast<int>(std::max(v0, std::max(v1, v2)).value()) + 1);
+
+    if (v0 == v1 || v0 == v2 || v1 == v2)
+      ++num_degenerated_faces_;
+  }
+
+  return num_vertices;
+}
+
+void CornerTable::MatchHalfEdgesOnEdge(const CornerIndex *begin, const CornerIndex *end)
+{
+  // The incremental method processes the half-edges in the corner order and
+  // connects each half-edge to the first (oldest) unmatched half-edge going
+  // in the opposite direction that doesn't belong to a mirrored face. All
+  // earlier half-edges that are still unmatched are exactly the ones the
+  // incremental method keeps in its per-vertex lists, so the same result is
+  // obtained by scanning the preceding half-edges of the same edge.
+  for (const CornerIndex *it = begin + 1; it < end; ++it)
+  {
+    const CornerIndex c = *it;
+    const VertexIndex tip_v = corner_to_vertex_map_[c];
+    const VertexIndex sink_v = corner_to_vertex_map_[Previous(c)];
+
+    for (const CornerIndex *other = begin; other < it; ++other)
+    {
+      const CornerIndex other_c = *other;
+
+      if (opposite_corners_[other_c] != kInvalidCornerIndex)
+        continue;  // Already matched.
+
+      if (corner_to_vertex_map_[Next(other_c)] != sink_v)
+        continue;  // Half-edge going in the same direction.
+
+      if (corner_to_vertex_map_[other_c] == tip_v)
+        continue;  // Don't connect mirrored faces.
+
+      opposite_corners_[c] = other_c;
+      opposite_corners_[other_c] = c;
+      break;
+    }
+  }
+}
+
+bool CornerTable::ComputeOppositeCornersSorted(int *num_vertices)
+{
+  const int num_table_corners = num_corners();
+  opposite_corners_.assign(num_table_corners, kInvalidCornerIndex);
+  *num_vertices = CountVerticesAndDegeneratedFaces();
+
+  // Counting sort of all half-edges (identified by their opposite corners) of
+  // valid faces by the lower vertex index of the half-edge. Corners within
+  // each bucket stay sorted by their index.
+  std::vector<int> bucket_end(*num_vertices + 1, 0);
+
+  for (CornerIndex c(0); c < num_table_corners; c += 3)
+  {
+    if (IsDegenerated(Face(c)))
+      continue;
+
+    for (int i = 0; i < 3; ++i)
+      ++bucket_end[EdgeLowerVertex(c + i).value() + 1];
+  }
+
+  for (int v = 0; v < *num_vertices; ++v)
+    bucket_end[v + 1] += bucket_end[v];
+
+  std::vector<CornerIndex> sorted_corners(bucket_end[*num_vertices]);
+
+  for (CornerIndex c(0); c < num_table_corners; c += 3)
+  {
+    if (IsDegenerated(Face(c)))
+      continue;
+
+    for (int i = 0; i < 3; ++i)
+      sorted_corners[bucket_end[EdgeLowerVertex(c + i).value()]++] = c + i;
+  }
+
+  // Bucket of vertex |v| is now stored in range
+  // [bucket_end[v - 1], bucket_end[v]). All half-edges of a given edge are in
+  // the same bucket so the buckets can be processed independently.
+  const auto match_buckets = [&](int first_v, int last_v)
+  {
+    for (int v = first_v; v < last_v; ++v)
+    {
+      CornerIndex *const begin = sorted_corners.data() + (v == 0 ? 0 : bucket_end[v - 1]);
+      CornerIndex *const end = sorted_corners.data() + bucket_end[v];
+
+      if (end - begin < 2)
+        continue;
+
+      // Group the half-edges by their higher vertex. The corners of each edge
+      // must stay sorted by their index.
+      std::sort(begin, end, [this](CornerIndex a, CornerIndex b)
+      {
+        const VertexIndex va = EdgeHigherVertex(a);
+        const VertexIndex vb = EdgeHigherVertex(b);
+        return va < vb || (va == vb && a < b);
+      });
+
+      for (CornerIndex *edge_begin = begin; edge_begin < end;)
+      {
+        const VertexIndex high_v = EdgeHigherVertex(*edge_begin);
+        CornerIndex *edge_end = edge_begin + 1;
+
+        while (edge_end < end && EdgeHigherVertex(*edge_end) == high_v)
+          ++edge_end;
+
+        MatchHalfEdgesOnEdge(edge_begin, edge_end);
+        edge_begin = edge_end;
+      }
+    }
+  };
+
+  const int num_tasks = thread_pool_ == nullptr ? 1 : 4 * (thread_pool_->num_threads() + 1);
+
+  if (num_tasks == 1)
+  {
+    match_buckets(0, *num_vertices);
+  }
+  else
+  {
+    // Split the vertices into ranges with roughly the same number of
+    // half-edges.
+    const int64_t num_half_edges = static_cast<int64_t>(sorted_corners.size());
+    std::vector<int> task_first_vertex(num_tasks + 1, *num_vertices);
+    task_first_vertex[0] = 0;
+
+    for (int t = 1; t < num_tasks; ++t)
+    {
+      const int target = static_cast<int>(num_half_edges * t / num_tasks);
+      task_first_vertex[t] = static_cast<int>(std::lower_bound(bucket_end.begin(), bucket_end.begin() + *num_vertices, target) -
+                                              bucket_end.begin());
+    }
+
+    thread_pool_->ParallelFor(num_tasks, [&](int t)
+    {
+      match_buckets(task_first_vertex[t], std::max(task_first_vertex[t], task_first_vertex[t + 1]));
+    });
+  }
+
+  return true;
+}
+
+bool CornerTable::ComputeOppositeCornersSortedLowMemory(int *num_vertices)
+{
+  const int num_table_corners = num_corners();
+  opposite_corners_.assign(num_table_corners, kInvalidCornerIndex);
+  *num_vertices = CountVerticesAndDegeneratedFaces();
+
+  std::vector<CornerIndex> sorted_corners;
+  sorted_corners.reserve(num_table_corners - 3 * num_degenerated_faces_);
+
+  for (CornerIndex c(0); c < num_table_corners; c += 3)
+  {
+    if (IsDegenerated(Face(c)))
+      continue;
+
+    for (int i = 0; i < 3; ++i)
+      sorted_corners.push_back(c + i);
+  }
+
+  // Sort the half-edges by their undirected edge and by the corner index
+  // within each edge.
+  std::sort(sorted_corners.begin(), sorted_corners.end(), [this](CornerIndex a, CornerIndex b)
+  {
+    const VertexIndex la = EdgeLowerVertex(a);
+    const VertexIndex lb = EdgeLowerVertex(b);
+
+    if (la != lb)
+      return la < lb;
+
+    const VertexIndex ha = EdgeHigherVertex(a);
+    const VertexIndex hb = EdgeHigherVertex(b);
+
+    if (ha != hb)
+      return ha < hb;
+
+    return a < b;
+  });
+
+  const CornerIndex *const end = sorted_corners.data() + sorted_corners.size();
+
+  for (const CornerIndex *edge_begin = sorted_corners.data(); edge_begin < end;)
+  {
+    const VertexIndex low_v = EdgeLowerVertex(*edge_begin);
+    const VertexIndex high_v = EdgeHigherVertex(*edge_begin);
+    const CornerIndex *edge_end = edge_begin + 1;
+
+    while (edge_end < end && EdgeLowerVertex(*edge_end) == low_v && EdgeHigherVertex(*edge_end) == high_v)
+      ++edge_end;
+
+    MatchHalfEdgesOnEdge(edge_begin, edge_end);
+    edge_begin = edge_end;
+  }
+
+  return true;
+}
+
 bool CornerTable::BreakNonManifoldEdges() {
   // This function detects and breaks non-manifold edges that are caused by
   // folds in 1-ring neighborhood around a vertex. Non-manifold edges can occur
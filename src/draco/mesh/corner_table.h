@@ -15,12 +15,14 @@
 #ifndef DRACO_MESH_CORNER_TABLE_H_
 #define DRACO_MESH_CORNER_TABLE_H_
 
+#include <algorithm>
 #include <array>
 #include <memory>
 
 #include "draco/attributes/geometry_indices.h"
 #include "draco/core/draco_index_type_vector.h"
 #include "draco/core/macros.h"
+#include "draco/core/thread_pool.h"
 #include "draco/mesh/valence_cache.h"
 
 namespace draco {
@@ -54,15 +56,51 @@ class CornerTable {
   // Corner table face type.
   typedef std::array<VertexIndex, 3> FaceType;
 
+  // Methods that can be used by Init() to find opposite corners. All of them
+  // produce identical corner tables.
+  enum OppositeCornersMethod {
+    // Half-edges are processed one by one and matched against lists of
+    // unmatched half-edges stored for each vertex (default).
+    OPPOSITE_CORNERS_INCREMENTAL = 0,
+    // Half-edges are bucketed by their lower vertex index using a counting
+    // sort and each bucket is matched independently. The buckets are
+    // processed in parallel when a thread pool is set. Uses less temporary
+    // memory than OPPOSITE_CORNERS_INCREMENTAL, but it is slower on a single
+    // thread.
+    OPPOSITE_CORNERS_SORTED,
+    // Half-edges are sorted in place by their edge. Uses a single temporary
+    // index per corner and no per-vertex arrays, but it is slower than
+    // OPPOSITE_CORNERS_SORTED.
+    OPPOSITE_CORNERS_SORTED_LOW_MEMORY,
+  };
+
   CornerTable();
   static std::unique_ptr<CornerTable> Create(
       const IndexTypeVector<FaceIndex, FaceType> &faces);
 
+  // Same as above but the opposite corners are computed using |method|. The
+  // |thread_pool| can be nullptr.
+  static std::unique_ptr<CornerTable> Create(
+      const IndexTypeVector<FaceIndex, FaceType> &faces,
+      OppositeCornersMethod method, ThreadPool *thread_pool);
+
   // Initializes the CornerTable from provides set of indexed faces.
   // The input faces can represent a non-manifold topology, in which case the
   // non-manifold edges and vertices are going to be split.
   bool Init(const IndexTypeVector<FaceIndex, FaceType> &faces);
 
+  // Sets the method used by Init() to compute opposite corners.
+  void set_opposite_corners_method(OppositeCornersMethod method) {
+    opposite_corners_method_ = method;
+  }
+  OppositeCornersMethod opposite_corners_method() const {
+    return opposite_corners_method_;
+  }
+
+  // Sets a thread pool that can be used by Init() to compute opposite corners
+  // in parallel (can be nullptr). The pool must outlive all calls to Init().
+  void set_thread_pool(ThreadPool *thread_pool) { thread_pool_ = thread_pool; }
+
   // Resets the corner table to the given number of invalid faces.
   bool Reset(int num_faces);
 
@@ -428,6 +466,32 @@ class CornerTable {
   // |corner_to_vertex_map_|.
   bool ComputeOppositeCorners(int *num_vertices);
 
+  // Implementations of ComputeOppositeCorners() for the sort based methods
+  // (see OppositeCornersMethod).
+  bool ComputeOppositeCornersSorted(int *num_vertices);
+  bool ComputeOppositeCornersSortedLowMemory(int *num_vertices);
+
+  // Returns the number of vertices referenced by |corner_to_vertex_map_| and
+  // counts the degenerated faces.
+  int CountVerticesAndDegeneratedFaces();
+
+  // Connects opposite corners of half-edges |begin| to |end| that all lie on
+  // the same undirected edge and are sorted by their corner index. The result
+  // is the same as when the half-edges are matched in the corner order by the
+  // incremental method.
+  void MatchHalfEdgesOnEdge(const CornerIndex *begin, const CornerIndex *end);
+
+  // Returns the lower and higher vertex index of the half-edge opposite to
+  // |corner|.
+  VertexIndex EdgeLowerVertex(CornerIndex corner) const {
+    return std::min(corner_to_vertex_map_[Next(corner)],
+                    corner_to_vertex_map_[Previous(corner)]);
+  }
+  VertexIndex EdgeHigherVertex(CornerIndex corner) const {
+    return std::max(corner_to_vertex_map_[Next(corner)],
+                    corner_to_vertex_map_[Previous(corner)]);
+  }
+
   // Finds and breaks non-manifold edges in the 1-ring neighborhood around
   // vertices (vertices themselves will be split in the ComputeVertexCorners()
   // function if necessary).
@@ -448,6 +512,9 @@ class CornerTable {
   int num_isolated_vertices_;
   IndexTypeVector<VertexIndex, VertexIndex> non_manifold_vertex_parents_;
 
+  OppositeCornersMethod opposite_corners_method_;
+  ThreadPool *thread_pool_;
+
   draco::ValenceCache<CornerTable> valence_cache_;
 };
 
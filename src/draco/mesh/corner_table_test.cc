@@ -0,0 +1,112 @@
+// Copyright 2016 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/mesh/corner_table.h"
+
+#include <memory>
+
+#include "draco/core/draco_test_base.h"
+#include "draco/core/draco_test_utils.h"
+#include "draco/core/thread_pool.h"
+
+namespace draco {
+
+class CornerTableTest : public ::testing::Test {
+ protected:
+  typedef IndexTypeVector<FaceIndex, CornerTable::FaceType> FaceVector;
+
+  static FaceVector GetPositionFaces(const Mesh &mesh) {
+    const PointAttribute *const pos_att =
+        mesh.GetNamedAttribute(GeometryAttribute::POSITION);
+    FaceVector faces(mesh.num_faces());
+    for (FaceIndex f(0); f < mesh.num_faces(); ++f) {
+      for (int c = 0; c < 3; ++c) {
+        faces[f][c] = pos_att->mapped_index(mesh.face(f)[c]).value();
+      }
+    }
+    return faces;
+  }
+
+  // Verifies that all opposite corner methods produce the same corner table
+  // as the incremental method.
+  static void TestAllMethods(const FaceVector &faces) {
+    const std::unique_ptr<CornerTable> ref = CornerTable::Create(
+        faces, CornerTable::OPPOSITE_CORNERS_INCREMENTAL, nullptr);
+    ASSERT_NE(ref, nullptr);
+    ThreadPool thread_pool(3);
+    CompareTables(*ref, CornerTable::Create(
+                            faces, CornerTable::OPPOSITE_CORNERS_SORTED,
+                            nullptr));
+    CompareTables(*ref, CornerTable::Create(
+                            faces, CornerTable::OPPOSITE_CORNERS_SORTED,
+                            &thread_pool));
+    CompareTables(
+        *ref, CornerTable::Create(
+                  faces, CornerTable::OPPOSITE_CORNERS_SORTED_LOW_MEMORY,
+                  nullptr));
+  }
+
+  static void CompareTables(const CornerTable &ref,
+                            const std::unique_ptr<CornerTable> &ct) {
+    ASSERT_NE(ct, nullptr);
+    ASSERT_EQ(ct->num_corners(), ref.num_corners());
+    ASSERT_EQ(ct->num_vertices(), ref.num_vertices());
+    ASSERT_EQ(ct->NumNewVertices(), ref.NumNewVertices());
+    ASSERT_EQ(ct->NumDegeneratedFaces(), ref.NumDegeneratedFaces());
+    ASSERT_EQ(ct->NumIsolatedVertices(), ref.NumIsolatedVertices());
+    for (CornerIndex c(0); c < ref.num_corners(); ++c) {
+      ASSERT_EQ(ct->Opposite(c), ref.Opposite(c));
+      ASSERT_EQ(ct->Vertex(c), ref.Vertex(c));
+    }
+    for (VertexIndex v(0); v < ref.num_vertices(); ++v) {
+      ASSERT_EQ(ct->LeftMostCorner(v), ref.LeftMostCorner(v));
+    }
+  }
+};
+
+TEST_F(CornerTableTest, TestOppositeCornersMethodsOnTestMeshes) {
+  const std::string files[] = {"bun_zipper.ply",
+                               "cube_att.obj",
+                               "deg_faces.obj",
+                               "multiple_isolated_triangles.obj",
+                               "multiple_tetrahedrons.obj",
+                               "test_nm.obj",
+                               "test_sphere.obj"};
+  for (const std::string &file : files) {
+    SCOPED_TRACE(file);
+    const std::unique_ptr<Mesh> mesh(ReadMeshFromTestFile(file));
+    ASSERT_NE(mesh, nullptr);
+    TestAllMethods(GetPositionFaces(*mesh));
+  }
+}
+
+TEST_F(CornerTableTest, TestOppositeCornersMethodsOnNonManifoldFaces) {
+  // Random faces on a small number of vertices create many non-manifold edges
+  // shared by several faces, mirrored faces and degenerated faces.
+  FaceVector faces(3000);
+  uint32_t seed = 1;
+  for (FaceIndex f(0); f < faces.size(); ++f) {
+    for (int c = 0; c < 3; ++c) {
+      seed = seed * 1103515245 + 12345;
+      faces[f][c] = VertexIndex((seed >> 16) % 40);
+    }
+  }
+  TestAllMethods(faces);
+}
+
+TEST_F(CornerTableTest, TestOppositeCornersMethodsOnEmptyTable) {
+  TestAllMethods(FaceVector());
+}
+
+}  // namespace draco
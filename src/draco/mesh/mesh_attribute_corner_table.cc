@@ -32,7 +32,9 @@ bool MeshAttributeCornerTable::InitEmpty(const CornerTable *table)
   is_edge_on_seam_.assign(table->num_corners(), false);
   is_vertex_on_seam_.assign(table->num_vertices(), false);
   corner_to_vertex_map_.assign(table->num_corners(), kInvalidVertexIndex);
+  vertex_to_attribute_entry_id_map_.clear();
   vertex_to_attribute_entry_id_map_.reserve(table->num_vertices());
+  vertex_to_left_most_corner_map_.clear();
   vertex_to_left_most_corner_map_.reserve(table->num_vertices());
   corner_table_ = table;
   no_interior_seams_ = true;
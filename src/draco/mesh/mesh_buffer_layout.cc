@@ -0,0 +1,178 @@
+// Copyright 2016 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/mesh/mesh_buffer_layout.h"
+
+#include <cstring>
+#include <limits>
+
+namespace draco {
+
+namespace {
+
+template <typename IndexT>
+Status WriteFaces(const Mesh &mesh, uint8_t *out_indices) {
+  if (mesh.num_points() > 0 &&
+      mesh.num_points() - 1 > std::numeric_limits<IndexT>::max()) {
+    return Status(Status::DRACO_ERROR, "Point index out of range.");
+  }
+  for (FaceIndex f(0); f < mesh.num_faces(); ++f) {
+    const Mesh::Face &face = mesh.face(f);
+    const IndexT indices[3] = {static_cast<IndexT>(face[0].value()),
+                               static_cast<IndexT>(face[1].value()),
+                               static_cast<IndexT>(face[2].value())};
+    memcpy(out_indices, indices, sizeof(indices));
+    out_indices += sizeof(indices);
+  }
+  return OkStatus();
+}
+
+template <typename OutT>
+Status WriteAttribute(const PointAttribute &att, int num_points,
+                      int num_components, uint8_t *out_data,
+                      int64_t byte_stride) {
+  const int entry_size = sizeof(OutT) * num_components;
+  std::vector<OutT> value(num_components);
+  for (PointIndex i(0); i < num_points; ++i) {
+    if (!att.ConvertValue<OutT>(att.mapped_index(i), num_components,
+                                value.data())) {
+      return Status(Status::DRACO_ERROR, "Failed to convert attribute value.");
+    }
+    // The output may not be aligned for OutT.
+    memcpy(out_data, value.data(), entry_size);
+    out_data += byte_stride;
+  }
+  return OkStatus();
+}
+
+}  // namespace
+
+Status CheckAttributeBufferLayout(const AttributeBufferLayout &layout,
+                                  int att_num_components, int num_points) {
+  const int num_components = layout.GetNumComponents(att_num_components);
+  const int data_type_length = DataTypeLength(layout.data_type);
+  if (data_type_length <= 0 || num_components <= 0 ||
+      num_components > std::numeric_limits<int8_t>::max()) {
+    return Status(Status::DRACO_ERROR, "Unsupported attribute layout.");
+  }
+  const int64_t entry_size =
+      static_cast<int64_t>(data_type_length) * num_components;
+  const int64_t byte_stride = layout.GetByteStride(att_num_components);
+  if (layout.byte_offset < 0 || byte_stride < entry_size) {
+    return Status(Status::DRACO_ERROR, "Invalid attribute layout.");
+  }
+  if (num_points == 0) {
+    return OkStatus();
+  }
+  const int64_t required_size =
+      layout.byte_offset + (num_points - 1) * byte_stride + entry_size;
+  if (layout.data == nullptr ||
+      static_cast<uint64_t>(required_size) > layout.data_size) {
+    return Status(Status::DRACO_ERROR, "Attribute buffer is too small.");
+  }
+  return OkStatus();
+}
+
+Status WriteAttributeToBuffer(const PointAttribute &attribute, int num_points,
+                              const AttributeBufferLayout &layout) {
+  DRACO_RETURN_IF_ERROR(CheckAttributeBufferLayout(
+      layout, attribute.num_components(), num_points))
+  if (num_points == 0) {
+    return OkStatus();
+  }
+  const int num_components =
+      layout.GetNumComponents(attribute.num_components());
+  const int64_t entry_size =
+      static_cast<int64_t>(DataTypeLength(layout.data_type)) * num_components;
+  const int64_t byte_stride = layout.GetByteStride(attribute.num_components());
+  uint8_t *out_data = static_cast<uint8_t *>(layout.data) + layout.byte_offset;
+  if (attribute.data_type() == layout.data_type &&
+      attribute.num_components() == num_components &&
+      attribute.byte_stride() == entry_size) {
+    // No conversion is needed and the values can be copied directly.
+    if (attribute.is_mapping_identity() && byte_stride == entry_size &&
+        attribute.size() >= static_cast<size_t>(num_points)) {
+      memcpy(out_data, attribute.GetAddress(AttributeValueIndex(0)),
+             num_points * entry_size);
+      return OkStatus();
+    }
+    for (PointIndex i(0); i < num_points; ++i) {
+      memcpy(out_data, attribute.GetAddress(attribute.mapped_index(i)),
+             entry_size);
+      out_data += byte_stride;
+    }
+    return OkStatus();
+  }
+  switch (layout.data_type) {
+    case DT_INT8:
+      return WriteAttribute<int8_t>(attribute, num_points, num_components,
+                                    out_data, byte_stride);
+    case DT_UINT8:
+      return WriteAttribute<uint8_t>(attribute, num_points, num_components,
+                                     out_data, byte_stride);
+    case DT_INT16:
+      return WriteAttribute<int16_t>(attribute, num_points, num_components,
+                                     out_data, byte_stride);
+    case DT_UINT16:
+      return WriteAttribute<uint16_t>(attribute, num_points, num_components,
+                                      out_data, byte_stride);
+    case DT_INT32:
+      return WriteAttribute<int32_t>(attribute, num_points, num_components,
+                                     out_data, byte_stride);
+    case DT_UINT32:
+      return WriteAttribute<uint32_t>(attribute, num_points, num_components,
+                                      out_data, byte_stride);
+    case DT_FLOAT32:
+      return WriteAttribute<float>(attribute, num_points, num_components,
+                                   out_data, byte_stride);
+    default:
+      return Status(Status::DRACO_ERROR, "Unsupported attribute data type.");
+  }
+}
+
+Status WriteMeshIndicesToBuffer(const Mesh &mesh,
+                                const MeshBufferLayout &layout) {
+  if (layout.indices == nullptr) {
+    return OkStatus();
+  }
+  const int index_size = DataTypeLength(layout.index_type);
+  if (layout.index_type != DT_UINT16 && layout.index_type != DT_UINT32) {
+    return Status(Status::DRACO_ERROR, "Unsupported index type.");
+  }
+  if (static_cast<uint64_t>(mesh.num_faces()) * 3 * index_size >
+      layout.indices_size) {
+    return Status(Status::DRACO_ERROR, "Index buffer is too small.");
+  }
+  uint8_t *const out_indices = static_cast<uint8_t *>(layout.indices);
+  if (layout.index_type == DT_UINT16) {
+    return WriteFaces<uint16_t>(mesh, out_indices);
+  }
+  return WriteFaces<uint32_t>(mesh, out_indices);
+}
+
+Status WriteMeshToBuffers(const Mesh &mesh, const MeshBufferLayout &layout) {
+  DRACO_RETURN_IF_ERROR(WriteMeshIndicesToBuffer(mesh, layout))
+  for (const AttributeBufferLayout &att_layout : layout.attributes) {
+    if (att_layout.attribute_id < 0 ||
+        att_layout.attribute_id >= mesh.num_attributes()) {
+      return Status(Status::DRACO_ERROR, "Invalid attribute id.");
+    }
+    DRACO_RETURN_IF_ERROR(WriteAttributeToBuffer(
+        *mesh.attribute(att_layout.attribute_id), mesh.num_points(),
+        att_layout))
+  }
+  return OkStatus();
+}
+
+}  // namespace draco
@@ -0,0 +1,112 @@
+// Copyright 2016 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef DRACO_MESH_MESH_BUFFER_LAYOUT_H_
+#define DRACO_MESH_MESH_BUFFER_LAYOUT_H_
+
+#include <vector>
+
+#include "draco/core/draco_types.h"
+#include "draco/core/status.h"
+#include "draco/mesh/mesh.h"
+
+namespace draco {
+
+// Describes caller-owned memory into which the values of one attribute are
+// written for all points of a mesh. The value of point |i| is written to
+// |data| + |byte_offset| + |i| * |byte_stride|. Interleaved vertex buffers
+// are described by multiple AttributeBufferLayouts sharing the same |data|
+// and |byte_stride| with different |byte_offset|s.
+struct AttributeBufferLayout {
+  AttributeBufferLayout()
+      : attribute_id(-1),
+        data_type(DT_FLOAT32),
+        num_components(0),
+        data(nullptr),
+        data_size(0),
+        byte_offset(0),
+        byte_stride(0) {}
+
+  // Returns the number of output components for a source attribute with
+  // |att_num_components| components.
+  int GetNumComponents(int att_num_components) const {
+    return num_components > 0 ? num_components : att_num_components;
+  }
+  // Returns the distance in bytes between the outputs of two consecutive
+  // points for a source attribute with |att_num_components| components.
+  int64_t GetByteStride(int att_num_components) const {
+    if (byte_stride > 0) {
+      return byte_stride;
+    }
+    return static_cast<int64_t>(DataTypeLength(data_type)) *
+           GetNumComponents(att_num_components);
+  }
+
+  // Id of the source attribute in the mesh.
+  int attribute_id;
+  // Output data type. The values are converted using
+  // GeometryAttribute::ConvertValue().
+  DataType data_type;
+  // Number of output components. Missing components are filled with zeros.
+  // When 0, the number of components of the source attribute is used.
+  int num_components;
+  void *data;
+  // Size of |data| in bytes.
+  size_t data_size;
+  int64_t byte_offset;
+  // When 0, the values are tightly packed.
+  int64_t byte_stride;
+};
+
+// Describes caller-owned memory into which the faces and attributes of a mesh
+// are written (see WriteMeshToBuffers()).
+struct MeshBufferLayout {
+  MeshBufferLayout()
+      : index_type(DT_UINT32), indices(nullptr), indices_size(0) {}
+
+  // Type of the face indices, either DT_UINT16 or DT_UINT32.
+  DataType index_type;
+  // Output for the point indices of all faces (three per face). Can be
+  // nullptr when the indices are not needed.
+  void *indices;
+  // Size of |indices| in bytes.
+  size_t indices_size;
+  std::vector<AttributeBufferLayout> attributes;
+};
+
+// Returns an error when |layout| can't hold the values of |num_points| points
+// of an attribute with |att_num_components| components.
+Status CheckAttributeBufferLayout(const AttributeBufferLayout &layout,
+                                  int att_num_components, int num_points);
+
+// Writes the values of |attribute| for the first |num_points| points into the
+// memory described by |layout|. The |layout.attribute_id| is ignored.
+Status WriteAttributeToBuffer(const PointAttribute &attribute, int num_points,
+                              const AttributeBufferLayout &layout);
+
+// Writes the point indices of all faces of |mesh| into |layout.indices|. Does
+// nothing when |layout.indices| is nullptr.
+Status WriteMeshIndicesToBuffer(const Mesh &mesh,
+                                const MeshBufferLayout &layout);
+
+// Writes the faces and the attribute values of |mesh| into the memory
+// described by |layout|. The attribute values are written for each point of
+// the mesh, i.e., attribute values shared by multiple points are duplicated.
+// Returns an error when the memory is too small or when the layout is not
+// compatible with the mesh.
+Status WriteMeshToBuffers(const Mesh &mesh, const MeshBufferLayout &layout);
+
+}  // namespace draco
+
+#endif  // DRACO_MESH_MESH_BUFFER_LAYOUT_H_
@@ -0,0 +1,159 @@
+// Copyright 2016 The Draco Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "draco/mesh/mesh_buffer_layout.h"
+
+#include "draco/core/draco_test_base.h"
+#include "draco/core/draco_test_utils.h"
+#include "draco/core/vector_d.h"
+#include "draco/mesh/triangle_soup_mesh_builder.h"
+
+namespace draco {
+
+class MeshBufferLayoutTest : public ::testing::Test {
+ protected:
+  // Creates a mesh with two faces sharing an edge with a float position
+  // attribute and an uint8 color attribute.
+  void SetUp() override {
+    TriangleSoupMeshBuilder mb;
+    mb.Start(2);
+    pos_att_id_ = mb.AddAttribute(GeometryAttribute::POSITION, 3, DT_FLOAT32);
+    color_att_id_ = mb.AddAttribute(GeometryAttribute::COLOR, 3, DT_UINT8);
+    // clang-format off
+    mb.SetAttributeValuesForFace(pos_att_id_, FaceIndex(0),
+                                 Vector3f(0.f, 0.f, 0.f).data(),
+                                 Vector3f(1.f, 0.f, 0.f).data(),
+                                 Vector3f(0.f, 1.f, 0.f).data());
+    mb.SetAttributeValuesForFace(pos_att_id_, FaceIndex(1),
+                                 Vector3f(0.f, 1.f, 0.f).data(),
+                                 Vector3f(1.f, 0.f, 0.f).data(),
+                                 Vector3f(1.f, 1.f, 0.f).data());
+    const uint8_t red[3] = {255, 0, 0};
+    const uint8_t green[3] = {0, 255, 0};
+    mb.SetAttributeValuesForFace(color_att_id_, FaceIndex(0), red, red, red);
+    mb.SetAttributeValuesForFace(color_att_id_, FaceIndex(1), red, red,
+                                 green);
+    // clang-format on
+    mesh_ = mb.Finalize();
+    ASSERT_NE(mesh_, nullptr);
+  }
+
+  // Verifies that |indices| contain the faces of |mesh_|.
+  template <typename IndexT>
+  void CheckIndices(const std::vector<IndexT> &indices) {
+    ASSERT_EQ(indices.size(), mesh_->num_faces() * 3);
+    for (FaceIndex f(0); f < mesh_->num_faces(); ++f) {
+      for (int c = 0; c < 3; ++c) {
+        ASSERT_EQ(indices[3 * f.value() + c], mesh_->face(f)[c].value());
+      }
+    }
+  }
+
+  // Verifies that the value of point |pi| at |data| matches attribute |att_id|
+  // of |mesh_|.
+  template <typename T>
+  void CheckValue(int att_id, PointIndex pi, const uint8_t *data) {
+    const PointAttribute *const att = mesh_->attribute(att_id);
+    T expected_value[3];
+    ASSERT_TRUE(att->ConvertValue<T>(att->mapped_index(pi), expected_value));
+    T value[3];
+    memcpy(value, data, sizeof(value));
+    for (int c = 0; c < 3; ++c) {
+      ASSERT_EQ(value[c], expected_value[c]);
+    }
+  }
+
+  std::unique_ptr<Mesh> mesh_;
+  int pos_att_id_;
+  int color_att_id_;
+};
+
+TEST_F(MeshBufferLayoutTest, TestSeparateBuffers) {
+  std::vector<uint16_t> indices(mesh_->num_faces() * 3);
+  std::vector<float> positions(mesh_->num_points() * 3);
+  std::vector<uint8_t> colors(mesh_->num_points() * 3);
+  MeshBufferLayout layout;
+  layout.index_type = DT_UINT16;
+  layout.indices = indices.data();
+  layout.indices_size = indices.size() * sizeof(uint16_t);
+  layout.attributes.resize(2);
+  layout.attributes[0].attribute_id = pos_att_id_;
+  layout.attributes[0].data = positions.data();
+  layout.attributes[0].data_size = positions.size() * sizeof(float);
+  layout.attributes[1].attribute_id = color_att_id_;
+  layout.attributes[1].data_type = DT_UINT8;
+  layout.attributes[1].data = colors.data();
+  layout.attributes[1].data_size = colors.size();
+  DRACO_ASSERT_OK(WriteMeshToBuffers(*mesh_, layout));
+
+  CheckIndices(indices);
+  for (PointIndex pi(0); pi < mesh_->num_points(); ++pi) {
+    CheckValue<float>(
+        pos_att_id_, pi,
+        reinterpret_cast<const uint8_t *>(&positions[3 * pi.value()]));
+    CheckValue<uint8_t>(color_att_id_, pi, &colors[3 * pi.value()]);
+  }
+}
+
+TEST_F(MeshBufferLayoutTest, TestInterleavedBuffer) {
+  // Positions and colors converted to floats are interleaved in a single
+  // buffer with some padding after each vertex.
+  const int byte_stride = 6 * sizeof(float) + 4;
+  std::vector<uint8_t> vertices(mesh_->num_points() * byte_stride);
+  std::vector<uint32_t> indices(mesh_->num_faces() * 3);
+  MeshBufferLayout layout;
+  layout.indices = indices.data();
+  layout.indices_size = indices.size() * sizeof(uint32_t);
+  layout.attributes.resize(2);
+  for (int i = 0; i < 2; ++i) {
+    AttributeBufferLayout &att_layout = layout.attributes[i];
+    att_layout.attribute_id = i == 0 ? pos_att_id_ : color_att_id_;
+    att_layout.data = vertices.data();
+    att_layout.data_size = vertices.size();
+    att_layout.byte_offset = i * 3 * sizeof(float);
+    att_layout.byte_stride = byte_stride;
+  }
+  DRACO_ASSERT_OK(WriteMeshToBuffers(*mesh_, layout));
+
+  CheckIndices(indices);
+  for (PointIndex pi(0); pi < mesh_->num_points(); ++pi) {
+    const uint8_t *const vertex = &vertices[pi.value() * byte_stride];
+    CheckValue<float>(pos_att_id_, pi, vertex);
+    CheckValue<float>(color_att_id_, pi, vertex + 3 * sizeof(float));
+  }
+}
+
+TEST_F(MeshBufferLayoutTest, TestInvalidLayout) {
+  std::vector<float> positions(mesh_->num_points() * 3);
+  MeshBufferLayout layout;
+  layout.attributes.resize(1);
+  layout.attributes[0].attribute_id = pos_att_id_;
+  layout.attributes[0].data = positions.data();
+  // Buffer is one byte too small.
+  layout.attributes[0].data_size = positions.size() * sizeof(float) - 1;
+  ASSERT_FALSE(WriteMeshToBuffers(*mesh_, layout).ok());
+
+  layout.attributes[0].data_size = positions.size() * sizeof(float);
+  layout.attributes[0].attribute_id = 2;
+  ASSERT_FALSE(WriteMeshToBuffers(*mesh_, layout).ok());
+
+  layout.attributes[0].attribute_id = pos_att_id_;
+  std::vector<uint16_t> indices(mesh_->num_faces() * 3 - 1);
+  layout.index_type = DT_UINT16;
+  layout.indices = indices.data();
+  layout.indices_size = indices.size() * sizeof(uint16_t);
+  ASSERT_FALSE(WriteMeshToBuffers(*mesh_, layout).ok());
+}
+
+}  // namespace draco
@@ -17,12 +17,38 @@
 namespace draco
 {
 
+namespace
+{
+
+std::unique_ptr<CornerTable> CreateCornerTable(const IndexTypeVector<FaceIndex, CornerTable::FaceType> &faces,
+                                               ThreadPool *thread_pool)
+{
+  // On a single thread the incremental method is faster than the sort based
+  // one, which pays off only when the work can be split between threads.
+  const CornerTable::OppositeCornersMethod method =
+      thread_pool == nullptr ? CornerTable::OPPOSITE_CORNERS_INCREMENTAL : CornerTable::OPPOSITE_CORNERS_SORTED;
+  return CornerTable::Create(faces, method, thread_pool);
+}
+
+}  // namespace
+
 std::unique_ptr<CornerTable> CreateCornerTableFromPositionAttribute(const Mesh *mesh)
 {
-  return CreateCornerTableFromAttribute(mesh, GeometryAttribute::POSITION);
+  return CreateCornerTableFromAttribute(mesh, GeometryAttribute::POSITION, nullptr);
+}
+
+std::unique_ptr<CornerTable> CreateCornerTableFromPositionAttribute(const Mesh *mesh, ThreadPool *thread_pool)
+{
+  return CreateCornerTableFromAttribute(mesh, GeometryAttribute::POSITION, thread_pool);
 }
 
 std::unique_ptr<CornerTable> CreateCornerTableFromAttribute(const Mesh *mesh, GeometryAttribute::Type type)
+{
+  return CreateCornerTableFromAttribute(mesh, type, nullptr);
+}
+
+std::unique_ptr<CornerTable> CreateCornerTableFromAttribute(const Mesh *mesh, GeometryAttribute::Type type,
+                                                            ThreadPool *thread_pool)
 {
   typedef CornerTable::FaceType FaceType;
   const PointAttribute *const att = mesh->GetNamedAttribute(type);
@@ -47,10 +73,15 @@ std::unique_ptr<CornerTable> CreateCornerTableFromAttribute(const Mesh *mesh, Ge
   }
 
   // Build the corner table.
-  return CornerTable::Create(faces);
+  return CreateCornerTable(faces, thread_pool);
 }
 
 std::unique_ptr<CornerTable> CreateCornerTableFromAllAttributes(const Mesh *mesh)
+{
+  return CreateCornerTableFromAllAttributes(mesh, nullptr);
+}
+
+std::unique_ptr<CornerTable> CreateCornerTableFromAllAttributes(const Mesh *mesh, ThreadPool *thread_pool)
 {
   typedef CornerTable::FaceType FaceType;
   IndexTypeVector<FaceIndex, FaceType> faces(mesh->num_faces());
@@ -69,6 +100,6 @@ std::unique_ptr<CornerTable> CreateCornerTableFromAllAttributes(const Mesh *mesh
   }
 
   // Build the corner table.
-  return CornerTable::Create(faces);
+  return CreateCornerTable(faces, thread_pool);
 }
 }  // namespace draco
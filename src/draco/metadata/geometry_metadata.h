@@ -58,6 +58,8 @@ class GeometryMetadata : public Metadata {
  public:
   GeometryMetadata() {}
   explicit GeometryMetadata(const Metadata &metadata) : Metadata(metadata) {}
+  // Creates a deep copy of |metadata| including all attribute metadata.
+  GeometryMetadata(const GeometryMetadata &metadata);
 
   const AttributeMetadata *GetAttributeMetadataByStringEntry(
       const std::string &entry_name, const std::string &entry_value) const;
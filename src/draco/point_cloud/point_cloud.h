@@ -111,12 +111,20 @@ class PointCloud {
   // Deduplicates all attribute values (all attribute entries with the same
   // value are merged into a single entry).
   virtual bool DeduplicateAttributeValues();
+
+  // Same as above but large attributes are deduplicated in parallel on
+  // |thread_pool| (can be nullptr). The result is the same.
+  bool DeduplicateAttributeValues(ThreadPool *thread_pool);
 #endif
 
 #ifdef DRACO_ATTRIBUTE_INDICES_DEDUPLICATION_SUPPORTED
   // Removes duplicate point ids (two point ids are duplicate when all of their
   // attributes are mapped to the same entry ids).
   virtual void DeduplicatePointIds();
+
+  // Same as above but duplicate points of large point clouds are found in
+  // parallel on |thread_pool| (can be nullptr). The result is the same.
+  void DeduplicatePointIds(ThreadPool *thread_pool);
 #endif
 
   // Get bounding box.
@@ -270,6 +270,47 @@ bool EXPORT_API GetAttributeData(const DracoMesh *mesh,
   return true;
 }
 
+bool EXPORT_API GetMeshIndicesToBuffer(const DracoMesh *mesh,
+                                       DataType index_type, void *indices,
+                                       int indices_size) {
+  if (mesh == nullptr || indices == nullptr || indices_size < 0) {
+    return false;
+  }
+  const Mesh *const m = static_cast<const Mesh *>(mesh->private_mesh);
+  MeshBufferLayout layout;
+  layout.index_type = index_type;
+  layout.indices = indices;
+  layout.indices_size = indices_size;
+  return WriteMeshToBuffers(*m, layout).ok();
+}
+
+bool EXPORT_API GetAttributeDataToBuffer(const DracoMesh *mesh,
+                                         const DracoAttribute *attribute,
+                                         DataType data_type, int byte_stride,
+                                         void *data, int data_size) {
+  if (mesh == nullptr || attribute == nullptr || data == nullptr ||
+      data_size < 0) {
+    return false;
+  }
+  const Mesh *const m = static_cast<const Mesh *>(mesh->private_mesh);
+  const PointAttribute *const attr =
+      static_cast<const PointAttribute *>(attribute->private_attribute);
+  MeshBufferLayout layout;
+  layout.attributes.resize(1);
+  AttributeBufferLayout &att_layout = layout.attributes[0];
+  for (int i = 0; i < m->num_attributes(); ++i) {
+    if (m->attribute(i) == attr) {
+      att_layout.attribute_id = i;
+      break;
+    }
+  }
+  att_layout.data_type = data_type;
+  att_layout.data = data;
+  att_layout.data_size = data_size;
+  att_layout.byte_stride = byte_stride;
+  return WriteMeshToBuffers(*m, layout).ok();
+}
+
 void ReleaseUnityMesh(DracoToUnityMesh **mesh_ptr) {
   DracoToUnityMesh *mesh = *mesh_ptr;
   if (!mesh) {
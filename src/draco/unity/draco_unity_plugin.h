@@ -19,6 +19,7 @@
 #include "draco/compression/config/compression_shared.h"
 #include "draco/compression/decode.h"
 #include "draco/core/draco_types.h"
+#include "draco/mesh/mesh_buffer_layout.h"
 
 //#define BUILD_UNITY_PLUGIN
 
@@ -112,6 +113,20 @@ bool EXPORT_API GetMeshIndices(const DracoMesh *mesh, DracoData **indices);
 bool EXPORT_API GetAttributeData(const DracoMesh *mesh,
                                  const DracoAttribute *attribute,
                                  DracoData **data);
+// Writes the indices of |mesh| into caller-owned memory |indices| (e.g. a
+// Unity NativeArray) of |indices_size| bytes. |index_type| must be DT_UINT16
+// or DT_UINT32.
+bool EXPORT_API GetMeshIndicesToBuffer(const DracoMesh *mesh,
+                                       DataType index_type, void *indices,
+                                       int indices_size);
+// Writes the attribute data of all vertices converted to |data_type| into
+// caller-owned memory |data| of |data_size| bytes. The values of consecutive
+// vertices are |byte_stride| bytes apart (0 for tightly packed values), which
+// allows writing directly into interleaved vertex buffers.
+bool EXPORT_API GetAttributeDataToBuffer(const DracoMesh *mesh,
+                                         const DracoAttribute *attribute,
+                                         DataType data_type, int byte_stride,
+                                         void *data, int data_size);
 
 // DracoToUnityMesh is deprecated.
 struct EXPORT_API DracoToUnityMesh {